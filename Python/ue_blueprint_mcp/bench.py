@@ -0,0 +1,716 @@
+"""
+Load generator and latency benchmark for the bridge protocol.
+
+Replays a workload (a weighted mix of commands) against a running bridge,
+either the editor plugin or the mock (mock_bridge.py / FMCPMockExecutor),
+sweeping connection count, pipelining depth and request padding. Each run
+reports throughput, latency percentiles (overall and per command), errors by
+error_type, bytes on the wire and client-side allocation counts, and the
+whole sweep is written as JSON that `compare` diffs against a baseline:
+
+    python -m ue_blueprint_mcp.bench run --workload mixed --concurrency 1,4 --depth 1,8 -o base.json
+    python -m ue_blueprint_mcp.bench run --workload mixed --concurrency 1,4 --depth 1,8 -o new.json
+    python -m ue_blueprint_mcp.bench compare base.json new.json --threshold 10
+
+Requests are sent on raw sockets with the plugin's framing (4-byte big-endian
+length + UTF-8 JSON), not through PersistentUnrealConnection, so pipelining
+(several requests written before the first reply is read) can be measured.
+The server answers a connection's requests in order; pushed events are skipped.
+"""
+
+import argparse
+import gc
+import json
+import logging
+import platform
+import random
+import socket
+import sys
+import threading
+import time
+import tracemalloc
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from itertools import product
+from typing import Any, Callable, Optional, Union
+
+logger = logging.getLogger(__name__)
+
+RESULTS_VERSION = 1
+MAX_MESSAGE_BYTES = 100 * 1024 * 1024
+
+# Request params may be a dict or built per request from (worker, sequence)
+ParamsSource = Union[dict, Callable[[int, int], dict]]
+
+
+# =============================================================================
+# Workloads
+# =============================================================================
+
+@dataclass
+class WorkloadStep:
+    """One command of a workload and how often it is picked."""
+    command: str
+    params: ParamsSource = field(default_factory=dict)
+    weight: float = 1.0
+
+    def build_params(self, worker: int, sequence: int) -> dict:
+        if callable(self.params):
+            return self.params(worker, sequence)
+        return _format_params(self.params, worker, sequence)
+
+
+@dataclass
+class Workload:
+    """Weighted command mix, with commands run once before and after a sweep."""
+    name: str
+    description: str
+    steps: list[WorkloadStep]
+    setup: list[tuple[str, dict]] = field(default_factory=list)
+    teardown: list[tuple[str, dict]] = field(default_factory=list)
+
+    def commands(self) -> set[str]:
+        return {step.command for step in self.steps} | {command for command, _ in self.setup + self.teardown}
+
+
+BENCH_BLUEPRINT = "BP_MCPBench"
+SPAWN_BATCH = 100
+
+
+def _format_params(value: Any, worker: int, sequence: int) -> Any:
+    """Expand {worker} and {seq} in the string values of a workload file's params."""
+    if isinstance(value, str):
+        return value.replace("{worker}", str(worker)).replace("{seq}", str(sequence))
+    if isinstance(value, dict):
+        return {key: _format_params(item, worker, sequence) for key, item in value.items()}
+    if isinstance(value, list):
+        return [_format_params(item, worker, sequence) for item in value]
+    return value
+
+
+def _branch_node(worker: int, sequence: int) -> dict:
+    # Spread nodes out so the graph stays readable if someone opens it
+    return {"blueprint_name": BENCH_BLUEPRINT, "node_position": f"[{(sequence % 50) * 300}, {worker * 400}]"}
+
+
+def _spawn_batch(count: int) -> Callable[[int, int], dict]:
+    def build(worker: int, sequence: int) -> dict:
+        # Fixed names per worker, so each call replaces the previous batch instead of growing the level
+        locations = []
+        for index in range(count):
+            locations += [float((index % 10) * 200), float((index // 10) * 200 + worker * 2500), 0.0]
+        return {
+            "class": "StaticMeshActor",
+            "locations": locations,
+            "names": [f"MCPBench_{worker}_{index}" for index in range(count)],
+        }
+    return build
+
+
+def _spawn_cleanup(workers: int, count: int) -> list[tuple[str, dict]]:
+    return [("delete_actor", {"name": f"MCPBench_{worker}_{index}"})
+            for worker in range(workers) for index in range(count)]
+
+
+def builtin_workloads(max_workers: int = 1) -> dict[str, Workload]:
+    """Workloads for the editor plugin and the mock, by name."""
+    spawn_cleanup = _spawn_cleanup(max_workers, SPAWN_BATCH)
+    return {
+        "ping": Workload("ping", "Transport round trip only", [WorkloadStep("ping")]),
+        "context": Workload("context", "get_context (session state, no editor work)", [WorkloadStep("get_context")]),
+        "nodes": Workload(
+            "nodes", f"add_blueprint_branch_node into {BENCH_BLUEPRINT}",
+            [WorkloadStep("add_blueprint_branch_node", _branch_node)],
+            setup=[("create_blueprint", {"name": BENCH_BLUEPRINT, "parent_class": "Actor"})],
+        ),
+        "spawn": Workload(
+            "spawn", f"spawn_actors, {SPAWN_BATCH} StaticMeshActors per call",
+            [WorkloadStep("spawn_actors", _spawn_batch(SPAWN_BATCH))],
+            teardown=spawn_cleanup,
+        ),
+        "reads": Workload(
+            "reads", "Large reads: get_actors_in_level and find_actors_by_name",
+            [WorkloadStep("get_actors_in_level", weight=3), WorkloadStep("find_actors_by_name", {"pattern": "MCPBench"})],
+        ),
+        "mixed": Workload(
+            "mixed", "ping, get_context, node creation, bulk spawn and large reads",
+            [
+                WorkloadStep("ping", weight=20),
+                WorkloadStep("get_context", weight=20),
+                WorkloadStep("add_blueprint_branch_node", _branch_node, weight=20),
+                WorkloadStep("spawn_actors", _spawn_batch(10), weight=10),
+                WorkloadStep("get_actors_in_level", weight=30),
+            ],
+            setup=[("create_blueprint", {"name": BENCH_BLUEPRINT, "parent_class": "Actor"})],
+            teardown=_spawn_cleanup(max_workers, 10),
+        ),
+        "mock-read": Workload("mock-read", "mock_read (1 ms, 256 B)", [WorkloadStep("mock_read")]),
+        "mock-write": Workload("mock-write", "mock_write (5 ms, echoes params)",
+                               [WorkloadStep("mock_write", {"worker": "{worker}", "seq": "{seq}"})]),
+        "mock-heavy": Workload("mock-heavy", "mock_heavy (50 ms, 4 KB)", [WorkloadStep("mock_heavy")]),
+        "mock-mixed": Workload(
+            "mock-mixed", "ping, get_context and the three mock commands",
+            [
+                WorkloadStep("ping", weight=10),
+                WorkloadStep("get_context", weight=10),
+                WorkloadStep("mock_read", weight=55),
+                WorkloadStep("mock_write", {"worker": "{worker}", "seq": "{seq}"}, weight=20),
+                WorkloadStep("mock_heavy", weight=5),
+            ],
+        ),
+    }
+
+
+def load_workload_file(path: str) -> Workload:
+    """
+    Read a workload from JSON:
+
+        {"name": "...", "description": "...",
+         "steps": [{"type": "ping", "params": {}, "weight": 1}, ...],
+         "setup": [{"type": "...", "params": {...}}], "teardown": [...]}
+
+    String values in step params may use {worker} and {seq}.
+    """
+    with open(path, encoding="utf-8") as file:
+        data = json.load(file)
+    steps = [WorkloadStep(step["type"], step.get("params") or {}, float(step.get("weight", 1.0)))
+             for step in data.get("steps", [])]
+    if not steps:
+        raise ValueError(f"{path}: workload has no steps")
+    return Workload(
+        name=data.get("name", path),
+        description=data.get("description", ""),
+        steps=steps,
+        setup=[(entry["type"], entry.get("params") or {}) for entry in data.get("setup", [])],
+        teardown=[(entry["type"], entry.get("params") or {}) for entry in data.get("teardown", [])],
+    )
+
+
+# =============================================================================
+# Client
+# =============================================================================
+
+class BenchConnection:
+    """Raw framed connection; responses are read in the order requests were sent."""
+
+    def __init__(self, host: str, port: int, timeout: float, sock: Optional[socket.socket] = None):
+        """Connects to host:port, or wraps an already connected sock (e.g. a Unix socket)."""
+        if sock is None:
+            sock = socket.create_connection((host, port), timeout=timeout)
+            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock = sock
+        self.bytes_sent = 0
+        self.bytes_received = 0
+
+    @staticmethod
+    def frame(request: dict) -> bytes:
+        body = json.dumps(request, separators=(",", ":")).encode("utf-8")
+        return len(body).to_bytes(4, byteorder="big") + body
+
+    def send(self, frames: bytes):
+        self.sock.sendall(frames)
+        self.bytes_sent += len(frames)
+
+    def receive(self) -> dict:
+        """Next response, skipping pushed events."""
+        while True:
+            length = int.from_bytes(self._recv_exact(4), byteorder="big")
+            if length <= 0 or length > MAX_MESSAGE_BYTES:
+                raise ConnectionError(f"Invalid message length: {length}")
+            message = json.loads(self._recv_exact(length))
+            self.bytes_received += 4 + length
+            if not (isinstance(message, dict) and "event" in message):
+                return message
+
+    def call(self, command: str, params: Optional[dict] = None) -> dict:
+        self.send(self.frame({"type": command, "params": params or {}}))
+        return self.receive()
+
+    def close(self):
+        try:
+            self.send(self.frame({"type": "close"}))
+        except OSError:
+            pass
+        self.sock.close()
+
+    def _recv_exact(self, num_bytes: int) -> bytes:
+        data = bytearray()
+        while len(data) < num_bytes:
+            chunk = self.sock.recv(num_bytes - len(data))
+            if not chunk:
+                raise ConnectionError("Connection closed by server")
+            data.extend(chunk)
+        return bytes(data)
+
+
+def response_outcome(response: dict) -> tuple[bool, Optional[str]]:
+    """(success, error_type) of a response in either wire format (see PersistentUnrealConnection)."""
+    if "success" in response:
+        ok = response.get("success") is True
+    else:
+        ok = response.get("status") == "success"
+    return ok, None if ok else response.get("error_type", "unknown")
+
+
+def response_result(response: dict) -> dict:
+    if "success" in response:
+        return response
+    return response.get("result") or {}
+
+
+# =============================================================================
+# Statistics
+# =============================================================================
+
+def percentile(sorted_values: list[float], fraction: float) -> float:
+    """Nearest-rank percentile of an ascending list."""
+    if not sorted_values:
+        return 0.0
+    return sorted_values[min(len(sorted_values) - 1, int(fraction * len(sorted_values)))]
+
+
+def latency_summary(samples_ms: list[float]) -> dict:
+    samples = sorted(samples_ms)
+    return {
+        "p50": round(percentile(samples, 0.50), 4),
+        "p95": round(percentile(samples, 0.95), 4),
+        "p99": round(percentile(samples, 0.99), 4),
+        "p999": round(percentile(samples, 0.999), 4),
+        "max": round(samples[-1], 4) if samples else 0.0,
+        "mean": round(sum(samples) / len(samples), 4) if samples else 0.0,
+    }
+
+
+@dataclass
+class _WorkerStats:
+    latencies: dict[str, list[float]] = field(default_factory=dict)
+    errors: dict[str, int] = field(default_factory=dict)
+    error_types: dict[str, int] = field(default_factory=dict)
+    bytes_sent: int = 0
+    bytes_received: int = 0
+    failure: Optional[str] = None
+
+
+# =============================================================================
+# Runner
+# =============================================================================
+
+@dataclass
+class RunConfig:
+    host: str = "127.0.0.1"
+    port: int = 55558
+    timeout: float = 30.0
+    duration: float = 10.0
+    warmup: float = 1.0
+    requests: int = 0
+    seed: int = 0
+    trace_allocations: bool = False
+    server_metrics: bool = False
+
+
+class BenchRunner:
+    """Runs one workload at one (concurrency, depth, payload) point."""
+
+    def __init__(self, config: RunConfig):
+        self.config = config
+
+    def connect(self) -> BenchConnection:
+        return BenchConnection(self.config.host, self.config.port, self.config.timeout)
+
+    def run_commands(self, commands: list[tuple[str, dict]], label: str):
+        """Setup or teardown; failures are logged, not fatal (e.g. the Blueprint already exists)."""
+        if not commands:
+            return
+        conn = self.connect()
+        try:
+            failed = 0
+            for command, params in commands:
+                ok, error_type = response_outcome(conn.call(command, params))
+                if not ok:
+                    failed += 1
+                    logger.debug(f"{label} {command} failed: {error_type}")
+            if failed:
+                logger.warning(f"{label}: {failed} of {len(commands)} commands failed")
+        finally:
+            conn.close()
+
+    def run(self, workload: Workload, concurrency: int, depth: int, payload_bytes: int) -> dict:
+        config = self.config
+        padding = "x" * payload_bytes
+        stats = [_WorkerStats() for _ in range(concurrency)]
+        connections = [self.connect() for _ in range(concurrency)]
+
+        # Split a request budget across workers; 0 means run for the duration
+        budgets = [config.requests // concurrency + (1 if index < config.requests % concurrency else 0)
+                   for index in range(concurrency)] if config.requests > 0 else [0] * concurrency
+
+        start_barrier = threading.Barrier(concurrency + 1)
+        timing = {}
+
+        def worker(index: int):
+            conn, worker_stats = connections[index], stats[index]
+            rng = random.Random(config.seed * 7919 + index)
+            weights = [step.weight for step in workload.steps]
+            sequence = 0
+            measured = 0
+            start_barrier.wait()
+            measure_from, stop_at = timing["measure_from"], timing["stop_at"]
+            try:
+                while True:
+                    now = time.perf_counter()
+                    if budgets[index] > 0 and measured >= budgets[index]:
+                        break
+                    if budgets[index] == 0 and now >= stop_at:
+                        break
+
+                    batch = []
+                    frames = bytearray()
+                    for _ in range(depth):
+                        step = rng.choices(workload.steps, weights)[0] if len(weights) > 1 else workload.steps[0]
+                        params = step.build_params(index, sequence)
+                        if padding:
+                            params["_bench_padding"] = padding
+                        frames += conn.frame({"type": step.command, "params": params, "id": f"bench-{index}-{sequence}"})
+                        batch.append(step.command)
+                        sequence += 1
+
+                    sent = time.perf_counter()
+                    conn.send(bytes(frames))
+                    for command in batch:
+                        ok, error_type = response_outcome(conn.receive())
+                        if sent < measure_from:
+                            continue
+                        worker_stats.latencies.setdefault(command, []).append((time.perf_counter() - sent) * 1000.0)
+                        measured += 1
+                        if not ok:
+                            worker_stats.errors[command] = worker_stats.errors.get(command, 0) + 1
+                            worker_stats.error_types[error_type] = worker_stats.error_types.get(error_type, 0) + 1
+            except (OSError, ConnectionError, json.JSONDecodeError) as e:
+                worker_stats.failure = f"{type(e).__name__}: {e}"
+            finally:
+                worker_stats.bytes_sent = conn.bytes_sent
+                worker_stats.bytes_received = conn.bytes_received
+
+        threads = [threading.Thread(target=worker, args=(index,), name=f"bench-{index}", daemon=True)
+                   for index in range(concurrency)]
+        for thread in threads:
+            thread.start()
+
+        server_before = self._server_metrics() if config.server_metrics else None
+        if config.trace_allocations:
+            tracemalloc.start()
+        gc_before = [entry["collections"] for entry in gc.get_stats()]
+        blocks_before = sys.getallocatedblocks()
+
+        now = time.perf_counter()
+        timing["measure_from"] = now + config.warmup
+        timing["stop_at"] = now + config.warmup + config.duration
+        start_barrier.wait()
+        for thread in threads:
+            thread.join()
+        elapsed = time.perf_counter() - timing["measure_from"]
+
+        client_alloc = {
+            "allocated_blocks_delta": sys.getallocatedblocks() - blocks_before,
+            "gc_collections": [after - before for before, after in zip(gc_before, (e["collections"] for e in gc.get_stats()))],
+        }
+        if config.trace_allocations:
+            current, peak = tracemalloc.get_traced_memory()
+            client_alloc["traced_peak_bytes"] = peak
+            client_alloc["traced_current_bytes"] = current
+            tracemalloc.stop()
+
+        for conn in connections:
+            conn.close()
+
+        result = self._summarize(workload, concurrency, depth, payload_bytes, elapsed, stats)
+        result["client_alloc"] = client_alloc
+        if config.server_metrics:
+            result["server_metrics"] = {"before": server_before, "after": self._server_metrics()}
+        return result
+
+    def _server_metrics(self) -> Optional[dict]:
+        """The server's own get_metrics, so its stage split and allocation-free paths can be compared."""
+        try:
+            conn = self.connect()
+            try:
+                response = conn.call("get_metrics")
+            finally:
+                conn.close()
+        except (OSError, ConnectionError):
+            return None
+        return response_result(response) if response_outcome(response)[0] else None
+
+    @staticmethod
+    def _summarize(workload: Workload, concurrency: int, depth: int, payload_bytes: int, elapsed: float,
+                   stats: list[_WorkerStats]) -> dict:
+        all_latencies: list[float] = []
+        by_command: dict[str, dict] = {}
+        error_types: dict[str, int] = {}
+        errors = 0
+        for command in sorted({command for s in stats for command in s.latencies}):
+            samples = [sample for s in stats for sample in s.latencies.get(command, [])]
+            command_errors = sum(s.errors.get(command, 0) for s in stats)
+            all_latencies += samples
+            errors += command_errors
+            by_command[command] = {"requests": len(samples), "errors": command_errors,
+                                   "latency_ms": latency_summary(samples)}
+        for s in stats:
+            for error_type, count in s.error_types.items():
+                error_types[error_type] = error_types.get(error_type, 0) + count
+
+        failures = [s.failure for s in stats if s.failure]
+        for failure in failures:
+            logger.error(f"{workload.name}: worker stopped: {failure}")
+
+        return {
+            "workload": workload.name,
+            "concurrency": concurrency,
+            "depth": depth,
+            "payload_bytes": payload_bytes,
+            "duration_s": round(elapsed, 3),
+            "requests": len(all_latencies),
+            "errors": errors,
+            "error_types": error_types,
+            "throughput_rps": round(len(all_latencies) / elapsed, 2) if elapsed > 0 else 0.0,
+            "latency_ms": latency_summary(all_latencies),
+            "by_command": by_command,
+            "bytes_sent": sum(s.bytes_sent for s in stats),
+            "bytes_received": sum(s.bytes_received for s in stats),
+            "worker_failures": failures,
+        }
+
+
+def detect_target(runner: BenchRunner) -> tuple[str, set[str]]:
+    """('mock' or 'editor', commands served) from list_commands."""
+    conn = runner.connect()
+    try:
+        response = conn.call("list_commands")
+    finally:
+        conn.close()
+    commands = {entry.get("name") for entry in response_result(response).get("commands", [])}
+    return ("mock" if any(name.startswith("mock_") for name in commands) else "editor"), commands
+
+
+# =============================================================================
+# Comparison
+# =============================================================================
+
+def _run_key(run: dict) -> tuple:
+    return run["workload"], run["concurrency"], run["depth"], run["payload_bytes"]
+
+
+def _change_pct(before: float, after: float) -> float:
+    if before == 0:
+        return 0.0 if after == 0 else float("inf")
+    return (after - before) / before * 100.0
+
+
+def compare_results(baseline: dict, current: dict, threshold_pct: float, min_delta_ms: float) -> dict:
+    """
+    Match runs by (workload, concurrency, depth, payload_bytes) and flag a
+    throughput drop or a p50/p99 rise beyond threshold_pct. Latency changes
+    smaller than min_delta_ms are ignored so sub-millisecond noise doesn't trip it.
+    """
+    baseline_runs = {_run_key(run): run for run in baseline.get("runs", [])}
+    rows = []
+    for run in current.get("runs", []):
+        before = baseline_runs.pop(_run_key(run), None)
+        if before is None:
+            continue
+        checks = {"throughput_rps": (before["throughput_rps"], run["throughput_rps"], True)}
+        for name in ("p50", "p99"):
+            checks[name] = (before["latency_ms"][name], run["latency_ms"][name], False)
+
+        regressions = []
+        changes = {}
+        for name, (old, new, higher_is_better) in checks.items():
+            change = _change_pct(old, new)
+            changes[name] = {"baseline": old, "current": new, "change_pct": round(change, 2)}
+            worse = -change if higher_is_better else change
+            if worse > threshold_pct and (higher_is_better or new - old >= min_delta_ms):
+                regressions.append(name)
+        if run["errors"] > before["errors"]:
+            regressions.append("errors")
+        changes["errors"] = {"baseline": before["errors"], "current": run["errors"]}
+
+        rows.append({"workload": run["workload"], "concurrency": run["concurrency"], "depth": run["depth"],
+                     "payload_bytes": run["payload_bytes"], "changes": changes, "regressions": regressions})
+
+    return {
+        "threshold_pct": threshold_pct,
+        "min_delta_ms": min_delta_ms,
+        "rows": rows,
+        "missing_from_current": [list(key) for key in baseline_runs],
+        "regressed": any(row["regressions"] for row in rows),
+    }
+
+
+# =============================================================================
+# CLI
+# =============================================================================
+
+def _int_list(value: str) -> list[int]:
+    try:
+        values = [int(part) for part in value.split(",") if part.strip()]
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"Expected comma-separated integers: {value}")
+    if not values or any(v < 0 for v in values):
+        raise argparse.ArgumentTypeError(f"Expected comma-separated non-negative integers: {value}")
+    return values
+
+
+def _print_run(run: dict):
+    latency = run["latency_ms"]
+    print(f"{run['workload']:<12} c={run['concurrency']:<3} d={run['depth']:<3} pad={run['payload_bytes']:<7} "
+          f"{run['throughput_rps']:>10.1f} req/s  p50 {latency['p50']:>8.3f}  p95 {latency['p95']:>8.3f}  "
+          f"p99 {latency['p99']:>8.3f}  p999 {latency['p999']:>8.3f} ms  errors {run['errors']}")
+
+
+def _print_comparison(comparison: dict):
+    for row in comparison["rows"]:
+        changes = row["changes"]
+        flag = "REGRESSED " + ",".join(row["regressions"]) if row["regressions"] else "ok"
+        print(f"{row['workload']:<12} c={row['concurrency']:<3} d={row['depth']:<3} pad={row['payload_bytes']:<7} "
+              f"rps {changes['throughput_rps']['change_pct']:+7.1f}%  p50 {changes['p50']['change_pct']:+7.1f}%  "
+              f"p99 {changes['p99']['change_pct']:+7.1f}%  {flag}")
+    for key in comparison["missing_from_current"]:
+        print(f"missing from current run: {key}")
+
+
+def cmd_run(args) -> int:
+    config = RunConfig(host=args.host, port=args.port, timeout=args.timeout, duration=args.duration,
+                       warmup=args.warmup, requests=args.requests, seed=args.seed,
+                       trace_allocations=args.trace_allocations, server_metrics=args.server_metrics)
+    runner = BenchRunner(config)
+    target, served = detect_target(runner)
+
+    workloads = builtin_workloads(max(args.concurrency))
+    selected = [load_workload_file(path) for path in args.workload_file]
+    for name in args.workload:
+        if name == "auto":
+            name = "mock-mixed" if target == "mock" else "mixed"
+        if name not in workloads:
+            logger.error(f"Unknown workload '{name}' (known: {', '.join(workloads)})")
+            return 2
+        selected.append(workloads[name])
+
+    meta = {
+        "tool": "ue_blueprint_mcp.bench",
+        "version": RESULTS_VERSION,
+        "started": datetime.now(timezone.utc).isoformat(),
+        "label": args.label,
+        "target": target,
+        "host": args.host,
+        "port": args.port,
+        "duration_s": args.duration,
+        "warmup_s": args.warmup,
+        "requests": args.requests,
+        "seed": args.seed,
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+    }
+    runs = []
+    for workload in selected:
+        missing = sorted(step.command for step in workload.steps if step.command not in served)
+        if missing:
+            logger.warning(f"Skipping {workload.name}: {target} does not serve {', '.join(missing)}")
+            continue
+        runner.run_commands(workload.setup, f"{workload.name} setup")
+        try:
+            for concurrency, depth, payload in product(args.concurrency, args.depth, args.payload):
+                if concurrency < 1 or depth < 1:
+                    continue
+                run = runner.run(workload, concurrency, depth, payload)
+                runs.append(run)
+                _print_run(run)
+        finally:
+            runner.run_commands(workload.teardown, f"{workload.name} teardown")
+
+    results = {"meta": meta, "runs": runs}
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as file:
+            json.dump(results, file, indent=2)
+        print(f"Wrote {len(runs)} runs to {args.output}")
+
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as file:
+            comparison = compare_results(json.load(file), results, args.threshold, args.min_delta_ms)
+        _print_comparison(comparison)
+        return 1 if comparison["regressed"] else 0
+    return 0
+
+
+def cmd_compare(args) -> int:
+    with open(args.baseline, encoding="utf-8") as file:
+        baseline = json.load(file)
+    with open(args.current, encoding="utf-8") as file:
+        current = json.load(file)
+    comparison = compare_results(baseline, current, args.threshold, args.min_delta_ms)
+    _print_comparison(comparison)
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as file:
+            json.dump(comparison, file, indent=2)
+    return 1 if comparison["regressed"] else 0
+
+
+def cmd_list(args) -> int:
+    for workload in builtin_workloads().values():
+        print(f"{workload.name:<12} {workload.description}")
+    return 0
+
+
+def main():
+    """Benchmark a bridge, or compare two result files."""
+    parser = argparse.ArgumentParser(description="Load generator and latency benchmark for the MCP bridge")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    def add_threshold_args(sub):
+        sub.add_argument("--threshold", type=float, default=10.0,
+                         help="Percent change in throughput, p50 or p99 that counts as a regression")
+        sub.add_argument("--min-delta-ms", type=float, default=0.05,
+                         help="Ignore latency rises smaller than this, in ms")
+
+    run = subparsers.add_parser("run", help="Run workloads and report throughput and latency")
+    run.add_argument("--host", default="127.0.0.1")
+    run.add_argument("--port", type=int, default=55558)
+    run.add_argument("--timeout", type=float, default=30.0, help="Socket timeout in seconds")
+    run.add_argument("--workload", action="append", default=[],
+                     help="Built-in workload (repeatable; see 'list'); 'auto' picks mixed or mock-mixed")
+    run.add_argument("--workload-file", action="append", default=[], help="Workload JSON file (repeatable)")
+    run.add_argument("--concurrency", type=_int_list, default=[1], help="Connections, e.g. 1,4,16")
+    run.add_argument("--depth", type=_int_list, default=[1], help="Requests in flight per connection, e.g. 1,8")
+    run.add_argument("--payload", type=_int_list, default=[0], help="Padding bytes added to each request's params")
+    run.add_argument("--duration", type=float, default=10.0, help="Measured seconds per run")
+    run.add_argument("--warmup", type=float, default=1.0, help="Unmeasured seconds before each run")
+    run.add_argument("--requests", type=int, default=0, help="Stop after this many measured requests instead")
+    run.add_argument("--seed", type=int, default=0, help="Seed for the command mix")
+    run.add_argument("--trace-allocations", action="store_true",
+                     help="Trace client allocations with tracemalloc (slows the client)")
+    run.add_argument("--server-metrics", action="store_true", help="Snapshot get_metrics before and after each run")
+    run.add_argument("--label", default="", help="Free text stored in the results (build, commit, machine)")
+    run.add_argument("-o", "--output", help="Write results JSON here")
+    run.add_argument("--baseline", help="Compare against this results JSON and exit 1 on regression")
+    add_threshold_args(run)
+    run.set_defaults(handler=cmd_run)
+
+    compare = subparsers.add_parser("compare", help="Compare two results files")
+    compare.add_argument("baseline")
+    compare.add_argument("current")
+    compare.add_argument("-o", "--output", help="Write the comparison JSON here")
+    add_threshold_args(compare)
+    compare.set_defaults(handler=cmd_compare)
+
+    listing = subparsers.add_parser("list", help="List built-in workloads")
+    listing.set_defaults(handler=cmd_list)
+
+    args = parser.parse_args()
+    if args.command == "run" and not args.workload and not args.workload_file:
+        args.workload = ["auto"]
+
+    logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+    sys.exit(args.handler(args))
+
+
+if __name__ == "__main__":
+    main()
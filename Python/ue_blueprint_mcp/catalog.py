@@ -0,0 +1,64 @@
+"""
+Command catalog served by the plugin's list_commands endpoint.
+
+The plugin's command registry is the source of truth for which commands
+exist, their version and cost class, and (for actions with typed params)
+their params schema. The catalog is fetched once at startup and
+revalidated with its ETag, so the MCP tool list is built once instead of
+on every list_tools call.
+"""
+
+import logging
+from typing import Optional
+
+from .connection import PersistentUnrealConnection
+
+logger = logging.getLogger(__name__)
+
+# inputSchema of tools whose command declares typed params: the plugin's
+# params_schema replaces it once the catalog is loaded, so the schema is
+# written once, next to the action
+PLUGIN_SCHEMA = {"type": "object"}
+
+
+class CommandCatalog:
+    """Cached copy of the plugin's command registry."""
+
+    def __init__(self):
+        self.etag: Optional[str] = None
+        self.commands: dict[str, dict] = {}
+
+    @property
+    def is_loaded(self) -> bool:
+        """Whether a command list has been fetched."""
+        return self.etag is not None
+
+    def refresh(self, conn: PersistentUnrealConnection) -> bool:
+        """
+        Fetch the command list, or revalidate the cached one by ETag.
+
+        Returns:
+            True if the cached list changed, False if unchanged or unavailable.
+        """
+        params = {"if_none_match": self.etag} if self.etag else None
+        result = conn.send_command("list_commands", params)
+        if not result.success:
+            logger.warning(f"list_commands failed, using built-in tool schemas: {result.error}")
+            return False
+
+        if result.data.get("not_modified"):
+            return False
+
+        self.etag = result.data.get("etag")
+        self.commands = {cmd["name"]: cmd for cmd in result.data.get("commands", [])}
+        logger.info(f"Loaded {len(self.commands)} commands from Unreal (etag {self.etag})")
+        return True
+
+    def get(self, command_type: str) -> Optional[dict]:
+        """Registry entry for a command, or None if unknown."""
+        return self.commands.get(command_type)
+
+    def params_schema(self, command_type: str) -> Optional[dict]:
+        """Params schema for a command, or None if the plugin doesn't publish one."""
+        info = self.commands.get(command_type)
+        return info.get("params_schema") if info else None
@@ -6,14 +6,18 @@ this maintains a persistent socket with heartbeat and auto-reconnect.
 """
 
 import json
+import select
 import socket
 import threading
 import time
+import uuid
 import logging
-from typing import Any, Optional
+from typing import Any, Callable, Optional
 from dataclasses import dataclass, field
 from enum import Enum
 
+from .recording import CommandRecorder
+
 logger = logging.getLogger(__name__)
 
 
@@ -36,6 +40,25 @@ class ConnectionConfig:
     max_reconnect_attempts: int = 5
     reconnect_base_delay: float = 1.0
     reconnect_max_delay: float = 30.0
+    # Session token sent with every command so this client keeps its own editor
+    # context ($last_node, current blueprint/material) across reconnects.
+    # None generates a random token per connection object.
+    session_id: Optional[str] = None
+    # Heavy commands run as async jobs: how long to wait for the pushed
+    # completion, and how often to poll get_job meanwhile (also keeps the
+    # connection from idling out while the editor works).
+    job_timeout: float = 600.0
+    job_poll_interval: float = 5.0
+    # While subscribed to editor events, pushed frames are read this often
+    # between commands so listeners hear about them promptly.
+    event_poll_interval: float = 0.25
+    # A full priority lane answers "busy" with a retry_after_ms hint; retry
+    # that many times, waiting the hint (capped) in between.
+    busy_retries: int = 3
+    busy_max_delay: float = 5.0
+    # Append every command and its outcome to this file (recording.py format),
+    # to replay the session later as a workload. None records nothing.
+    record_path: Optional[str] = None
 
 
 @dataclass
@@ -66,8 +89,16 @@ class PersistentUnrealConnection:
     - Auto-reconnect with exponential backoff on failure
     - Thread-safe command execution
     - Queues commands during reconnection
+    - Runs long commands as async jobs and collects pushed completions
+    - Subscribes to editor events and hands them to listeners
     """
 
+    # Pushed job completions kept until their run_job() collects them
+    MAX_PENDING_JOB_RESULTS = 128
+    JOB_FINISHED_STATES = ("succeeded", "failed", "cancelled")
+    # Longest _wait_for_job holds the lock while waiting for a pushed completion
+    JOB_WAIT_SLICE = 0.05
+
     def __init__(self, config: Optional[ConnectionConfig] = None):
         self.config = config or ConnectionConfig()
         self._socket: Optional[socket.socket] = None
@@ -77,6 +108,21 @@ class PersistentUnrealConnection:
         self._stop_heartbeat = threading.Event()
         self._last_activity = time.time()
         self._reconnect_attempts = 0
+        self.session_id = self.config.session_id or uuid.uuid4().hex
+        # Commands that send_command() runs through run_job()
+        self.job_commands: set = set()
+        self._job_results: dict = {}
+        self._event_listeners: list = []
+        # Event names subscribed to; restored after a reconnect
+        self._subscriptions: set = set()
+        # Ids of requests abandoned on a dead or timed-out socket; cancelled
+        # on the next connection so Unreal drops them instead of running them
+        self._pending_cancels: list = []
+        # Sockets opened so far; names the connection in recordings
+        self._connection_count = 0
+        self._last_response_bytes = 0
+        self._recorder = (CommandRecorder(self.config.record_path, port=self.config.port)
+                          if self.config.record_path else None)
 
     @property
     def state(self) -> ConnectionState:
@@ -105,15 +151,22 @@ class PersistentUnrealConnection:
                 self._socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
                 self._socket.settimeout(self.config.timeout)
                 self._socket.connect((self.config.host, self.config.port))
+                # Requests are small and answered before the next is sent; don't let Nagle hold them
+                self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
 
                 self._state = ConnectionState.CONNECTED
                 self._reconnect_attempts = 0
+                self._connection_count += 1
                 self._last_activity = time.time()
 
                 # Start heartbeat thread
                 self._start_heartbeat()
 
                 logger.info(f"Connected to Unreal at {self.config.host}:{self.config.port}")
+
+                # Subscriptions belong to the connection, so a new socket starts with none
+                if self._subscriptions:
+                    self._execute("subscribe", {"events": sorted(self._subscriptions)})
                 return True
 
             except (socket.error, socket.timeout, ConnectionRefusedError) as e:
@@ -140,17 +193,185 @@ class PersistentUnrealConnection:
             self._state = ConnectionState.DISCONNECTED
             logger.info("Disconnected from Unreal")
 
-    def send_command(self, command_type: str, params: Optional[dict] = None) -> CommandResult:
+    def send_command(self, command_type: str, params: Optional[dict] = None,
+                     priority: Optional[str] = None) -> CommandResult:
         """
         Send a command to Unreal and wait for response.
 
+        Commands in job_commands run as async jobs (see run_job), so a long
+        compile or save isn't bound by the socket timeout.
+
         Args:
             command_type: The command type (e.g., "create_blueprint", "ping")
             params: Optional parameters for the command
+            priority: Optional lane override ("interactive", "bulk", "background");
+                by default heavy commands queue as bulk, others as interactive
 
         Returns:
             CommandResult with success/failure and data/error
         """
+        if command_type in self.job_commands:
+            return self.run_job(command_type, params, priority=priority)
+        return self._execute(command_type, params, priority=priority)
+
+    def get_queue_stats(self) -> CommandResult:
+        """Per-lane depth, wait and execution stats of the bridge's dispatcher."""
+        return self._execute("get_queue_stats")
+
+    def get_metrics(self, fmt: str = "json") -> CommandResult:
+        """
+        Per-command latency percentiles by stage, error rates and payload sizes.
+
+        Args:
+            fmt: "json", or "prometheus" for the text exposition format in data["text"]
+        """
+        return self._execute("get_metrics", {"format": fmt})
+
+    def dump_flight_recorder(self, count: int = 100, log: bool = False) -> CommandResult:
+        """
+        The last requests the bridge answered, oldest first, with stage times and outcome.
+
+        Args:
+            count: How many records to return (the bridge keeps the last 1024)
+            log: Also write them to the editor log
+        """
+        return self._execute("dump_flight_recorder", {"count": count, "log": log})
+
+    def run_job(self, command_type: str, params: Optional[dict] = None,
+                timeout: Optional[float] = None, priority: Optional[str] = None) -> CommandResult:
+        """
+        Run a command as an async job and wait for its result.
+
+        The bridge replies with a job id at once and pushes a job_completed
+        event when the command is done; get_job is polled as a fallback.
+        The job is cancelled if it outlives the timeout.
+
+        Args:
+            command_type: The command type (e.g., "compile_blueprint")
+            params: Optional parameters for the command
+            timeout: Seconds to wait (default: config.job_timeout)
+
+        Returns:
+            CommandResult of the command itself
+        """
+        timeout = timeout or self.config.job_timeout
+        started = self._execute(command_type, params, async_job=True, priority=priority)
+        job_id = started.data.get("job_id") if started.success else None
+        if not job_id:
+            # Failed to start, or a bridge without jobs answered directly
+            return started
+
+        logger.debug(f"Job {job_id} ({command_type}) started")
+        deadline = time.time() + timeout
+        while True:
+            remaining = deadline - time.time()
+            if remaining <= 0:
+                self.cancel_job(job_id)
+                return CommandResult(
+                    success=False,
+                    error=f"Job {job_id} ('{command_type}') timed out after {timeout}s and was cancelled",
+                    recoverable=True
+                )
+
+            event = self._wait_for_job(job_id, min(remaining, self.config.job_poll_interval))
+            if event is None:
+                status = self.get_job(job_id)
+                if not status.success:
+                    return status
+                if status.data.get("status") in self.JOB_FINISHED_STATES:
+                    event = status.data
+            if event is not None:
+                return self._job_result(command_type, event)
+
+    def get_job(self, job_id: str) -> CommandResult:
+        """Get an async job's status (and result once finished)."""
+        return self._execute("get_job", {"job_id": job_id})
+
+    def cancel_job(self, job_id: str) -> CommandResult:
+        """Ask an async job to stop."""
+        return self._execute("cancel_job", {"job_id": job_id})
+
+    def cancel(self, request_id: str) -> CommandResult:
+        """Cancel an in-flight request (or async job) by id, from any connection."""
+        return self._execute("cancel", {"id": request_id})
+
+    def add_event_listener(self, listener: Callable[[dict], None]):
+        """Call listener(event) for every frame Unreal pushes unsolicited."""
+        self._event_listeners.append(listener)
+
+    def remove_event_listener(self, listener: Callable[[dict], None]):
+        """Stop calling a listener added with add_event_listener."""
+        if listener in self._event_listeners:
+            self._event_listeners.remove(listener)
+
+    def subscribe(self, events: Optional[list] = None) -> CommandResult:
+        """
+        Subscribe this connection to editor events (None = all of them).
+
+        Events (asset_added, blueprint_compiled, actor_moved, pie_started,
+        ...) are pushed on the same socket and delivered to event listeners,
+        also between commands while any subscription is active.
+        """
+        result = self._execute("subscribe", {"events": list(events)} if events else None)
+        if result.success:
+            self._subscriptions = set(result.data.get("subscribed", []))
+        return result
+
+    def unsubscribe(self, events: Optional[list] = None) -> CommandResult:
+        """Unsubscribe from editor events (None = all of them)."""
+        result = self._execute("unsubscribe", {"events": list(events)} if events else None)
+        if result.success:
+            self._subscriptions = set(result.data.get("subscribed", []))
+        return result
+
+    def poll_events(self, timeout: float = 0.0) -> int:
+        """
+        Read frames Unreal pushed while no command was running.
+
+        Returns:
+            Number of events dispatched (0 if a command holds the socket).
+        """
+        if not self._lock.acquire(blocking=False):
+            return 0
+        try:
+            count = 0
+            deadline = time.time() + timeout
+            while self._socket:
+                remaining = max(deadline - time.time(), 0.0)
+                readable, _, _ = select.select([self._socket], [], [], remaining)
+                if not readable:
+                    break
+                try:
+                    frame = self._receive_raw()
+                except socket.timeout:
+                    frame = None
+                if frame is None:
+                    self._state = ConnectionState.ERROR
+                    self._cleanup_socket()
+                    break
+                if "event" in frame:
+                    self._dispatch_event(frame)
+                    count += 1
+                else:
+                    logger.warning("Dropping unexpected frame received between commands")
+            return count
+        finally:
+            self._lock.release()
+
+    def _execute(self, command_type: str, params: Optional[dict] = None,
+                 async_job: bool = False, priority: Optional[str] = None,
+                 busy_attempt: int = 0, idempotency_key: Optional[str] = None) -> CommandResult:
+        """
+        Send one command and parse its direct response.
+
+        Every command carries an id and a deadline (the socket timeout), so
+        Unreal drops it unrun once this client has given up on it. Busy
+        rejections from a full lane are retried after the server's hint.
+
+        Every command also carries an idempotency key, kept across retries of
+        the same call: a mutating command re-sent after a dropped connection
+        gets the first attempt's response back instead of running twice.
+        """
         with self._lock:
             # Ensure connected
             if not self.is_connected:
@@ -161,99 +382,76 @@ class PersistentUnrealConnection:
                         recoverable=True
                     )
 
-            command = {"type": command_type}
+            self._flush_pending_cancels()
+
+            request_id = uuid.uuid4().hex
+            idempotency_key = idempotency_key or uuid.uuid4().hex
+            command = {
+                "type": command_type,
+                "session": self.session_id,
+                "id": request_id,
+                "deadline_ms": int(self.config.timeout * 1000),
+                "idempotency_key": idempotency_key,
+            }
             if params:
                 command["params"] = params
+            if async_job:
+                command["async"] = True
+            if priority:
+                command["priority"] = priority
 
             try:
-                # Log outgoing command (truncate large params)
-                params_preview = json.dumps(params)[:200] if params else "none"
-                logger.debug(f">>> Sending command '{command_type}' with params: {params_preview}")
+                # Per-command traffic is debug detail; skip building previews otherwise
+                debug = logger.isEnabledFor(logging.DEBUG)
+                if debug:
+                    params_preview = json.dumps(params)[:200] if params else "none"
+                    logger.debug(f">>> Sending command '{command_type}' with params: {params_preview}")
 
                 # Send command
+                sent_at = time.perf_counter()
                 self._send_raw(command)
 
                 # Receive response
-                response = self._receive_raw()
+                response = self._receive_response()
                 self._last_activity = time.time()
+                self._record(command, sent_at, response)
 
-                # Log incoming response (truncate large responses)
-                if response:
-                    response_preview = json.dumps(response)[:500]
-                    logger.warning(f"<<< [{command_type}] Response: {response_preview}")
+                if response and debug:
+                    logger.debug(f"<<< [{command_type}] Response: {json.dumps(response)[:500]}")
 
                 if response is None:
                     # Connection died, try reconnect
                     self._state = ConnectionState.ERROR
                     if self._try_reconnect():
-                        # Retry the command once
-                        return self.send_command(command_type, params)
+                        # Retry once under the same key: the bridge replays the lost
+                        # attempt's response (or waits for it) rather than running it again
+                        return self._execute(command_type, params, async_job, priority,
+                                             idempotency_key=idempotency_key)
+                    self._pending_cancels.append(request_id)
                     return CommandResult(
                         success=False,
                         error="Connection lost and reconnect failed",
                         recoverable=True
                     )
 
-                # Parse response - handle both formats:
-                # Format 1 (EditorAction): {"success": true, ...data...}
-                # Format 2 (MCPBridge legacy): {"status": "success", "result": {...}}
-                #
-                # IMPORTANT: Check "success" field FIRST because some responses
-                # have both "success" and "status" where "status" is a data field
-                # (e.g., compilation status "UpToDate"), not a success indicator.
-
-                # Check Format 1 first (success bool field)
-                if "success" in response:
-                    if response.get("success") is True:
-                        # Extract all fields except 'success' as data
-                        data = {k: v for k, v in response.items() if k != "success"}
-                        return CommandResult(
-                            success=True,
-                            data=data
-                        )
-                    else:
-                        error_msg = response.get("error", "Unknown error (no error message in response)")
-                        error_type = response.get("error_type", "unknown")
-                        # Include raw response in error for debugging
-                        raw_preview = json.dumps(response)[:200]
-                        full_error = f"[{error_type}] {error_msg} | RAW: {raw_preview}"
-                        logger.error(f"Command '{command_type}' failed: {full_error}")
-                        return CommandResult(
-                            success=False,
-                            error=full_error,
-                            recoverable=response.get("recoverable", True)
-                        )
-
-                # Check Format 2 (legacy status field - only if no success field)
-                elif "status" in response:
-                    if response.get("status") == "success":
-                        return CommandResult(
-                            success=True,
-                            data=response.get("result", {})
-                        )
-                    else:
-                        error_msg = response.get("error", "Unknown error (no error message in response)")
-                        error_type = response.get("error_type", "unknown")
-                        raw_preview = json.dumps(response)[:200]
-                        full_error = f"[{error_type}] {error_msg} | RAW: {raw_preview}"
-                        logger.error(f"Command '{command_type}' failed: {full_error}")
-                        return CommandResult(
-                            success=False,
-                            error=full_error,
-                            recoverable=response.get("recoverable", True)
-                        )
-
-                # Unknown response format - log the raw response for debugging
-                else:
-                    logger.error(f"Command '{command_type}' returned unknown response format: {json.dumps(response)[:500]}")
-                    return CommandResult(
-                        success=False,
-                        error=f"Unknown response format from Unreal. Raw: {json.dumps(response)[:200]}",
-                        recoverable=True
-                    )
+                # Backpressure: the lane was full and the command never ran
+                if response.get("error_type") == "busy" and busy_attempt < self.config.busy_retries:
+                    delay = min(response.get("retry_after_ms", 100) / 1000.0, self.config.busy_max_delay)
+                    logger.info(f"Command '{command_type}' rejected as busy ({response.get('lane')} lane), retrying in {delay:.2f}s")
+                    time.sleep(delay)
+                    return self._execute(command_type, params, async_job, priority, busy_attempt + 1,
+                                         idempotency_key=idempotency_key)
+
+                return self._parse_response(command_type, response)
 
             except socket.timeout:
+                # The late response would answer the next command: drop this socket,
+                # and cancel the request once reconnected in case it is still queued
                 logger.warning(f"Command '{command_type}' timed out")
+                self._record(command, sent_at, None)
+                self._state = ConnectionState.ERROR
+                self._cleanup_socket()
+                self._pending_cancels.append(request_id)
                 return CommandResult(
                     success=False,
                     error=f"Command '{command_type}' timed out after {self.config.timeout}s",
@@ -263,12 +461,155 @@ class PersistentUnrealConnection:
                 logger.error(f"Socket error during command '{command_type}': {e}")
                 self._state = ConnectionState.ERROR
                 self._cleanup_socket()
+                self._pending_cancels.append(request_id)
                 return CommandResult(
                     success=False,
                     error=str(e),
                     recoverable=True
                 )
 
+    def _record(self, command: dict, sent_at: float, response: Optional[dict]):
+        """Add a sent command and its outcome to the recording, if recording."""
+        if self._recorder:
+            self._recorder.record(self._connection_count, self.session_id, command, sent_at, time.perf_counter(),
+                                  response, self._last_response_bytes if response is not None else 0)
+
+    def _flush_pending_cancels(self):
+        """Cancel requests abandoned on a previous socket."""
+        while self._pending_cancels:
+            request_id = self._pending_cancels.pop(0)
+            self._execute("cancel", {"id": request_id})
+
+    def _parse_response(self, command_type: str, response: dict) -> CommandResult:
+        """Turn a response in either wire format into a CommandResult."""
+        # Parse response - handle both formats:
+        # Format 1 (EditorAction): {"success": true, ...data...}
+        # Format 2 (MCPBridge legacy): {"status": "success", "result": {...}}
+        #
+        # IMPORTANT: Check "success" field FIRST because some responses
+        # have both "success" and "status" where "status" is a data field
+        # (e.g., compilation status "UpToDate"), not a success indicator.
+
+        # Check Format 1 first (success bool field)
+        if "success" in response:
+            if response.get("success") is True:
+                # Extract all fields except 'success' as data
+                data = {k: v for k, v in response.items() if k != "success"}
+                return CommandResult(
+                    success=True,
+                    data=data
+                )
+            else:
+                error_msg = response.get("error", "Unknown error (no error message in response)")
+                error_type = response.get("error_type", "unknown")
+                # Include raw response in error for debugging
+                raw_preview = json.dumps(response)[:200]
+                full_error = f"[{error_type}] {error_msg} | RAW: {raw_preview}"
+                logger.error(f"Command '{command_type}' failed: {full_error}")
+                return CommandResult(
+                    success=False,
+                    error=full_error,
+                    recoverable=response.get("recoverable", True)
+                )
+
+        # Check Format 2 (legacy status field - only if no success field)
+        elif "status" in response:
+            if response.get("status") == "success":
+                return CommandResult(
+                    success=True,
+                    data=response.get("result", {})
+                )
+            else:
+                error_msg = response.get("error", "Unknown error (no error message in response)")
+                error_type = response.get("error_type", "unknown")
+                raw_preview = json.dumps(response)[:200]
+                full_error = f"[{error_type}] {error_msg} | RAW: {raw_preview}"
+                logger.error(f"Command '{command_type}' failed: {full_error}")
+                return CommandResult(
+                    success=False,
+                    error=full_error,
+                    recoverable=response.get("recoverable", True)
+                )
+
+        # Unknown response format - log the raw response for debugging
+        else:
+            logger.error(f"Command '{command_type}' returned unknown response format: {json.dumps(response)[:500]}")
+            return CommandResult(
+                success=False,
+                error=f"Unknown response format from Unreal. Raw: {json.dumps(response)[:200]}",
+                recoverable=True
+            )
+
+    def _receive_response(self) -> Optional[dict]:
+        """Receive the reply to the command just sent, handling pushed events first."""
+        response = self._receive_raw()
+        while response is not None and "event" in response:
+            self._dispatch_event(response)
+            response = self._receive_raw()
+        return response
+
+    def _dispatch_event(self, event: dict):
+        """Handle a frame Unreal pushed without being asked."""
+        if event.get("event") == "job_completed" and event.get("job_id"):
+            self._job_results[event["job_id"]] = event
+            while len(self._job_results) > self.MAX_PENDING_JOB_RESULTS:
+                self._job_results.pop(next(iter(self._job_results)))
+
+        for listener in list(self._event_listeners):
+            try:
+                listener(event)
+            except Exception as e:
+                logger.error(f"Event listener error: {e}")
+
+    def _wait_for_job(self, job_id: str, wait: float) -> Optional[dict]:
+        """
+        Read pushed frames for up to `wait` seconds until job_id completes.
+
+        The lock is only held for one short select at a time, so other
+        commands and the heartbeat keep running while the job does (their
+        responses may also carry the completion).
+
+        Returns:
+            The job_completed event, or None if it hasn't arrived yet.
+        """
+        deadline = time.time() + wait
+        while True:
+            with self._lock:
+                if job_id in self._job_results:
+                    return self._job_results.pop(job_id)
+                remaining = deadline - time.time()
+                if remaining <= 0 or not self._socket:
+                    return None
+                readable, _, _ = select.select([self._socket], [], [], min(remaining, self.JOB_WAIT_SLICE))
+                if readable:
+                    try:
+                        frame = self._receive_raw()
+                    except socket.timeout:
+                        frame = None
+                    if frame is None:
+                        # Half a frame is left on the socket; the next command reconnects
+                        self._state = ConnectionState.ERROR
+                        self._cleanup_socket()
+                        return None
+                    if "event" in frame:
+                        self._dispatch_event(frame)
+                    else:
+                        logger.warning(f"Dropping unexpected frame while waiting for job {job_id}")
+            # Let a waiting caller take the socket between slices
+            time.sleep(0)
+
+    def _job_result(self, command_type: str, event: dict) -> CommandResult:
+        """Result of a finished job: the command's own response."""
+        self._job_results.pop(event.get("job_id"), None)
+        result = event.get("result")
+        if isinstance(result, dict):
+            return self._parse_response(command_type, result)
+        return CommandResult(
+            success=False,
+            error=f"Job {event.get('job_id')} ({command_type}) {event.get('status', 'failed')} without a result",
+            recoverable=True
+        )
+
     def ping(self) -> bool:
         """
         Send a ping to check connection health.
@@ -296,10 +637,9 @@ class PersistentUnrealConnection:
         json_str = json.dumps(data)
         message = json_str.encode('utf-8')
 
-        # Send length prefix (4 bytes, big endian)
+        # Length prefix (4 bytes, big endian) and body in one write, so they leave as one segment
         length = len(message)
-        self._socket.sendall(length.to_bytes(4, byteorder='big'))
-        self._socket.sendall(message)
+        self._socket.sendall(length.to_bytes(4, byteorder='big') + message)
 
     def _receive_raw(self) -> Optional[dict]:
         """Receive raw JSON data from socket."""
@@ -313,6 +653,7 @@ class PersistentUnrealConnection:
                 return None
 
             length = int.from_bytes(length_bytes, byteorder='big')
+            self._last_response_bytes = length
 
             # Sanity check length
             if length <= 0 or length > 100 * 1024 * 1024:  # Max 100MB
@@ -343,7 +684,8 @@ class PersistentUnrealConnection:
                     return None  # Connection closed
                 data.extend(chunk)
             except socket.timeout:
-                return None
+                # Let the caller tell a slow editor from a dead connection
+                raise
             except socket.error:
                 return None
 
@@ -394,13 +736,22 @@ class PersistentUnrealConnection:
         self._heartbeat_thread.start()
 
     def _heartbeat_loop(self):
-        """Background thread that sends periodic pings."""
+        """Background thread that sends periodic pings (and reads pushed events)."""
         while not self._stop_heartbeat.is_set():
-            self._stop_heartbeat.wait(self.config.heartbeat_interval)
+            interval = self.config.heartbeat_interval
+            if self._subscriptions:
+                interval = min(interval, self.config.event_poll_interval)
+            self._stop_heartbeat.wait(interval)
 
             if self._stop_heartbeat.is_set():
                 break
 
+            if self._subscriptions and self.is_connected:
+                try:
+                    self.poll_events()
+                except Exception as e:
+                    logger.error(f"Event poll error: {e}")
+
             # Check if we need to ping (no recent activity)
             elapsed = time.time() - self._last_activity
             if elapsed >= self.config.heartbeat_interval:
@@ -0,0 +1,579 @@
+"""
+Stand-in for the Unreal bridge that speaks the same protocol without Unreal.
+
+Mirrors the plugin's FMCPMockExecutor: every command is answered after a
+synthetic latency with a payload of a configured size. Framing (4-byte
+big-endian length + UTF-8 JSON), sessions, the server commands
+(ping/close/list_commands/get_context/jobs/cancel/get_metrics/...),
+deadlines, idempotency keys and async jobs with pushed completions behave
+like the plugin's server, so the client, transport and framing can be
+benchmarked on machines without an editor. Commands are serialized through
+one worker, like the editor's game thread.
+
+    python -m ue_blueprint_mcp.mock_bridge --port 55558
+    python -m ue_blueprint_mcp.mock_bridge --command mock_write=mutating,20,1024,5
+    python -m ue_blueprint_mcp.mock_bridge --recording session.jsonl
+"""
+
+import argparse
+import hashlib
+import json
+import logging
+import random
+import socket
+import socketserver
+import threading
+import time
+import uuid
+from collections import deque
+from dataclasses import dataclass
+from typing import Optional
+
+logger = logging.getLogger(__name__)
+
+MAX_MESSAGE_BYTES = 100 * 1024 * 1024
+FLIGHT_RECORDER_CAPACITY = 1024
+MAX_FINISHED_JOBS = 128
+
+SERVER_COMMANDS = {
+    "ping": "read_only", "get_context": "read_only", "list_commands": "read_only",
+    "get_job": "read_only", "list_jobs": "read_only", "cancel_job": "mutating", "cancel": "mutating",
+    "get_queue_stats": "read_only", "get_metrics": "read_only", "dump_flight_recorder": "read_only",
+    "subscribe": "read_only", "unsubscribe": "read_only",
+}
+
+
+@dataclass
+class MockCommand:
+    """Synthetic cost and response of one mock command."""
+    cost: str = "mutating"
+    latency_ms: float = 1.0
+    payload_bytes: int = 64
+    jitter_ms: float = 0.0
+    error_rate: float = 0.0
+
+
+def default_commands() -> dict[str, MockCommand]:
+    """Same defaults as FMCPMockExecutorSettings::MakeDefault."""
+    return {
+        "mock_read": MockCommand("read_only", 1.0, 256),
+        "mock_write": MockCommand("mutating", 5.0, 64),
+        "mock_heavy": MockCommand("heavy", 50.0, 4096),
+    }
+
+
+def parse_command_spec(spec: str) -> tuple[str, MockCommand]:
+    """Parse 'name=cost,latency_ms,payload_bytes[,jitter_ms[,error_rate]]'."""
+    name, _, values = spec.partition("=")
+    parts = values.split(",") if values else []
+    if not name or len(parts) < 3:
+        raise argparse.ArgumentTypeError(f"Expected name=cost,latency_ms,payload_bytes[,jitter_ms[,error_rate]]: {spec}")
+    return name, MockCommand(
+        cost=parts[0],
+        latency_ms=float(parts[1]),
+        payload_bytes=int(parts[2]),
+        jitter_ms=float(parts[3]) if len(parts) > 3 else 0.0,
+        error_rate=float(parts[4]) if len(parts) > 4 else 0.0,
+    )
+
+
+def _percentile(sorted_values: list[float], fraction: float) -> float:
+    if not sorted_values:
+        return 0.0
+    return sorted_values[min(len(sorted_values) - 1, int(fraction * len(sorted_values)))]
+
+
+def _error(message: str, error_type: str, **fields) -> dict:
+    return {"success": False, "error": message, "error_type": error_type, **fields}
+
+
+class _CancelToken:
+    """Cancellation state of one request (explicit cancel or deadline)."""
+
+    def __init__(self, deadline_ms: float = 0.0):
+        self.cancelled = False
+        self.deadline = time.monotonic() + deadline_ms / 1000.0 if deadline_ms > 0 else 0.0
+
+    def expired(self) -> bool:
+        return self.deadline > 0 and time.monotonic() > self.deadline
+
+    def should_stop(self) -> bool:
+        return self.cancelled or self.expired()
+
+
+class _Job:
+    def __init__(self, command_type: str, session: str, connection: "_Connection"):
+        self.id = uuid.uuid4().hex[:16]
+        self.command = command_type
+        self.session = session
+        self.connection = connection
+        self.status = "queued"
+        self.cancel_requested = False
+        self.created = time.monotonic()
+        self.finished: Optional[float] = None
+        self.result: Optional[dict] = None
+
+    @property
+    def cancelled(self) -> bool:
+        return self.cancel_requested
+
+    def should_stop(self) -> bool:
+        return self.cancel_requested
+
+    def status_fields(self, include_result: bool) -> dict:
+        done = self.finished is not None
+        fields = {
+            "job_id": self.id,
+            "command": self.command,
+            "status": self.status,
+            "progress": 1.0 if done else 0.0,
+            "elapsed_ms": round(((self.finished or time.monotonic()) - self.created) * 1000.0),
+        }
+        if include_result and done and self.result is not None:
+            fields["result"] = self.result
+        return fields
+
+
+class _Connection:
+    """One client connection: its socket, session and send lock."""
+
+    def __init__(self, sock: socket.socket, session: str):
+        self.sock = sock
+        self.session = session
+        self.send_lock = threading.Lock()
+        self.open = True
+
+    def send(self, body: bytes):
+        with self.send_lock:
+            self.sock.sendall(len(body).to_bytes(4, byteorder="big") + body)
+
+
+class MockBridge:
+    """Protocol-compatible stand-in for the Unreal bridge's TCP server."""
+
+    def __init__(self, host: str = "127.0.0.1", port: int = 55558,
+                 commands: Optional[dict[str, MockCommand]] = None, seed: int = 0):
+        self.commands = commands or default_commands()
+        self._random = random.Random(seed)
+
+        # One worker runs commands, like the game thread
+        self._game_thread = threading.Lock()
+
+        self._lock = threading.Lock()
+        self._jobs: dict[str, _Job] = {}
+        self._in_flight: dict[str, _CancelToken] = {}
+        self._idempotent: dict[str, tuple[str, str, Optional[bytes]]] = {}
+        self._session_calls: dict[str, int] = {}
+        self._samples: dict[str, list[float]] = {}
+        self._errors: dict[str, int] = {}
+        self._flight = deque(maxlen=FLIGHT_RECORDER_CAPACITY)
+        self._recorded = 0
+        self._start = time.monotonic()
+
+        registry = [
+            {"name": name, "version": 1, "cost": cost, "concurrent": False, "params_schema": None}
+            for name, cost in {**SERVER_COMMANDS, **{n: c.cost for n, c in self.commands.items()}}.items()
+        ]
+        registry.sort(key=lambda entry: entry["name"])
+        condensed = json.dumps(registry, separators=(",", ":")).encode("utf-8")
+        self.etag = hashlib.md5(condensed).hexdigest()
+        self._list_response = {"success": True, "etag": self.etag, "count": len(registry), "commands": registry}
+
+        bridge = self
+
+        class Handler(socketserver.BaseRequestHandler):
+            def handle(self):
+                bridge._serve_connection(self.request)
+
+        class Server(socketserver.ThreadingTCPServer):
+            daemon_threads = True
+            allow_reuse_address = True
+
+        self._server = Server((host, port), Handler)
+        self.port = self._server.server_address[1]
+        self._thread: Optional[threading.Thread] = None
+
+    # -------------------------------------------------------------------------
+    # Lifecycle
+    # -------------------------------------------------------------------------
+
+    def start(self) -> "MockBridge":
+        """Serve on a background thread."""
+        self._thread = threading.Thread(target=self._server.serve_forever, name="MockBridge", daemon=True)
+        self._thread.start()
+        logger.info(f"Mock bridge listening on port {self.port} ({', '.join(sorted(self.commands))})")
+        return self
+
+    def serve_forever(self):
+        logger.info(f"Mock bridge listening on port {self.port} ({', '.join(sorted(self.commands))})")
+        self._server.serve_forever()
+
+    def stop(self):
+        self._server.shutdown()
+        self._server.server_close()
+
+    def __enter__(self) -> "MockBridge":
+        return self.start()
+
+    def __exit__(self, *exc):
+        self.stop()
+
+    # -------------------------------------------------------------------------
+    # Connection loop
+    # -------------------------------------------------------------------------
+
+    def _serve_connection(self, sock: socket.socket):
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        conn = _Connection(sock, f"conn-{uuid.uuid4().hex[:8]}")
+        try:
+            while True:
+                started = time.perf_counter()
+                message = self._receive(sock)
+                if message is None:
+                    break
+                received = time.perf_counter()
+
+                try:
+                    request = json.loads(message)
+                except (json.JSONDecodeError, UnicodeDecodeError):
+                    conn.send(b'{"status":"error","error":"Invalid JSON"}')
+                    continue
+                command_type = request.get("type") if isinstance(request, dict) else None
+                if not command_type:
+                    conn.send(b'{"status":"error","error":"Missing \'type\' field"}')
+                    continue
+                if command_type == "close":
+                    conn.send(b'{"status":"success","result":{"closed":true}}')
+                    break
+
+                session = request.get("session") or conn.session
+                params = request.get("params") or {}
+                response, body, record = self._handle(conn, request, command_type, session, params)
+                if body is None:
+                    body = json.dumps(response).encode("utf-8")
+                conn.send(body)
+
+                if record:
+                    ok = response is None or bool(response.get("success", response.get("status") != "error"))
+                    self._record(command_type, session, request.get("id", ""), started, received,
+                                 time.perf_counter(), ok, None if ok else response.get("error_type"),
+                                 len(message), len(body))
+        except OSError:
+            pass
+        finally:
+            conn.open = False
+            with self._lock:
+                self._session_calls.pop(conn.session, None)
+
+    @staticmethod
+    def _receive(sock: socket.socket) -> Optional[bytes]:
+        header = MockBridge._recv_exact(sock, 4)
+        if header is None:
+            return None
+        length = int.from_bytes(header, byteorder="big")
+        if length <= 0 or length > MAX_MESSAGE_BYTES:
+            logger.warning(f"Invalid message length: {length}")
+            return None
+        return MockBridge._recv_exact(sock, length)
+
+    @staticmethod
+    def _recv_exact(sock: socket.socket, num_bytes: int) -> Optional[bytes]:
+        data = bytearray()
+        while len(data) < num_bytes:
+            chunk = sock.recv(num_bytes - len(data))
+            if not chunk:
+                return None
+            data.extend(chunk)
+        return bytes(data)
+
+    # -------------------------------------------------------------------------
+    # Routing
+    # -------------------------------------------------------------------------
+
+    def _handle(self, conn: _Connection, request: dict, command_type: str, session: str,
+                params: dict) -> tuple[Optional[dict], Optional[bytes], bool]:
+        """Returns (response, pre-serialized body or None, whether to record it)."""
+        if command_type == "ping":
+            return {"status": "success", "result": {"pong": True}}, None, False
+        if command_type == "get_context":
+            with self._lock:
+                calls = self._session_calls.get(session, 0)
+            return {"status": "success", "result": {"mock": True, "calls": calls, "session": session}}, None, False
+        if command_type == "list_commands":
+            if params.get("if_none_match") == self.etag:
+                return {"success": True, "not_modified": True, "etag": self.etag}, None, False
+            return self._list_response, None, False
+        if command_type in ("get_job", "list_jobs", "cancel_job"):
+            return self._handle_job_command(command_type, params), None, False
+        if command_type == "cancel":
+            return self._handle_cancel(params), None, False
+        if command_type == "get_queue_stats":
+            return {"success": True, "mock": True, "lanes": {}}, None, False
+        if command_type == "get_metrics":
+            return self._handle_metrics(params), None, False
+        if command_type == "dump_flight_recorder":
+            count = max(1, min(int(params.get("count", 100)), FLIGHT_RECORDER_CAPACITY))
+            with self._lock:
+                records = list(self._flight)[-count:]
+                recorded = self._recorded
+            return {"success": True, "capacity": FLIGHT_RECORDER_CAPACITY, "recorded": recorded,
+                    "records": records}, None, False
+        if command_type in ("subscribe", "unsubscribe"):
+            return {"success": True, "subscribed": [], "available": []}, None, False
+
+        profile = self.commands.get(command_type)
+        if profile is None:
+            return _error(f"Unknown command: {command_type}", "unknown_command"), None, True
+
+        # Replay a keyed mutating command instead of running it twice
+        key = request.get("idempotency_key")
+        scoped_key = None
+        if key and profile.cost != "read_only":
+            scoped_key = f"{session}/{key}"
+            fingerprint = hashlib.md5(json.dumps(params, sort_keys=True).encode("utf-8")).hexdigest()
+            with self._lock:
+                entry = self._idempotent.get(scoped_key)
+                if entry is None:
+                    self._idempotent[scoped_key] = (command_type, fingerprint, None)
+                elif entry[:2] != (command_type, fingerprint):
+                    return _error("Idempotency key reused for a different command or params",
+                                  "validation_failed"), None, True
+                elif entry[2] is not None:
+                    return None, entry[2], False
+                else:
+                    return _error("A request with this idempotency key is still running", "busy",
+                                  retry_after_ms=100), None, False
+
+        if request.get("async"):
+            response = self._start_job(conn, command_type, session, params)
+            body = json.dumps(response).encode("utf-8")
+            if scoped_key:
+                self._complete_key(scoped_key, body)
+            return response, body, False
+
+        token = _CancelToken(float(request.get("deadline_ms", 0) or 0))
+        request_id = request.get("id")
+        if request_id:
+            with self._lock:
+                self._in_flight[request_id] = token
+        try:
+            with self._game_thread:
+                if token.should_stop():
+                    response = _error("Request cancelled before it ran" if token.cancelled
+                                      else "Request deadline passed before it ran",
+                                      "cancelled" if token.cancelled else "deadline_exceeded")
+                    ran = False
+                else:
+                    response = self._run(command_type, session, params, profile, token)
+                    ran = True
+        finally:
+            if request_id:
+                with self._lock:
+                    self._in_flight.pop(request_id, None)
+
+        body = json.dumps(response).encode("utf-8")
+        if scoped_key:
+            if ran:
+                self._complete_key(scoped_key, body)
+            else:
+                with self._lock:
+                    self._idempotent.pop(scoped_key, None)
+        return response, body, True
+
+    def _complete_key(self, scoped_key: str, body: bytes):
+        with self._lock:
+            command_type, fingerprint, _ = self._idempotent[scoped_key]
+            self._idempotent[scoped_key] = (command_type, fingerprint, body)
+
+    # -------------------------------------------------------------------------
+    # Execution (under the game-thread lock)
+    # -------------------------------------------------------------------------
+
+    def _run(self, command_type: str, session: str, params: dict, profile: MockCommand, token) -> dict:
+        """Run a mock command; token is a _CancelToken or _Job (should_stop(), cancelled)."""
+        with self._lock:
+            self._session_calls[session] = self._session_calls.get(session, 0) + 1
+            jitter = self._random.uniform(-profile.jitter_ms, profile.jitter_ms) if profile.jitter_ms > 0 else 0.0
+            fail = profile.error_rate > 0 and self._random.random() < profile.error_rate
+
+        # Sleep in slices so a cancel or deadline cuts the wait short
+        target = max(0.0, profile.latency_ms + jitter) / 1000.0
+        start = time.perf_counter()
+        while (elapsed := time.perf_counter() - start) < target:
+            if token.should_stop():
+                return _error("Request cancelled" if token.cancelled else "Request deadline passed",
+                              "cancelled" if token.cancelled else "deadline_exceeded")
+            time.sleep(min(target - elapsed, 0.001))
+        latency_ms = (time.perf_counter() - start) * 1000.0
+
+        if fail:
+            return _error(f"Injected failure of {command_type}", "execution_failed")
+
+        response = {"success": True, "command": command_type, "session": session, "latency_ms": latency_ms}
+        if profile.cost != "read_only":
+            response["params"] = params
+        response["payload"] = "x" * profile.payload_bytes
+        return response
+
+    # -------------------------------------------------------------------------
+    # Jobs, cancel, metrics
+    # -------------------------------------------------------------------------
+
+    def _start_job(self, conn: _Connection, command_type: str, session: str, params: dict) -> dict:
+        job = _Job(command_type, session, conn)
+        with self._lock:
+            self._jobs[job.id] = job
+
+        def run():
+            with self._game_thread:
+                if job.cancel_requested:
+                    job.status = "cancelled"
+                    job.result = _error("Job cancelled before it ran", "cancelled")
+                else:
+                    job.status = "running"
+                    job.result = self._run(command_type, session, params, self.commands[command_type], job)
+                    if job.result.get("success"):
+                        job.status = "succeeded"
+                    else:
+                        job.status = "cancelled" if job.result.get("error_type") == "cancelled" else "failed"
+            job.finished = time.monotonic()
+            self._age_out_jobs()
+            if conn.open:
+                try:
+                    conn.send(json.dumps({"event": "job_completed", **job.status_fields(True)}).encode("utf-8"))
+                except OSError:
+                    pass
+
+        threading.Thread(target=run, name=f"MockJob {job.id}", daemon=True).start()
+        return {"success": True, **job.status_fields(False)}
+
+    def _age_out_jobs(self):
+        with self._lock:
+            finished = [job_id for job_id, job in self._jobs.items() if job.finished is not None]
+            for job_id in finished[:-MAX_FINISHED_JOBS]:
+                del self._jobs[job_id]
+
+    def _handle_job_command(self, command_type: str, params: dict) -> dict:
+        with self._lock:
+            if command_type == "list_jobs":
+                jobs = [job.status_fields(False) for job in self._jobs.values()
+                        if params.get("all") or job.finished is None]
+                return {"success": True, "jobs": jobs, "count": len(jobs)}
+            job_id = params.get("job_id")
+            if not job_id:
+                return _error("Missing 'job_id' parameter", "validation_failed")
+            job = self._jobs.get(job_id)
+            if job is None:
+                return _error(f"Job not found: {job_id}", "not_found")
+            if command_type == "cancel_job":
+                requested = job.finished is None
+                job.cancel_requested = job.cancel_requested or requested
+                return {"success": True, "cancel_requested": requested, **job.status_fields(False)}
+            return {"success": True, **job.status_fields(True)}
+
+    def _handle_cancel(self, params: dict) -> dict:
+        request_id = params.get("id")
+        if not request_id:
+            return _error("Missing 'id' parameter", "validation_failed")
+        with self._lock:
+            token = self._in_flight.get(request_id)
+            job = self._jobs.get(request_id)
+        if token:
+            token.cancelled = True
+        elif job and job.finished is None:
+            job.cancel_requested = True
+        return {"success": True, "id": request_id, "cancelled": bool(token or (job and job.finished is None))}
+
+    def _record(self, command_type: str, session: str, request_id: str, started: float, received: float,
+                finished: float, ok: bool, error_type: Optional[str], request_bytes: int, response_bytes: int):
+        total_ms = (finished - started) * 1000.0
+        with self._lock:
+            self._samples.setdefault(command_type, []).append(total_ms)
+            if not ok:
+                self._errors[command_type] = self._errors.get(command_type, 0) + 1
+            record = {
+                "seq": self._recorded,
+                "time": time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()),
+                "command": command_type,
+                "session": session,
+                "success": ok,
+                "total_ms": total_ms,
+                "stages_ms": {"receive": (received - started) * 1000.0, "execute": (finished - received) * 1000.0},
+                "request_bytes": request_bytes,
+                "response_bytes": response_bytes,
+            }
+            if request_id:
+                record["id"] = request_id
+            if error_type:
+                record["error_type"] = error_type
+            self._flight.append(record)
+            self._recorded += 1
+
+    def _handle_metrics(self, params: dict) -> dict:
+        fmt = params.get("format", "json")
+        with self._lock:
+            stats = {name: (sorted(samples), self._errors.get(name, 0)) for name, samples in self._samples.items()}
+
+        if fmt == "prometheus":
+            lines = ["# TYPE ue_mcp_request_duration_seconds summary"]
+            for name, (samples, errors) in sorted(stats.items()):
+                for quantile in (0.5, 0.9, 0.99):
+                    lines.append(f'ue_mcp_request_duration_seconds{{command="{name}",quantile="{quantile}"}} '
+                                 f"{_percentile(samples, quantile) / 1000.0:.9g}")
+                lines.append(f'ue_mcp_request_duration_seconds_sum{{command="{name}"}} {sum(samples) / 1000.0:.9g}')
+                lines.append(f'ue_mcp_request_duration_seconds_count{{command="{name}"}} {len(samples)}')
+                lines.append(f'ue_mcp_errors_total{{command="{name}"}} {errors}')
+            return {"success": True, "format": "prometheus", "text": "\n".join(lines) + "\n"}
+        if fmt != "json":
+            return _error(f"Unknown format '{fmt}'. Available: json, prometheus", "validation_failed")
+
+        commands = {}
+        for name, (samples, errors) in sorted(stats.items()):
+            commands[name] = {
+                "count": len(samples),
+                "errors": errors,
+                "error_rate": errors / len(samples),
+                "latency_ms": {"total": {
+                    "count": len(samples),
+                    "mean": sum(samples) / len(samples),
+                    "p50": _percentile(samples, 0.5),
+                    "p90": _percentile(samples, 0.9),
+                    "p99": _percentile(samples, 0.99),
+                    "max": samples[-1],
+                }},
+            }
+        return {"success": True, "uptime_seconds": time.monotonic() - self._start, "commands": commands}
+
+
+def main():
+    """Run the mock bridge until interrupted."""
+    parser = argparse.ArgumentParser(description="Protocol-compatible stand-in for the Unreal MCP bridge")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=55558)
+    parser.add_argument("--command", action="append", type=parse_command_spec, default=[],
+                        metavar="NAME=COST,LATENCY_MS,PAYLOAD_BYTES[,JITTER_MS[,ERROR_RATE]]",
+                        help="Serve a mock command (repeatable); defaults to mock_read, mock_write and mock_heavy")
+    parser.add_argument("--recording", action="append", default=[],
+                        help="Also serve every command in this recording at its recorded cost (repeatable)")
+    parser.add_argument("--seed", type=int, default=0, help="Seed for jitter and injected errors")
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+
+    commands = dict(args.command)
+    if args.recording:
+        from .recording import commands_from_recording, read_recording
+        for path in args.recording:
+            commands = {**commands_from_recording(read_recording(path)), **commands}
+
+    bridge = MockBridge(args.host, args.port, commands or None, args.seed)
+    try:
+        bridge.serve_forever()
+    except KeyboardInterrupt:
+        logger.info("Mock bridge stopped by user")
+    finally:
+        bridge.stop()
+
+
+if __name__ == "__main__":
+    main()
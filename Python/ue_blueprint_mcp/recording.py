@@ -0,0 +1,357 @@
+"""
+Record bridge requests and replay them as a workload.
+
+A recording is JSON Lines: a header line per capture, then one line per
+answered request, written by the plugin (-MCPRecord=<path>, see
+FMCPCommandRecorder) or by this client (ConnectionConfig.record_path):
+
+    {"mcp_recording":1,"source":"server","started":"...","port":55558}
+    {"t":1520.113,"c":1,"s":"conn-1","ms":12.402,"ok":true,"e":"","rb":311,"req":{"type":...}}
+
+t is ms since the capture started, c the connection, s the session, ms the
+time to answer, ok/e the outcome and rb the response size.
+
+Replay sends every request again, one socket per recorded connection so
+connection sessions and per-connection order are kept, at the original pace,
+N times faster, or as fast as the target answers. Each outcome (success and
+error_type) is checked against the recording and answer times are compared:
+
+    python -m ue_blueprint_mcp.recording session.jsonl --speed original
+    python -m ue_blueprint_mcp.recording session.jsonl --speed max --port 55600 -o replay.json
+
+To replay without an editor, serve the recorded commands from the mock at
+their recorded cost: python -m ue_blueprint_mcp.mock_bridge --recording session.jsonl
+"""
+
+import argparse
+import json
+import logging
+import sys
+import threading
+import time
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from typing import Optional
+
+from .bench import BenchConnection, latency_summary, response_outcome
+from .mock_bridge import MockCommand
+
+logger = logging.getLogger(__name__)
+
+RECORDING_VERSION = 1
+
+# Answered by the server from its own state (job ids, subscriptions, stats), not replayable
+STATEFUL_SERVER_COMMANDS = {"close", "get_job", "cancel_job", "list_jobs", "cancel", "subscribe", "unsubscribe",
+                            "get_queue_stats", "get_metrics", "dump_flight_recorder"}
+
+# Left out when deriving mock commands from a recording
+SERVER_COMMANDS = STATEFUL_SERVER_COMMANDS | {"ping", "get_context", "list_commands"}
+
+
+# =============================================================================
+# Recording
+# =============================================================================
+
+class CommandRecorder:
+    """Appends answered requests to a recording file (thread-safe, flushed per line)."""
+
+    def __init__(self, path: str, source: str = "client", **header):
+        self.path = path
+        self._lock = threading.Lock()
+        self._start = time.perf_counter()
+        self._file = open(path, "a", encoding="utf-8")
+        self._write({"mcp_recording": RECORDING_VERSION, "source": source,
+                     "started": datetime.now(timezone.utc).isoformat(), **header})
+
+    def record(self, connection: int, session: str, request: dict, received_at: float, answered_at: float,
+               response: Optional[dict], response_bytes: int = 0):
+        """
+        Append one request. received_at/answered_at are time.perf_counter() values;
+        a None response (connection lost) is recorded as a failure with error_type "no_response".
+        """
+        ok, error_type = response_outcome(response) if response is not None else (False, "no_response")
+        self._write({
+            "t": round((received_at - self._start) * 1000.0, 3),
+            "c": connection,
+            "s": session,
+            "ms": round((answered_at - received_at) * 1000.0, 3),
+            "ok": ok,
+            "e": error_type or "",
+            "rb": response_bytes,
+            "req": request,
+        })
+
+    def close(self):
+        with self._lock:
+            if not self._file.closed:
+                self._file.close()
+
+    def _write(self, line: dict):
+        text = json.dumps(line, separators=(",", ":")) + "\n"
+        with self._lock:
+            if not self._file.closed:
+                self._file.write(text)
+                self._file.flush()
+
+
+@dataclass
+class Capture:
+    """One header and the requests recorded under it."""
+    header: dict
+    records: list[dict] = field(default_factory=list)
+
+
+def read_recording(path: str) -> list[Capture]:
+    """Captures in file order; a truncated last line (recorder killed mid-write) is skipped."""
+    captures: list[Capture] = []
+    with open(path, encoding="utf-8") as file:
+        for number, line in enumerate(file, 1):
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                entry = json.loads(line)
+            except json.JSONDecodeError:
+                logger.warning(f"{path}:{number}: skipping unreadable line")
+                continue
+            if "mcp_recording" in entry:
+                captures.append(Capture(entry))
+            elif "req" in entry:
+                if not captures:
+                    captures.append(Capture({"mcp_recording": RECORDING_VERSION, "source": "unknown"}))
+                captures[-1].records.append(entry)
+    return captures
+
+
+def commands_from_recording(captures: list[Capture]) -> dict[str, MockCommand]:
+    """
+    A mock command per recorded command type, with its median answer time and
+    response size and its failure rate (same as FMCPMockExecutorSettings::FromRecording).
+    """
+    observed: dict[str, list[dict]] = {}
+    for capture in captures:
+        for record in capture.records:
+            command = record["req"].get("type")
+            if command and command not in SERVER_COMMANDS:
+                observed.setdefault(command, []).append(record)
+
+    commands = {}
+    for command, records in observed.items():
+        times = sorted(record.get("ms", 0.0) for record in records)
+        sizes = sorted(record.get("rb", 0) for record in records)
+        failures = sum(1 for record in records if not record.get("ok", True))
+        commands[command] = MockCommand("mutating", times[len(times) // 2], sizes[len(sizes) // 2],
+                                        error_rate=failures / len(records))
+    return commands
+
+
+# =============================================================================
+# Replay
+# =============================================================================
+
+@dataclass
+class ReplayConfig:
+    host: str = "127.0.0.1"
+    port: int = 55558
+    timeout: float = 60.0
+    # Multiplier on the recorded pace; 0 sends as fast as the target answers
+    speed: float = 1.0
+    verify: bool = True
+    # Idempotency keys are dropped by default so a replay onto the same editor runs, not replays
+    keep_idempotency_keys: bool = False
+    max_mismatches: int = 50
+
+
+class Replayer:
+    """Feeds a recording back into a bridge and checks the answers."""
+
+    def __init__(self, config: ReplayConfig):
+        self.config = config
+
+    def replay(self, captures: list[Capture]) -> dict:
+        started = time.perf_counter()
+        sent = skipped = 0
+        mismatches: list[dict] = []
+        recorded_ms: dict[str, list[float]] = {}
+        replayed_ms: dict[str, list[float]] = {}
+        failures: list[str] = []
+
+        for capture_index, capture in enumerate(captures):
+            result = self._replay_capture(capture_index, capture)
+            sent += result["sent"]
+            skipped += result["skipped"]
+            mismatches += result["mismatches"]
+            failures += result["failures"]
+            for command, samples in result["recorded_ms"].items():
+                recorded_ms.setdefault(command, []).extend(samples)
+            for command, samples in result["replayed_ms"].items():
+                replayed_ms.setdefault(command, []).extend(samples)
+
+        by_command = {
+            command: {
+                "requests": len(replayed_ms.get(command, [])),
+                "recorded_ms": latency_summary(recorded_ms.get(command, [])),
+                "replayed_ms": latency_summary(replayed_ms.get(command, [])),
+            }
+            for command in sorted(replayed_ms)
+        }
+        all_recorded = [sample for samples in recorded_ms.values() for sample in samples]
+        all_replayed = [sample for samples in replayed_ms.values() for sample in samples]
+        recorded_span = sum(_span_seconds(capture.records) for capture in captures)
+
+        return {
+            "speed": self.config.speed,
+            "verified": self.config.verify,
+            "sent": sent,
+            "skipped": skipped,
+            "mismatched": len(mismatches),
+            "mismatches": mismatches[:self.config.max_mismatches],
+            "worker_failures": failures,
+            "recorded_span_s": round(recorded_span, 3),
+            "replay_wall_s": round(time.perf_counter() - started, 3),
+            "recorded_ms": latency_summary(all_recorded),
+            "replayed_ms": latency_summary(all_replayed),
+            "by_command": by_command,
+        }
+
+    def _replay_capture(self, capture_index: int, capture: Capture) -> dict:
+        by_connection: dict[object, list[tuple[int, dict]]] = {}
+        skipped = 0
+        for index, record in enumerate(capture.records):
+            if record["req"].get("type") in STATEFUL_SERVER_COMMANDS:
+                skipped += 1
+                continue
+            by_connection.setdefault(record.get("c", 0), []).append((index, record))
+
+        # Pace from the first request, not from when the capture was opened
+        base_ms = min((record.get("t", 0.0) for records in by_connection.values() for _, record in records), default=0.0)
+
+        lock = threading.Lock()
+        result = {"sent": 0, "skipped": skipped, "mismatches": [], "failures": [],
+                  "recorded_ms": {}, "replayed_ms": {}}
+        start_barrier = threading.Barrier(len(by_connection) + 1)
+        timing = {}
+
+        def worker(records: list[tuple[int, dict]]):
+            try:
+                conn = BenchConnection(self.config.host, self.config.port, self.config.timeout)
+            except OSError as e:
+                with lock:
+                    result["failures"].append(f"connect: {e}")
+                start_barrier.wait()
+                return
+            start_barrier.wait()
+            try:
+                for index, record in records:
+                    if self.config.speed > 0:
+                        offset = (record.get("t", 0.0) - base_ms) / 1000.0 / self.config.speed
+                        delay = timing["start"] + offset - time.perf_counter()
+                        if delay > 0:
+                            time.sleep(delay)
+
+                    request = dict(record["req"])
+                    if not self.config.keep_idempotency_keys:
+                        request.pop("idempotency_key", None)
+                    command = request.get("type", "")
+
+                    sent = time.perf_counter()
+                    conn.send(conn.frame(request))
+                    ok, error_type = response_outcome(conn.receive())
+                    elapsed_ms = (time.perf_counter() - sent) * 1000.0
+
+                    with lock:
+                        result["sent"] += 1
+                        result["recorded_ms"].setdefault(command, []).append(record.get("ms", 0.0))
+                        result["replayed_ms"].setdefault(command, []).append(elapsed_ms)
+                        expected_ok = record.get("ok", True)
+                        expected_error = None if expected_ok else (record.get("e") or "unknown")
+                        if self.config.verify and (ok, error_type) != (expected_ok, expected_error):
+                            result["mismatches"].append({
+                                "capture": capture_index, "index": index, "type": command,
+                                "expected": {"ok": expected_ok, "error_type": expected_error},
+                                "actual": {"ok": ok, "error_type": error_type},
+                            })
+            except (OSError, ConnectionError, json.JSONDecodeError) as e:
+                with lock:
+                    result["failures"].append(f"{type(e).__name__}: {e}")
+            finally:
+                conn.close()
+
+        threads = [threading.Thread(target=worker, args=(records,), daemon=True)
+                   for records in by_connection.values()]
+        for thread in threads:
+            thread.start()
+        timing["start"] = time.perf_counter()
+        start_barrier.wait()
+        for thread in threads:
+            thread.join()
+        return result
+
+
+def _span_seconds(records: list[dict]) -> float:
+    if not records:
+        return 0.0
+    return (max(r.get("t", 0.0) + r.get("ms", 0.0) for r in records) - min(r.get("t", 0.0) for r in records)) / 1000.0
+
+
+def parse_speed(value: str) -> float:
+    """'original' (1), 'max' (0), or a multiplier such as '4' or '4x'."""
+    value = value.strip().lower()
+    if value == "original":
+        return 1.0
+    if value == "max":
+        return 0.0
+    try:
+        speed = float(value.rstrip("x"))
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"Expected 'original', 'max' or a multiplier: {value}")
+    if speed <= 0:
+        raise argparse.ArgumentTypeError(f"Multiplier must be positive: {value}")
+    return speed
+
+
+def main():
+    """Replay a recording against a bridge."""
+    parser = argparse.ArgumentParser(description="Replay a recorded MCP session against a bridge")
+    parser.add_argument("recording", help="Recording file (JSON Lines)")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=55558)
+    parser.add_argument("--timeout", type=float, default=60.0, help="Socket timeout in seconds")
+    parser.add_argument("--speed", type=parse_speed, default=1.0,
+                        help="'original', 'max', or a multiplier of the recorded pace (e.g. 4x)")
+    parser.add_argument("--no-verify", action="store_true", help="Don't compare outcomes with the recording")
+    parser.add_argument("--keep-idempotency-keys", action="store_true",
+                        help="Send recorded idempotency keys (a server that saw them answers from its cache)")
+    parser.add_argument("-o", "--output", help="Write the replay report JSON here")
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+
+    captures = read_recording(args.recording)
+    if not any(capture.records for capture in captures):
+        logger.error(f"{args.recording}: no recorded requests")
+        sys.exit(2)
+
+    config = ReplayConfig(host=args.host, port=args.port, timeout=args.timeout, speed=args.speed,
+                          verify=not args.no_verify, keep_idempotency_keys=args.keep_idempotency_keys)
+    report = Replayer(config).replay(captures)
+
+    recorded, replayed = report["recorded_ms"], report["replayed_ms"]
+    print(f"Replayed {report['sent']} requests ({report['skipped']} stateful server commands skipped) "
+          f"in {report['replay_wall_s']:.2f}s, recorded span {report['recorded_span_s']:.2f}s")
+    print(f"  recorded  p50 {recorded['p50']:>9.3f}  p99 {recorded['p99']:>9.3f}  max {recorded['max']:>9.3f} ms")
+    print(f"  replayed  p50 {replayed['p50']:>9.3f}  p99 {replayed['p99']:>9.3f}  max {replayed['max']:>9.3f} ms")
+    for mismatch in report["mismatches"]:
+        print(f"  mismatch #{mismatch['index']} {mismatch['type']}: expected {mismatch['expected']}, got {mismatch['actual']}")
+    for failure in report["worker_failures"]:
+        print(f"  connection failed: {failure}")
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as file:
+            json.dump(report, file, indent=2)
+
+    sys.exit(1 if report["mismatched"] or report["worker_failures"] else 0)
+
+
+if __name__ == "__main__":
+    main()
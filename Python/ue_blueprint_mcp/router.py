@@ -0,0 +1,620 @@
+"""
+Route commands across a pool of editors, sharded by asset.
+
+One editor runs every mutation on its game thread, so a single instance
+caps throughput. The router fronts several instances and sends each
+command to the instance that owns its asset: the first command naming a
+Blueprint, widget or material assigns that asset to the least loaded
+instance, and every later command for it goes to the same instance in
+order. Independent assets are built in parallel; one asset never spans
+two editors. Commands that work on the level (actors, viewport, post
+process volumes) and commands naming no asset go to the primary instance.
+
+Instances are editors listening on their own port (launch each with
+-MCPPort=<port>), anything speaking the framing on a Unix socket
+(unix:/path), or MCPScript commandlets the router starts and drives over
+stdin/stdout:
+
+    python -m ue_blueprint_mcp.router serve --port 55600 --backend 127.0.0.1:55558 --backend 127.0.0.1:55559
+    python -m ue_blueprint_mcp.router run build.jsonl -o results.jsonl \\
+        --commandlets 4 --editor UnrealEditor-Cmd --project Game.uproject
+
+serve listens with the same framing as the plugin, so clients point their
+ConnectionConfig at the router. Responses on a connection come back in
+request order, but a pipelining client gets its requests run in parallel
+across instances. run executes a script in the MCPScript format (one
+request per line) and writes one result line per request, in script order.
+
+Server commands are answered from the pool: ping locally, list_commands
+and get_context by the primary, and save_all, get_metrics, get_queue_stats
+and dump_flight_recorder by every instance, with each instance's answer
+under "backends". get_router_stats reports the assignment and load per
+instance. {"type": "barrier"} waits until every instance is idle and
+flushes (saves) them all; put one in a script between building an asset
+and using it from another asset, since instances only see each other's
+assets once saved. "async" is ignored (the router already runs
+independent work in parallel) and job, cancel and subscription commands
+are not routed.
+"""
+
+import argparse
+import json
+import logging
+import socket
+import socketserver
+import subprocess
+import sys
+import threading
+import time
+import uuid
+from collections import deque
+from concurrent.futures import Future, ThreadPoolExecutor
+from typing import Optional
+
+from .bench import BenchConnection, MAX_MESSAGE_BYTES, latency_summary, response_outcome
+
+logger = logging.getLogger(__name__)
+
+# Params naming the asset a command works on, most specific first
+SHARD_FIELDS = ("blueprint_name", "widget_name", "material_name", "instance_name")
+
+# Commands on the level rather than an asset; the level lives in the primary instance
+LEVEL_MARKERS = ("actor", "viewport", "level", "post_process_volume")
+
+# Sent to every instance; the answers are combined under "backends"
+FAN_OUT_COMMANDS = {"save_all", "get_metrics", "get_queue_stats", "dump_flight_recorder"}
+
+# Answered by the primary instance
+PRIMARY_COMMANDS = {"list_commands", "get_context"}
+
+# Tied to one instance's server state (job ids, in-flight ids, subscriptions)
+UNROUTED_COMMANDS = {"get_job", "list_jobs", "cancel_job", "cancel", "subscribe", "unsubscribe"}
+
+COMMANDLET_PREFIX = "@mcp "
+
+
+def _error(message: str, error_type: str, **fields) -> dict:
+    return {"success": False, "error": message, "error_type": error_type, **fields}
+
+
+def shard_key(command_type: str, params: dict) -> Optional[str]:
+    """
+    Asset a command works on, normalized so a name and an object path to the
+    same asset agree ("BP_Door", "/Game/BP/BP_Door.BP_Door" -> "bp_door");
+    None for level commands and commands naming no asset.
+    """
+    if any(marker in command_type for marker in LEVEL_MARKERS):
+        return None
+    value = next((params[f] for f in SHARD_FIELDS if isinstance(params.get(f), str) and params[f]), None)
+    if value is None and command_type.startswith("create_") and isinstance(params.get("name"), str):
+        value = params["name"]
+    if not value:
+        return None
+    return value.rsplit("/", 1)[-1].split(".", 1)[0].lower()
+
+
+# =============================================================================
+# Backends
+# =============================================================================
+
+class TcpBackend:
+    """An editor (or mock bridge) on host:port, or a framed server on unix:/path."""
+
+    def __init__(self, address: str, timeout: float = 300.0):
+        self.name = address
+        self.address = address
+        self.timeout = timeout
+        self._conn: Optional[BenchConnection] = None
+
+    def call(self, request: dict) -> dict:
+        if self._conn is None:
+            self._conn = self._connect()
+        try:
+            self._conn.send(self._conn.frame(request))
+            return self._conn.receive()
+        except (OSError, ConnectionError, json.JSONDecodeError) as e:
+            # The command may or may not have run; the next call reconnects
+            self._drop()
+            return _error(f"Lost connection to {self.name}: {e}", "not_ready")
+
+    def flush(self) -> dict:
+        return self.call({"type": "save_all"})
+
+    def close(self):
+        self._drop()
+
+    def _connect(self) -> BenchConnection:
+        if self.address.startswith("unix:"):
+            sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            sock.settimeout(self.timeout)
+            sock.connect(self.address[len("unix:"):])
+            return BenchConnection(self.address, 0, self.timeout, sock=sock)
+        host, _, port = self.address.rpartition(":")
+        return BenchConnection(host or "127.0.0.1", int(port), self.timeout)
+
+    def _drop(self):
+        if self._conn is not None:
+            try:
+                self._conn.close()
+            except OSError:
+                pass
+            self._conn = None
+
+
+class CommandletBackend:
+    """An MCPScript commandlet started by the router and driven over its stdin/stdout."""
+
+    def __init__(self, name: str, command: list[str]):
+        self.name = name
+        self.command = command
+        self.flushes: list[dict] = []
+        self._process: Optional[subprocess.Popen] = None
+
+    def call(self, request: dict) -> dict:
+        line = self._exchange(request, "line")
+        return line.get("result", {}) if line else _error(f"{self.name} exited", "not_ready")
+
+    def flush(self) -> dict:
+        line = self._exchange({"type": "flush"}, "flush")
+        return line.get("result", {}) if line else _error(f"{self.name} exited", "not_ready")
+
+    def close(self) -> Optional[int]:
+        """Close stdin so the commandlet runs its final flush, and wait for it."""
+        if self._process is None:
+            return None
+        try:
+            self._process.stdin.close()
+        except OSError:
+            pass
+        # Drain the final flush line so the pipe can't fill up while it exits
+        while self._read_line() is not None:
+            pass
+        return self._process.wait()
+
+    def _exchange(self, request: dict, answer_field: str) -> Optional[dict]:
+        if self._process is None:
+            logger.info(f"Starting {self.name}: {' '.join(self.command)}")
+            self._process = subprocess.Popen(self.command, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                             encoding="utf-8", errors="replace", bufsize=1)
+        if self._process.poll() is not None:
+            return None
+        try:
+            self._process.stdin.write(json.dumps(request, separators=(",", ":")) + "\n")
+            self._process.stdin.flush()
+        except OSError:
+            return None
+        # Flushes run on their own every -SaveEvery commands; keep those and read on
+        while (line := self._read_line()) is not None:
+            if answer_field in line:
+                return line
+            if "flush" in line:
+                self.flushes.append(line)
+        return None
+
+    def _read_line(self) -> Optional[dict]:
+        """Next result line; log lines on stdout are skipped."""
+        for text in self._process.stdout:
+            if text.startswith(COMMANDLET_PREFIX):
+                try:
+                    return json.loads(text[len(COMMANDLET_PREFIX):])
+                except json.JSONDecodeError:
+                    logger.warning(f"{self.name}: unreadable result line")
+        return None
+
+
+def commandlet_command(editor: str, project: str, index: int, save_every: int, extra: list[str]) -> list[str]:
+    return [editor, project, "-run=MCPScript", f"-SaveEvery={save_every}", f"-Session=router-{index}",
+            "-nullrhi", "-unattended", "-nop4", "-nosplash", *extra]
+
+
+# =============================================================================
+# Router
+# =============================================================================
+
+class _Shard:
+    """One backend, its queue (a single worker keeps per-asset order) and load."""
+
+    def __init__(self, backend):
+        self.backend = backend
+        self.executor = ThreadPoolExecutor(max_workers=1, thread_name_prefix=f"Router {backend.name}")
+        self.keys: set[str] = set()
+        self.pending = 0
+        self.requests = 0
+        self.errors = 0
+        self.busy_s = 0.0
+        self.samples_ms: list[float] = []
+
+
+class Router:
+    """Sends each request to the backend owning its asset; thread-safe."""
+
+    def __init__(self, backends: list, primary: int = 0):
+        if not backends:
+            raise ValueError("The router needs at least one backend")
+        self._shards = [_Shard(backend) for backend in backends]
+        self._primary = primary
+        self._lock = threading.Lock()
+        self._owners: dict[str, int] = {}
+
+    @property
+    def backends(self) -> list:
+        return [shard.backend for shard in self._shards]
+
+    def route(self, command_type: str, params: dict) -> int:
+        """Backend index for a command, assigning a new asset to the least loaded backend."""
+        key = shard_key(command_type, params)
+        if key is None:
+            return self._primary
+        with self._lock:
+            index = self._owners.get(key)
+            if index is None:
+                index = min(range(len(self._shards)),
+                            key=lambda i: (len(self._shards[i].keys), self._shards[i].pending, i))
+                self._owners[key] = index
+                self._shards[index].keys.add(key)
+            return index
+
+    def submit(self, request: dict) -> Future:
+        """Future of the response to one request."""
+        if not isinstance(request, dict):
+            return _done({"status": "error", "error": "Invalid JSON"})
+        command_type = request.get("type")
+        if not command_type:
+            return _done({"status": "error", "error": "Missing 'type' field"})
+
+        if command_type == "ping":
+            return _done({"status": "success", "result": {"pong": True}})
+        if command_type == "get_router_stats":
+            return _done(self.stats())
+        if command_type in ("barrier", "flush"):
+            return self._fan_out(lambda backend: backend.flush())
+        if command_type in UNROUTED_COMMANDS:
+            return _done(_error(f"{command_type} is not routed; send it to an instance directly", "unknown_command"))
+
+        request = {key: value for key, value in request.items() if key != "async"}
+        if command_type in FAN_OUT_COMMANDS:
+            return self._fan_out(lambda backend: backend.call(request))
+        if command_type in PRIMARY_COMMANDS:
+            return self._submit_to(self._primary, request)
+        return self._submit_to(self.route(command_type, request.get("params") or {}), request)
+
+    def call(self, request: dict) -> dict:
+        return self.submit(request).result()
+
+    def run_batch(self, requests: list[dict]) -> list[dict]:
+        """
+        Run requests across the pool and return responses in request order;
+        a barrier waits for everything before it.
+        """
+        futures: list[Future] = []
+        for request in requests:
+            if isinstance(request, dict) and request.get("type") == "barrier":
+                for future in futures:
+                    future.result()
+                futures.append(self.submit(request))
+                futures[-1].result()
+            else:
+                futures.append(self.submit(request))
+        return [future.result() for future in futures]
+
+    def stats(self) -> dict:
+        with self._lock:
+            backends = {
+                shard.backend.name: {
+                    "assets": len(shard.keys),
+                    "pending": shard.pending,
+                    "requests": shard.requests,
+                    "errors": shard.errors,
+                    "busy_s": round(shard.busy_s, 3),
+                    "latency_ms": latency_summary(shard.samples_ms),
+                }
+                for shard in self._shards
+            }
+            assets = len(self._owners)
+        return {"success": True, "backends": backends, "assets": assets,
+                "primary": self._shards[self._primary].backend.name}
+
+    def close(self) -> dict:
+        """Stop every backend; returns commandlet exit codes by name."""
+        exit_codes = {}
+        for shard in self._shards:
+            shard.executor.shutdown(wait=True)
+            code = shard.backend.close()
+            if code is not None:
+                exit_codes[shard.backend.name] = code
+        return exit_codes
+
+    def _submit_to(self, index: int, request: dict) -> Future:
+        shard = self._shards[index]
+        with self._lock:
+            shard.pending += 1
+
+        def run() -> dict:
+            started = time.perf_counter()
+            try:
+                response = shard.backend.call(request)
+            except Exception as e:
+                logger.exception(f"{shard.backend.name} failed on {request.get('type')}")
+                response = _error(f"{shard.backend.name}: {e}", "execution_failed")
+            elapsed = time.perf_counter() - started
+            ok, _ = response_outcome(response)
+            with self._lock:
+                shard.pending -= 1
+                shard.requests += 1
+                shard.errors += 0 if ok else 1
+                shard.busy_s += elapsed
+                shard.samples_ms.append(elapsed * 1000.0)
+            return response
+
+        return shard.executor.submit(run)
+
+    def _fan_out(self, action) -> Future:
+        """Run action on every backend behind its queued work; answers under "backends"."""
+        futures = [(shard.backend.name, shard.executor.submit(action, shard.backend)) for shard in self._shards]
+        combined: Future = Future()
+        remaining = [len(futures)]
+        lock = threading.Lock()
+
+        def finished(_):
+            with lock:
+                remaining[0] -= 1
+                if remaining[0]:
+                    return
+            backends = {}
+            for name, future in futures:
+                try:
+                    backends[name] = future.result()
+                except Exception as e:
+                    backends[name] = _error(str(e), "execution_failed")
+            ok = all(response_outcome(response)[0] for response in backends.values())
+            combined.set_result({"success": ok, "backends": backends})
+
+        for _, future in futures:
+            future.add_done_callback(finished)
+        return combined
+
+
+def _done(response: dict) -> Future:
+    future: Future = Future()
+    future.set_result(response)
+    return future
+
+
+# =============================================================================
+# Server
+# =============================================================================
+
+class RouterServer:
+    """Serves the router with the plugin's framing; responses keep request order per connection."""
+
+    def __init__(self, router: Router, host: str = "127.0.0.1", port: int = 55600):
+        self.router = router
+        server = self
+
+        class Handler(socketserver.BaseRequestHandler):
+            def handle(self):
+                server._serve_connection(self.request)
+
+        class Server(socketserver.ThreadingTCPServer):
+            daemon_threads = True
+            allow_reuse_address = True
+
+        self._server = Server((host, port), Handler)
+        self.port = self._server.server_address[1]
+        self._thread: Optional[threading.Thread] = None
+
+    def start(self) -> "RouterServer":
+        self._thread = threading.Thread(target=self._server.serve_forever, name="RouterServer", daemon=True)
+        self._thread.start()
+        self._log_listening()
+        return self
+
+    def serve_forever(self):
+        self._log_listening()
+        self._server.serve_forever()
+
+    def stop(self):
+        self._server.shutdown()
+        self._server.server_close()
+
+    def __enter__(self) -> "RouterServer":
+        return self.start()
+
+    def __exit__(self, *exc):
+        self.stop()
+
+    def _log_listening(self):
+        names = ", ".join(backend.name for backend in self.router.backends)
+        logger.info(f"Router listening on port {self.port} ({names})")
+
+    def _serve_connection(self, sock: socket.socket):
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        session = f"router-{uuid.uuid4().hex[:8]}"
+        # Responses in flight, oldest first; the writer sends each as soon as it and all before it are done
+        queue: deque = deque()
+        ready = threading.Condition()
+        state = {"reading": True}
+
+        def writer():
+            while True:
+                with ready:
+                    while not queue and state["reading"]:
+                        ready.wait()
+                    if not queue:
+                        return
+                    future = queue.popleft()
+                body = json.dumps(future.result()).encode("utf-8")
+                try:
+                    sock.sendall(len(body).to_bytes(4, byteorder="big") + body)
+                except OSError:
+                    return
+
+        writer_thread = threading.Thread(target=writer, name=f"RouterWriter {session}", daemon=True)
+        writer_thread.start()
+        try:
+            while True:
+                message = self._receive(sock)
+                if message is None:
+                    break
+                try:
+                    request = json.loads(message)
+                except (json.JSONDecodeError, UnicodeDecodeError):
+                    future = _done({"status": "error", "error": "Invalid JSON"})
+                else:
+                    if isinstance(request, dict) and request.get("type") == "close":
+                        with ready:
+                            queue.append(_done({"status": "success", "result": {"closed": True}}))
+                            ready.notify()
+                        break
+                    if isinstance(request, dict):
+                        # One backend connection carries every client, so keep clients' sessions apart
+                        request.setdefault("session", session)
+                    future = self.router.submit(request)
+                with ready:
+                    queue.append(future)
+                    ready.notify()
+        except OSError:
+            pass
+        finally:
+            with ready:
+                state["reading"] = False
+                ready.notify()
+            writer_thread.join()
+            sock.close()
+
+    @staticmethod
+    def _receive(sock: socket.socket) -> Optional[bytes]:
+        header = RouterServer._recv_exact(sock, 4)
+        if header is None:
+            return None
+        length = int.from_bytes(header, byteorder="big")
+        if length <= 0 or length > MAX_MESSAGE_BYTES:
+            logger.warning(f"Invalid message length: {length}")
+            return None
+        return RouterServer._recv_exact(sock, length)
+
+    @staticmethod
+    def _recv_exact(sock: socket.socket, num_bytes: int) -> Optional[bytes]:
+        data = bytearray()
+        while len(data) < num_bytes:
+            chunk = sock.recv(num_bytes - len(data))
+            if not chunk:
+                return None
+            data.extend(chunk)
+        return bytes(data)
+
+
+# =============================================================================
+# CLI
+# =============================================================================
+
+def _read_script(path: str) -> list[tuple[int, dict]]:
+    """(line number, request) per request line of an MCPScript file; '-' reads stdin."""
+    file = sys.stdin if path == "-" else open(path, encoding="utf-8")
+    requests = []
+    with file:
+        for number, line in enumerate(file, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            try:
+                requests.append((number, json.loads(line)))
+            except json.JSONDecodeError:
+                requests.append((number, line))
+    return requests
+
+
+def _build_backends(args) -> list:
+    backends: list = [TcpBackend(address, args.timeout) for address in args.backend]
+    for index in range(args.commandlets):
+        if not args.editor or not args.project:
+            raise SystemExit("--commandlets needs --editor and --project")
+        command = commandlet_command(args.editor, args.project, index, args.save_every, args.commandlet_arg)
+        backends.append(CommandletBackend(f"commandlet-{index}", command))
+    if not backends:
+        raise SystemExit("Give at least one --backend or --commandlets")
+    return backends
+
+
+def _run(args) -> int:
+    script = _read_script(args.script)
+    router = Router(_build_backends(args))
+    started = time.perf_counter()
+    responses = router.run_batch([request for _, request in script])
+    wall_s = time.perf_counter() - started
+
+    failures = 0
+    out = open(args.output, "w", encoding="utf-8") if args.output and args.output != "-" else sys.stdout
+    for (number, request), response in zip(script, responses):
+        ok, _ = response_outcome(response)
+        failures += 0 if ok else 1
+        request = request if isinstance(request, dict) else {}
+        line = {"line": number, "type": request.get("type"), "result": response}
+        if request.get("id"):
+            line["id"] = request["id"]
+        out.write(json.dumps(line, separators=(",", ":")) + "\n")
+    if out is not sys.stdout:
+        out.close()
+
+    # Final flush, then let commandlets finish
+    flush = router.call({"type": "barrier"})
+    failures += 0 if flush.get("success") else 1
+    stats = router.stats()
+    exit_codes = router.close()
+
+    print(f"Ran {len(script)} requests on {len(router.backends)} backends in {wall_s:.2f}s "
+          f"({len(script) / wall_s if wall_s > 0 else 0.0:.1f}/s), {failures} failed", file=sys.stderr)
+    for name, backend in stats["backends"].items():
+        print(f"  {name}: {backend['assets']} assets, {backend['requests']} requests, "
+              f"{backend['errors']} errors, busy {backend['busy_s']:.2f}s", file=sys.stderr)
+    for name, code in exit_codes.items():
+        if code:
+            print(f"  {name} exited with {code}", file=sys.stderr)
+            failures += 1
+    return 1 if failures else 0
+
+
+def main():
+    """Route commands across several editors or commandlets."""
+    parser = argparse.ArgumentParser(description="Shard MCP commands by asset across a pool of editors")
+    subparsers = parser.add_subparsers(dest="mode", required=True)
+
+    def add_backend_args(sub):
+        sub.add_argument("--backend", action="append", default=[], metavar="HOST:PORT|unix:PATH",
+                         help="Instance to route to (repeatable); the first is the primary")
+        sub.add_argument("--commandlets", type=int, default=0, help="Start this many MCPScript commandlets")
+        sub.add_argument("--editor", help="UnrealEditor-Cmd executable for --commandlets")
+        sub.add_argument("--project", help=".uproject for --commandlets")
+        sub.add_argument("--save-every", type=int, default=100, help="-SaveEvery for the commandlets")
+        sub.add_argument("--commandlet-arg", action="append", default=[], help="Extra commandlet argument (repeatable)")
+        sub.add_argument("--timeout", type=float, default=300.0, help="Socket timeout in seconds")
+
+    serve = subparsers.add_parser("serve", help="Listen with the plugin's framing and route what arrives")
+    serve.add_argument("--host", default="127.0.0.1")
+    serve.add_argument("--port", type=int, default=55600)
+    add_backend_args(serve)
+
+    run = subparsers.add_parser("run", help="Run an MCPScript file across the pool")
+    run.add_argument("script", help="JSON Lines requests ('-' for stdin)")
+    run.add_argument("-o", "--output", help="Write result lines here instead of stdout")
+    add_backend_args(run)
+
+    args = parser.parse_args()
+    logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+
+    if args.mode == "run":
+        sys.exit(_run(args))
+
+    router = Router(_build_backends(args))
+    server = RouterServer(router, args.host, args.port)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        logger.info("Router stopped by user")
+    finally:
+        server.stop()
+        router.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -13,6 +13,7 @@ from mcp.server.stdio import stdio_server
 from mcp.types import Tool, TextContent
 
 from .connection import get_connection, PersistentUnrealConnection, CommandResult
+from .catalog import CommandCatalog
 
 # Import tool modules
 from .tools import blueprint, editor, nodes, project, umg, materials
@@ -22,6 +23,20 @@ logger = logging.getLogger(__name__)
 # Create MCP server instance
 server = Server("ue-blueprint-mcp")
 
+# Tool modules, in list order
+TOOL_MODULES = [editor, blueprint, nodes, project, umg, materials]
+
+# Commands answered by the connection tools below
+SERVER_COMMANDS = {"ping", "get_context", "list_commands", "get_job", "cancel_job", "list_jobs",
+                   "cancel", "get_queue_stats", "get_metrics", "dump_flight_recorder", "subscribe", "unsubscribe"}
+
+# Plugin command registry (fetched at startup) and the tool list built from it
+_catalog = CommandCatalog()
+_tools_cache: list[Tool] | None = None
+
+# Registry commands without a hand-written tool, sent straight through
+_passthrough_commands: set[str] = set()
+
 
 def _result_to_text(result: CommandResult) -> list[TextContent]:
     """Convert CommandResult to MCP text content."""
@@ -42,9 +57,14 @@ def _send_command(command_type: str, params: dict | None = None) -> list[TextCon
 # Connection Tools
 # =============================================================================
 
-@server.list_tools()
-async def list_tools() -> list[Tool]:
-    """List all available tools."""
+def _build_tools() -> list[Tool]:
+    """
+    Build the tool list from the module definitions and the plugin catalog.
+
+    Plugin-published params schemas replace the hand-written ones, tools for
+    commands the plugin doesn't register are dropped, and registry commands
+    with a schema but no hand-written tool are exposed as passthroughs.
+    """
     tools = []
 
     # Connection tools
@@ -60,17 +80,93 @@ async def list_tools() -> list[Tool]:
         inputSchema={"type": "object", "properties": {}}
     ))
 
+    tools.append(Tool(
+        name="get_queue_stats",
+        description="Get the bridge's game-thread queue stats per priority lane (depth, waits, rejections)",
+        inputSchema={"type": "object", "properties": {}}
+    ))
+
+    tools.append(Tool(
+        name="get_metrics",
+        description="Get per-command latency percentiles by pipeline stage, error rates and payload sizes",
+        inputSchema={
+            "type": "object",
+            "properties": {
+                "format": {"type": "string", "enum": ["json", "prometheus"], "default": "json"}
+            }
+        }
+    ))
+
+    tools.append(Tool(
+        name="dump_flight_recorder",
+        description="Get the last requests the bridge answered (command, outcome, stage times, sizes), e.g. to see what led up to a failure",
+        inputSchema={
+            "type": "object",
+            "properties": {
+                "count": {"type": "integer", "minimum": 1, "maximum": 1024, "default": 100},
+                "log": {"type": "boolean", "default": False, "description": "Also write them to the editor log"}
+            }
+        }
+    ))
+
     # Add tools from all modules
-    tools.extend(editor.get_tools())
-    tools.extend(blueprint.get_tools())
-    tools.extend(nodes.get_tools())
-    tools.extend(project.get_tools())
-    tools.extend(umg.get_tools())
-    tools.extend(materials.get_tools())
+    covered = set(SERVER_COMMANDS)
+    for module in TOOL_MODULES:
+        for tool in module.get_tools():
+            command_type = module.TOOL_HANDLERS.get(tool.name, tool.name)
+            covered.add(command_type)
+
+            if _catalog.is_loaded and _catalog.get(command_type) is None:
+                logger.warning(f"Tool '{tool.name}' maps to unregistered command '{command_type}', skipping")
+                continue
+
+            # Typed commands publish their schema; tools declared with PLUGIN_SCHEMA rely on it
+            schema = _catalog.params_schema(command_type)
+            if schema:
+                tool = Tool(name=tool.name, description=tool.description, inputSchema=schema)
+            tools.append(tool)
+
+    # Registry commands with no hand-written tool
+    _passthrough_commands.clear()
+    for command_type, info in sorted(_catalog.commands.items()):
+        schema = info.get("params_schema")
+        if command_type in covered or not schema:
+            continue
+        _passthrough_commands.add(command_type)
+        tools.append(Tool(
+            name=command_type,
+            description=f"{command_type} ({info.get('cost', 'mutating')}, v{info.get('version', 1)})",
+            inputSchema=schema
+        ))
 
     return tools
 
 
+def _refresh_catalog():
+    """Fetch or revalidate the plugin catalog; rebuild the tool list if it changed."""
+    global _tools_cache
+    conn = get_connection()
+    if not conn.is_connected and not conn.connect():
+        return
+    if _catalog.refresh(conn):
+        _tools_cache = None
+        # Long-running commands go through the async job API
+        conn.job_commands = {
+            name for name, info in _catalog.commands.items() if info.get("cost") == "heavy"
+        }
+
+
+@server.list_tools()
+async def list_tools() -> list[Tool]:
+    """List all available tools (built once, rebuilt only when the catalog changes)."""
+    global _tools_cache
+    if not _catalog.is_loaded:
+        _refresh_catalog()
+    if _tools_cache is None:
+        _tools_cache = _build_tools()
+    return _tools_cache
+
+
 @server.call_tool()
 async def call_tool(name: str, arguments: dict[str, Any]) -> list[TextContent]:
     """Route tool calls to appropriate handlers."""
@@ -86,6 +182,25 @@ async def call_tool(name: str, arguments: dict[str, Any]) -> list[TextContent]:
     if name == "get_context":
         return _send_command("get_context")
 
+    if name == "get_queue_stats":
+        return _send_command("get_queue_stats")
+
+    if name == "get_metrics":
+        conn = get_connection()
+        if not conn.is_connected:
+            conn.connect()
+        fmt = arguments.get("format", "json")
+        result = conn.get_metrics(fmt)
+        if result.success and fmt == "prometheus":
+            return [TextContent(type="text", text=result.data.get("text", ""))]
+        return _result_to_text(result)
+
+    if name == "dump_flight_recorder":
+        return _send_command("dump_flight_recorder", {
+            "count": arguments.get("count", 100),
+            "log": arguments.get("log", False),
+        })
+
     # Route to tool modules
     if name in editor.TOOL_HANDLERS:
         return await editor.handle_tool(name, arguments)
@@ -105,6 +220,9 @@ async def call_tool(name: str, arguments: dict[str, Any]) -> list[TextContent]:
     if name in materials.TOOL_HANDLERS:
         return await materials.handle_tool(name, arguments)
 
+    if name in _passthrough_commands:
+        return _send_command(name, arguments if arguments else None)
+
     return [TextContent(type="text", text=f'{{"success": false, "error": "Unknown tool: {name}"}}')]
 
 
@@ -112,9 +230,10 @@ async def run_server():
     """Run the MCP server."""
     logger.info("Starting UE Blueprint MCP server...")
 
-    # Establish connection to Unreal
+    # Establish connection to Unreal and fetch the command catalog once
     conn = get_connection()
-    conn.connect()
+    if conn.connect():
+        _refresh_catalog()
 
     async with stdio_server() as (read_stream, write_stream):
         await server.run(read_stream, write_stream, server.create_initialization_options())
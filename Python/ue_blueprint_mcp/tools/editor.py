@@ -6,6 +6,7 @@ import json
 from typing import Any
 from mcp.types import Tool, TextContent
 
+from ..catalog import PLUGIN_SCHEMA
 from ..connection import get_connection, CommandResult
 
 
@@ -60,6 +61,11 @@ def get_tools() -> list[Tool]:
                 "required": ["name", "type"]
             }
         ),
+        Tool(
+            name="spawn_actors",
+            description="Spawn many actors in one call from columnar arrays. Much faster than repeated spawn_actor for level population.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
         Tool(
             name="spawn_blueprint_actor",
             description="Spawn an actor from a Blueprint.",
@@ -85,13 +91,7 @@ def get_tools() -> list[Tool]:
         Tool(
             name="delete_actor",
             description="Delete an actor by name.",
-            inputSchema={
-                "type": "object",
-                "properties": {
-                    "name": {"type": "string", "description": "Name of the actor to delete"}
-                },
-                "required": ["name"]
-            }
+            inputSchema=PLUGIN_SCHEMA
         ),
         Tool(
             name="set_actor_transform",
@@ -107,6 +107,11 @@ def get_tools() -> list[Tool]:
                 "required": ["name"]
             }
         ),
+        Tool(
+            name="set_actor_transforms",
+            description="Set or adjust transforms of many actors in one call. Absolute columns are applied first, then an optional relative operation over the whole batch.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
         Tool(
             name="get_actor_properties",
             description="Get all properties of an actor.",
@@ -131,6 +136,11 @@ def get_tools() -> list[Tool]:
                 "required": ["name", "property_name", "property_value"]
             }
         ),
+        Tool(
+            name="set_properties_bulk",
+            description="Set properties on every actor matched by a selector in one call. Paths may go through components and structs, e.g. 'LightComponent.Intensity', 'StaticMeshComponent.Mobility'.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
 
         # Viewport
         Tool(
@@ -169,6 +179,14 @@ def get_tools() -> list[Tool]:
             description="Save all dirty packages (blueprints, levels, assets).",
             inputSchema={"type": "object", "properties": {}}
         ),
+        # Change journal
+        Tool(
+            name="get_changes",
+            description="Get actor and Blueprint graph changes recorded since a revision. "
+                        "Keep the returned 'revision' and 'epoch' and pass them as since_revision and epoch next time. "
+                        "If resync_required is true, re-fetch the full state.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
     ]
 
 
@@ -177,15 +195,19 @@ TOOL_HANDLERS = {
     "get_actors_in_level": "get_actors_in_level",
     "find_actors_by_name": "find_actors_by_name",
     "spawn_actor": "spawn_actor",
+    "spawn_actors": "spawn_actors",
     "spawn_blueprint_actor": "spawn_blueprint_actor",
     "delete_actor": "delete_actor",
     "set_actor_transform": "set_actor_transform",
+    "set_actor_transforms": "set_actor_transforms",
     "get_actor_properties": "get_actor_properties",
     "set_actor_property": "set_actor_property",
+    "set_properties_bulk": "set_properties_bulk",
     "focus_viewport": "focus_viewport",
     "get_viewport_transform": "get_viewport_transform",
     "set_viewport_transform": "set_viewport_transform",
     "save_all": "save_all",
+    "get_changes": "get_changes",
 }
 
 
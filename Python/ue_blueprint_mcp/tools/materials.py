@@ -6,6 +6,7 @@ import json
 from typing import Any
 from mcp.types import Tool, TextContent
 
+from ..catalog import PLUGIN_SCHEMA
 from ..connection import get_connection, CommandResult
 
 
@@ -123,6 +124,11 @@ def get_tools() -> list[Tool]:
                 "required": ["material_name"]
             }
         ),
+        Tool(
+            name="build_material_graph",
+            description="Build or extend a material graph in one call: expressions, material properties, connections and output bindings, recompiled once. Prefer this over many add/connect calls.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
         Tool(
             name="create_material_instance",
             description="Create a Material Instance from a parent material with parameter overrides.",
@@ -198,6 +204,7 @@ TOOL_HANDLERS = {
     "set_material_expression_property": "set_material_expression_property",
     "set_material_property": "set_material_property",
     "compile_material": "compile_material",
+    "build_material_graph": "build_material_graph",
     "create_material_instance": "create_material_instance",
     "create_post_process_volume": "create_post_process_volume",
 }
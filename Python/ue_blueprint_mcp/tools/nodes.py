@@ -6,6 +6,7 @@ import json
 from typing import Any
 from mcp.types import Tool, TextContent
 
+from ..catalog import PLUGIN_SCHEMA
 from ..connection import get_connection
 
 
@@ -239,17 +240,7 @@ def get_tools() -> list[Tool]:
         Tool(
             name="set_node_pin_default",
             description="Set the default value of a pin on an existing node.",
-            inputSchema={
-                "type": "object",
-                "properties": {
-                    "blueprint_name": {"type": "string", "description": "Name of the Blueprint"},
-                    "node_id": {"type": "string", "description": "GUID of the node"},
-                    "pin_name": {"type": "string", "description": "Name of the pin"},
-                    "default_value": {"type": "string", "description": "Default value as string"},
-                    "graph_name": {"type": "string", "description": "Optional function graph name"}
-                },
-                "required": ["blueprint_name", "node_id", "pin_name", "default_value"]
-            }
+            inputSchema=PLUGIN_SCHEMA
         ),
         Tool(
             name="set_object_property",
@@ -364,18 +355,7 @@ def get_tools() -> list[Tool]:
         Tool(
             name="connect_blueprint_nodes",
             description="Connect two nodes in a Blueprint graph.",
-            inputSchema={
-                "type": "object",
-                "properties": {
-                    "blueprint_name": {"type": "string", "description": "Name of the Blueprint"},
-                    "source_node_id": {"type": "string", "description": "GUID of the source node"},
-                    "source_pin": {"type": "string", "description": "Name of the output pin"},
-                    "target_node_id": {"type": "string", "description": "GUID of the target node"},
-                    "target_pin": {"type": "string", "description": "Name of the input pin"},
-                    "graph_name": {"type": "string", "description": "Optional function graph name"}
-                },
-                "required": ["blueprint_name", "source_node_id", "source_pin", "target_node_id", "target_pin"]
-            }
+            inputSchema=PLUGIN_SCHEMA
         ),
         Tool(
             name="find_blueprint_nodes",
@@ -431,6 +411,22 @@ def get_tools() -> list[Tool]:
                 "required": ["blueprint_name", "node_id", "node_position"]
             }
         ),
+        Tool(
+            name="export_graph",
+            description="Export a whole Blueprint graph in one call as compact tables: nodes "
+                        "[guid, class, title, x, y], pins [node index, name, direction, category, sub_type, default] "
+                        "and links [from pin index, to pin index]. Use instead of find_blueprint_nodes + get_node_pins per node.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
+        Tool(
+            name="apply_graph_patch",
+            description="Apply many graph edits atomically in one call (one transaction, one compile, one save). "
+                        "Order: delete_nodes, add_nodes, move_nodes, pin_defaults, connections. "
+                        "add_nodes entries use any node-creating command as 'action' with its usual 'params' and a "
+                        "client-local 'id' that later ops can reference; the response maps ids to real GUIDs. "
+                        "If any op fails the whole patch is rolled back ('rolled_back': true) and 'failed_op' names it.",
+            inputSchema=PLUGIN_SCHEMA
+        ),
     ]
 
 
@@ -469,6 +465,8 @@ TOOL_HANDLERS = {
     "delete_blueprint_node": "delete_blueprint_node",
     "get_node_pins": "get_node_pins",
     "set_node_position": "set_node_position",
+    "export_graph": "export_graph",
+    "apply_graph_patch": "apply_graph_patch",
 }
 
 
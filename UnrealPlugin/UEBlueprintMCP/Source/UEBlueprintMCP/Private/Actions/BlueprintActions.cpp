@@ -2,6 +2,7 @@
 
 #include "Actions/BlueprintActions.h"
 #include "MCPCommonUtils.h"
+#include "MCPTrace.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/SimpleConstructionScript.h"
@@ -34,6 +35,7 @@
 #include "EdGraph/EdGraphNode.h"
 #include "FileHelpers.h"
 #include "UObject/SavePackage.h"
+#include "MCPLog.h"
 
 // ============================================================================
 // FCreateBlueprintAction
@@ -100,7 +102,7 @@ TSharedPtr<FJsonObject> FCreateBlueprintAction::ExecuteInternal(const TSharedPtr
 	Context.SetCurrentBlueprint(NewBlueprint);
 	Context.MarkPackageDirty(Package);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Created Blueprint '%s' with parent '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Created Blueprint '%s' with parent '%s'"),
 		*BlueprintName, *ParentClass->GetName());
 
 	// Build response
@@ -176,7 +178,7 @@ UClass* FCreateBlueprintAction::ResolveParentClass(const FString& ParentClassNam
 	}
 
 	// Fallback to Actor
-	UE_LOG(LogTemp, Warning, TEXT("UEBlueprintMCP: Could not resolve parent class '%s', defaulting to AActor"),
+	UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Could not resolve parent class '%s', defaulting to AActor"),
 		*ParentClassName);
 	return AActor::StaticClass();
 }
@@ -192,7 +194,7 @@ void FCreateBlueprintAction::CleanupExistingBlueprint(const FString& BlueprintNa
 		UBlueprint* ExistingBlueprint = FindObject<UBlueprint>(ExistingPackage, *BlueprintName);
 		if (ExistingBlueprint)
 		{
-			UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Blueprint '%s' exists in memory, cleaning up"), *BlueprintName);
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Blueprint '%s' exists in memory, cleaning up"), *BlueprintName);
 
 			FString TempName = FString::Printf(TEXT("%s_TEMP_%d"), *BlueprintName, FMath::Rand());
 			ExistingBlueprint->Rename(*TempName, GetTransientPackage(),
@@ -205,7 +207,7 @@ void FCreateBlueprintAction::CleanupExistingBlueprint(const FString& BlueprintNa
 	// Delete from disk
 	if (UEditorAssetLibrary::DoesAssetExist(PackagePathName))
 	{
-		UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Blueprint '%s' exists on disk, deleting"), *BlueprintName);
+		UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Blueprint '%s' exists on disk, deleting"), *BlueprintName);
 		UEditorAssetLibrary::DeleteAsset(PackagePathName);
 	}
 }
@@ -217,28 +219,32 @@ void FCreateBlueprintAction::CleanupExistingBlueprint(const FString& BlueprintNa
 
 bool FCompileBlueprintAction::Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError)
 {
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: compile_blueprint Validate called"));
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: compile_blueprint Validate called"));
 	bool bResult = ValidateBlueprint(Params, Context, OutError);
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: compile_blueprint Validate result: %s, Error: '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: compile_blueprint Validate result: %s, Error: '%s'"),
 		bResult ? TEXT("true") : TEXT("false"), *OutError);
 	return bResult;
 }
 
 TSharedPtr<FJsonObject> FCompileBlueprintAction::ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
 {
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: compile_blueprint ExecuteInternal called"));
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: compile_blueprint ExecuteInternal called"));
 
 	UBlueprint* Blueprint = GetTargetBlueprint(Params, Context);
 	if (!Blueprint)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UEBlueprintMCP: compile_blueprint - Blueprint not found"));
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: compile_blueprint - Blueprint not found"));
 		return CreateErrorResponse(TEXT("Blueprint not found"), TEXT("not_found"));
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: compile_blueprint - Found blueprint '%s'"), *Blueprint->GetName());
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: compile_blueprint - Found blueprint '%s'"), *Blueprint->GetName());
 
 	// Compile
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	Context.ReportProgress(0.0f, TEXT("compiling"));
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	}
 
 	// Check status
 	EBlueprintStatus Status = Blueprint->Status;
@@ -250,10 +256,20 @@ TSharedPtr<FJsonObject> FCompileBlueprintAction::ExecuteInternal(const TSharedPt
 	TArray<TSharedPtr<FJsonValue>> Warnings;
 	CollectCompilationMessages(Blueprint, Errors, Warnings);
 
+	// Cancelled jobs and requests stop between compiling and saving
+	if (Context.IsCancelRequested())
+	{
+		return CreateErrorResponse(
+			FString::Printf(TEXT("Cancelled after compiling Blueprint '%s' (not saved)"), *Blueprint->GetName()),
+			TEXT("cancelled"));
+	}
+
 	// Save if successful
 	int32 SavedPackagesCount = 0;
 	if (bSuccess)
 	{
+		Context.ReportProgress(0.5f, TEXT("saving"));
+
 		TArray<UPackage*> DirtyPackages;
 		FEditorFileUtils::GetDirtyPackages(DirtyPackages);
 
@@ -292,7 +308,7 @@ TSharedPtr<FJsonObject> FCompileBlueprintAction::ExecuteInternal(const TSharedPt
 		default: StatusStr = TEXT("Unknown"); break;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Compiled Blueprint '%s' - Status: %s, Errors: %d, Warnings: %d"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Compiled Blueprint '%s' - Status: %s, Errors: %d, Warnings: %d"),
 		*Blueprint->GetName(), *StatusStr, Errors.Num(), Warnings.Num());
 
 	// Build response
@@ -445,9 +461,12 @@ TSharedPtr<FJsonObject> FAddComponentToBlueprintAction::ExecuteInternal(const TS
 	MarkBlueprintModified(Blueprint, Context);
 
 	// Compile
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Added component '%s' (%s) to Blueprint '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Added component '%s' (%s) to Blueprint '%s'"),
 		*ComponentName, *ComponentType, *Blueprint->GetName());
 
 	// Build response
@@ -608,7 +627,7 @@ TSharedPtr<FJsonObject> FSpawnBlueprintActorAction::ExecuteInternal(const TShare
 	NewActor->SetActorLabel(*ActorName);
 	Context.LastCreatedActorName = ActorName;
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Spawned '%s' from Blueprint '%s' at (%f, %f, %f)"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Spawned '%s' from Blueprint '%s' at (%f, %f, %f)"),
 		*ActorName, *BlueprintName, Location.X, Location.Y, Location.Z);
 
 	return CreateSuccessResponse(ActorToJson(NewActor));
@@ -738,7 +757,7 @@ TSharedPtr<FJsonObject> FSetComponentPropertyAction::ExecuteInternal(const TShar
 
 	MarkBlueprintModified(Blueprint, Context);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Set property '%s' on component '%s' in Blueprint '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set property '%s' on component '%s' in Blueprint '%s'"),
 		*PropertyName, *ComponentName, *Blueprint->GetName());
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -828,7 +847,7 @@ TSharedPtr<FJsonObject> FSetStaticMeshPropertiesAction::ExecuteInternal(const TS
 	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
 	Context.MarkPackageDirty(Blueprint->GetOutermost());
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Set mesh properties on '%s' in Blueprint '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set mesh properties on '%s' in Blueprint '%s'"),
 		*ComponentName, *Blueprint->GetName());
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -909,7 +928,7 @@ TSharedPtr<FJsonObject> FSetPhysicsPropertiesAction::ExecuteInternal(const TShar
 
 	MarkBlueprintModified(Blueprint, Context);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Set physics properties on '%s' in Blueprint '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set physics properties on '%s' in Blueprint '%s'"),
 		*ComponentName, *Blueprint->GetName());
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -974,7 +993,7 @@ TSharedPtr<FJsonObject> FSetBlueprintPropertyAction::ExecuteInternal(const TShar
 
 	MarkBlueprintModified(Blueprint, Context);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Set property '%s' on Blueprint '%s'"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set property '%s' on Blueprint '%s'"),
 		*PropertyName, *Blueprint->GetName());
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -1082,7 +1101,7 @@ TSharedPtr<FJsonObject> FCreateColoredMaterialAction::ExecuteInternal(const TSha
 	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
 	UPackage::SavePackage(Package, NewMaterial, *PackageFileName, SaveArgs);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Created material '%s' with color (%.2f, %.2f, %.2f)"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Created material '%s' with color (%.2f, %.2f, %.2f)"),
 		*MaterialName, R, G, B);
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
@@ -2,12 +2,16 @@
 
 #include "Actions/EditorAction.h"
 #include "MCPCommonUtils.h"
+#include "MCPResponseWriter.h"
+#include "MCPMetrics.h"
+#include "MCPTrace.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "MCPLog.h"
 
 // NOTE: SEH crash protection is deferred to Phase 2
 // For now, using defensive programming (validation before execution)
@@ -18,41 +22,136 @@
 
 TSharedPtr<FJsonObject> FEditorAction::Execute(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
 {
+	return RunPipeline(Params, Context, true);
+}
+
+TSharedPtr<FJsonObject> FEditorAction::ExecuteWithoutSave(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
+{
+	return RunPipeline(Params, Context, false);
+}
+
+void FEditorAction::ExecuteToWriter(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer)
+{
+	if (!SupportsStreaming())
+	{
+		TSharedPtr<FJsonObject> Response = RunPipeline(Params, Context, true);
+		FMCPStageTimer SerializeTimer(Context.Timings, EMCPStage::Serialize);
+		Writer.WriteResponseObject(Response);
+		return;
+	}
+
 	FString Error;
+	FString ErrorType = TEXT("execution_failed");
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Action '%s' Execute started"), *GetActionName());
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Action '%s' Execute started (streaming)"), *GetActionName());
 
 	// Step 1: Pre-validation
-	if (!Validate(Params, Context, Error))
+	bool bValid = false;
+	{
+		FMCPStageTimer ValidateTimer(Context.Timings, EMCPStage::Validate);
+		MCP_TRACE_SCOPE_TEXT(TEXT("MCP Validate: %s"), *GetActionName());
+		bValid = Validate(Params, Context, Error);
+	}
+	if (!bValid)
+	{
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Action '%s' validation failed: %s"), *GetActionName(), *Error);
+		Writer.WriteErrorResponse(Error, TEXT("validation_failed"));
+		return;
+	}
+
+	// Step 2: Stream the result fields (serialization happens as they are written)
+	FMCPStageTimer ExecuteTimer(Context.Timings, EMCPStage::Execute);
+	Writer.BeginResponse(true);
+	bool bExecuted = false;
+	{
+		MCP_TRACE_SCOPE_TEXT(TEXT("MCP Execute: %s"), *GetActionName());
+		bExecuted = ExecuteStreaming(Params, Context, Writer, Error, ErrorType);
+	}
+	if (!bExecuted)
+	{
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Action '%s' failed: %s"), *GetActionName(), *Error);
+		Writer.WriteErrorResponse(Error, ErrorType);
+		return;
+	}
+
+	// Step 3: Post-validation
+	bool bPostValid = false;
+	{
+		MCP_TRACE_SCOPE_TEXT(TEXT("MCP PostValidate: %s"), *GetActionName());
+		bPostValid = PostValidate(Context, Error);
+	}
+	if (!bPostValid)
+	{
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Action '%s' post-validation failed: %s"), *GetActionName(), *Error);
+		Writer.WriteErrorResponse(Error, TEXT("post_validation_failed"));
+		return;
+	}
+
+	Writer.EndResponse();
+
+	// Step 4: Auto-save on success
+	if (RequiresSave())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UEBlueprintMCP: Action '%s' validation failed: %s"), *GetActionName(), *Error);
+		Context.SaveDirtyPackages();
+	}
+}
+
+TSharedPtr<FJsonObject> FEditorAction::RunPipeline(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, bool bAllowSave)
+{
+	FString Error;
+
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Action '%s' Execute started"), *GetActionName());
+
+	// Step 1: Pre-validation
+	bool bValid = false;
+	{
+		FMCPStageTimer ValidateTimer(Context.Timings, EMCPStage::Validate);
+		MCP_TRACE_SCOPE_TEXT(TEXT("MCP Validate: %s"), *GetActionName());
+		bValid = Validate(Params, Context, Error);
+	}
+	if (!bValid)
+	{
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Action '%s' validation failed: %s"), *GetActionName(), *Error);
 		return CreateErrorResponse(Error, TEXT("validation_failed"));
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Action '%s' validation passed"), *GetActionName());
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Action '%s' validation passed"), *GetActionName());
 
 	// Step 2: Execute with crash protection
-	TSharedPtr<FJsonObject> Result = ExecuteWithCrashProtection(Params, Context);
+	TSharedPtr<FJsonObject> Result;
+	bool bPostValid = false;
+	{
+		FMCPStageTimer ExecuteTimer(Context.Timings, EMCPStage::Execute);
+		{
+			MCP_TRACE_SCOPE_TEXT(TEXT("MCP Execute: %s"), *GetActionName());
+			Result = ExecuteWithCrashProtection(Params, Context);
+		}
+		if (Result)
+		{
+			MCP_TRACE_SCOPE_TEXT(TEXT("MCP PostValidate: %s"), *GetActionName());
+			bPostValid = PostValidate(Context, Error);
+		}
+	}
 	if (!Result)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UEBlueprintMCP: Action '%s' returned nullptr!"), *GetActionName());
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Action '%s' returned nullptr!"), *GetActionName());
 		return CreateCrashPreventedResponse();
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Action '%s' ExecuteInternal returned (has success=%s, has error=%s)"),
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Action '%s' ExecuteInternal returned (has success=%s, has error=%s)"),
 		*GetActionName(),
 		Result->HasField(TEXT("success")) ? TEXT("yes") : TEXT("no"),
 		Result->HasField(TEXT("error")) ? TEXT("yes") : TEXT("no"));
 
 	// Step 3: Post-validation
-	if (!PostValidate(Context, Error))
+	if (!bPostValid)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UEBlueprintMCP: Action '%s' post-validation failed: %s"), *GetActionName(), *Error);
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Action '%s' post-validation failed: %s"), *GetActionName(), *Error);
 		return CreateErrorResponse(Error, TEXT("post_validation_failed"));
 	}
 
 	// Step 4: Auto-save on success
-	if (RequiresSave() && Result->HasField(TEXT("success")))
+	if (bAllowSave && RequiresSave() && Result->HasField(TEXT("success")))
 	{
 		bool bSuccess = false;
 		if (Result->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess)
@@ -78,6 +177,8 @@ TSharedPtr<FJsonObject> FEditorAction::CreateSuccessResponse(const TSharedPtr<FJ
 
 	if (ResultData.IsValid())
 	{
+		Response->Values.Reserve(ResultData->Values.Num() + 1);
+
 		// Merge result data into response
 		for (const auto& Field : ResultData->Values)
 		{
@@ -284,8 +385,16 @@ void FBlueprintAction::MarkBlueprintModified(UBlueprint* Blueprint, FMCPEditorCo
 {
 	if (Blueprint)
 	{
-		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 		Context.MarkPackageDirty(Blueprint->GetOutermost());
+
+		// Batched callers (apply_graph_patch) flush once at the end
+		if (Context.bDeferBlueprintModified)
+		{
+			Context.PendingModifiedBlueprints.Add(Blueprint);
+			return;
+		}
+
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 	}
 }
 
@@ -297,7 +406,10 @@ bool FBlueprintAction::CompileBlueprint(UBlueprint* Blueprint, FString& OutError
 		return false;
 	}
 
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	}
 
 	if (Blueprint->Status == BS_Error)
 	{
@@ -346,6 +458,7 @@ void FBlueprintNodeAction::RegisterCreatedNode(UEdGraphNode* Node, FMCPEditorCon
 	if (Node)
 	{
 		Context.LastCreatedNodeId = Node->NodeGuid;
+		Context.RecordNodeChange(EMCPChangeKind::NodeAdded, Node, Node->GetClass()->GetName());
 	}
 }
 
@@ -2,11 +2,14 @@
 
 #include "Actions/EditorActions.h"
 #include "MCPCommonUtils.h"
+#include "MCPResponseWriter.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Blueprint.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/DirectionalLight.h"
 #include "Engine/PointLight.h"
@@ -15,6 +18,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "FileHelpers.h"
 #include "UObject/SavePackage.h"
+#include "MCPLog.h"
 
 
 // Helper to find actor by name
@@ -65,6 +69,31 @@ TSharedPtr<FJsonObject> FGetActorsInLevelAction::ExecuteInternal(const TSharedPt
 	return CreateSuccessResponse(Result);
 }
 
+bool FGetActorsInLevelAction::ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType)
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		OutError = TEXT("No editor world available");
+		OutErrorType = TEXT("no_world");
+		return false;
+	}
+
+	TArray<AActor*> AllActors;
+	UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+
+	Writer.BeginArray(TEXT("actors"));
+	for (AActor* Actor : AllActors)
+	{
+		if (Actor)
+		{
+			FMCPCommonUtils::WriteActor(Writer, Actor);
+		}
+	}
+	Writer.EndArray();
+	return true;
+}
+
 
 // ============================================================================
 // FFindActorsByNameAction
@@ -104,6 +133,34 @@ TSharedPtr<FJsonObject> FFindActorsByNameAction::ExecuteInternal(const TSharedPt
 	return CreateSuccessResponse(Result);
 }
 
+bool FFindActorsByNameAction::ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType)
+{
+	FString Pattern;
+	GetRequiredString(Params, TEXT("pattern"), Pattern, OutError);
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		OutError = TEXT("No editor world available");
+		OutErrorType = TEXT("no_world");
+		return false;
+	}
+
+	TArray<AActor*> AllActors;
+	UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+
+	Writer.BeginArray(TEXT("actors"));
+	for (AActor* Actor : AllActors)
+	{
+		if (Actor && Actor->GetName().Contains(Pattern))
+		{
+			FMCPCommonUtils::WriteActor(Writer, Actor);
+		}
+	}
+	Writer.EndArray();
+	return true;
+}
+
 
 // ============================================================================
 // FSpawnActorAction
@@ -170,12 +227,13 @@ TSharedPtr<FJsonObject> FSpawnActorAction::ExecuteInternal(const TSharedPtr<FJso
 	// Mark level dirty so auto-save works
 	Context.MarkPackageDirty(World->GetOutermost());
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Spawned actor '%s' of type '%s'"), *ActorName, *ActorType);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Spawned actor '%s' of type '%s'"), *ActorName, *ActorType);
 
 	return CreateSuccessResponse(FMCPCommonUtils::ActorToJsonObject(NewActor));
 }
 
-UClass* FSpawnActorAction::ResolveActorClass(const FString& TypeName) const
+// Built-in actor types accepted by spawn_actor / spawn_actors
+static UClass* ResolveBuiltInActorClass(const FString& TypeName)
 {
 	if (TypeName == TEXT("StaticMeshActor")) return AStaticMeshActor::StaticClass();
 	if (TypeName == TEXT("PointLight")) return APointLight::StaticClass();
@@ -186,21 +244,279 @@ UClass* FSpawnActorAction::ResolveActorClass(const FString& TypeName) const
 	return nullptr;
 }
 
+UClass* FSpawnActorAction::ResolveActorClass(const FString& TypeName) const
+{
+	return ResolveBuiltInActorClass(TypeName);
+}
+
 
 // ============================================================================
-// FDeleteActorAction
+// FSpawnActorsAction
 // ============================================================================
 
-bool FDeleteActorAction::Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError)
+// Reads a flat numeric column ([x0, y0, z0, x1, ...]) into Out; false if absent
+static bool ReadNumberColumn(const TSharedPtr<FJsonObject>& Params, const FString& FieldName, TArray<double>& Out)
 {
-	FString Name;
-	return GetRequiredString(Params, TEXT("name"), Name, OutError);
+	const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+	if (!Params->TryGetArrayField(FieldName, Values))
+	{
+		return false;
+	}
+
+	Out.SetNumUninitialized(Values->Num());
+	for (int32 i = 0; i < Values->Num(); ++i)
+	{
+		Out[i] = (*Values)[i]->AsNumber();
+	}
+	return true;
 }
 
-TSharedPtr<FJsonObject> FDeleteActorAction::ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
+// A vector column holds either one triple (applied to every row) or one triple per row
+static bool IsValidVectorColumn(const TArray<double>& Column, int32 RowCount)
 {
-	FString ActorName, Error;
-	GetRequiredString(Params, TEXT("name"), ActorName, Error);
+	return Column.Num() == 0 || Column.Num() == 3 || Column.Num() == RowCount * 3;
+}
+
+static FVector GetColumnVector(const TArray<double>& Column, int32 Row, const FVector& Default)
+{
+	if (Column.Num() == 0) return Default;
+	const int32 Base = Column.Num() == 3 ? 0 : Row * 3;
+	return FVector(Column[Base], Column[Base + 1], Column[Base + 2]);
+}
+
+bool FSpawnActorsAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSpawnActorsParams& Args, FMCPEditorContext& Context, FString& OutError)
+{
+	if (Args.Locations.Num() % 3 != 0)
+	{
+		OutError = TEXT("'locations' must be a flat [x0, y0, z0, x1, y1, z1, ...] array");
+		return false;
+	}
+	const int32 Count = Args.Locations.Num() / 3;
+
+	const TPair<const TCHAR*, const TArray<double>*> VectorColumns[] = { { TEXT("rotations"), &Args.Rotations }, { TEXT("scales"), &Args.Scales } };
+	for (const TPair<const TCHAR*, const TArray<double>*>& Column : VectorColumns)
+	{
+		if (!IsValidVectorColumn(*Column.Value, Count))
+		{
+			OutError = FString::Printf(TEXT("'%s' must hold 3 values (shared) or 3 per actor (%d)"), Column.Key, Count * 3);
+			return false;
+		}
+	}
+
+	// String columns: 'classes' may be a single shared entry, 'names'/'tags' are per actor
+	if (Args.Classes.Num() == 0 && Args.ClassName.IsEmpty())
+	{
+		OutError = TEXT("Missing 'classes' (array) or 'class' (string) parameter");
+		return false;
+	}
+	if (Args.Classes.Num() > 1 && Args.Classes.Num() != Count)
+	{
+		OutError = FString::Printf(TEXT("'classes' must hold 1 or %d entries"), Count);
+		return false;
+	}
+
+	const TPair<const TCHAR*, int32> RowColumns[] = { { TEXT("names"), Args.Names.Num() }, { TEXT("tags"), Args.Tags.Num() } };
+	for (const TPair<const TCHAR*, int32>& Column : RowColumns)
+	{
+		if (Column.Value > 0 && Column.Value != Count)
+		{
+			OutError = FString::Printf(TEXT("'%s' must hold %d entries"), Column.Key, Count);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+UClass* FSpawnActorsAction::ResolveClass(const FString& ClassName) const
+{
+	if (UClass* BuiltIn = ResolveBuiltInActorClass(ClassName))
+	{
+		return BuiltIn;
+	}
+
+	// Full class path (e.g. /Script/Engine.SkyLight or /Game/BP_Tree.BP_Tree_C)
+	if (ClassName.StartsWith(TEXT("/")))
+	{
+		UClass* Loaded = LoadObject<UClass>(nullptr, *ClassName);
+		return Loaded && Loaded->IsChildOf(AActor::StaticClass()) ? Loaded : nullptr;
+	}
+
+	// Blueprint by asset name
+	FString Error;
+	UBlueprint* Blueprint = FindBlueprint(ClassName, Error);
+	if (Blueprint && Blueprint->GeneratedClass && Blueprint->GeneratedClass->IsChildOf(AActor::StaticClass()))
+	{
+		return Blueprint->GeneratedClass;
+	}
+	return nullptr;
+}
+
+TSharedPtr<FJsonObject> FSpawnActorsAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSpawnActorsParams& Args, FMCPEditorContext& Context)
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No editor world available"), TEXT("no_world"));
+	}
+
+	const TArray<double>& Locations = Args.Locations;
+	const TArray<double>& Rotations = Args.Rotations;
+	const TArray<double>& Scales = Args.Scales;
+	const int32 Count = Locations.Num() / 3;
+
+	// Tags may be a string or an array per row, so they are read from the raw params
+	const TArray<TSharedPtr<FJsonValue>>* Tags = Args.Tags.Num() > 0 ? GetOptionalArray(Params, TEXT("tags")) : nullptr;
+
+	// Resolve each distinct class name once
+	TMap<FString, UClass*> ClassCache;
+	TArray<UClass*> RowClasses;
+	RowClasses.SetNumUninitialized(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FString& ClassName = Args.Classes.Num() > 0 ? Args.Classes[Args.Classes.Num() == 1 ? 0 : i] : Args.ClassName;
+		UClass** Cached = ClassCache.Find(ClassName);
+		if (!Cached)
+		{
+			Cached = &ClassCache.Add(ClassName, ResolveClass(ClassName));
+		}
+		if (!*Cached)
+		{
+			return CreateErrorResponse(
+				FString::Printf(TEXT("Unknown actor class '%s' (row %d)"), *ClassName, i),
+				TEXT("invalid_type"));
+		}
+		RowClasses[i] = *Cached;
+	}
+
+	// Last point before the level changes
+	if (Context.IsCancelRequested())
+	{
+		return CreateErrorResponse(FString::Printf(TEXT("Cancelled before spawning %d actor(s)"), Count), TEXT("cancelled"));
+	}
+
+	// Requested names replace existing actors, as spawn_actor does; index the level once
+	if (Args.Names.Num() > 0)
+	{
+		TMap<FString, AActor*> ExistingByName;
+		TArray<AActor*> AllActors;
+		UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+		for (AActor* Actor : AllActors)
+		{
+			if (Actor)
+			{
+				ExistingByName.Add(Actor->GetName(), Actor);
+			}
+		}
+
+		for (const FString& Name : Args.Names)
+		{
+			if (AActor* Existing = ExistingByName.FindRef(Name))
+			{
+				World->EditorDestroyActor(Existing, true);
+			}
+		}
+	}
+
+	// Phase 1: spawn with deferred construction so no component registers or construction script runs yet
+	TArray<AActor*> Spawned;
+	TArray<FTransform> Transforms;
+	Spawned.Reserve(Count);
+	Transforms.Reserve(Count);
+
+	TArray<TSharedPtr<FJsonValue>> Failed;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const FVector PitchYawRoll = GetColumnVector(Rotations, i, FVector::ZeroVector);
+		const FTransform Transform(
+			FRotator(PitchYawRoll.X, PitchYawRoll.Y, PitchYawRoll.Z),
+			GetColumnVector(Locations, i, FVector::ZeroVector),
+			GetColumnVector(Scales, i, FVector::OneVector));
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.bDeferConstruction = true;
+		if (Args.Names.Num() > 0)
+		{
+			SpawnParams.Name = FName(*Args.Names[i]);
+			SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+		}
+
+		AActor* NewActor = World->SpawnActor<AActor>(RowClasses[i], Transform, SpawnParams);
+		if (!NewActor)
+		{
+			TSharedPtr<FJsonObject> FailObj = MakeShared<FJsonObject>();
+			FailObj->SetNumberField(TEXT("index"), i);
+			FailObj->SetStringField(TEXT("error"), TEXT("Failed to spawn actor"));
+			Failed.Add(MakeShared<FJsonValueObject>(FailObj));
+			Spawned.Add(nullptr);
+			Transforms.Add(Transform);
+			continue;
+		}
+
+		if (Tags)
+		{
+			const TArray<TSharedPtr<FJsonValue>>* RowTags = nullptr;
+			if ((*Tags)[i]->TryGetArray(RowTags))
+			{
+				for (const TSharedPtr<FJsonValue>& Tag : *RowTags)
+				{
+					NewActor->Tags.Add(FName(*Tag->AsString()));
+				}
+			}
+			else if (!(*Tags)[i]->AsString().IsEmpty())
+			{
+				NewActor->Tags.Add(FName(*(*Tags)[i]->AsString()));
+			}
+		}
+
+		Spawned.Add(NewActor);
+		Transforms.Add(Transform);
+	}
+
+	// Phase 2: register components and run construction for the whole batch
+	TArray<TSharedPtr<FJsonValue>> SpawnedNames;
+	SpawnedNames.Reserve(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		AActor* NewActor = Spawned[i];
+		if (!NewActor)
+		{
+			SpawnedNames.Add(MakeShared<FJsonValueNull>());
+			continue;
+		}
+
+		NewActor->FinishSpawning(Transforms[i]);
+
+		// Label without dirtying per actor; the level is marked dirty once below
+		const FString ActorName = NewActor->GetName();
+		NewActor->SetActorLabel(ActorName, false);
+		SpawnedNames.Add(MakeShared<FJsonValueString>(ActorName));
+		Context.LastCreatedActorName = ActorName;
+	}
+
+	// Mark level dirty once for the batch
+	Context.MarkPackageDirty(World->GetOutermost());
+
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Spawned %d actors (%d failed)"), Count - Failed.Num(), Failed.Num());
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("count"), Count - Failed.Num());
+	Result->SetArrayField(TEXT("names"), SpawnedNames);
+	if (Failed.Num() > 0)
+	{
+		Result->SetArrayField(TEXT("failed"), Failed);
+	}
+	return CreateSuccessResponse(Result);
+}
+
+
+// ============================================================================
+// FDeleteActorAction
+// ============================================================================
+
+TSharedPtr<FJsonObject> FDeleteActorAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPDeleteActorParams& Args, FMCPEditorContext& Context)
+{
+	const FString& ActorName = Args.Name;
 
 	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
 	if (!World)
@@ -231,7 +547,7 @@ TSharedPtr<FJsonObject> FDeleteActorAction::ExecuteInternal(const TSharedPtr<FJs
 	// Mark world dirty
 	Context.MarkPackageDirty(World->GetOutermost());
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Deleted actor '%s'"), *ActorName);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Deleted actor '%s'"), *ActorName);
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetObjectField(TEXT("deleted_actor"), ActorInfo);
@@ -289,13 +605,352 @@ TSharedPtr<FJsonObject> FSetActorTransformAction::ExecuteInternal(const TSharedP
 
 	// Mark level dirty so auto-save works
 	Context.MarkPackageDirty(World->GetOutermost());
+	Context.RecordActorChange(EMCPChangeKind::ActorMoved, Actor);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Set transform on actor '%s'"), *ActorName);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set transform on actor '%s'"), *ActorName);
 
 	return CreateSuccessResponse(FMCPCommonUtils::ActorToJsonObject(Actor));
 }
 
 
+// ============================================================================
+// FSetActorTransformsAction
+// ============================================================================
+
+// Structure-of-arrays view of a batch of transforms; the kernels below run
+// straight loops over contiguous columns so they stay cheap for thousands of actors.
+struct FTransformColumns
+{
+	TArray<double> PX, PY, PZ;
+	TArray<FQuat> Rotation;
+	TArray<double> SX, SY, SZ;
+
+	void Reserve(int32 Num)
+	{
+		PX.Reserve(Num); PY.Reserve(Num); PZ.Reserve(Num);
+		Rotation.Reserve(Num);
+		SX.Reserve(Num); SY.Reserve(Num); SZ.Reserve(Num);
+	}
+
+	void Add(const FTransform& Transform)
+	{
+		const FVector Location = Transform.GetLocation();
+		const FVector Scale = Transform.GetScale3D();
+		PX.Add(Location.X); PY.Add(Location.Y); PZ.Add(Location.Z);
+		Rotation.Add(Transform.GetRotation());
+		SX.Add(Scale.X); SY.Add(Scale.Y); SZ.Add(Scale.Z);
+	}
+
+	FTransform Get(int32 Index) const
+	{
+		return FTransform(Rotation[Index], FVector(PX[Index], PY[Index], PZ[Index]), FVector(SX[Index], SY[Index], SZ[Index]));
+	}
+
+	int32 Num() const { return PX.Num(); }
+};
+
+static FVector ComputeCentroid(const FTransformColumns& Columns)
+{
+	const int32 Num = Columns.Num();
+	double SumX = 0.0, SumY = 0.0, SumZ = 0.0;
+	for (int32 i = 0; i < Num; ++i) SumX += Columns.PX[i];
+	for (int32 i = 0; i < Num; ++i) SumY += Columns.PY[i];
+	for (int32 i = 0; i < Num; ++i) SumZ += Columns.PZ[i];
+	return Num > 0 ? FVector(SumX, SumY, SumZ) / Num : FVector::ZeroVector;
+}
+
+static void OffsetKernel(FTransformColumns& Columns, const FVector& Offset)
+{
+	const int32 Num = Columns.Num();
+	double* RESTRICT X = Columns.PX.GetData();
+	double* RESTRICT Y = Columns.PY.GetData();
+	double* RESTRICT Z = Columns.PZ.GetData();
+	for (int32 i = 0; i < Num; ++i) X[i] += Offset.X;
+	for (int32 i = 0; i < Num; ++i) Y[i] += Offset.Y;
+	for (int32 i = 0; i < Num; ++i) Z[i] += Offset.Z;
+}
+
+static void RotateAboutPivotKernel(FTransformColumns& Columns, const FVector& Pivot, const FRotator& Delta)
+{
+	const int32 Num = Columns.Num();
+	const FMatrix M = FRotationMatrix(Delta);
+	double* RESTRICT X = Columns.PX.GetData();
+	double* RESTRICT Y = Columns.PY.GetData();
+	double* RESTRICT Z = Columns.PZ.GetData();
+
+	// Row-vector convention: P' = Pivot + (P - Pivot) * M
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const double DX = X[i] - Pivot.X;
+		const double DY = Y[i] - Pivot.Y;
+		const double DZ = Z[i] - Pivot.Z;
+		X[i] = Pivot.X + DX * M.M[0][0] + DY * M.M[1][0] + DZ * M.M[2][0];
+		Y[i] = Pivot.Y + DX * M.M[0][1] + DY * M.M[1][1] + DZ * M.M[2][1];
+		Z[i] = Pivot.Z + DX * M.M[0][2] + DY * M.M[1][2] + DZ * M.M[2][2];
+	}
+
+	const FQuat DeltaQuat = Delta.Quaternion();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Columns.Rotation[i] = DeltaQuat * Columns.Rotation[i];
+	}
+}
+
+static void AlignToGridKernel(FTransformColumns& Columns, const FVector& GridSize)
+{
+	const int32 Num = Columns.Num();
+	double* RESTRICT X = Columns.PX.GetData();
+	double* RESTRICT Y = Columns.PY.GetData();
+	double* RESTRICT Z = Columns.PZ.GetData();
+	if (GridSize.X > 0.0) for (int32 i = 0; i < Num; ++i) X[i] = FMath::RoundHalfFromZero(X[i] / GridSize.X) * GridSize.X;
+	if (GridSize.Y > 0.0) for (int32 i = 0; i < Num; ++i) Y[i] = FMath::RoundHalfFromZero(Y[i] / GridSize.Y) * GridSize.Y;
+	if (GridSize.Z > 0.0) for (int32 i = 0; i < Num; ++i) Z[i] = FMath::RoundHalfFromZero(Z[i] / GridSize.Z) * GridSize.Z;
+}
+
+static void ScaleAboutPivotKernel(FTransformColumns& Columns, const FVector& Pivot, const FVector& Factor)
+{
+	const int32 Num = Columns.Num();
+	double* RESTRICT X = Columns.PX.GetData();
+	double* RESTRICT Y = Columns.PY.GetData();
+	double* RESTRICT Z = Columns.PZ.GetData();
+	for (int32 i = 0; i < Num; ++i) X[i] = Pivot.X + (X[i] - Pivot.X) * Factor.X;
+	for (int32 i = 0; i < Num; ++i) Y[i] = Pivot.Y + (Y[i] - Pivot.Y) * Factor.Y;
+	for (int32 i = 0; i < Num; ++i) Z[i] = Pivot.Z + (Z[i] - Pivot.Z) * Factor.Z;
+
+	double* RESTRICT SX = Columns.SX.GetData();
+	double* RESTRICT SY = Columns.SY.GetData();
+	double* RESTRICT SZ = Columns.SZ.GetData();
+	if (Factor.AllComponentsEqual())
+	{
+		for (int32 i = 0; i < Num; ++i) SX[i] *= Factor.X;
+		for (int32 i = 0; i < Num; ++i) SY[i] *= Factor.X;
+		for (int32 i = 0; i < Num; ++i) SZ[i] *= Factor.X;
+		return;
+	}
+
+	// A world-axis factor stretches each local axis by how much of it lies along each world axis.
+	// Exact for axis-aligned actors; for others the shear a non-uniform factor would add is dropped.
+	auto LocalFactor = [&Factor](const FVector& Axis)
+	{
+		const double Stretch = (Factor * Axis).Size();
+		return (Factor | (Axis * Axis)) < 0.0 ? -Stretch : Stretch;
+	};
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const FQuat& Rotation = Columns.Rotation[i];
+		SX[i] *= LocalFactor(Rotation.GetAxisX());
+		SY[i] *= LocalFactor(Rotation.GetAxisY());
+		SZ[i] *= LocalFactor(Rotation.GetAxisZ());
+	}
+}
+
+// Reads a vector operand given as a number (uniform) or [x, y, z]
+static bool ReadVectorOperand(const TSharedPtr<FJsonObject>& Params, const FString& FieldName, FVector& OutVector)
+{
+	double Uniform = 0.0;
+	if (Params->TryGetNumberField(FieldName, Uniform))
+	{
+		OutVector = FVector(Uniform);
+		return true;
+	}
+
+	TArray<double> Column;
+	if (ReadNumberColumn(Params, FieldName, Column) && Column.Num() == 3)
+	{
+		OutVector = FVector(Column[0], Column[1], Column[2]);
+		return true;
+	}
+	return false;
+}
+
+bool FSetActorTransformsAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSetActorTransformsParams& Args, FMCPEditorContext& Context, FString& OutError)
+{
+	const int32 Count = Args.Names.Num();
+
+	const TPair<const TCHAR*, const TArray<double>*> VectorColumns[] = {
+		{ TEXT("locations"), &Args.Locations }, { TEXT("rotations"), &Args.Rotations }, { TEXT("scales"), &Args.Scales } };
+	for (const TPair<const TCHAR*, const TArray<double>*>& Column : VectorColumns)
+	{
+		if (!IsValidVectorColumn(*Column.Value, Count))
+		{
+			OutError = FString::Printf(TEXT("'%s' must hold 3 values (shared) or 3 per actor (%d)"), Column.Key, Count * 3);
+			return false;
+		}
+	}
+
+	// Operation names are checked by the params metadata; each needs its operand
+	FVector Operand;
+	if (Args.Operation == TEXT("offset") && !Params->HasField(TEXT("offset")))
+	{
+		OutError = TEXT("'offset' operation requires 'offset': [x, y, z]");
+		return false;
+	}
+	if (Args.Operation == TEXT("rotate_about_pivot") && !Params->HasField(TEXT("rotation")))
+	{
+		OutError = TEXT("'rotate_about_pivot' operation requires 'rotation': [pitch, yaw, roll]");
+		return false;
+	}
+	if (Args.Operation == TEXT("align_to_grid") && !ReadVectorOperand(Params, TEXT("grid_size"), Operand))
+	{
+		OutError = TEXT("'align_to_grid' operation requires 'grid_size': number or [x, y, z]");
+		return false;
+	}
+	if (Args.Operation == TEXT("scale_about_centroid") && !ReadVectorOperand(Params, TEXT("scale"), Operand))
+	{
+		OutError = TEXT("'scale_about_centroid' operation requires 'scale': number or [x, y, z]");
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FSetActorTransformsAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSetActorTransformsParams& Args, FMCPEditorContext& Context)
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No editor world available"), TEXT("no_world"));
+	}
+
+	const TArray<FString>& Names = Args.Names;
+
+	// Index the level once instead of scanning per actor
+	TMap<FString, AActor*> ActorsByName;
+	{
+		TArray<AActor*> AllActors;
+		UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+		ActorsByName.Reserve(AllActors.Num());
+		for (AActor* Actor : AllActors)
+		{
+			if (Actor)
+			{
+				ActorsByName.Add(Actor->GetName(), Actor);
+			}
+		}
+	}
+
+	const TArray<double>& Locations = Args.Locations;
+	const TArray<double>& Rotations = Args.Rotations;
+	const TArray<double>& Scales = Args.Scales;
+
+	// Gather current transforms (with absolute overrides) into columns
+	TArray<AActor*> Actors;
+	TArray<TSharedPtr<FJsonValue>> Missing;
+	FTransformColumns Columns;
+	Actors.Reserve(Names.Num());
+	Columns.Reserve(Names.Num());
+
+	for (int32 i = 0; i < Names.Num(); ++i)
+	{
+		const FString& ActorName = Names[i];
+		AActor* Actor = ActorsByName.FindRef(ActorName);
+		if (!Actor)
+		{
+			Missing.Add(MakeShared<FJsonValueString>(ActorName));
+			continue;
+		}
+
+		FTransform Transform = Actor->GetTransform();
+		if (Locations.Num() > 0)
+		{
+			Transform.SetLocation(GetColumnVector(Locations, i, FVector::ZeroVector));
+		}
+		if (Rotations.Num() > 0)
+		{
+			const FVector PitchYawRoll = GetColumnVector(Rotations, i, FVector::ZeroVector);
+			Transform.SetRotation(FQuat(FRotator(PitchYawRoll.X, PitchYawRoll.Y, PitchYawRoll.Z)));
+		}
+		if (Scales.Num() > 0)
+		{
+			Transform.SetScale3D(GetColumnVector(Scales, i, FVector::OneVector));
+		}
+
+		Actors.Add(Actor);
+		Columns.Add(Transform);
+	}
+
+	// Relative operation over the whole batch
+	const FString& Operation = Args.Operation;
+	FVector Operand;
+	if (Operation == TEXT("offset"))
+	{
+		OffsetKernel(Columns, Args.Offset);
+	}
+	else if (Operation == TEXT("rotate_about_pivot"))
+	{
+		const FVector Pivot = Params->HasField(TEXT("pivot")) ? Args.Pivot : ComputeCentroid(Columns);
+		RotateAboutPivotKernel(Columns, Pivot, Args.Rotation);
+	}
+	else if (Operation == TEXT("align_to_grid"))
+	{
+		ReadVectorOperand(Params, TEXT("grid_size"), Operand);
+		AlignToGridKernel(Columns, Operand);
+	}
+	else if (Operation == TEXT("scale_about_centroid"))
+	{
+		ReadVectorOperand(Params, TEXT("scale"), Operand);
+		ScaleAboutPivotKernel(Columns, ComputeCentroid(Columns), Operand);
+	}
+
+	// Apply: teleport without sweeps so each moved actor does one component-to-world update.
+	// There is no engine API to update many actors at once, so actors left where they were are skipped.
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		const FTransform NewTransform = Columns.Get(i);
+		if (NewTransform.Equals(Actors[i]->GetTransform(), 0.0))
+		{
+			continue;
+		}
+		Actors[i]->SetActorTransform(NewTransform, false, nullptr, ETeleportType::TeleportPhysics);
+		Context.RecordActorChange(EMCPChangeKind::ActorMoved, Actors[i]);
+	}
+
+	// Mark level dirty once for the batch
+	if (Actors.Num() > 0)
+	{
+		Context.MarkPackageDirty(World->GetOutermost());
+	}
+
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set transforms on %d actors (%d missing)"), Actors.Num(), Missing.Num());
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("count"), Actors.Num());
+	if (Missing.Num() > 0)
+	{
+		Result->SetArrayField(TEXT("missing"), Missing);
+	}
+
+	// Optional flat result columns, one row per found actor; "names" says which (missing actors are skipped)
+	if (Args.bReturnTransforms)
+	{
+		TArray<TSharedPtr<FJsonValue>> OutNames, OutLocations, OutRotations, OutScales;
+		OutNames.Reserve(Actors.Num());
+		OutLocations.Reserve(Actors.Num() * 3);
+		OutRotations.Reserve(Actors.Num() * 3);
+		OutScales.Reserve(Actors.Num() * 3);
+		for (int32 i = 0; i < Actors.Num(); ++i)
+		{
+			const FRotator Rotator = Columns.Rotation[i].Rotator();
+			OutNames.Add(MakeShared<FJsonValueString>(Actors[i]->GetName()));
+			OutLocations.Add(MakeShared<FJsonValueNumber>(Columns.PX[i]));
+			OutLocations.Add(MakeShared<FJsonValueNumber>(Columns.PY[i]));
+			OutLocations.Add(MakeShared<FJsonValueNumber>(Columns.PZ[i]));
+			OutRotations.Add(MakeShared<FJsonValueNumber>(Rotator.Pitch));
+			OutRotations.Add(MakeShared<FJsonValueNumber>(Rotator.Yaw));
+			OutRotations.Add(MakeShared<FJsonValueNumber>(Rotator.Roll));
+			OutScales.Add(MakeShared<FJsonValueNumber>(Columns.SX[i]));
+			OutScales.Add(MakeShared<FJsonValueNumber>(Columns.SY[i]));
+			OutScales.Add(MakeShared<FJsonValueNumber>(Columns.SZ[i]));
+		}
+		Result->SetArrayField(TEXT("names"), OutNames);
+		Result->SetArrayField(TEXT("locations"), OutLocations);
+		Result->SetArrayField(TEXT("rotations"), OutRotations);
+		Result->SetArrayField(TEXT("scales"), OutScales);
+	}
+
+	return CreateSuccessResponse(Result);
+}
+
 // ============================================================================
 // FGetActorPropertiesAction
 // ============================================================================
@@ -329,6 +984,31 @@ TSharedPtr<FJsonObject> FGetActorPropertiesAction::ExecuteInternal(const TShared
 	return CreateSuccessResponse(FMCPCommonUtils::ActorToJsonObject(Actor));
 }
 
+bool FGetActorPropertiesAction::ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType)
+{
+	FString ActorName;
+	GetRequiredString(Params, TEXT("name"), ActorName, OutError);
+
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		OutError = TEXT("No editor world available");
+		OutErrorType = TEXT("no_world");
+		return false;
+	}
+
+	AActor* Actor = FindActorByName(World, ActorName);
+	if (!Actor)
+	{
+		OutError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+		OutErrorType = TEXT("not_found");
+		return false;
+	}
+
+	FMCPCommonUtils::WriteActorFields(Writer, Actor);
+	return true;
+}
+
 
 // ============================================================================
 // FSetActorPropertyAction
@@ -378,8 +1058,9 @@ TSharedPtr<FJsonObject> FSetActorPropertyAction::ExecuteInternal(const TSharedPt
 
 	// Mark level dirty so auto-save works
 	Context.MarkPackageDirty(World->GetOutermost());
+	Context.RecordActorChange(EMCPChangeKind::ActorPropertyChanged, Actor, PropertyName);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Set property '%s' on actor '%s'"), *PropertyName, *ActorName);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Set property '%s' on actor '%s'"), *PropertyName, *ActorName);
 
 	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
 	Result->SetStringField(TEXT("actor"), ActorName);
@@ -389,6 +1070,343 @@ TSharedPtr<FJsonObject> FSetActorPropertyAction::ExecuteInternal(const TSharedPt
 }
 
 
+// ============================================================================
+// FSetPropertiesBulkAction
+// ============================================================================
+
+// Property lookups cached per (owning class/struct, path segment) for the duration of one call
+struct FPropertyPathCache
+{
+	TMap<TPair<const UStruct*, FName>, FProperty*> Properties;
+
+	FProperty* Find(const UStruct* Struct, FName Segment)
+	{
+		const TPair<const UStruct*, FName> Key(Struct, Segment);
+		if (FProperty** Found = Properties.Find(Key))
+		{
+			return *Found;
+		}
+		return Properties.Add(Key, Struct->FindPropertyByName(Segment));
+	}
+};
+
+// A resolved write: Property lives in Container, which belongs to Object via MemberProperty
+struct FPendingPropertyWrite
+{
+	UObject* Object = nullptr;
+	FProperty* MemberProperty = nullptr;
+	FProperty* Property = nullptr;
+	void* Container = nullptr;
+	int32 PathIndex = INDEX_NONE;
+};
+
+static UActorComponent* FindComponentByName(AActor* Actor, FName ComponentName)
+{
+	TInlineComponentArray<UActorComponent*> Components(Actor);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component && Component->GetFName() == ComponentName)
+		{
+			return Component;
+		}
+	}
+	return nullptr;
+}
+
+// Walks "Component.Struct.Property" style paths. The first segment may name a component;
+// object properties are only followed into subobjects of the actor so assets are never edited.
+static bool ResolvePropertyPath(AActor* Actor, const TArray<FName>& Segments, FPropertyPathCache& Cache,
+	FPendingPropertyWrite& OutWrite, FString& OutError)
+{
+	UObject* Object = Actor;
+	const UStruct* Struct = Actor->GetClass();
+	void* Container = Actor;
+	FProperty* MemberProperty = nullptr;
+
+	for (int32 i = 0; i < Segments.Num(); ++i)
+	{
+		const bool bLast = i == Segments.Num() - 1;
+		FProperty* Property = Cache.Find(Struct, Segments[i]);
+
+		if (!Property)
+		{
+			if (i == 0 && !bLast)
+			{
+				if (UActorComponent* Component = FindComponentByName(Actor, Segments[i]))
+				{
+					Object = Component;
+					Struct = Component->GetClass();
+					Container = Component;
+					continue;
+				}
+			}
+			OutError = FString::Printf(TEXT("Property not found: %s on %s"), *Segments[i].ToString(), *Struct->GetName());
+			return false;
+		}
+
+		if (!MemberProperty)
+		{
+			MemberProperty = Property;
+		}
+
+		if (bLast)
+		{
+			OutWrite.Object = Object;
+			OutWrite.MemberProperty = MemberProperty;
+			OutWrite.Property = Property;
+			OutWrite.Container = Container;
+			return true;
+		}
+
+		if (FStructProperty* StructProp = CastField<FStructProperty>(Property))
+		{
+			Container = StructProp->ContainerPtrToValuePtr<void>(Container);
+			Struct = StructProp->Struct;
+		}
+		else if (FObjectPropertyBase* ObjectProp = CastField<FObjectPropertyBase>(Property))
+		{
+			UObject* SubObject = ObjectProp->GetObjectPropertyValue_InContainer(Container);
+			if (!SubObject || !SubObject->IsIn(Actor))
+			{
+				OutError = FString::Printf(TEXT("'%s' is not a subobject of the actor"), *Segments[i].ToString());
+				return false;
+			}
+			Object = SubObject;
+			Struct = SubObject->GetClass();
+			Container = SubObject;
+			MemberProperty = nullptr;
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Cannot descend into '%s'"), *Segments[i].ToString());
+			return false;
+		}
+	}
+
+	OutError = TEXT("Empty property path");
+	return false;
+}
+
+bool FSetPropertiesBulkAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSetPropertiesBulkParams& Args, FMCPEditorContext& Context, FString& OutError)
+{
+	// Sphere and box have no empty form, so their presence is read from the raw selector
+	const TSharedPtr<FJsonObject> Target = Params->GetObjectField(TEXT("target"));
+	const FMCPActorSelector& Selector = Args.Target;
+	if (Selector.Names.Num() == 0 && Selector.ClassName.IsEmpty() && Selector.Tag.IsEmpty()
+		&& !Target->HasField(TEXT("sphere")) && !Target->HasField(TEXT("box")))
+	{
+		OutError = TEXT("'target' needs at least one of: names, class, tag, sphere, box");
+		return false;
+	}
+
+	if (Params->GetObjectField(TEXT("properties"))->Values.Num() == 0)
+	{
+		OutError = TEXT("Missing 'properties' object ({\"Path.To.Property\": value})");
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FSetPropertiesBulkAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSetPropertiesBulkParams& Args, FMCPEditorContext& Context)
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return CreateErrorResponse(TEXT("No editor world available"), TEXT("no_world"));
+	}
+
+	const TSharedPtr<FJsonObject> Target = Params->GetObjectField(TEXT("target"));
+	const FMCPActorSelector& Selector = Args.Target;
+
+	// Class filter narrows the scan itself
+	UClass* ScanClass = AActor::StaticClass();
+	const FString& ClassName = Selector.ClassName;
+	if (!ClassName.IsEmpty())
+	{
+		ScanClass = ResolveBuiltInActorClass(ClassName);
+		if (!ScanClass && ClassName.StartsWith(TEXT("/")))
+		{
+			ScanClass = LoadObject<UClass>(nullptr, *ClassName);
+		}
+		if (!ScanClass)
+		{
+			FString Error;
+			UBlueprint* Blueprint = FindBlueprint(ClassName, Error);
+			ScanClass = Blueprint ? Blueprint->GeneratedClass.Get() : nullptr;
+		}
+		if (!ScanClass || !ScanClass->IsChildOf(AActor::StaticClass()))
+		{
+			return CreateErrorResponse(FString::Printf(TEXT("Unknown actor class: %s"), *ClassName), TEXT("invalid_type"));
+		}
+	}
+
+	const TSet<FString> Names(Selector.Names);
+	const FName Tag = Selector.Tag.IsEmpty() ? NAME_None : FName(*Selector.Tag);
+
+	// Spatial queries test the actor location
+	const bool bHasSphere = Target->HasField(TEXT("sphere"));
+	const FVector SphereCenter = Selector.Sphere.Center;
+	const double SphereRadius = Selector.Sphere.Radius;
+
+	const bool bHasBox = Target->HasField(TEXT("box"));
+	const FBox Box = bHasBox ? FBox(Selector.Box.Min, Selector.Box.Max) : FBox(ForceInit);
+
+	// Select in a single pass over the level
+	TArray<AActor*> Candidates;
+	UGameplayStatics::GetAllActorsOfClass(World, ScanClass, Candidates);
+
+	TArray<AActor*> Selected;
+	for (AActor* Actor : Candidates)
+	{
+		if (!Actor) continue;
+		if (Names.Num() > 0 && !Names.Contains(Actor->GetName())) continue;
+		if (Tag != NAME_None && !Actor->ActorHasTag(Tag)) continue;
+
+		const FVector Location = Actor->GetActorLocation();
+		if (bHasSphere && FVector::DistSquared(Location, SphereCenter) > SphereRadius * SphereRadius) continue;
+		if (bHasBox && !Box.IsInsideOrOn(Location)) continue;
+
+		Selected.Add(Actor);
+	}
+
+	// Split paths once
+	const TSharedPtr<FJsonObject> Properties = Params->GetObjectField(TEXT("properties"));
+	TArray<FString> Paths;
+	TArray<TArray<FName>> PathSegments;
+	TArray<TSharedPtr<FJsonValue>> Values;
+	for (const auto& Pair : Properties->Values)
+	{
+		TArray<FString> Parts;
+		Pair.Key.ParseIntoArray(Parts, TEXT("."));
+
+		TArray<FName>& Segments = PathSegments.AddDefaulted_GetRef();
+		for (const FString& Part : Parts)
+		{
+			Segments.Add(FName(*Part));
+		}
+		Paths.Add(Pair.Key);
+		Values.Add(Pair.Value);
+	}
+
+	FPropertyPathCache Cache;
+	TArray<TSharedPtr<FJsonValue>> Failures;
+	int32 FailureCount = 0;
+	int32 UpdatedActors = 0;
+	int32 UpdatedObjects = 0;
+	constexpr int32 MaxReportedFailures = 100;
+
+	auto AddFailure = [&](AActor* Actor, const FString& Path, const FString& Message)
+	{
+		if (FailureCount++ < MaxReportedFailures)
+		{
+			TSharedPtr<FJsonObject> FailObj = MakeShared<FJsonObject>();
+			FailObj->SetStringField(TEXT("actor"), Actor->GetName());
+			FailObj->SetStringField(TEXT("path"), Path);
+			FailObj->SetStringField(TEXT("error"), Message);
+			Failures.Add(MakeShared<FJsonValueObject>(FailObj));
+		}
+	};
+
+	TArray<FPendingPropertyWrite> Writes;
+	TArray<UObject*> Objects;
+	for (AActor* Actor : Selected)
+	{
+		// Resolve every path for this actor before touching it
+		Writes.Reset();
+		Objects.Reset();
+		for (int32 PathIndex = 0; PathIndex < Paths.Num(); ++PathIndex)
+		{
+			FPendingPropertyWrite Write;
+			FString Error;
+			if (!ResolvePropertyPath(Actor, PathSegments[PathIndex], Cache, Write, Error))
+			{
+				AddFailure(Actor, Paths[PathIndex], Error);
+				continue;
+			}
+			Write.PathIndex = PathIndex;
+			Writes.Add(Write);
+			Objects.AddUnique(Write.Object);
+		}
+
+		// One Pre/PostEditChange bracket per touched object (actor or component)
+		bool bActorChanged = false;
+		for (UObject* Object : Objects)
+		{
+			FProperty* OnlyMember = nullptr;
+			int32 MemberCount = 0;
+			for (const FPendingPropertyWrite& Write : Writes)
+			{
+				if (Write.Object == Object && Write.MemberProperty != OnlyMember)
+				{
+					OnlyMember = Write.MemberProperty;
+					++MemberCount;
+				}
+			}
+
+			Object->Modify();
+			Object->PreEditChange(MemberCount == 1 ? OnlyMember : nullptr);
+
+			bool bObjectChanged = false;
+			for (const FPendingPropertyWrite& Write : Writes)
+			{
+				if (Write.Object != Object) continue;
+
+				FString Error;
+				if (FMCPCommonUtils::SetPropertyValue(Write.Property, Write.Container, Values[Write.PathIndex], Error))
+				{
+					bObjectChanged = true;
+				}
+				else
+				{
+					AddFailure(Actor, Paths[Write.PathIndex], Error);
+				}
+			}
+
+			if (MemberCount == 1)
+			{
+				FPropertyChangedEvent ChangedEvent(OnlyMember, EPropertyChangeType::ValueSet);
+				Object->PostEditChangeProperty(ChangedEvent);
+			}
+			else
+			{
+				Object->PostEditChange();
+			}
+
+			if (bObjectChanged)
+			{
+				++UpdatedObjects;
+				bActorChanged = true;
+			}
+		}
+
+		if (bActorChanged)
+		{
+			++UpdatedActors;
+		}
+	}
+
+	// Mark level dirty once for the batch
+	if (UpdatedActors > 0)
+	{
+		Context.MarkPackageDirty(World->GetOutermost());
+	}
+
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Bulk-set %d properties on %d/%d actors (%d failures)"),
+		Paths.Num(), UpdatedActors, Selected.Num(), FailureCount);
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("matched"), Selected.Num());
+	Result->SetNumberField(TEXT("updated_actors"), UpdatedActors);
+	Result->SetNumberField(TEXT("updated_objects"), UpdatedObjects);
+	Result->SetNumberField(TEXT("failure_count"), FailureCount);
+	if (Failures.Num() > 0)
+	{
+		Result->SetArrayField(TEXT("failures"), Failures);
+	}
+	return CreateSuccessResponse(Result);
+}
+
 // ============================================================================
 // FFocusViewportAction
 // ============================================================================
@@ -594,10 +1612,20 @@ TSharedPtr<FJsonObject> FSaveAllAction::ExecuteInternal(const TSharedPtr<FJsonOb
 		TArray<UPackage*> DirtyPackages;
 		FEditorFileUtils::GetDirtyPackages(DirtyPackages);
 
-		for (UPackage* Package : DirtyPackages)
+		for (int32 PackageIndex = 0; PackageIndex < DirtyPackages.Num(); ++PackageIndex)
 		{
+			UPackage* Package = DirtyPackages[PackageIndex];
 			if (!Package) continue;
 
+			// Cancelled jobs and requests stop between packages
+			if (Context.IsCancelRequested())
+			{
+				return CreateErrorResponse(
+					FString::Printf(TEXT("Cancelled after saving %d of %d package(s)"), SavedCount, DirtyPackages.Num()),
+					TEXT("cancelled"));
+			}
+			Context.ReportProgress(static_cast<float>(PackageIndex) / DirtyPackages.Num(), TEXT("saving"));
+
 			FString PackageFilename;
 			FString PackageName = Package->GetName();
 			bool bIsMap = Package->ContainsMap();
@@ -616,7 +1644,7 @@ TSharedPtr<FJsonObject> FSaveAllAction::ExecuteInternal(const TSharedPtr<FJsonOb
 				{
 					SavedCount++;
 					SavedPackages.Add(PackageName);
-					UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP SaveAll: Saved %s"), *PackageName);
+					UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP SaveAll: Saved %s"), *PackageName);
 				}
 			}
 		}
@@ -634,3 +1662,49 @@ TSharedPtr<FJsonObject> FSaveAllAction::ExecuteInternal(const TSharedPtr<FJsonOb
 
 	return CreateSuccessResponse(Result);
 }
+
+
+// ============================================================================
+// FGetChangesAction
+// ============================================================================
+
+TSharedPtr<FJsonObject> FGetChangesAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPGetChangesParams& Args, FMCPEditorContext& Context)
+{
+	if (!Context.ChangeJournal.IsValid())
+	{
+		return CreateErrorResponse(TEXT("Change journal is not available"), TEXT("no_journal"));
+	}
+
+	const int64 SinceRevision = Args.SinceRevision;
+	const int32 Limit = Args.Limit;
+
+	// Read the head revision first so nothing recorded meanwhile is skipped
+	const int64 Revision = Context.ChangeJournal->GetRevision();
+
+	// Revisions from another journal (e.g. before an editor restart) mean nothing here
+	const FString Epoch = Context.ChangeJournal->GetEpoch().ToString();
+	const FString& ClientEpoch = Args.Epoch;
+	const bool bSameEpoch = ClientEpoch.IsEmpty() || ClientEpoch == Epoch;
+
+	TArray<FMCPChangeEntry> Entries;
+	const bool bComplete = bSameEpoch && Context.ChangeJournal->GetChangesSince(SinceRevision, Limit, Entries);
+
+	TArray<TSharedPtr<FJsonValue>> ChangesArray;
+	ChangesArray.Reserve(Entries.Num());
+	for (const FMCPChangeEntry& Entry : Entries)
+	{
+		ChangesArray.Add(MakeShared<FJsonValueObject>(Entry.ToJson()));
+	}
+
+	// Resume point: last returned revision when paging, head revision otherwise
+	const bool bHasMore = Limit > 0 && Entries.Num() == Limit && Entries.Last().Revision < Revision;
+	const int64 NextRevision = bHasMore ? Entries.Last().Revision : FMath::Max(Revision, Entries.Num() > 0 ? Entries.Last().Revision : 0);
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetNumberField(TEXT("revision"), static_cast<double>(NextRevision));
+	Result->SetStringField(TEXT("epoch"), Epoch);
+	Result->SetBoolField(TEXT("resync_required"), !bComplete);
+	Result->SetBoolField(TEXT("has_more"), bHasMore);
+	Result->SetArrayField(TEXT("changes"), ChangesArray);
+	return CreateSuccessResponse(Result);
+}
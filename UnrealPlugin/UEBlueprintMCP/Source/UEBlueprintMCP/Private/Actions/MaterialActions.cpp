@@ -73,6 +73,9 @@
 #include "Components/PostProcessComponent.h"
 #include "EngineUtils.h"  // For TActorIterator
 #include "ComponentReregisterContext.h"  // For FGlobalComponentReregisterContext
+#include "MaterialShared.h"  // For FMaterialResource compile errors
+#include "RHI.h"  // For GMaxRHIFeatureLevel
+#include "MCPLog.h"
 
 // =========================================================================
 // Expression Class Mapping
@@ -201,6 +204,66 @@ static void InitExpressionClassMap()
 	ExpressionClassMap.Add(TEXT("Custom"), UMaterialExpressionCustom::StaticClass());
 }
 
+// =========================================================================
+// Material Property Handlers (property name -> handler lambda)
+// =========================================================================
+
+using FMaterialPropertyHandler = TFunction<bool(UMaterial*, const FString&, FString&)>;
+static TMap<FString, FMaterialPropertyHandler> MaterialPropertyHandlers;
+
+static void InitMaterialPropertyHandlers()
+{
+	if (MaterialPropertyHandlers.Num() > 0) return;
+
+	MaterialPropertyHandlers.Add(TEXT("ShadingModel"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
+	{
+		InitShadingModelMap();
+		if (EMaterialShadingModel* Found = ShadingModelMap.Find(Value))
+		{
+			Mat->SetShadingModel(*Found);
+			return true;
+		}
+		OutErr = FString::Printf(TEXT("Invalid ShadingModel '%s'. Valid: Unlit, DefaultLit, Subsurface, PreintegratedSkin, ClearCoat, SubsurfaceProfile, TwoSidedFoliage, Hair, Cloth, Eye"), *Value);
+		return false;
+	});
+
+	MaterialPropertyHandlers.Add(TEXT("TwoSided"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
+	{
+		Mat->TwoSided = Value.ToBool() || Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
+		return true;
+	});
+
+	MaterialPropertyHandlers.Add(TEXT("BlendMode"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
+	{
+		InitBlendModeMap();
+		if (EBlendMode* Found = BlendModeMap.Find(Value))
+		{
+			Mat->BlendMode = *Found;
+			return true;
+		}
+		OutErr = FString::Printf(TEXT("Invalid BlendMode '%s'. Valid: Opaque, Masked, Translucent, Additive, Modulate, AlphaComposite, AlphaHoldout"), *Value);
+		return false;
+	});
+
+	MaterialPropertyHandlers.Add(TEXT("DitheredLODTransition"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
+	{
+		Mat->DitheredLODTransition = Value.ToBool() || Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
+		return true;
+	});
+
+	MaterialPropertyHandlers.Add(TEXT("AllowNegativeEmissiveColor"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
+	{
+		Mat->bAllowNegativeEmissiveColor = Value.ToBool() || Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
+		return true;
+	});
+
+	MaterialPropertyHandlers.Add(TEXT("OpacityMaskClipValue"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
+	{
+		Mat->OpacityMaskClipValue = FCString::Atof(*Value);
+		return true;
+	});
+}
+
 // =========================================================================
 // FMaterialAction - Base Class
 // =========================================================================
@@ -473,7 +536,7 @@ bool FAddMaterialExpressionAction::Validate(const TSharedPtr<FJsonObject>& Param
 	return true;
 }
 
-void FAddMaterialExpressionAction::SetExpressionProperties(UMaterialExpression* Expression, const TSharedPtr<FJsonObject>& Properties) const
+void FMaterialAction::SetExpressionProperties(UMaterialExpression* Expression, const TSharedPtr<FJsonObject>& Properties) const
 {
 	if (!Properties.IsValid() || !Expression) return;
 
@@ -676,7 +739,7 @@ bool FConnectMaterialExpressionsAction::Validate(const TSharedPtr<FJsonObject>&
 	return true;
 }
 
-bool FConnectMaterialExpressionsAction::ConnectToExpressionInput(UMaterialExpression* SourceExpr, int32 OutputIndex,
+bool FMaterialAction::ConnectToExpressionInput(UMaterialExpression* SourceExpr, int32 OutputIndex,
 	UMaterialExpression* TargetExpr, const FString& InputName, FString& OutError) const
 {
 	// Handle common expression types with named inputs
@@ -926,7 +989,7 @@ bool FConnectToMaterialOutputAction::Validate(const TSharedPtr<FJsonObject>& Par
 	return true;
 }
 
-bool FConnectToMaterialOutputAction::ConnectToMaterialProperty(UMaterial* Material, UMaterialExpression* SourceExpr,
+bool FMaterialAction::ConnectToMaterialProperty(UMaterial* Material, UMaterialExpression* SourceExpr,
 	int32 OutputIndex, const FString& PropertyName, FString& OutError) const
 {
 	// Get editor-only data for main material outputs
@@ -1193,6 +1256,14 @@ TSharedPtr<FJsonObject> FCompileMaterialAction::ExecuteInternal(const TSharedPtr
 	// Force recompile for rendering (async shader compilation)
 	Material->ForceRecompileForRendering();
 
+	// As an async job, stay open until the shaders have finished compiling
+	TWeakObjectPtr<UMaterial> WeakMaterial(Material);
+	Context.CompleteJobWhen([WeakMaterial]()
+	{
+		const UMaterial* CompiledMaterial = WeakMaterial.Get();
+		return !CompiledMaterial || !CompiledMaterial->IsCompiling();
+	}, TEXT("compiling_shaders"));
+
 	// Reregister all components using this material
 	FGlobalComponentReregisterContext RecreateComponents;
 
@@ -1210,6 +1281,293 @@ TSharedPtr<FJsonObject> FCompileMaterialAction::ExecuteInternal(const TSharedPtr
 	return CreateSuccessResponse(Result);
 }
 
+// =========================================================================
+// FBuildMaterialGraphAction
+// =========================================================================
+
+bool FBuildMaterialGraphAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPBuildMaterialGraphParams& Args, FMCPEditorContext& Context, FString& OutError)
+{
+	// Material properties must have a known handler
+	const TSharedPtr<FJsonObject>* PropsObj = nullptr;
+	if (Params->TryGetObjectField(TEXT("material_properties"), PropsObj))
+	{
+		InitMaterialPropertyHandlers();
+		for (const auto& Pair : (*PropsObj)->Values)
+		{
+			if (!MaterialPropertyHandlers.Contains(Pair.Key))
+			{
+				OutError = FString::Printf(TEXT("Unknown material property '%s'. Supported: ShadingModel, TwoSided, BlendMode, DitheredLODTransition, AllowNegativeEmissiveColor, OpacityMaskClipValue"), *Pair.Key);
+				return false;
+			}
+		}
+	}
+
+	// Expressions need a unique name and a resolvable class (presence is checked by the params metadata)
+	TSet<FString> Names;
+	for (int32 i = 0; i < Args.Expressions.Num(); ++i)
+	{
+		const FMCPMaterialExpressionSpec& Expression = Args.Expressions[i];
+		if (Names.Contains(Expression.Name))
+		{
+			OutError = FString::Printf(TEXT("Duplicate expression name '%s'"), *Expression.Name);
+			return false;
+		}
+		if (!ResolveExpressionClass(Expression.ClassName))
+		{
+			OutError = FString::Printf(TEXT("expressions[%d]: unknown expression class '%s'"), i, *Expression.ClassName);
+			return false;
+		}
+		Names.Add(Expression.Name);
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonObject> FBuildMaterialGraphAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPBuildMaterialGraphParams& Args, FMCPEditorContext& Context)
+{
+	FString Error;
+	const FString& MaterialName = Args.MaterialName;
+
+	// Resolve the material once for the whole build
+	UMaterial* Material = FindMaterial(MaterialName, Error);
+	if (!Material)
+	{
+		return CreateErrorResponse(Error, TEXT("material_not_found"));
+	}
+
+	// Switch first: SetCurrentMaterial clears the session node map when the material changes
+	Context.SetCurrentMaterial(Material);
+
+	// Single pass over the existing graph: index expressions by Desc and parameter name
+	TMap<FString, UMaterialExpression*> NodesByName;
+	TMap<const UMaterialExpression*, FString> NamesByNode;
+	for (UMaterialExpression* Expr : Material->GetExpressionCollection().Expressions)
+	{
+		if (!Expr) continue;
+
+		const FName ParameterName = Expr->GetParameterName();
+		if (ParameterName != NAME_None)
+		{
+			NodesByName.Add(ParameterName.ToString(), Expr);
+			NamesByNode.Add(Expr, ParameterName.ToString());
+		}
+		if (!Expr->Desc.IsEmpty())
+		{
+			NodesByName.Add(Expr->Desc, Expr);
+			NamesByNode.Add(Expr, Expr->Desc);
+		}
+	}
+
+	// Session-registered names take precedence over Desc / parameter names
+	for (const auto& Pair : Context.MaterialNodeMap)
+	{
+		if (UMaterialExpression* Expr = Pair.Value.Get())
+		{
+			NodesByName.Add(Pair.Key, Expr);
+			NamesByNode.Add(Expr, Pair.Key);
+		}
+	}
+
+	// Check names and references before touching the material
+	TSet<FString> NewNames;
+	for (const FMCPMaterialExpressionSpec& Expression : Args.Expressions)
+	{
+		if (Context.GetMaterialNode(Expression.Name))
+		{
+			return CreateErrorResponse(
+				FString::Printf(TEXT("Node name '%s' already exists. Use a unique name."), *Expression.Name),
+				TEXT("duplicate_node_name"));
+		}
+		NewNames.Add(Expression.Name);
+	}
+
+	// Returns true (with OutName) if Name resolves to nothing
+	auto IsUnknownNode = [&](const FString& Name, FString& OutName) -> bool
+	{
+		if (!NewNames.Contains(Name) && !NodesByName.Contains(Name) && !Context.GetMaterialNode(Name))
+		{
+			OutName = Name;
+			return true;
+		}
+		return false;
+	};
+
+	FString UnknownNode;
+	bool bHasUnknownNode = false;
+	for (const FMCPMaterialConnectionSpec& Connection : Args.Connections)
+	{
+		bHasUnknownNode = bHasUnknownNode || IsUnknownNode(Connection.Source, UnknownNode) || IsUnknownNode(Connection.Target, UnknownNode);
+	}
+	for (const FMCPMaterialOutputSpec& Output : Args.Outputs)
+	{
+		bHasUnknownNode = bHasUnknownNode || IsUnknownNode(Output.Source, UnknownNode);
+	}
+	if (bHasUnknownNode)
+	{
+		return CreateErrorResponse(
+			FString::Printf(TEXT("Node '%s' not found in material '%s' or in this request"), *UnknownNode, *MaterialName),
+			TEXT("node_not_found"));
+	}
+
+	// Last point before the material changes
+	if (Context.IsCancelRequested())
+	{
+		return CreateErrorResponse(FString::Printf(TEXT("Cancelled before building material '%s'"), *MaterialName), TEXT("cancelled"));
+	}
+
+	// Material-level properties
+	const TSharedPtr<FJsonObject>* PropsObj = nullptr;
+	if (Params->TryGetObjectField(TEXT("material_properties"), PropsObj))
+	{
+		InitMaterialPropertyHandlers();
+		for (const auto& Pair : (*PropsObj)->Values)
+		{
+			if (!MaterialPropertyHandlers[Pair.Key](Material, Pair.Value->AsString(), Error))
+			{
+				return CreateErrorResponse(Error, TEXT("property_set_failed"));
+			}
+		}
+	}
+
+	// Create expressions
+	// Expression properties are untyped, so they come from the raw entries (decoding checked each is an object)
+	const TArray<TSharedPtr<FJsonValue>>* RawExpressions = GetOptionalArray(Params, TEXT("expressions"));
+	TArray<TSharedPtr<FJsonValue>> CreatedNodes;
+	for (int32 i = 0; i < Args.Expressions.Num(); ++i)
+	{
+		const FMCPMaterialExpressionSpec& Expression = Args.Expressions[i];
+		const FString& Name = Expression.Name;
+
+		UMaterialExpression* NewExpr = NewObject<UMaterialExpression>(Material, ResolveExpressionClass(Expression.ClassName));
+		if (!NewExpr)
+		{
+			return CreateErrorResponse(
+				FString::Printf(TEXT("Failed to create material expression '%s'"), *Name),
+				TEXT("creation_failed"));
+		}
+
+		if (Expression.Position.Num() >= 2)
+		{
+			NewExpr->MaterialExpressionEditorX = Expression.Position[0];
+			NewExpr->MaterialExpressionEditorY = Expression.Position[1];
+		}
+
+		Material->GetExpressionCollection().AddExpression(NewExpr);
+
+		const TSharedPtr<FJsonObject>* ExprProps = nullptr;
+		if (RawExpressions && (*RawExpressions)[i]->AsObject()->TryGetObjectField(TEXT("properties"), ExprProps))
+		{
+			SetExpressionProperties(NewExpr, *ExprProps);
+		}
+
+		NodesByName.Add(Name, NewExpr);
+		NamesByNode.Add(NewExpr, Name);
+		Context.RegisterMaterialNode(Name, NewExpr);
+		CreatedNodes.Add(MakeShared<FJsonValueString>(Name));
+	}
+
+	auto FindNode = [&](const FString& Name) -> UMaterialExpression*
+	{
+		if (UMaterialExpression** Found = NodesByName.Find(Name))
+		{
+			return *Found;
+		}
+		return Context.GetMaterialNode(Name);
+	};
+
+	// Wire connections and outputs; failures are reported per link rather than aborting the build
+	TArray<TSharedPtr<FJsonValue>> LinkErrors;
+	auto AddLinkError = [&LinkErrors](const TCHAR* Kind, int32 Index, const FString& Message)
+	{
+		TSharedPtr<FJsonObject> ErrObj = MakeShared<FJsonObject>();
+		ErrObj->SetStringField(TEXT("kind"), Kind);
+		ErrObj->SetNumberField(TEXT("index"), Index);
+		ErrObj->SetStringField(TEXT("error"), Message);
+		LinkErrors.Add(MakeShared<FJsonValueObject>(ErrObj));
+	};
+
+	int32 ConnectionCount = 0;
+	for (int32 i = 0; i < Args.Connections.Num(); ++i)
+	{
+		const FMCPMaterialConnectionSpec& Connection = Args.Connections[i];
+		if (ConnectToExpressionInput(
+				FindNode(Connection.Source), Connection.SourceOutputIndex,
+				FindNode(Connection.Target), Connection.TargetInput, Error))
+		{
+			++ConnectionCount;
+		}
+		else
+		{
+			AddLinkError(TEXT("connection"), i, Error);
+		}
+	}
+
+	int32 OutputCount = 0;
+	for (int32 i = 0; i < Args.Outputs.Num(); ++i)
+	{
+		const FMCPMaterialOutputSpec& Output = Args.Outputs[i];
+		if (ConnectToMaterialProperty(Material, FindNode(Output.Source), Output.SourceOutputIndex,
+				Output.MaterialProperty, Error))
+		{
+			++OutputCount;
+		}
+		else
+		{
+			AddLinkError(TEXT("output"), i, Error);
+		}
+	}
+
+	// Recompile exactly once for the whole build
+	MarkMaterialModified(Material, Context);
+
+	// Collect compile errors and map them back to node names
+	TArray<TSharedPtr<FJsonValue>> CompileErrors;
+	if (Args.bWaitForCompile)
+	{
+		if (FMaterialResource* Resource = Material->GetMaterialResource(GMaxRHIFeatureLevel))
+		{
+			Resource->FinishCompilation();
+
+			const TArray<FString>& Messages = Resource->GetCompileErrors();
+			const TArray<TObjectPtr<UMaterialExpression>>& ErrorExpressions = Resource->GetErrorExpressions();
+			for (int32 i = 0; i < Messages.Num(); ++i)
+			{
+				TSharedPtr<FJsonObject> ErrObj = MakeShared<FJsonObject>();
+				ErrObj->SetStringField(TEXT("message"), Messages[i]);
+
+				// Error expressions are recorded in step with the messages when the translator knows the source node
+				if (Messages.Num() == ErrorExpressions.Num() && ErrorExpressions[i])
+				{
+					const FString* NodeName = NamesByNode.Find(ErrorExpressions[i].Get());
+					ErrObj->SetStringField(TEXT("node"), NodeName ? *NodeName : ErrorExpressions[i]->GetName());
+				}
+				CompileErrors.Add(MakeShared<FJsonValueObject>(ErrObj));
+			}
+		}
+	}
+	else
+	{
+		// As an async job, stay open until the shaders have finished compiling
+		TWeakObjectPtr<UMaterial> WeakMaterial(Material);
+		Context.CompleteJobWhen([WeakMaterial]()
+		{
+			const UMaterial* CompiledMaterial = WeakMaterial.Get();
+			return !CompiledMaterial || !CompiledMaterial->IsCompiling();
+		}, TEXT("compiling_shaders"));
+	}
+
+	// Build response
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("material"), Material->GetName());
+	Result->SetArrayField(TEXT("nodes"), CreatedNodes);
+	Result->SetNumberField(TEXT("connections"), ConnectionCount);
+	Result->SetNumberField(TEXT("outputs"), OutputCount);
+	Result->SetArrayField(TEXT("link_errors"), LinkErrors);
+	Result->SetArrayField(TEXT("compile_errors"), CompileErrors);
+
+	return CreateSuccessResponse(Result);
+}
+
 // =========================================================================
 // FCreateMaterialInstanceAction
 // =========================================================================
@@ -1339,16 +1697,6 @@ bool FSetMaterialPropertyAction::Validate(const TSharedPtr<FJsonObject>& Params,
 	return true;
 }
 
-TOptional<EMaterialShadingModel> FSetMaterialPropertyAction::ResolveShadingModel(const FString& ShadingModelString) const
-{
-	InitShadingModelMap();
-	if (EMaterialShadingModel* Found = ShadingModelMap.Find(ShadingModelString))
-	{
-		return *Found;
-	}
-	return TOptional<EMaterialShadingModel>();
-}
-
 TSharedPtr<FJsonObject> FSetMaterialPropertyAction::ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
 {
 	FString Error;
@@ -1364,63 +1712,9 @@ TSharedPtr<FJsonObject> FSetMaterialPropertyAction::ExecuteInternal(const TShare
 		return CreateErrorResponse(Error, TEXT("material_not_found"));
 	}
 
-	// Property handlers map (property name -> handler lambda)
-	using FPropertyHandler = TFunction<bool(UMaterial*, const FString&, FString&)>;
-	static TMap<FString, FPropertyHandler> PropertyHandlers;
-
-	if (PropertyHandlers.Num() == 0)
-	{
-		PropertyHandlers.Add(TEXT("ShadingModel"), [this](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
-		{
-			TOptional<EMaterialShadingModel> Model = ResolveShadingModel(Value);
-			if (!Model.IsSet())
-			{
-				OutErr = FString::Printf(TEXT("Invalid ShadingModel '%s'. Valid: Unlit, DefaultLit, Subsurface, PreintegratedSkin, ClearCoat, SubsurfaceProfile, TwoSidedFoliage, Hair, Cloth, Eye"), *Value);
-				return false;
-			}
-			Mat->SetShadingModel(Model.GetValue());
-			return true;
-		});
-
-		PropertyHandlers.Add(TEXT("TwoSided"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
-		{
-			Mat->TwoSided = Value.ToBool() || Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
-			return true;
-		});
-
-		PropertyHandlers.Add(TEXT("BlendMode"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
-		{
-			InitBlendModeMap();
-			if (EBlendMode* Found = BlendModeMap.Find(Value))
-			{
-				Mat->BlendMode = *Found;
-				return true;
-			}
-			OutErr = FString::Printf(TEXT("Invalid BlendMode '%s'. Valid: Opaque, Masked, Translucent, Additive, Modulate, AlphaComposite, AlphaHoldout"), *Value);
-			return false;
-		});
-
-		PropertyHandlers.Add(TEXT("DitheredLODTransition"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
-		{
-			Mat->DitheredLODTransition = Value.ToBool() || Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
-			return true;
-		});
-
-		PropertyHandlers.Add(TEXT("AllowNegativeEmissiveColor"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
-		{
-			Mat->bAllowNegativeEmissiveColor = Value.ToBool() || Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value == TEXT("1");
-			return true;
-		});
-
-		PropertyHandlers.Add(TEXT("OpacityMaskClipValue"), [](UMaterial* Mat, const FString& Value, FString& OutErr) -> bool
-		{
-			Mat->OpacityMaskClipValue = FCString::Atof(*Value);
-			return true;
-		});
-	}
-
 	// Find and execute the property handler
-	FPropertyHandler* Handler = PropertyHandlers.Find(PropertyName);
+	InitMaterialPropertyHandlers();
+	FMaterialPropertyHandler* Handler = MaterialPropertyHandlers.Find(PropertyName);
 	if (!Handler)
 	{
 		return CreateErrorResponse(
@@ -1534,7 +1828,7 @@ TSharedPtr<FJsonObject> FCreatePostProcessVolumeAction::ExecuteInternal(const TS
 			}
 			else
 			{
-				UE_LOG(LogTemp, Warning, TEXT("FCreatePostProcessVolumeAction: Material '%s' not found"), *MatName);
+				UE_LOG(LogUEBlueprintMCP, Warning, TEXT("FCreatePostProcessVolumeAction: Material '%s' not found"), *MatName);
 			}
 		}
 	}
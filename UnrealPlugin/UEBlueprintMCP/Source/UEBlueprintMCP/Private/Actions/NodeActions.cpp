@@ -2,6 +2,7 @@
 
 #include "Actions/NodeActions.h"
 #include "MCPCommonUtils.h"
+#include "MCPTrace.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "EdGraph/EdGraph.h"
@@ -33,27 +34,79 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputAction.h"
+#include "ScopedTransaction.h"
+#include "Editor/Transactor.h"
+#include "Editor.h"
+#include "MCPBridge.h"
+#include "MCPLog.h"
+
+// Helper to journal the links of a pin that are gone, against the output side like LinkAdded
+static void RecordRemovedLinks(FMCPEditorContext& Context, const UEdGraphPin* Pin, const TArray<UEdGraphPin*>& PreviousLinks)
+{
+	for (const UEdGraphPin* Linked : PreviousLinks)
+	{
+		if (!Linked || Pin->LinkedTo.Contains(Linked))
+		{
+			continue;
+		}
+		const UEdGraphPin* FromPin = Pin->Direction == EGPD_Output ? Pin : Linked;
+		const UEdGraphPin* ToPin = FromPin == Pin ? Linked : Pin;
+		Context.RecordNodeChange(EMCPChangeKind::LinkRemoved, FromPin->GetOwningNode(),
+			FString::Printf(TEXT("%s->%s.%s"), *FromPin->PinName.ToString(), *ToPin->GetOwningNode()->NodeGuid.ToString(), *ToPin->PinName.ToString()));
+	}
+}
+
+// Helper to break every link of a node that is about to be removed, journaling each one
+static void BreakAndRecordNodeLinks(FMCPEditorContext& Context, UEdGraphNode* Node)
+{
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		const TArray<UEdGraphPin*> PreviousLinks = Pin->LinkedTo;
+		Pin->BreakAllPinLinks();
+		RecordRemovedLinks(Context, Pin, PreviousLinks);
+	}
+}
+
+// Helper to set a pin default - object pins are loaded, everything else is stored as string
+static bool ApplyPinDefaultValue(UEdGraphPin* Pin, const FString& DefaultValue, FString& OutError)
+{
+	if (Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Object ||
+		Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Class ||
+		Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftObject ||
+		Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftClass)
+	{
+		UObject* LoadedObject = StaticLoadObject(UObject::StaticClass(), nullptr, *DefaultValue);
+		if (!LoadedObject)
+		{
+			OutError = FString::Printf(TEXT("Failed to load object: %s"), *DefaultValue);
+			return false;
+		}
+		Pin->DefaultObject = LoadedObject;
+		Pin->DefaultValue.Empty();
+	}
+	else
+	{
+		Pin->DefaultValue = DefaultValue;
+	}
+	return true;
+}
+
 
 // ============================================================================
 // Graph Operations (connect, find, delete, inspect)
 // ============================================================================
 
-bool FConnectBlueprintNodesAction::Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError)
+bool FConnectBlueprintNodesAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPConnectBlueprintNodesParams& Args, FMCPEditorContext& Context, FString& OutError)
 {
-	FString SourceNodeId, TargetNodeId, SourcePin, TargetPin;
-	if (!GetRequiredString(Params, TEXT("source_node_id"), SourceNodeId, OutError)) return false;
-	if (!GetRequiredString(Params, TEXT("target_node_id"), TargetNodeId, OutError)) return false;
-	if (!GetRequiredString(Params, TEXT("source_pin"), SourcePin, OutError)) return false;
-	if (!GetRequiredString(Params, TEXT("target_pin"), TargetPin, OutError)) return false;
 	return ValidateGraph(Params, Context, OutError);
 }
 
-TSharedPtr<FJsonObject> FConnectBlueprintNodesAction::ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
+TSharedPtr<FJsonObject> FConnectBlueprintNodesAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPConnectBlueprintNodesParams& Args, FMCPEditorContext& Context)
 {
-	FString SourceNodeId = Params->GetStringField(TEXT("source_node_id"));
-	FString TargetNodeId = Params->GetStringField(TEXT("target_node_id"));
-	FString SourcePinName = Params->GetStringField(TEXT("source_pin"));
-	FString TargetPinName = Params->GetStringField(TEXT("target_pin"));
+	const FString& SourceNodeId = Args.SourceNodeId;
+	const FString& TargetNodeId = Args.TargetNodeId;
+	const FString& SourcePinName = Args.SourcePin;
+	const FString& TargetPinName = Args.TargetPin;
 
 	UBlueprint* Blueprint = GetTargetBlueprint(Params, Context);
 	UEdGraph* TargetGraph = GetTargetGraph(Params, Context);
@@ -117,12 +170,20 @@ TSharedPtr<FJsonObject> FConnectBlueprintNodesAction::ExecuteInternal(const TSha
 	const UEdGraphSchema* Schema = TargetGraph->GetSchema();
 	if (Schema)
 	{
+		// The schema breaks existing links on pins that only take one
+		const TArray<UEdGraphPin*> PreviousSourceLinks = SourcePin->LinkedTo;
+		const TArray<UEdGraphPin*> PreviousTargetLinks = TargetPin->LinkedTo;
+
 		bool bResult = Schema->TryCreateConnection(SourcePin, TargetPin);
 		if (bResult)
 		{
 			SourceNode->PinConnectionListChanged(SourcePin);
 			TargetNode->PinConnectionListChanged(TargetPin);
 			MarkBlueprintModified(Blueprint, Context);
+			RecordRemovedLinks(Context, SourcePin, PreviousSourceLinks);
+			RecordRemovedLinks(Context, TargetPin, PreviousTargetLinks);
+			Context.RecordNodeChange(EMCPChangeKind::LinkAdded, SourceNode,
+				FString::Printf(TEXT("%s->%s.%s"), *SourcePin->PinName.ToString(), *TargetNodeId, *TargetPin->PinName.ToString()));
 
 			TSharedPtr<FJsonObject> ResultData = MakeShared<FJsonObject>();
 			ResultData->SetStringField(TEXT("source_node_id"), SourceNodeId);
@@ -259,11 +320,11 @@ TSharedPtr<FJsonObject> FDeleteBlueprintNodeAction::ExecuteInternal(const TShare
 	FString NodeClass = NodeToDelete->GetClass()->GetName();
 	FString NodeTitle = NodeToDelete->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
 
+	// Journal before removal while the node still knows its graph
+	Context.RecordNodeChange(EMCPChangeKind::NodeRemoved, NodeToDelete, NodeClass);
+
 	// Break all pin connections
-	for (UEdGraphPin* Pin : NodeToDelete->Pins)
-	{
-		Pin->BreakAllPinLinks();
-	}
+	BreakAndRecordNodeLinks(Context, NodeToDelete);
 
 	// Remove from graph
 	TargetGraph->RemoveNode(NodeToDelete);
@@ -332,6 +393,641 @@ TSharedPtr<FJsonObject> FGetNodePinsAction::ExecuteInternal(const TSharedPtr<FJs
 }
 
 
+bool FExportGraphAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPExportGraphParams& Args, FMCPEditorContext& Context, FString& OutError)
+{
+	if (Args.bAllGraphs)
+	{
+		return ValidateBlueprint(Params, Context, OutError);
+	}
+	return ValidateGraph(Params, Context, OutError);
+}
+
+TSharedPtr<FJsonObject> FExportGraphAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPExportGraphParams& Args, FMCPEditorContext& Context)
+{
+	const bool bAllGraphs = Args.bAllGraphs;
+	const bool bIncludeHidden = Args.bIncludeHidden;
+
+	UBlueprint* Blueprint = GetTargetBlueprint(Params, Context);
+
+	TArray<UEdGraph*> Graphs;
+	if (bAllGraphs)
+	{
+		Blueprint->GetAllGraphs(Graphs);
+	}
+	else
+	{
+		Graphs.Add(GetTargetGraph(Params, Context));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> GraphsArray;
+	GraphsArray.Reserve(Graphs.Num());
+	for (UEdGraph* Graph : Graphs)
+	{
+		if (Graph)
+		{
+			GraphsArray.Add(MakeShared<FJsonValueObject>(ExportGraph(Graph, bIncludeHidden)));
+		}
+	}
+
+	// Column layouts are shared by every graph in the response
+	auto MakeColumns = [](std::initializer_list<const TCHAR*> Names)
+	{
+		TArray<TSharedPtr<FJsonValue>> Columns;
+		for (const TCHAR* Name : Names)
+		{
+			Columns.Add(MakeShared<FJsonValueString>(Name));
+		}
+		return Columns;
+	};
+
+	TSharedPtr<FJsonObject> ResultData = MakeShared<FJsonObject>();
+	ResultData->SetStringField(TEXT("blueprint"), Blueprint->GetName());
+	ResultData->SetArrayField(TEXT("node_columns"), MakeColumns({ TEXT("guid"), TEXT("class"), TEXT("title"), TEXT("x"), TEXT("y") }));
+	ResultData->SetArrayField(TEXT("pin_columns"), MakeColumns({ TEXT("node"), TEXT("name"), TEXT("direction"), TEXT("category"), TEXT("sub_type"), TEXT("default") }));
+	ResultData->SetArrayField(TEXT("link_columns"), MakeColumns({ TEXT("from_pin"), TEXT("to_pin") }));
+	ResultData->SetArrayField(TEXT("graphs"), GraphsArray);
+	if (Context.ChangeJournal.IsValid())
+	{
+		ResultData->SetNumberField(TEXT("revision"), static_cast<double>(Context.ChangeJournal->GetRevision()));
+		ResultData->SetStringField(TEXT("epoch"), Context.ChangeJournal->GetEpoch().ToString());
+	}
+	return CreateSuccessResponse(ResultData);
+}
+
+TSharedPtr<FJsonObject> FExportGraphAction::ExportGraph(UEdGraph* Graph, bool bIncludeHidden) const
+{
+	TArray<TSharedPtr<FJsonValue>> NodeRows;
+	TArray<TSharedPtr<FJsonValue>> PinRows;
+	TArray<TSharedPtr<FJsonValue>> LinkRows;
+	NodeRows.Reserve(Graph->Nodes.Num());
+	PinRows.Reserve(Graph->Nodes.Num() * 4);
+
+	// Single pass: assign row indices to nodes and pins
+	TMap<const UEdGraphPin*, int32> PinIndices;
+	TArray<const UEdGraphPin*> OutputPins;
+	PinIndices.Reserve(Graph->Nodes.Num() * 4);
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node) continue;
+
+		const int32 NodeIndex = NodeRows.Num();
+
+		TArray<TSharedPtr<FJsonValue>> NodeRow;
+		NodeRow.Reserve(5);
+		NodeRow.Add(MakeShared<FJsonValueString>(Node->NodeGuid.ToString()));
+		NodeRow.Add(MakeShared<FJsonValueString>(Node->GetClass()->GetName()));
+		NodeRow.Add(MakeShared<FJsonValueString>(Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString()));
+		NodeRow.Add(MakeShared<FJsonValueNumber>(Node->NodePosX));
+		NodeRow.Add(MakeShared<FJsonValueNumber>(Node->NodePosY));
+		NodeRows.Add(MakeShared<FJsonValueArray>(NodeRow));
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || (Pin->bHidden && !bIncludeHidden)) continue;
+
+			FString SubType;
+			if (UObject* SubObject = Pin->PinType.PinSubCategoryObject.Get())
+			{
+				SubType = SubObject->GetName();
+			}
+			else if (Pin->PinType.PinSubCategory != NAME_None)
+			{
+				SubType = Pin->PinType.PinSubCategory.ToString();
+			}
+
+			FString Default;
+			if (Pin->DefaultObject)
+			{
+				Default = Pin->DefaultObject->GetPathName();
+			}
+			else if (!Pin->DefaultTextValue.IsEmpty())
+			{
+				Default = Pin->DefaultTextValue.ToString();
+			}
+			else
+			{
+				Default = Pin->DefaultValue;
+			}
+
+			TArray<TSharedPtr<FJsonValue>> PinRow;
+			PinRow.Reserve(6);
+			PinRow.Add(MakeShared<FJsonValueNumber>(NodeIndex));
+			PinRow.Add(MakeShared<FJsonValueString>(Pin->PinName.ToString()));
+			PinRow.Add(MakeShared<FJsonValueString>(Pin->Direction == EGPD_Input ? TEXT("in") : TEXT("out")));
+			PinRow.Add(MakeShared<FJsonValueString>(Pin->PinType.PinCategory.ToString()));
+			PinRow.Add(MakeShared<FJsonValueString>(SubType));
+			PinRow.Add(MakeShared<FJsonValueString>(Default));
+
+			PinIndices.Add(Pin, PinRows.Num());
+			PinRows.Add(MakeShared<FJsonValueArray>(PinRow));
+
+			if (Pin->Direction == EGPD_Output && Pin->LinkedTo.Num() > 0)
+			{
+				OutputPins.Add(Pin);
+			}
+		}
+	}
+
+	// Links are emitted once, from the output side
+	for (const UEdGraphPin* Pin : OutputPins)
+	{
+		const int32 PinIndex = PinIndices.FindChecked(Pin);
+		for (const UEdGraphPin* Linked : Pin->LinkedTo)
+		{
+			if (const int32* LinkedIndex = PinIndices.Find(Linked))
+			{
+				TArray<TSharedPtr<FJsonValue>> LinkRow;
+				LinkRow.Add(MakeShared<FJsonValueNumber>(PinIndex));
+				LinkRow.Add(MakeShared<FJsonValueNumber>(*LinkedIndex));
+				LinkRows.Add(MakeShared<FJsonValueArray>(LinkRow));
+			}
+		}
+	}
+
+	TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
+	GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+	GraphObj->SetArrayField(TEXT("nodes"), NodeRows);
+	GraphObj->SetArrayField(TEXT("pins"), PinRows);
+	GraphObj->SetArrayField(TEXT("links"), LinkRows);
+	return GraphObj;
+}
+
+
+// ============================================================================
+// Graph Patch (declarative batch edit)
+// ============================================================================
+
+// add_nodes entries dispatch to the bridge's registered node-creating actions
+static TSharedPtr<FEditorAction> FindPatchNodeAction(const FString& ActionName)
+{
+	UMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UMCPBridge>() : nullptr;
+	const TSharedRef<FEditorAction>* Action = Bridge ? Bridge->GetActions().Find(ActionName) : nullptr;
+	if (!Action || !(*Action)->CreatesGraphNode())
+	{
+		return nullptr;
+	}
+	return *Action;
+}
+
+static FString ListPatchNodeActions()
+{
+	TArray<FString> Names;
+	if (UMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UMCPBridge>() : nullptr)
+	{
+		for (const TPair<FString, TSharedRef<FEditorAction>>& Pair : Bridge->GetActions())
+		{
+			if (Pair.Value->CreatesGraphNode())
+			{
+				Names.Add(Pair.Key);
+			}
+		}
+	}
+	Names.Sort();
+	return FString::Join(Names, TEXT(", "));
+}
+
+/** Working state for one apply_graph_patch run */
+struct FGraphPatchState
+{
+	/** Client-local id -> created node GUID */
+	TMap<FString, FGuid> LocalIds;
+
+	/** GUID -> node, built once so ops don't rescan Graph->Nodes */
+	TMap<FGuid, UEdGraphNode*> NodeIndex;
+
+	/** Description of the op that failed, e.g. "connections[3]" */
+	FString FailedOp;
+
+	/** The patch stopped because the request was cancelled or timed out */
+	bool bCancelled = false;
+
+	/** The patch stopped at an op that is no longer valid (add_nodes action not registered) */
+	bool bInvalidOp = false;
+
+	int32 Deleted = 0;
+	int32 Added = 0;
+	int32 Moved = 0;
+	int32 PinDefaults = 0;
+	int32 Connections = 0;
+};
+
+/** Remove the nodes a failed patch created, when its transaction can't be undone */
+static void RemovePatchCreatedNodes(UEdGraph* Graph, FMCPEditorContext& Context, FGraphPatchState& State)
+{
+	for (const TPair<FString, FGuid>& Pair : State.LocalIds)
+	{
+		UEdGraphNode* Node = State.NodeIndex.FindRef(Pair.Value);
+		if (!Node)
+		{
+			continue;
+		}
+		Context.RecordNodeChange(EMCPChangeKind::NodeRemoved, Node, Node->GetClass()->GetName());
+		BreakAndRecordNodeLinks(Context, Node);
+		Graph->RemoveNode(Node);
+		State.NodeIndex.Remove(Pair.Value);
+	}
+	State.LocalIds.Empty();
+}
+
+bool FApplyGraphPatchAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPApplyGraphPatchParams& Args, FMCPEditorContext& Context, FString& OutError)
+{
+	if (Args.AddNodes.Num() == 0 && Args.DeleteNodes.Num() == 0 && Args.MoveNodes.Num() == 0
+		&& Args.PinDefaults.Num() == 0 && Args.Connections.Num() == 0)
+	{
+		OutError = TEXT("Patch is empty: provide add_nodes, delete_nodes, move_nodes, pin_defaults or connections");
+		return false;
+	}
+
+	// Entry fields are checked by the params metadata; what's left is checked here so bad patches fail before the transaction opens
+	TSet<FString> SeenIds;
+	for (int32 i = 0; i < Args.AddNodes.Num(); ++i)
+	{
+		const FMCPGraphPatchAddNode& Add = Args.AddNodes[i];
+		if (SeenIds.Contains(Add.Id))
+		{
+			OutError = FString::Printf(TEXT("add_nodes[%d] reuses id '%s'"), i, *Add.Id);
+			return false;
+		}
+		SeenIds.Add(Add.Id);
+
+		if (!FindPatchNodeAction(Add.Action).IsValid())
+		{
+			OutError = FString::Printf(TEXT("add_nodes[%d] has unsupported action '%s'. Supported: %s"),
+				i, *Add.Action, *ListPatchNodeActions());
+			return false;
+		}
+		if (Add.Position.Num() == 1)
+		{
+			OutError = FString::Printf(TEXT("add_nodes[%d].position must be an [X, Y] array"), i);
+			return false;
+		}
+	}
+
+	for (int32 i = 0; i < Args.MoveNodes.Num(); ++i)
+	{
+		if (Args.MoveNodes[i].Position.Num() < 2)
+		{
+			OutError = FString::Printf(TEXT("move_nodes[%d].position must be an [X, Y] array"), i);
+			return false;
+		}
+	}
+
+	return ValidateGraph(Params, Context, OutError);
+}
+
+TSharedPtr<FJsonObject> FApplyGraphPatchAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPApplyGraphPatchParams& Args, FMCPEditorContext& Context)
+{
+	UBlueprint* Blueprint = GetTargetBlueprint(Params, Context);
+	UEdGraph* Graph = GetTargetGraph(Params, Context);
+	const bool bCompile = Args.bCompile;
+
+	FGraphPatchState State;
+	State.NodeIndex.Reserve(Graph->Nodes.Num());
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node)
+		{
+			State.NodeIndex.Add(Node->NodeGuid, Node);
+		}
+	}
+
+	// Sub-actions queue their MarkBlueprintModified calls; flushed once below.
+	// They also resolve the Blueprint through the context instead of an asset registry lookup per node.
+	const TWeakObjectPtr<UBlueprint> PreviousBlueprint = Context.CurrentBlueprint;
+	Context.CurrentBlueprint = Blueprint;
+	Context.bDeferBlueprintModified = true;
+
+	// Journal entries are held until the patch sticks; a rollback undoes what they describe
+	Context.bDeferJournal = true;
+
+	// Only a transaction this patch opened on its own may be undone: nested in an outer
+	// transaction, or with transacting off, nothing new lands on top of the undo stack
+	const FText TransactionTitle = NSLOCTEXT("UEBlueprintMCP", "ApplyGraphPatch", "MCP: Apply Graph Patch");
+	const int32 QueueLengthBefore = (GEditor && GEditor->Trans && !GEditor->IsTransactionActive()) ? GEditor->Trans->GetQueueLength() : INDEX_NONE;
+
+	FString Error;
+	bool bApplied = false;
+	{
+		FScopedTransaction Transaction(TransactionTitle);
+		Blueprint->Modify();
+		Graph->Modify();
+		bApplied = ApplyPatch(Params, Args, Graph, Context, State, Error);
+	}
+
+	Context.bDeferBlueprintModified = false;
+	Context.bDeferJournal = false;
+	Context.CurrentBlueprint = PreviousBlueprint;
+
+	if (!bApplied)
+	{
+		bool bRolledBack = false;
+		if (QueueLengthBefore != INDEX_NONE && GEditor->Trans->GetQueueLength() == QueueLengthBefore + 1)
+		{
+			const FTransaction* Top = GEditor->Trans->GetTransaction(QueueLengthBefore);
+			if (Top && Top->GetContext().Title.EqualTo(TransactionTitle))
+			{
+				bRolledBack = GEditor->UndoTransaction(false);
+			}
+		}
+
+		// Without our own transaction the ops that ran stay applied and are journaled
+		Context.FlushPendingChanges(!bRolledBack);
+		if (!bRolledBack)
+		{
+			RemovePatchCreatedNodes(Graph, Context, State);
+			UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: apply_graph_patch could not be undone (no transaction of its own); created nodes were removed, other ops before %s remain applied"), *State.FailedOp);
+			Error = FString::Printf(TEXT("%s. The patch could not be rolled back: created nodes were removed, ops before %s remain applied"), *Error, *State.FailedOp);
+		}
+
+		Context.PendingModifiedBlueprints.Empty();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+
+		if (bRolledBack)
+		{
+			UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: apply_graph_patch rolled back at %s: %s"), *State.FailedOp, *Error);
+		}
+
+		const TCHAR* ErrorType = State.bCancelled ? TEXT("cancelled") : State.bInvalidOp ? TEXT("validation_failed") : TEXT("patch_failed");
+		TSharedPtr<FJsonObject> ErrorResponse = CreateErrorResponse(Error, ErrorType);
+		ErrorResponse->SetStringField(TEXT("failed_op"), State.FailedOp);
+		ErrorResponse->SetBoolField(TEXT("rolled_back"), bRolledBack);
+		return ErrorResponse;
+	}
+
+	Context.FlushPendingChanges(true);
+
+	// Single modification notification per touched Blueprint
+	Context.PendingModifiedBlueprints.Add(Blueprint);
+	for (const TWeakObjectPtr<UBlueprint>& Pending : Context.PendingModifiedBlueprints)
+	{
+		if (UBlueprint* PendingBlueprint = Pending.Get())
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsModified(PendingBlueprint);
+		}
+	}
+	Context.PendingModifiedBlueprints.Empty();
+	Context.MarkPackageDirty(Blueprint->GetOutermost());
+
+	TSharedPtr<FJsonObject> ResultData = MakeShared<FJsonObject>();
+
+	if (bCompile)
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+		ResultData->SetBoolField(TEXT("compiled"), Blueprint->Status != BS_Error);
+	}
+
+	TSharedPtr<FJsonObject> NodeIds = MakeShared<FJsonObject>();
+	for (const TPair<FString, FGuid>& Pair : State.LocalIds)
+	{
+		NodeIds->SetStringField(Pair.Key, Pair.Value.ToString());
+	}
+
+	ResultData->SetObjectField(TEXT("node_ids"), NodeIds);
+	ResultData->SetNumberField(TEXT("deleted"), State.Deleted);
+	ResultData->SetNumberField(TEXT("added"), State.Added);
+	ResultData->SetNumberField(TEXT("moved"), State.Moved);
+	ResultData->SetNumberField(TEXT("pin_defaults"), State.PinDefaults);
+	ResultData->SetNumberField(TEXT("connections"), State.Connections);
+	return CreateSuccessResponse(ResultData);
+}
+
+bool FApplyGraphPatchAction::ApplyPatch(const TSharedPtr<FJsonObject>& Params, const FMCPApplyGraphPatchParams& Args, UEdGraph* Graph,
+	FMCPEditorContext& Context, FGraphPatchState& State, FString& OutError) const
+{
+	// Checked between steps; a cancelled patch is rolled back like a failed one
+	auto StopIfCancelled = [&Context, &State, &OutError](const TCHAR* NextStep) -> bool
+	{
+		if (!Context.IsCancelRequested())
+		{
+			return false;
+		}
+		State.bCancelled = true;
+		State.FailedOp = NextStep;
+		OutError = FString::Printf(TEXT("Cancelled before %s, patch rolled back"), NextStep);
+		return true;
+	};
+
+	// Step 1: Deletes
+	for (int32 i = 0; i < Args.DeleteNodes.Num(); ++i)
+	{
+		State.FailedOp = FString::Printf(TEXT("delete_nodes[%d]"), i);
+
+		UEdGraphNode* Node = ResolvePatchNode(Args.DeleteNodes[i], State, Context, OutError);
+		if (!Node) return false;
+
+		Context.RecordNodeChange(EMCPChangeKind::NodeRemoved, Node, Node->GetClass()->GetName());
+		Node->Modify();
+		BreakAndRecordNodeLinks(Context, Node);
+		Graph->RemoveNode(Node);
+		State.NodeIndex.Remove(Node->NodeGuid);
+		State.Deleted++;
+	}
+
+	if (StopIfCancelled(TEXT("add_nodes")))
+	{
+		return false;
+	}
+
+	// Step 2: Adds (through the regular node actions, without their auto-save)
+	// Their params are untyped, so they come from the raw entries (decoding checked each is an object)
+	const TArray<TSharedPtr<FJsonValue>>* RawAdds = GetOptionalArray(Params, TEXT("add_nodes"));
+	for (int32 i = 0; i < Args.AddNodes.Num(); ++i)
+	{
+		const FMCPGraphPatchAddNode& Add = Args.AddNodes[i];
+		State.FailedOp = FString::Printf(TEXT("add_nodes[%d] (%s)"), i, *Add.Id);
+
+		TSharedPtr<FJsonObject> NodeParams = MakeShared<FJsonObject>();
+		const TSharedPtr<FJsonObject>* EntryParams = nullptr;
+		if (RawAdds && (*RawAdds)[i]->AsObject()->TryGetObjectField(TEXT("params"), EntryParams))
+		{
+			NodeParams->Values = (*EntryParams)->Values;
+		}
+		NodeParams->RemoveField(TEXT("blueprint_name"));
+		if (!Args.GraphName.IsEmpty())
+		{
+			NodeParams->SetStringField(TEXT("graph_name"), Args.GraphName);
+		}
+		if (Add.Position.Num() > 0)
+		{
+			TArray<TSharedPtr<FJsonValue>> Position;
+			for (const double Coordinate : Add.Position)
+			{
+				Position.Add(MakeShared<FJsonValueNumber>(Coordinate));
+			}
+			NodeParams->SetArrayField(TEXT("node_position"), Position);
+		}
+
+		const TSharedPtr<FEditorAction> NodeAction = FindPatchNodeAction(Add.Action);
+		if (!NodeAction.IsValid())
+		{
+			OutError = FString::Printf(TEXT("Unsupported action '%s'"), *Add.Action);
+			State.bInvalidOp = true;
+			return false;
+		}
+		TSharedPtr<FJsonObject> NodeResult = NodeAction->ExecuteWithoutSave(NodeParams, Context);
+
+		bool bSuccess = false;
+		FString NodeIdString;
+		FGuid NodeGuid;
+		if (!NodeResult.IsValid() || !NodeResult->TryGetBoolField(TEXT("success"), bSuccess) || !bSuccess)
+		{
+			OutError = TEXT("Node action returned no result");
+			if (NodeResult.IsValid())
+			{
+				NodeResult->TryGetStringField(TEXT("error"), OutError);
+			}
+			return false;
+		}
+		if (!NodeResult->TryGetStringField(TEXT("node_id"), NodeIdString) || !FGuid::Parse(NodeIdString, NodeGuid))
+		{
+			OutError = FString::Printf(TEXT("Action '%s' did not report a node_id"), *Add.Action);
+			return false;
+		}
+
+		// Freshly spawned nodes sit at the end of Graph->Nodes
+		UEdGraphNode* CreatedNode = nullptr;
+		for (int32 NodeIdx = Graph->Nodes.Num() - 1; NodeIdx >= 0 && !CreatedNode; --NodeIdx)
+		{
+			UEdGraphNode* Candidate = Graph->Nodes[NodeIdx];
+			if (Candidate && Candidate->NodeGuid == NodeGuid)
+			{
+				CreatedNode = Candidate;
+			}
+		}
+		if (!CreatedNode)
+		{
+			OutError = FString::Printf(TEXT("Created node %s is not in graph '%s'"), *NodeIdString, *Graph->GetName());
+			return false;
+		}
+
+		State.LocalIds.Add(Add.Id, NodeGuid);
+		State.NodeIndex.Add(NodeGuid, CreatedNode);
+		State.Added++;
+	}
+
+	if (StopIfCancelled(TEXT("move_nodes")))
+	{
+		return false;
+	}
+
+	// Step 3: Moves
+	for (int32 i = 0; i < Args.MoveNodes.Num(); ++i)
+	{
+		const FMCPGraphPatchMoveNode& Move = Args.MoveNodes[i];
+		State.FailedOp = FString::Printf(TEXT("move_nodes[%d]"), i);
+
+		UEdGraphNode* Node = ResolvePatchNode(Move.Node, State, Context, OutError);
+		if (!Node) return false;
+
+		Node->Modify();
+		Node->NodePosX = static_cast<int32>(Move.Position[0]);
+		Node->NodePosY = static_cast<int32>(Move.Position[1]);
+		Context.RecordNodeChange(EMCPChangeKind::NodeMoved, Node);
+		State.Moved++;
+	}
+
+	// Step 4: Pin defaults
+	for (int32 i = 0; i < Args.PinDefaults.Num(); ++i)
+	{
+		const FMCPGraphPatchPinDefault& PinDefault = Args.PinDefaults[i];
+		State.FailedOp = FString::Printf(TEXT("pin_defaults[%d]"), i);
+
+		UEdGraphNode* Node = ResolvePatchNode(PinDefault.Node, State, Context, OutError);
+		if (!Node) return false;
+
+		UEdGraphPin* Pin = FMCPCommonUtils::FindPin(Node, PinDefault.Pin, EGPD_Input);
+		if (!Pin)
+		{
+			OutError = FString::Printf(TEXT("Pin not found: %s"), *PinDefault.Pin);
+			return false;
+		}
+
+		Node->Modify();
+		if (!ApplyPinDefaultValue(Pin, PinDefault.Value, OutError))
+		{
+			return false;
+		}
+		Context.RecordNodeChange(EMCPChangeKind::PinDefaultChanged, Node, PinDefault.Pin);
+		State.PinDefaults++;
+	}
+
+	if (StopIfCancelled(TEXT("connections")))
+	{
+		return false;
+	}
+
+	// Step 5: Connections
+	if (Args.Connections.Num() > 0)
+	{
+		const UEdGraphSchema* Schema = Graph->GetSchema();
+		if (!Schema)
+		{
+			OutError = TEXT("Failed to get graph schema");
+			return false;
+		}
+
+		for (int32 i = 0; i < Args.Connections.Num(); ++i)
+		{
+			const FMCPGraphPatchConnection& Connection = Args.Connections[i];
+			State.FailedOp = FString::Printf(TEXT("connections[%d]"), i);
+
+			UEdGraphNode* SourceNode = ResolvePatchNode(Connection.From, State, Context, OutError);
+			if (!SourceNode) return false;
+			UEdGraphNode* TargetNode = ResolvePatchNode(Connection.To, State, Context, OutError);
+			if (!TargetNode) return false;
+
+			UEdGraphPin* SourcePin = FMCPCommonUtils::FindPin(SourceNode, Connection.FromPin, EGPD_Output);
+			UEdGraphPin* TargetPin = FMCPCommonUtils::FindPin(TargetNode, Connection.ToPin, EGPD_Input);
+			if (!SourcePin || !TargetPin)
+			{
+				OutError = FString::Printf(TEXT("Pin not found: %s"), !SourcePin ? *Connection.FromPin : *Connection.ToPin);
+				return false;
+			}
+
+			const TArray<UEdGraphPin*> PreviousSourceLinks = SourcePin->LinkedTo;
+			const TArray<UEdGraphPin*> PreviousTargetLinks = TargetPin->LinkedTo;
+			if (!Schema->TryCreateConnection(SourcePin, TargetPin))
+			{
+				OutError = FString::Printf(
+					TEXT("Schema refused connection: '%s' (%s) -> '%s' (%s). Types may be incompatible."),
+					*SourcePin->PinName.ToString(), *SourcePin->PinType.PinCategory.ToString(),
+					*TargetPin->PinName.ToString(), *TargetPin->PinType.PinCategory.ToString());
+				return false;
+			}
+
+			SourceNode->PinConnectionListChanged(SourcePin);
+			TargetNode->PinConnectionListChanged(TargetPin);
+			RecordRemovedLinks(Context, SourcePin, PreviousSourceLinks);
+			RecordRemovedLinks(Context, TargetPin, PreviousTargetLinks);
+			Context.RecordNodeChange(EMCPChangeKind::LinkAdded, SourceNode,
+				FString::Printf(TEXT("%s->%s.%s"), *Connection.FromPin, *TargetNode->NodeGuid.ToString(), *Connection.ToPin));
+			State.Connections++;
+		}
+	}
+
+	State.FailedOp.Empty();
+	return true;
+}
+
+UEdGraphNode* FApplyGraphPatchAction::ResolvePatchNode(const FString& NodeRef, const FGraphPatchState& State,
+	const FMCPEditorContext& Context, FString& OutError) const
+{
+	// Client-local ids from add_nodes take precedence over GUIDs/aliases
+	const FGuid* LocalGuid = State.LocalIds.Find(NodeRef);
+	const FGuid NodeGuid = LocalGuid ? *LocalGuid : Context.ResolveNodeId(NodeRef);
+
+	UEdGraphNode* const* Node = NodeGuid.IsValid() ? State.NodeIndex.Find(NodeGuid) : nullptr;
+	if (!Node)
+	{
+		OutError = FString::Printf(TEXT("Node not found: '%s' (not a local id from add_nodes or a GUID in this graph)"), *NodeRef);
+		return nullptr;
+	}
+	return *Node;
+}
+
+
 // ============================================================================
 // Node Positioning
 // ============================================================================
@@ -380,6 +1076,7 @@ TSharedPtr<FJsonObject> FSetNodePositionAction::ExecuteInternal(const TSharedPtr
 	TargetNode->NodePosY = (int32)Position.Y;
 
 	MarkBlueprintModified(Blueprint, Context);
+	Context.RecordNodeChange(EMCPChangeKind::NodeMoved, TargetNode);
 
 	TSharedPtr<FJsonObject> ResultData = MakeShared<FJsonObject>();
 	ResultData->SetStringField(TEXT("node_id"), NodeId);
@@ -717,20 +1414,16 @@ TSharedPtr<FJsonObject> FAddBlueprintVariableSetAction::ExecuteInternal(const TS
 }
 
 
-bool FSetNodePinDefaultAction::Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError)
+bool FSetNodePinDefaultAction::ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSetNodePinDefaultParams& Args, FMCPEditorContext& Context, FString& OutError)
 {
-	FString NodeId, PinName, DefaultValue;
-	if (!GetRequiredString(Params, TEXT("node_id"), NodeId, OutError)) return false;
-	if (!GetRequiredString(Params, TEXT("pin_name"), PinName, OutError)) return false;
-	if (!GetRequiredString(Params, TEXT("default_value"), DefaultValue, OutError)) return false;
 	return ValidateGraph(Params, Context, OutError);
 }
 
-TSharedPtr<FJsonObject> FSetNodePinDefaultAction::ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context)
+TSharedPtr<FJsonObject> FSetNodePinDefaultAction::ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSetNodePinDefaultParams& Args, FMCPEditorContext& Context)
 {
-	FString NodeId = Params->GetStringField(TEXT("node_id"));
-	FString PinName = Params->GetStringField(TEXT("pin_name"));
-	FString DefaultValue = Params->GetStringField(TEXT("default_value"));
+	const FString& NodeId = Args.NodeId;
+	const FString& PinName = Args.PinName;
+	const FString& DefaultValue = Args.DefaultValue;
 
 	UBlueprint* Blueprint = GetTargetBlueprint(Params, Context);
 	UEdGraph* TargetGraph = GetTargetGraph(Params, Context);
@@ -758,29 +1451,14 @@ TSharedPtr<FJsonObject> FSetNodePinDefaultAction::ExecuteInternal(const TSharedP
 		return CreateErrorResponse(FString::Printf(TEXT("Pin not found: %s"), *PinName));
 	}
 
-	// Set the default value - handle object pins differently
-	if (TargetPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Object ||
-		TargetPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Class ||
-		TargetPin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftObject ||
-		TargetPin->PinType.PinCategory == UEdGraphSchema_K2::PC_SoftClass)
-	{
-		UObject* LoadedObject = StaticLoadObject(UObject::StaticClass(), nullptr, *DefaultValue);
-		if (LoadedObject)
-		{
-			TargetPin->DefaultObject = LoadedObject;
-			TargetPin->DefaultValue.Empty();
-		}
-		else
-		{
-			return CreateErrorResponse(FString::Printf(TEXT("Failed to load object: %s"), *DefaultValue));
-		}
-	}
-	else
+	FString Error;
+	if (!ApplyPinDefaultValue(TargetPin, DefaultValue, Error))
 	{
-		TargetPin->DefaultValue = DefaultValue;
+		return CreateErrorResponse(Error);
 	}
 
 	MarkBlueprintModified(Blueprint, Context);
+	Context.RecordNodeChange(EMCPChangeKind::PinDefaultChanged, TargetNode, PinName);
 
 	TSharedPtr<FJsonObject> ResultData = MakeShared<FJsonObject>();
 	ResultData->SetStringField(TEXT("pin_name"), PinName);
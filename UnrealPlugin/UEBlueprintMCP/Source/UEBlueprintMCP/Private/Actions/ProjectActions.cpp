@@ -11,6 +11,7 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/SavePackage.h"
 #include "EditorAssetLibrary.h"
+#include "MCPLog.h"
 
 // =============================================================================
 // FCreateInputMappingAction - Legacy input mapping
@@ -152,7 +153,7 @@ TSharedPtr<FJsonObject> FCreateInputActionAction::ExecuteInternal(const TSharedP
 		UInputAction* ExistingAction = FindObject<UInputAction>(ExistingPackage, *Name);
 		if (ExistingAction)
 		{
-			UE_LOG(LogTemp, Log, TEXT("Input Action '%s' already exists, cleaning up for recreation"), *Name);
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Input Action '%s' already exists, cleaning up for recreation"), *Name);
 			FString TempName = FString::Printf(TEXT("%s_TEMP_%d"), *Name, FMath::Rand());
 			ExistingAction->Rename(*TempName, GetTransientPackage(), REN_DoNotDirty | REN_DontCreateRedirectors | REN_NonTransactional);
 			ExistingAction->MarkAsGarbage();
@@ -163,7 +164,7 @@ TSharedPtr<FJsonObject> FCreateInputActionAction::ExecuteInternal(const TSharedP
 	// Delete from disk if exists
 	if (UEditorAssetLibrary::DoesAssetExist(PackagePath))
 	{
-		UE_LOG(LogTemp, Log, TEXT("Input Action '%s' exists on disk, deleting"), *Name);
+		UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Input Action '%s' exists on disk, deleting"), *Name);
 		UEditorAssetLibrary::DeleteAsset(PackagePath);
 	}
 
@@ -227,7 +228,7 @@ TSharedPtr<FJsonObject> FCreateInputMappingContextAction::ExecuteInternal(const
 		UInputMappingContext* ExistingIMC = FindObject<UInputMappingContext>(ExistingPackage, *Name);
 		if (ExistingIMC)
 		{
-			UE_LOG(LogTemp, Log, TEXT("Input Mapping Context '%s' already exists, cleaning up for recreation"), *Name);
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Input Mapping Context '%s' already exists, cleaning up for recreation"), *Name);
 			FString TempName = FString::Printf(TEXT("%s_TEMP_%d"), *Name, FMath::Rand());
 			ExistingIMC->Rename(*TempName, GetTransientPackage(), REN_DoNotDirty | REN_DontCreateRedirectors | REN_NonTransactional);
 			ExistingIMC->MarkAsGarbage();
@@ -238,7 +239,7 @@ TSharedPtr<FJsonObject> FCreateInputMappingContextAction::ExecuteInternal(const
 	// Delete from disk if exists
 	if (UEditorAssetLibrary::DoesAssetExist(PackagePath))
 	{
-		UE_LOG(LogTemp, Log, TEXT("Input Mapping Context '%s' exists on disk, deleting"), *Name);
+		UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Input Mapping Context '%s' exists on disk, deleting"), *Name);
 		UEditorAssetLibrary::DeleteAsset(PackagePath);
 	}
 
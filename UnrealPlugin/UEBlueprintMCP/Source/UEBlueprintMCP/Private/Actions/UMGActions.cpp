@@ -2,6 +2,7 @@
 
 #include "Actions/UMGActions.h"
 #include "MCPCommonUtils.h"
+#include "MCPTrace.h"
 #include "Editor.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -19,6 +20,7 @@
 #include "K2Node_CustomEvent.h"
 #include "K2Node_ComponentBoundEvent.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "MCPLog.h"
 
 // Helper to find widget blueprint in common paths
 static UWidgetBlueprint* FindWidgetBlueprintByName(const FString& BlueprintName)
@@ -88,7 +90,7 @@ TSharedPtr<FJsonObject> FCreateUMGWidgetBlueprintAction::ExecuteInternal(const T
 		// Delete from disk first
 		if (UEditorAssetLibrary::DoesAssetExist(CheckPath))
 		{
-			UE_LOG(LogTemp, Log, TEXT("Widget Blueprint exists at '%s', deleting from disk"), *CheckPath);
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Widget Blueprint exists at '%s', deleting from disk"), *CheckPath);
 			UEditorAssetLibrary::DeleteAsset(CheckPath);
 		}
 
@@ -104,7 +106,7 @@ TSharedPtr<FJsonObject> FCreateUMGWidgetBlueprintAction::ExecuteInternal(const T
 
 			if (ExistingBP)
 			{
-				UE_LOG(LogTemp, Log, TEXT("Widget Blueprint '%s' found in memory, cleaning up"), *AssetName);
+				UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Widget Blueprint '%s' found in memory, cleaning up"), *AssetName);
 				FString TempName = FString::Printf(TEXT("%s_OLD_%d"), *AssetName, FMath::Rand());
 				ExistingBP->Rename(*TempName, GetTransientPackage(), REN_DoNotDirty | REN_DontCreateRedirectors | REN_NonTransactional | REN_ForceNoResetLoaders);
 				ExistingBP->ClearFlags(RF_Public | RF_Standalone);
@@ -159,12 +161,15 @@ TSharedPtr<FJsonObject> FCreateUMGWidgetBlueprintAction::ExecuteInternal(const T
 
 	// Register and compile
 	FAssetRegistryModule::AssetCreated(WidgetBlueprint);
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	}
 
 	// Save immediately
 	UEditorAssetLibrary::SaveAsset(FullPath, false);
 
-	UE_LOG(LogTemp, Log, TEXT("Widget Blueprint '%s' created at '%s'"), *BlueprintName, *FullPath);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Widget Blueprint '%s' created at '%s'"), *BlueprintName, *FullPath);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
@@ -239,7 +244,10 @@ TSharedPtr<FJsonObject> FAddTextBlockToWidgetAction::ExecuteInternal(const TShar
 	PanelSlot->SetPosition(Position);
 
 	// Compile and save
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	}
 	UEditorAssetLibrary::SaveAsset(WidgetBlueprint->GetPathName(), false);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -326,7 +334,10 @@ TSharedPtr<FJsonObject> FAddButtonToWidgetAction::ExecuteInternal(const TSharedP
 	}
 
 	// Compile and save
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	}
 	UEditorAssetLibrary::SaveAsset(WidgetBlueprint->GetPathName(), false);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -453,10 +464,13 @@ TSharedPtr<FJsonObject> FBindWidgetEventAction::ExecuteInternal(const TSharedPtr
 	EventNode->NodePosY = (int32)(MaxY + 200);
 	EventNode->AllocateDefaultPins();
 
-	UE_LOG(LogTemp, Log, TEXT("Created Component Bound Event: %s.%s"), *WidgetComponentName, *EventName);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("Created Component Bound Event: %s.%s"), *WidgetComponentName, *EventName);
 
 	// Compile and save
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	}
 	UEditorAssetLibrary::SaveAsset(WidgetBlueprint->GetPathName(), false);
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -602,7 +616,10 @@ TSharedPtr<FJsonObject> FSetTextBlockBindingAction::ExecuteInternal(const TShare
 
 	// Compile
 	WidgetBlueprint->MarkPackageDirty();
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	{
+		MCP_TRACE_SCOPE("MCP::CompileBlueprint");
+		FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	}
 
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetBoolField(TEXT("success"), true);
@@ -2,6 +2,20 @@
 
 #include "MCPBridge.h"
 #include "MCPServer.h"
+#include "MCPExecutor.h"
+#include "MCPChangeJournal.h"
+#include "MCPCommonUtils.h"
+#include "MCPResponseWriter.h"
+#include "MCPCommandRegistry.h"
+#include "MCPSnapshot.h"
+#include "MCPJobs.h"
+#include "MCPEvents.h"
+#include "MCPCancellation.h"
+#include "MCPResultCache.h"
+#include "MCPMetrics.h"
+#include "MCPFlightRecorder.h"
+#include "MCPTrace.h"
+#include "MCPCommandRecorder.h"
 #include "Actions/EditorAction.h"
 #include "Actions/BlueprintActions.h"
 #include "Actions/EditorActions.h"
@@ -13,12 +27,102 @@
 #include "GameFramework/Actor.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Editor.h"
+#include "Components/ActorComponent.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "ShaderCompiler.h"
+#include "MCPLog.h"
 
 // NOTE: SEH crash protection is deferred to Phase 2
 // For now, using defensive programming (validation before execution)
 
+namespace
+{
+	/**
+	 * Serves the server from the bridge. Holds the bridge weakly: queued
+	 * game-thread work can outlive it during shutdown, and is dropped then.
+	 */
+	class FMCPBridgeExecutor : public IMCPCommandExecutor
+	{
+	public:
+		explicit FMCPBridgeExecutor(UMCPBridge* InBridge)
+			: Bridge(InBridge)
+			, CommandRegistry(InBridge->GetCommandRegistry())
+			, SnapshotStore(InBridge->GetSnapshotStore())
+			, JobManager(InBridge->GetJobManager())
+			, EventHub(InBridge->GetEventHub())
+			, ResultCache(InBridge->GetResultCache())
+			, Metrics(InBridge->GetMetrics())
+			, FlightRecorder(InBridge->GetFlightRecorder())
+		{
+		}
+
+		virtual TSharedPtr<const FMCPCommandRegistry> GetCommandRegistry() const override { return CommandRegistry; }
+		virtual TSharedPtr<const IMCPSnapshotReader> GetSnapshotStore() const override { return SnapshotStore; }
+		virtual TSharedPtr<FMCPJobManager> GetJobManager() const override { return JobManager; }
+		virtual TSharedPtr<FMCPEventHub> GetEventHub() const override { return EventHub; }
+		virtual TSharedPtr<FMCPResultCache> GetResultCache() const override { return ResultCache; }
+		virtual TSharedPtr<FMCPMetrics> GetMetrics() const override { return Metrics; }
+		virtual TSharedPtr<FMCPFlightRecorder> GetFlightRecorder() const override { return FlightRecorder; }
+
+		virtual void ExecuteCommandToWriter(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer, const FString& SessionId, const TSharedPtr<FMCPCancelToken>& CancelToken, FMCPRequestTimings* Timings) override
+		{
+			if (UMCPBridge* StrongBridge = Bridge.Get())
+			{
+				StrongBridge->ExecuteCommandToWriter(CommandType, Params, Writer, SessionId, CancelToken, Timings);
+			}
+			else
+			{
+				Writer.WriteErrorResponse(TEXT("Bridge not available"), TEXT("not_ready"));
+			}
+		}
+
+		virtual void ExecuteJob(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Params) override
+		{
+			if (UMCPBridge* StrongBridge = Bridge.Get())
+			{
+				StrongBridge->ExecuteJob(Job, Params);
+			}
+		}
+
+		virtual TSharedPtr<FJsonObject> GetSessionContextJson(const FString& SessionId) override
+		{
+			UMCPBridge* StrongBridge = Bridge.Get();
+			FMCPEditorContext* SessionContext = StrongBridge ? StrongBridge->GetSessionContext(SessionId) : nullptr;
+			return SessionContext ? SessionContext->ToJson() : nullptr;
+		}
+
+		virtual void ReleaseSession(const FString& SessionId) override
+		{
+			if (UMCPBridge* StrongBridge = Bridge.Get())
+			{
+				StrongBridge->ReleaseSession(SessionId);
+			}
+		}
+
+	private:
+		TWeakObjectPtr<UMCPBridge> Bridge;
+		TSharedPtr<const FMCPCommandRegistry> CommandRegistry;
+		TSharedPtr<const FMCPSnapshotStore> SnapshotStore;
+		TSharedPtr<FMCPJobManager> JobManager;
+		TSharedPtr<FMCPEventHub> EventHub;
+		TSharedPtr<FMCPResultCache> ResultCache;
+		TSharedPtr<FMCPMetrics> Metrics;
+		TSharedPtr<FMCPFlightRecorder> FlightRecorder;
+	};
+}
+
 UMCPBridge::UMCPBridge()
 	: Server(nullptr)
 {
@@ -28,26 +132,57 @@ void UMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Bridge initializing"));
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Bridge initializing"));
+
+	// Change journal is shared by every context so revisions stay global
+	ChangeJournal = MakeShared<FMCPChangeJournal>();
+	Context.ChangeJournal = ChangeJournal;
+	SnapshotStore = MakeShared<FMCPSnapshotStore>(ChangeJournal);
+	BindChangeJournalDelegates();
+
+	JobManager = MakeShared<FMCPJobManager>();
+	EventHub = MakeShared<FMCPEventHub>();
+	ResultCache = MakeShared<FMCPResultCache>();
+	FlightRecorder = MakeShared<FMCPFlightRecorder>();
+	BindEventDelegates();
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UMCPBridge::Tick), 0.1f);
 
 	// Register action handlers
 	RegisterActions();
+	BuildCommandRegistry();
+	Metrics = MakeShared<FMCPMetrics>(*CommandRegistry);
 
-	// Start the TCP server
-	Server = new FMCPServer(this, DefaultPort);
+	// Commandlets (UMCPScriptCommandlet) run commands in-process and don't listen
+	if (IsRunningCommandlet())
+	{
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Running as a commandlet, TCP server not started"));
+		return;
+	}
+
+	// Start the TCP server (-MCPPort=<port> lets several editors run side by side behind the router)
+	int32 Port = DefaultPort;
+	FParse::Value(FCommandLine::Get(), PortCommandLineSwitch, Port);
+	Server = new FMCPServer(MakeShared<FMCPBridgeExecutor>(this), Port);
 	if (Server->Start())
 	{
-		UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Server started on port %d"), DefaultPort);
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Server started on port %d"), Port);
+
+		// -MCPRecord=<path> captures the session for replay
+		FString RecordingPath;
+		if (FParse::Value(FCommandLine::Get(), FMCPCommandRecorder::CommandLineSwitch, RecordingPath) && !RecordingPath.IsEmpty())
+		{
+			Server->StartRecording(RecordingPath);
+		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("UEBlueprintMCP: Failed to start server"));
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to start server"));
 	}
 }
 
 void UMCPBridge::Deinitialize()
 {
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Bridge deinitializing"));
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Bridge deinitializing"));
 
 	// Stop the server
 	if (Server)
@@ -57,8 +192,13 @@ void UMCPBridge::Deinitialize()
 		Server = nullptr;
 	}
 
-	// Clear action handlers
+	UnbindChangeJournalDelegates();
+	UnbindEventDelegates();
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	// Clear action handlers and sessions
 	ActionHandlers.Empty();
+	Sessions.Empty();
 
 	Super::Deinitialize();
 }
@@ -84,14 +224,18 @@ void UMCPBridge::RegisterActions()
 	ActionHandlers.Add(TEXT("get_actors_in_level"), MakeShared<FGetActorsInLevelAction>());
 	ActionHandlers.Add(TEXT("find_actors_by_name"), MakeShared<FFindActorsByNameAction>());
 	ActionHandlers.Add(TEXT("spawn_actor"), MakeShared<FSpawnActorAction>());
+	ActionHandlers.Add(TEXT("spawn_actors"), MakeShared<FSpawnActorsAction>());
 	ActionHandlers.Add(TEXT("delete_actor"), MakeShared<FDeleteActorAction>());
 	ActionHandlers.Add(TEXT("set_actor_transform"), MakeShared<FSetActorTransformAction>());
+	ActionHandlers.Add(TEXT("set_actor_transforms"), MakeShared<FSetActorTransformsAction>());
 	ActionHandlers.Add(TEXT("get_actor_properties"), MakeShared<FGetActorPropertiesAction>());
 	ActionHandlers.Add(TEXT("set_actor_property"), MakeShared<FSetActorPropertyAction>());
+	ActionHandlers.Add(TEXT("set_properties_bulk"), MakeShared<FSetPropertiesBulkAction>());
 	ActionHandlers.Add(TEXT("focus_viewport"), MakeShared<FFocusViewportAction>());
 	ActionHandlers.Add(TEXT("get_viewport_transform"), MakeShared<FGetViewportTransformAction>());
 	ActionHandlers.Add(TEXT("set_viewport_transform"), MakeShared<FSetViewportTransformAction>());
 	ActionHandlers.Add(TEXT("save_all"), MakeShared<FSaveAllAction>());
+	ActionHandlers.Add(TEXT("get_changes"), MakeShared<FGetChangesAction>());
 
 	// =========================================================================
 	// Node Actions - Graph Operations
@@ -101,6 +245,8 @@ void UMCPBridge::RegisterActions()
 	ActionHandlers.Add(TEXT("delete_blueprint_node"), MakeShared<FDeleteBlueprintNodeAction>());
 	ActionHandlers.Add(TEXT("get_node_pins"), MakeShared<FGetNodePinsAction>());
 	ActionHandlers.Add(TEXT("set_node_position"), MakeShared<FSetNodePositionAction>());
+	ActionHandlers.Add(TEXT("export_graph"), MakeShared<FExportGraphAction>());
+	ActionHandlers.Add(TEXT("apply_graph_patch"), MakeShared<FApplyGraphPatchAction>());
 
 	// =========================================================================
 	// Node Actions - Event Nodes
@@ -184,10 +330,307 @@ void UMCPBridge::RegisterActions()
 	ActionHandlers.Add(TEXT("connect_to_material_output"), MakeShared<FConnectToMaterialOutputAction>());
 	ActionHandlers.Add(TEXT("set_material_expression_property"), MakeShared<FSetMaterialExpressionPropertyAction>());
 	ActionHandlers.Add(TEXT("compile_material"), MakeShared<FCompileMaterialAction>());
+	ActionHandlers.Add(TEXT("build_material_graph"), MakeShared<FBuildMaterialGraphAction>());
 	ActionHandlers.Add(TEXT("create_material_instance"), MakeShared<FCreateMaterialInstanceAction>());
 	ActionHandlers.Add(TEXT("create_post_process_volume"), MakeShared<FCreatePostProcessVolumeAction>());
 
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Registered %d action handlers"), ActionHandlers.Num());
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Registered %d action handlers"), ActionHandlers.Num());
+}
+
+void UMCPBridge::BuildCommandRegistry()
+{
+	CommandRegistry = MakeShared<FMCPCommandRegistry>();
+
+	CommandRegistry->RegisterServerCommands();
+
+	for (const auto& Pair : ActionHandlers)
+	{
+		FMCPCommandInfo Info;
+		Info.Name = Pair.Key;
+		Info.Version = Pair.Value->GetVersion();
+		Info.Cost = Pair.Value->GetCostClass();
+		Info.ParamsSchema = Pair.Value->GetParamsSchema();
+		Info.bConcurrent = Info.Cost == EMCPCommandCost::ReadOnly && FMCPSnapshotStore::CanServe(Pair.Key);
+		CommandRegistry->Register(Info);
+	}
+
+	CommandRegistry->Freeze();
+}
+
+void UMCPBridge::BindChangeJournalDelegates()
+{
+	if (GEngine)
+	{
+		ActorAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &UMCPBridge::OnLevelActorAdded);
+		ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &UMCPBridge::OnLevelActorDeleted);
+	}
+	if (GEditor)
+	{
+		ActorMovedHandle = GEditor->OnActorMoved().AddUObject(this, &UMCPBridge::OnActorMoved);
+	}
+	PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UMCPBridge::OnObjectPropertyChanged);
+
+	// Edits the journal doesn't describe invalidate snapshots instead
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddUObject(this, &UMCPBridge::OnBlueprintPreCompile);
+	}
+	MapOpenedHandle = FEditorDelegates::OnMapOpened.AddUObject(this, &UMCPBridge::OnMapOpened);
+	ObjectTransactedHandle = FCoreUObjectDelegates::OnObjectTransacted.AddUObject(this, &UMCPBridge::OnObjectTransacted);
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddUObject(this, &UMCPBridge::OnPostUndoRedo);
+}
+
+void UMCPBridge::UnbindChangeJournalDelegates()
+{
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+	}
+	if (GEditor)
+	{
+		GEditor->OnActorMoved().Remove(ActorMovedHandle);
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+	FEditorDelegates::OnMapOpened.Remove(MapOpenedHandle);
+	FCoreUObjectDelegates::OnObjectTransacted.Remove(ObjectTransactedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+}
+
+bool UMCPBridge::ShouldJournalActor(const AActor* Actor)
+{
+	if (!Actor || Actor->HasAnyFlags(RF_Transient | RF_ClassDefaultObject))
+	{
+		return false;
+	}
+
+	const UWorld* World = Actor->GetWorld();
+	return World && World->WorldType == EWorldType::Editor;
+}
+
+void UMCPBridge::OnLevelActorAdded(AActor* Actor)
+{
+	if (ShouldJournalActor(Actor))
+	{
+		ChangeJournal->RecordActorChange(EMCPChangeKind::ActorAdded, Actor, Actor->GetClass()->GetName());
+		PublishActorEvent(TEXT("actor_added"), Actor);
+	}
+}
+
+void UMCPBridge::OnLevelActorDeleted(AActor* Actor)
+{
+	if (ShouldJournalActor(Actor))
+	{
+		ChangeJournal->RecordActorChange(EMCPChangeKind::ActorRemoved, Actor);
+		PublishActorEvent(TEXT("actor_deleted"), Actor);
+	}
+}
+
+void UMCPBridge::OnActorMoved(AActor* Actor)
+{
+	if (ShouldJournalActor(Actor))
+	{
+		ChangeJournal->RecordActorChange(EMCPChangeKind::ActorMoved, Actor);
+		PublishActorEvent(TEXT("actor_moved"), Actor);
+	}
+}
+
+void UMCPBridge::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Blueprint edits made in the editor aren't journaled per node
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		SnapshotStore->InvalidateBlueprint(Blueprint->GetName());
+		return;
+	}
+
+	// Component edits are reported against their owning actor
+	AActor* Actor = Cast<AActor>(Object);
+	if (!Actor)
+	{
+		if (UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			Actor = Component->GetOwner();
+		}
+	}
+
+	if (ShouldJournalActor(Actor))
+	{
+		ChangeJournal->RecordActorChange(EMCPChangeKind::ActorPropertyChanged, Actor, PropertyChangedEvent.GetPropertyName().ToString());
+	}
+}
+
+void UMCPBridge::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	// Compiling may reconstruct nodes and pins
+	if (Blueprint)
+	{
+		SnapshotStore->InvalidateBlueprint(Blueprint->GetName());
+		CompilingBlueprints.AddUnique(Blueprint);
+	}
+}
+
+void UMCPBridge::OnMapOpened(const FString& Filename, bool bAsTemplate)
+{
+	SnapshotStore->Reset();
+}
+
+void UMCPBridge::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent)
+{
+	// Nodes added, deleted or rewired in the Blueprint editor go through a
+	// transaction but never through the journal
+	UBlueprint* Blueprint = nullptr;
+	if (const UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
+	}
+	else if (const UEdGraph* Graph = Cast<UEdGraph>(Object))
+	{
+		Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+	}
+
+	if (Blueprint)
+	{
+		SnapshotStore->InvalidateBlueprint(Blueprint->GetName());
+	}
+}
+
+void UMCPBridge::OnPostUndoRedo()
+{
+	// Undo/redo can revert any edit, journaled or not, in any asset
+	SnapshotStore->Reset();
+}
+
+void UMCPBridge::BindEventDelegates()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddUObject(this, &UMCPBridge::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddUObject(this, &UMCPBridge::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddUObject(this, &UMCPBridge::OnAssetRenamed);
+
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddUObject(this, &UMCPBridge::OnBlueprintCompiled);
+	}
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddUObject(this, &UMCPBridge::OnPackageSaved);
+	PostPIEStartedHandle = FEditorDelegates::PostPIEStarted.AddUObject(this, &UMCPBridge::OnPostPIEStarted);
+	EndPIEHandle = FEditorDelegates::EndPIE.AddUObject(this, &UMCPBridge::OnEndPIE);
+}
+
+void UMCPBridge::UnbindEventDelegates()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FEditorDelegates::PostPIEStarted.Remove(PostPIEStartedHandle);
+	FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+}
+
+void UMCPBridge::OnAssetAdded(const FAssetData& AssetData)
+{
+	PublishAssetEvent(TEXT("asset_added"), AssetData);
+}
+
+void UMCPBridge::OnAssetRemoved(const FAssetData& AssetData)
+{
+	PublishAssetEvent(TEXT("asset_removed"), AssetData);
+}
+
+void UMCPBridge::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	PublishAssetEvent(TEXT("asset_renamed"), AssetData, OldObjectPath);
+}
+
+void UMCPBridge::OnBlueprintCompiled()
+{
+	// The broadcast carries no blueprint; report the ones that started compiling
+	TArray<TWeakObjectPtr<UBlueprint>> Compiled = MoveTemp(CompilingBlueprints);
+	CompilingBlueprints.Reset();
+
+	for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : Compiled)
+	{
+		UBlueprint* Blueprint = WeakBlueprint.Get();
+		if (!Blueprint)
+		{
+			continue;
+		}
+		EventHub->Publish(TEXT("blueprint_compiled"), [Blueprint](FMCPResponseWriter& Writer)
+		{
+			Writer.WriteField(TEXT("blueprint"), Blueprint->GetName());
+			Writer.WriteField(TEXT("path"), Blueprint->GetPathName());
+			Writer.WriteField(TEXT("has_errors"), Blueprint->Status == BS_Error);
+		});
+	}
+}
+
+void UMCPBridge::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
+{
+	// Procedural saves (cooking) aren't user-visible edits
+	if (!Package || ObjectSaveContext.IsProceduralSave())
+	{
+		return;
+	}
+	EventHub->Publish(TEXT("package_saved"), [Package, &PackageFileName](FMCPResponseWriter& Writer)
+	{
+		Writer.WriteField(TEXT("package"), Package->GetName());
+		Writer.WriteField(TEXT("filename"), PackageFileName);
+	});
+}
+
+void UMCPBridge::OnPostPIEStarted(bool bIsSimulating)
+{
+	EventHub->Publish(TEXT("pie_started"), [bIsSimulating](FMCPResponseWriter& Writer)
+	{
+		Writer.WriteField(TEXT("simulating"), bIsSimulating);
+	});
+}
+
+void UMCPBridge::OnEndPIE(bool bIsSimulating)
+{
+	EventHub->Publish(TEXT("pie_stopped"), [bIsSimulating](FMCPResponseWriter& Writer)
+	{
+		Writer.WriteField(TEXT("simulating"), bIsSimulating);
+	});
+}
+
+void UMCPBridge::PublishActorEvent(const FString& EventName, AActor* Actor)
+{
+	EventHub->Publish(EventName, [Actor](FMCPResponseWriter& Writer)
+	{
+		FMCPCommonUtils::WriteActorFields(Writer, Actor);
+		Writer.WriteField(TEXT("label"), Actor->GetActorLabel());
+	});
+}
+
+void UMCPBridge::PublishAssetEvent(const FString& EventName, const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	// The startup scan reports every asset in the project as added
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		return;
+	}
+
+	EventHub->Publish(EventName, [&AssetData, &OldObjectPath](FMCPResponseWriter& Writer)
+	{
+		Writer.WriteField(TEXT("asset_path"), AssetData.GetObjectPathString());
+		Writer.WriteField(TEXT("asset_name"), AssetData.AssetName.ToString());
+		Writer.WriteField(TEXT("asset_class"), AssetData.AssetClassPath.GetAssetName().ToString());
+		if (!OldObjectPath.IsEmpty())
+		{
+			Writer.WriteField(TEXT("old_path"), OldObjectPath);
+		}
+	});
 }
 
 TSharedRef<FEditorAction>* UMCPBridge::FindAction(const FString& CommandType)
@@ -222,6 +665,272 @@ TSharedPtr<FJsonObject> UMCPBridge::ExecuteCommandSafe(const FString& CommandTyp
 	return ExecuteCommandInternal(CommandType, Params);
 }
 
+void UMCPBridge::ExecuteCommandToWriter(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer, const FString& SessionId, const TSharedPtr<FMCPCancelToken>& CancelToken, FMCPRequestTimings* Timings)
+{
+	TSharedRef<FEditorAction>* ActionPtr = FindAction(CommandType);
+	if (!ActionPtr)
+	{
+		FMCPStageTimer ExecuteTimer(Timings, EMCPStage::Execute);
+		Writer.WriteResponseObject(ExecuteCommandSafe(CommandType, Params));
+		return;
+	}
+
+	FMCPEditorContext* SessionContext = GetSessionContext(SessionId);
+	if (!SessionContext)
+	{
+		Writer.WriteResponseObject(CreateSessionsFullResponse());
+		return;
+	}
+	SessionContext->CancelToken = CancelToken;
+	SessionContext->Timings = Timings;
+	(*ActionPtr)->ExecuteToWriter(Params, *SessionContext, Writer);
+	SessionContext->Timings = nullptr;
+	SessionContext->CancelToken.Reset();
+
+	PublishSnapshots(CommandType, Params);
+}
+
+TSharedPtr<FJsonObject> UMCPBridge::ExecuteCommandWithoutSave(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, FMCPRequestTimings* Timings)
+{
+	TSharedRef<FEditorAction>* ActionPtr = FindAction(CommandType);
+	if (!ActionPtr)
+	{
+		FMCPStageTimer ExecuteTimer(Timings, EMCPStage::Execute);
+		return ExecuteCommandSafe(CommandType, Params);
+	}
+
+	FMCPEditorContext* SessionContext = GetSessionContext(SessionId);
+	if (!SessionContext)
+	{
+		return CreateSessionsFullResponse();
+	}
+	SessionContext->Timings = Timings;
+	TSharedPtr<FJsonObject> Response = (*ActionPtr)->ExecuteWithoutSave(Params, *SessionContext);
+	SessionContext->Timings = nullptr;
+
+	PublishSnapshots(CommandType, Params);
+	return Response;
+}
+
+TSharedPtr<FJsonObject> UMCPBridge::FlushDeferredSaves(FMCPRequestTimings* Timings)
+{
+	// Packages dirtied in any context since the last flush
+	TSet<UPackage*> Dirty = Context.DirtyPackages;
+	for (const TPair<FString, FMCPSession>& Pair : Sessions)
+	{
+		Dirty.Append(Pair.Value.Context->DirtyPackages);
+	}
+
+	// Compile each touched Blueprint once, so what gets saved is compiled
+	int32 Compiled = 0;
+	TArray<TSharedPtr<FJsonValue>> CompileErrors;
+	{
+		FMCPStageTimer ExecuteTimer(Timings, EMCPStage::Execute);
+		MCP_TRACE_SCOPE("MCP::CompileDeferred");
+		for (UPackage* Package : Dirty)
+		{
+			if (!Package)
+			{
+				continue;
+			}
+
+			TArray<UObject*> Objects;
+			GetObjectsWithPackage(Package, Objects, false);
+			for (UObject* Object : Objects)
+			{
+				UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+				if (!Blueprint || Blueprint->Status == BS_UpToDate || Blueprint->Status == BS_UpToDateWithWarnings)
+				{
+					continue;
+				}
+
+				FKismetEditorUtilities::CompileBlueprint(Blueprint);
+				++Compiled;
+				if (Blueprint->Status == BS_Error)
+				{
+					CompileErrors.Add(MakeShared<FJsonValueString>(Blueprint->GetName()));
+				}
+			}
+		}
+	}
+
+	// One save for the whole batch; the default context's save clears its own set
+	Context.Timings = Timings;
+	Context.DirtyPackages = Dirty;
+	Context.SaveDirtyPackages();
+	Context.Timings = nullptr;
+	for (TPair<FString, FMCPSession>& Pair : Sessions)
+	{
+		Pair.Value.Context->DirtyPackages.Empty();
+	}
+
+	int32 StillDirty = 0;
+	for (UPackage* Package : Dirty)
+	{
+		if (Package && Package->IsDirty())
+		{
+			++StillDirty;
+		}
+	}
+
+	TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetBoolField(TEXT("success"), StillDirty == 0 && CompileErrors.Num() == 0);
+	Result->SetNumberField(TEXT("compiled"), Compiled);
+	Result->SetArrayField(TEXT("compile_errors"), CompileErrors);
+	Result->SetNumberField(TEXT("saved"), Dirty.Num() - StillDirty);
+	Result->SetNumberField(TEXT("still_dirty"), StillDirty);
+	return Result;
+}
+
+void UMCPBridge::ExecuteJob(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Params)
+{
+	if (!JobManager->MarkRunning(Job))
+	{
+		// Cancelled while queued
+		return;
+	}
+
+	const FString& CommandType = Job->GetCommandType();
+	TSharedRef<FEditorAction>* ActionPtr = FindAction(CommandType);
+	if (!ActionPtr)
+	{
+		JobManager->Finish(Job, ExecuteCommandSafe(CommandType, Params));
+		return;
+	}
+
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Running job %s (%s)"), *Job->GetId(), *CommandType);
+
+	FMCPRequestTimings Timings;
+	FMCPEditorContext* SessionContext = GetSessionContext(Job->GetSessionId());
+	if (!SessionContext)
+	{
+		JobManager->Finish(Job, CreateSessionsFullResponse());
+		return;
+	}
+	SessionContext->ActiveJob = Job;
+	SessionContext->Timings = &Timings;
+	TSharedPtr<FJsonObject> Response = (*ActionPtr)->Execute(Params, *SessionContext);
+	SessionContext->Timings = nullptr;
+	SessionContext->ActiveJob.Reset();
+
+	PublishSnapshots(CommandType, Params);
+
+	// Jobs have no socket stages of their own; their start request is a separate reply
+	bool bSuccess = false;
+	Timings.bSuccess = Response.IsValid() && Response->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess;
+	if (Response.IsValid())
+	{
+		Response->TryGetStringField(TEXT("error_type"), Timings.ErrorType);
+	}
+	Metrics->Record(CommandType, Timings);
+	FlightRecorder->Record(CommandType, Job->GetSessionId(), Job->GetId(), Timings);
+
+	JobManager->Finish(Job, Response);
+}
+
+void UMCPBridge::PublishSnapshots(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+	// Publish what this command (and any editor edits before it) touched
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	SnapshotStore->PublishChanges(World);
+
+	const FMCPCommandInfo* Info = CommandRegistry->Find(CommandType);
+	if (Info && Info->bConcurrent)
+	{
+		SnapshotStore->PrimeForQuery(CommandType, Params, World);
+	}
+}
+
+bool UMCPBridge::Tick(float DeltaTime)
+{
+	JobManager->TickWaitingJobs();
+
+	const bool bCompilingNow = GShaderCompilingManager && GShaderCompilingManager->IsCompiling();
+	if (bShadersCompiling && !bCompilingNow)
+	{
+		EventHub->Publish(TEXT("shader_compile_finished"));
+	}
+	bShadersCompiling = bCompilingNow;
+
+	return true;
+}
+
+FMCPEditorContext* UMCPBridge::GetSessionContext(const FString& SessionId)
+{
+	if (SessionId.IsEmpty())
+	{
+		return &Context;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (FMCPSession* Existing = Sessions.Find(SessionId))
+	{
+		Existing->LastUsedTime = Now;
+		return &Existing->Context.Get();
+	}
+
+	// Stay bounded by evicting the least recently used session, but only one that
+	// has gone idle: a live agent's current Blueprint and aliases must survive
+	if (Sessions.Num() >= MaxSessions)
+	{
+		FString OldestId;
+		double OldestTime = TNumericLimits<double>::Max();
+		for (const auto& Pair : Sessions)
+		{
+			if (Pair.Value.LastUsedTime < OldestTime)
+			{
+				OldestTime = Pair.Value.LastUsedTime;
+				OldestId = Pair.Key;
+			}
+		}
+
+		if (Now - OldestTime < SessionIdleTimeoutSeconds)
+		{
+			UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Refusing session '%s': %d sessions active, none idle for %.0fs"),
+				*SessionId, Sessions.Num(), SessionIdleTimeoutSeconds);
+			return nullptr;
+		}
+
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Evicting session '%s' (idle for %.0fs) for '%s'"), *OldestId, Now - OldestTime, *SessionId);
+		RemoveSession(OldestId);
+	}
+
+	FMCPSession& Session = Sessions.Add(SessionId);
+	Session.Context->ChangeJournal = ChangeJournal;
+	Session.LastUsedTime = Now;
+
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Created session '%s' (%d active)"), *SessionId, Sessions.Num());
+	return &Session.Context.Get();
+}
+
+TSharedPtr<FJsonObject> UMCPBridge::CreateSessionsFullResponse()
+{
+	return CreateErrorResponse(
+		FString::Printf(TEXT("Too many active sessions (%d); close a connection or retry once a session has been idle"), MaxSessions),
+		TEXT("busy"));
+}
+
+void UMCPBridge::ReleaseSession(const FString& SessionId)
+{
+	if (RemoveSession(SessionId))
+	{
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Released session '%s' (%d active)"), *SessionId, Sessions.Num());
+	}
+}
+
+bool UMCPBridge::RemoveSession(const FString& SessionId)
+{
+	FMCPSession Session;
+	if (!Sessions.RemoveAndCopyValue(SessionId, Session))
+	{
+		return false;
+	}
+
+	// Saves deferred by the session still belong to the next FlushDeferredSaves
+	Context.DirtyPackages.Append(Session.Context->DirtyPackages);
+	return true;
+}
+
 TSharedPtr<FJsonObject> UMCPBridge::ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
 {
 	return ExecuteCommand(CommandType, Params);
@@ -0,0 +1,191 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPChangeJournal.h"
+#include "GameFramework/Actor.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/ScopeLock.h"
+
+TSharedPtr<FJsonObject> FMCPChangeEntry::ToJson() const
+{
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("revision"), static_cast<double>(Revision));
+	Obj->SetStringField(TEXT("kind"), FMCPChangeJournal::KindToString(Kind));
+	Obj->SetStringField(TEXT("target"), Target);
+
+	if (!Graph.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("graph"), Graph);
+	}
+	if (!NodeId.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("node_id"), NodeId);
+	}
+	if (!Detail.IsEmpty())
+	{
+		Obj->SetStringField(TEXT("detail"), Detail);
+	}
+
+	return Obj;
+}
+
+FMCPChangeJournal::FMCPChangeJournal(int32 InCapacity)
+	: Head(0)
+	, Count(0)
+	, Revision(0)
+	, EvictedRevision(0)
+	, Epoch(FGuid::NewGuid())
+{
+	Entries.SetNum(FMath::Max(InCapacity, 1));
+}
+
+void FMCPChangeJournal::RecordActorChange(EMCPChangeKind Kind, const AActor* Actor, const FString& Detail)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	Record(Kind, Actor->GetName(), FString(), FString(), Detail);
+}
+
+void FMCPChangeJournal::RecordNodeChange(EMCPChangeKind Kind, const UEdGraphNode* Node, const FString& Detail)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	const FMCPChangeEntry Entry = MakeNodeEntry(Kind, Node, Detail);
+	Record(Entry.Kind, Entry.Target, Entry.Graph, Entry.NodeId, Entry.Detail);
+}
+
+FMCPChangeEntry FMCPChangeJournal::MakeNodeEntry(EMCPChangeKind Kind, const UEdGraphNode* Node, const FString& Detail)
+{
+	FMCPChangeEntry Entry;
+	Entry.Kind = Kind;
+	Entry.Detail = Detail;
+	if (Node)
+	{
+		const UEdGraph* Graph = Node->GetGraph();
+		const UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
+		Entry.Target = Blueprint ? Blueprint->GetName() : FString();
+		Entry.Graph = Graph ? Graph->GetName() : FString();
+		Entry.NodeId = Node->NodeGuid.ToString();
+	}
+	return Entry;
+}
+
+void FMCPChangeJournal::Record(EMCPChangeKind Kind, const FString& Target, const FString& Graph, const FString& NodeId, const FString& Detail)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const int32 Capacity = Entries.Num();
+	++Revision;
+
+	// Coalesce with the newest entry if it describes the same change
+	if (Count > 0)
+	{
+		FMCPChangeEntry& Last = Entries[(Head + Count - 1) % Capacity];
+		if (Last.Kind == Kind && Last.Target == Target && Last.NodeId == NodeId && Last.Detail == Detail && Last.Graph == Graph)
+		{
+			Last.Revision = Revision;
+			return;
+		}
+	}
+
+	// Evict the oldest entry when full
+	if (Count == Capacity)
+	{
+		EvictedRevision = Entries[Head].Revision;
+		Head = (Head + 1) % Capacity;
+		--Count;
+	}
+
+	FMCPChangeEntry& Entry = Entries[(Head + Count) % Capacity];
+	Entry.Revision = Revision;
+	Entry.Kind = Kind;
+	Entry.Target = Target;
+	Entry.Graph = Graph;
+	Entry.NodeId = NodeId;
+	Entry.Detail = Detail;
+	++Count;
+}
+
+int64 FMCPChangeJournal::GetRevision() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Revision;
+}
+
+bool FMCPChangeJournal::GetChangesSince(int64 SinceRevision, int32 MaxEntries, TArray<FMCPChangeEntry>& OutEntries) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// Evicted history, or a revision from before the journal restarted (e.g. an editor restart)
+	if (SinceRevision < EvictedRevision || SinceRevision > Revision)
+	{
+		return false;
+	}
+
+	const int32 Capacity = Entries.Num();
+
+	// Entries are sorted by revision, so binary search for the first newer one
+	int32 Low = 0;
+	int32 High = Count;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High) / 2;
+		if (Entries[(Head + Mid) % Capacity].Revision <= SinceRevision)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	int32 Num = Count - Low;
+	if (MaxEntries > 0)
+	{
+		Num = FMath::Min(Num, MaxEntries);
+	}
+
+	OutEntries.Reserve(OutEntries.Num() + Num);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		OutEntries.Add(Entries[(Head + Low + i) % Capacity]);
+	}
+
+	return true;
+}
+
+void FMCPChangeJournal::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	EvictedRevision = Revision;
+	Head = 0;
+	Count = 0;
+}
+
+const TCHAR* FMCPChangeJournal::KindToString(EMCPChangeKind Kind)
+{
+	switch (Kind)
+	{
+	case EMCPChangeKind::ActorAdded:			return TEXT("actor_added");
+	case EMCPChangeKind::ActorRemoved:			return TEXT("actor_removed");
+	case EMCPChangeKind::ActorMoved:			return TEXT("actor_moved");
+	case EMCPChangeKind::ActorPropertyChanged:	return TEXT("actor_property_changed");
+	case EMCPChangeKind::NodeAdded:				return TEXT("node_added");
+	case EMCPChangeKind::NodeRemoved:			return TEXT("node_removed");
+	case EMCPChangeKind::NodeMoved:				return TEXT("node_moved");
+	case EMCPChangeKind::PinDefaultChanged:		return TEXT("pin_default_changed");
+	case EMCPChangeKind::LinkAdded:				return TEXT("link_added");
+	case EMCPChangeKind::LinkRemoved:			return TEXT("link_removed");
+	default:									return TEXT("unknown");
+	}
+}
@@ -20,6 +20,7 @@
 #include "Kismet2/KismetEditorUtilities.h"
 #include "GameFramework/Actor.h"
 #include "EditorAssetLibrary.h"
+#include "MCPResponseWriter.h"
 
 // =========================================================================
 // JSON Parsing Utilities
@@ -238,7 +239,14 @@ bool FMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Property
 		return false;
 	}
 
-	void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Object);
+	return SetPropertyValue(Property, Object, Value, OutErrorMessage);
+}
+
+bool FMCPCommonUtils::SetPropertyValue(FProperty* Property, void* Container,
+	const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage)
+{
+	const FString PropertyName = Property->GetName();
+	void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(Container);
 
 	// Handle different property types
 	if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
@@ -248,7 +256,7 @@ bool FMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Property
 	}
 	else if (FIntProperty* IntProp = CastField<FIntProperty>(Property))
 	{
-		IntProp->SetPropertyValue_InContainer(Object, static_cast<int32>(Value->AsNumber()));
+		IntProp->SetPropertyValue(PropertyAddr, static_cast<int32>(Value->AsNumber()));
 		return true;
 	}
 	else if (FFloatProperty* FloatProp = CastField<FFloatProperty>(Property))
@@ -266,6 +274,34 @@ bool FMCPCommonUtils::SetObjectProperty(UObject* Object, const FString& Property
 		StrProp->SetPropertyValue(PropertyAddr, Value->AsString());
 		return true;
 	}
+	else if (FNameProperty* NameProp = CastField<FNameProperty>(Property))
+	{
+		NameProp->SetPropertyValue(PropertyAddr, FName(*Value->AsString()));
+		return true;
+	}
+	else if (FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+	{
+		// TEnumAsByte properties (e.g. Mobility) accept enum names as well as numbers
+		if (Value->Type == EJson::String && ByteProp->Enum)
+		{
+			FString EnumValueName = Value->AsString();
+			if (EnumValueName.Contains(TEXT("::")))
+			{
+				EnumValueName.Split(TEXT("::"), nullptr, &EnumValueName);
+			}
+
+			int64 EnumValue = ByteProp->Enum->GetValueByNameString(EnumValueName);
+			if (EnumValue == INDEX_NONE)
+			{
+				OutErrorMessage = FString::Printf(TEXT("Invalid enum value: %s"), *EnumValueName);
+				return false;
+			}
+			ByteProp->SetPropertyValue(PropertyAddr, static_cast<uint8>(EnumValue));
+			return true;
+		}
+		ByteProp->SetPropertyValue(PropertyAddr, static_cast<uint8>(Value->AsNumber()));
+		return true;
+	}
 	else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
 	{
 		UEnum* EnumDef = EnumProp->GetEnum();
@@ -591,3 +627,31 @@ TSharedPtr<FJsonValue> FMCPCommonUtils::ActorToJsonValue(AActor* Actor)
 	}
 	return MakeShared<FJsonValueNull>();
 }
+
+void FMCPCommonUtils::WriteActorFields(FMCPResponseWriter& Writer, AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// Same fields and order as ActorToJsonObject
+	Writer.WriteField(TEXT("name"), Actor->GetName());
+	Writer.WriteField(TEXT("class"), Actor->GetClass()->GetName());
+	Writer.WriteVectorField(TEXT("location"), Actor->GetActorLocation());
+	Writer.WriteRotatorField(TEXT("rotation"), Actor->GetActorRotation());
+	Writer.WriteVectorField(TEXT("scale"), Actor->GetActorScale3D());
+}
+
+void FMCPCommonUtils::WriteActor(FMCPResponseWriter& Writer, AActor* Actor)
+{
+	if (!Actor)
+	{
+		Writer.WriteNull();
+		return;
+	}
+
+	Writer.BeginObject();
+	WriteActorFields(Writer, Actor);
+	Writer.EndObject();
+}
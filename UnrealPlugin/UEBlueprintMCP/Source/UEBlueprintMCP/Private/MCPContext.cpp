@@ -2,15 +2,22 @@
 
 #include "MCPContext.h"
 #include "MCPCommonUtils.h"
+#include "MCPJobs.h"
+#include "MCPCancellation.h"
+#include "MCPMetrics.h"
+#include "MCPTrace.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/SavePackage.h"
 #include "FileHelpers.h"
+#include "MCPLog.h"
 
 FMCPEditorContext::FMCPEditorContext()
 	: CurrentGraphName(NAME_None)
+	, bDeferBlueprintModified(false)
+	, Timings(nullptr)
 {
 }
 
@@ -88,6 +95,9 @@ void FMCPEditorContext::MarkPackageDirty(UPackage* Package)
 
 void FMCPEditorContext::SaveDirtyPackages()
 {
+	FMCPStageTimer SaveTimer(Timings, EMCPStage::Save);
+	MCP_TRACE_SCOPE("MCP::SaveDirtyPackages");
+
 	// Save the whole project
 	bool bSaved = FEditorFileUtils::SaveDirtyPackages(false, true, true, false, false, false);
 
@@ -103,16 +113,53 @@ void FMCPEditorContext::SaveDirtyPackages()
 
 	if (StillDirty.Num() > 0)
 	{
-		UE_LOG(LogTemp, Error, TEXT("UEBlueprintMCP: SaveDirtyPackages failed! %d packages still dirty after save:"), StillDirty.Num());
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: SaveDirtyPackages failed! %d packages still dirty after save:"), StillDirty.Num());
 		for (UPackage* Package : StillDirty)
 		{
-			UE_LOG(LogTemp, Error, TEXT("  - %s"), *Package->GetName());
+			UE_LOG(LogUEBlueprintMCP, Error, TEXT("  - %s"), *Package->GetName());
 		}
 	}
 
 	DirtyPackages.Empty();
 }
 
+void FMCPEditorContext::RecordActorChange(EMCPChangeKind Kind, const AActor* Actor, const FString& Detail)
+{
+	if (ChangeJournal.IsValid())
+	{
+		ChangeJournal->RecordActorChange(Kind, Actor, Detail);
+	}
+}
+
+void FMCPEditorContext::RecordNodeChange(EMCPChangeKind Kind, const UEdGraphNode* Node, const FString& Detail)
+{
+	if (!ChangeJournal.IsValid() || !Node)
+	{
+		return;
+	}
+
+	if (bDeferJournal)
+	{
+		// Resolved now: the node may be gone by the time the buffer is flushed
+		PendingChanges.Add(FMCPChangeJournal::MakeNodeEntry(Kind, Node, Detail));
+		return;
+	}
+
+	ChangeJournal->RecordNodeChange(Kind, Node, Detail);
+}
+
+void FMCPEditorContext::FlushPendingChanges(bool bCommit)
+{
+	if (bCommit && ChangeJournal.IsValid())
+	{
+		for (const FMCPChangeEntry& Entry : PendingChanges)
+		{
+			ChangeJournal->Record(Entry.Kind, Entry.Target, Entry.Graph, Entry.NodeId, Entry.Detail);
+		}
+	}
+	PendingChanges.Empty();
+}
+
 void FMCPEditorContext::Clear()
 {
 	CurrentBlueprint = nullptr;
@@ -122,6 +169,10 @@ void FMCPEditorContext::Clear()
 	LastCreatedActorName.Empty();
 	LastCreatedWidgetName.Empty();
 	DirtyPackages.Empty();
+	bDeferBlueprintModified = false;
+	PendingModifiedBlueprints.Empty();
+	bDeferJournal = false;
+	PendingChanges.Empty();
 
 	// Clear material context
 	CurrentMaterial = nullptr;
@@ -248,6 +299,13 @@ TSharedPtr<FJsonObject> FMCPEditorContext::ToJson() const
 	// Dirty packages count
 	JsonObj->SetNumberField(TEXT("dirty_packages_count"), DirtyPackages.Num());
 
+	// Change journal revision (clients compare against their mirror)
+	if (ChangeJournal.IsValid())
+	{
+		JsonObj->SetNumberField(TEXT("revision"), static_cast<double>(ChangeJournal->GetRevision()));
+		JsonObj->SetStringField(TEXT("epoch"), ChangeJournal->GetEpoch().ToString());
+	}
+
 	// Material context
 	if (UMaterial* Mat = CurrentMaterial.Get())
 	{
@@ -335,3 +393,31 @@ FGuid FMCPEditorContext::ResolveNodeId(const FString& NodeIdOrAlias) const
 	// Invalid
 	return FGuid();
 }
+
+// =========================================================================
+// Async Jobs
+// =========================================================================
+
+void FMCPEditorContext::ReportProgress(float Progress, const FString& Phase)
+{
+	if (ActiveJob.IsValid())
+	{
+		ActiveJob->SetProgress(Progress, Phase);
+	}
+}
+
+bool FMCPEditorContext::IsCancelRequested() const
+{
+	return (ActiveJob.IsValid() && ActiveJob->IsCancelRequested())
+		|| (CancelToken.IsValid() && CancelToken->ShouldStop());
+}
+
+bool FMCPEditorContext::CompleteJobWhen(TFunction<bool()> Condition, const FString& WaitPhase)
+{
+	if (!ActiveJob.IsValid())
+	{
+		return false;
+	}
+	ActiveJob->CompleteWhen(MoveTemp(Condition), WaitPhase);
+	return true;
+}
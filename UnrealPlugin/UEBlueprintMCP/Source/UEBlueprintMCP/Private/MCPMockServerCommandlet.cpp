@@ -0,0 +1,73 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPMockServerCommandlet.h"
+#include "MCPMockExecutor.h"
+#include "MCPServer.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "CoreGlobals.h"
+#include "HAL/PlatformProcess.h"
+#include "MCPLog.h"
+
+UMCPMockServerCommandlet::UMCPMockServerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UMCPMockServerCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Values;
+	ParseCommandLine(*Params, Tokens, Switches, Values);
+
+	const FString* PortValue = Values.Find(TEXT("Port"));
+	const int32 Port = PortValue ? FCString::Atoi(**PortValue) : DefaultPort;
+	const FString* SecondsValue = Values.Find(TEXT("Seconds"));
+	const double Seconds = SecondsValue ? FCString::Atod(**SecondsValue) : 0.0;
+	const FString RecordingPath = Values.FindRef(TEXT("Recording"));
+
+	FMCPMockExecutorSettings Settings = FMCPMockExecutorSettings::MakeDefault();
+	if (!RecordingPath.IsEmpty())
+	{
+		Settings = FMCPMockExecutorSettings::FromRecording(RecordingPath);
+		if (Settings.Commands.Num() == 0)
+		{
+			UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: No commands found in recording %s"), *RecordingPath);
+			return 1;
+		}
+	}
+	if (const FString* SeedValue = Values.Find(TEXT("Seed")))
+	{
+		Settings.Seed = FCString::Atoi(**SeedValue);
+	}
+
+	FMCPServer Server(MakeShared<FMCPMockExecutor>(Settings), Port);
+	if (!Server.Start())
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to start mock server on port %d"), Port);
+		return 1;
+	}
+	UE_LOG(LogUEBlueprintMCP, Display, TEXT("UEBlueprintMCP: Mock server on port %d serving %d commands"), Port, Settings.Commands.Num());
+
+	// Commands run as game-thread tasks and a yielded pump resumes from the core ticker
+	const double StartTime = FPlatformTime::Seconds();
+	double LastTickTime = StartTime;
+	while (!IsEngineExitRequested() && (Seconds <= 0.0 || LastTickTime - StartTime < Seconds))
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+		const double Now = FPlatformTime::Seconds();
+		FTSTicker::GetCoreTicker().Tick(static_cast<float>(Now - LastTickTime));
+		LastTickTime = Now;
+
+		FPlatformProcess::Sleep(PumpIntervalSeconds);
+	}
+
+	Server.Stop();
+	UE_LOG(LogUEBlueprintMCP, Display, TEXT("UEBlueprintMCP: Mock server stopped after %.1fs"), FPlatformTime::Seconds() - StartTime);
+	return 0;
+}
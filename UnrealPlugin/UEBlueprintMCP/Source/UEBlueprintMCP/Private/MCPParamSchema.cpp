@@ -0,0 +1,430 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPParamSchema.h"
+#include "Actions/ActionParams.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "JsonObjectConverter.h"
+#include "Misc/ScopeLock.h"
+
+FCriticalSection FMCPParamSchema::BindingsLock;
+TMap<const UScriptStruct*, TSharedRef<const TArray<FMCPParamSchema::FParamBinding>>> FMCPParamSchema::BindingsCache;
+
+// Helper to read a fixed-size number array ([x, y, z] style params)
+static bool ReadNumberTriple(const TSharedPtr<FJsonValue>& Value, double& OutA, double& OutB, double& OutC)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+	if (!Value.IsValid() || !Value->TryGetArray(Array) || Array->Num() != 3)
+	{
+		return false;
+	}
+	return (*Array)[0]->TryGetNumber(OutA) && (*Array)[1]->TryGetNumber(OutB) && (*Array)[2]->TryGetNumber(OutC);
+}
+
+// Helper to tell raw JSON params (FMCPJsonValue) apart from decoded ones
+static bool IsRawJsonStruct(const FProperty* Property)
+{
+	const FStructProperty* StructProp = CastField<FStructProperty>(Property);
+	return StructProp && StructProp->Struct == FMCPJsonValue::StaticStruct();
+}
+
+// Helper to check a raw JSON value against a JsonType name ("object", "array", "string", "number", "boolean")
+static bool MatchesJsonType(const TSharedPtr<FJsonValue>& Value, const FString& JsonType)
+{
+	if (JsonType.IsEmpty())
+	{
+		return true;
+	}
+	switch (Value->Type)
+	{
+	case EJson::Object:		return JsonType == TEXT("object");
+	case EJson::Array:		return JsonType == TEXT("array");
+	case EJson::String:		return JsonType == TEXT("string");
+	case EJson::Number:		return JsonType == TEXT("number");
+	case EJson::Boolean:	return JsonType == TEXT("boolean");
+	default:				return false;
+	}
+}
+
+// Helper to name the expected JSON type in decode errors
+static FString DescribeExpectedType(const FProperty* Property)
+{
+	if (CastField<FBoolProperty>(Property))
+	{
+		return TEXT("boolean");
+	}
+	if (CastField<FNumericProperty>(Property) && !CastField<FNumericProperty>(Property)->IsEnum())
+	{
+		return TEXT("number");
+	}
+	if (CastField<FArrayProperty>(Property))
+	{
+		return TEXT("array");
+	}
+	if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+	{
+		if (StructProp->Struct == TBaseStructure<FVector>::Get() || StructProp->Struct == TBaseStructure<FRotator>::Get())
+		{
+			return TEXT("[x, y, z] array");
+		}
+		return TEXT("object");
+	}
+	return TEXT("string");
+}
+
+FString FMCPParamSchema::GetJsonKey(const FProperty* Property)
+{
+	if (Property->HasMetaData(TEXT("JsonKey")))
+	{
+		return Property->GetMetaData(TEXT("JsonKey"));
+	}
+
+	FString Name = Property->GetName();
+
+	// bForce -> Force
+	if (CastField<FBoolProperty>(Property) && Name.Len() > 1 && Name[0] == TCHAR('b') && FChar::IsUpper(Name[1]))
+	{
+		Name.RightChopInline(1);
+	}
+
+	// SourceNodeId -> source_node_id, HTTPPort -> http_port
+	FString Key;
+	Key.Reserve(Name.Len() + 4);
+	for (int32 i = 0; i < Name.Len(); ++i)
+	{
+		const TCHAR Char = Name[i];
+		if (FChar::IsUpper(Char) && i > 0)
+		{
+			const bool bPrevLower = FChar::IsLower(Name[i - 1]) || FChar::IsDigit(Name[i - 1]);
+			const bool bNextLower = i + 1 < Name.Len() && FChar::IsLower(Name[i + 1]);
+			if (bPrevLower || (bNextLower && FChar::IsUpper(Name[i - 1])))
+			{
+				Key.AppendChar(TCHAR('_'));
+			}
+		}
+		Key.AppendChar(FChar::ToLower(Char));
+	}
+	return Key;
+}
+
+TSharedRef<const TArray<FMCPParamSchema::FParamBinding>> FMCPParamSchema::GetBindings(const UScriptStruct* Struct)
+{
+	FScopeLock Lock(&BindingsLock);
+
+	if (const TSharedRef<const TArray<FParamBinding>>* Found = BindingsCache.Find(Struct))
+	{
+		return *Found;
+	}
+
+	TSharedRef<TArray<FParamBinding>> Bindings = MakeShared<TArray<FParamBinding>>();
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		FProperty* Property = *It;
+
+		FParamBinding& Binding = Bindings->AddDefaulted_GetRef();
+		Binding.Property = Property;
+		Binding.Key = GetJsonKey(Property);
+		Binding.bRequired = Property->HasMetaData(TEXT("Required"));
+		Binding.bAllowEmpty = Property->HasMetaData(TEXT("AllowEmpty"));
+
+		if (Property->HasMetaData(TEXT("ClampMin")))
+		{
+			Binding.Min = FCString::Atod(*Property->GetMetaData(TEXT("ClampMin")));
+		}
+		if (Property->HasMetaData(TEXT("ClampMax")))
+		{
+			Binding.Max = FCString::Atod(*Property->GetMetaData(TEXT("ClampMax")));
+		}
+		if (Property->HasMetaData(TEXT("JsonType")))
+		{
+			Binding.JsonType = Property->GetMetaData(TEXT("JsonType"));
+		}
+		if (Property->HasMetaData(TEXT("AllowedValues")))
+		{
+			Property->GetMetaData(TEXT("AllowedValues")).ParseIntoArray(Binding.AllowedValues, TEXT(","), true);
+			for (FString& Allowed : Binding.AllowedValues)
+			{
+				Allowed.TrimStartAndEndInline();
+			}
+		}
+	}
+
+	BindingsCache.Add(Struct, Bindings);
+	return Bindings;
+}
+
+bool FMCPParamSchema::Decode(const UScriptStruct* Struct, void* OutStruct, const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+	return DecodeStruct(Struct, OutStruct, Params, FString(), OutError);
+}
+
+bool FMCPParamSchema::DecodeStruct(const UScriptStruct* Struct, void* OutStruct, const TSharedPtr<FJsonObject>& Params, const FString& Path, FString& OutError)
+{
+	TSharedRef<const TArray<FParamBinding>> Bindings = GetBindings(Struct);
+
+	for (const FParamBinding& Binding : *Bindings)
+	{
+		const FString KeyPath = Path.IsEmpty() ? Binding.Key : FString::Printf(TEXT("%s.%s"), *Path, *Binding.Key);
+
+		const TSharedPtr<FJsonValue>* Found = Params.IsValid() ? Params->Values.Find(Binding.Key) : nullptr;
+		const bool bPresent = Found && Found->IsValid() && !(*Found)->IsNull();
+		if (!bPresent)
+		{
+			if (Binding.bRequired)
+			{
+				OutError = FString::Printf(TEXT("Required parameter '%s' is missing or empty"), *KeyPath);
+				return false;
+			}
+			continue;
+		}
+
+		const TSharedPtr<FJsonValue>& Value = *Found;
+		FProperty* Property = Binding.Property;
+		void* ValuePtr = Property->ContainerPtrToValuePtr<void>(OutStruct);
+
+		if (!DecodeValue(Property, ValuePtr, Value, Binding.JsonType, KeyPath, OutError))
+		{
+			return false;
+		}
+
+		// Metadata checks
+		if (const FStrProperty* StrProp = CastField<FStrProperty>(Property))
+		{
+			const FString& StrValue = StrProp->GetPropertyValue(ValuePtr);
+			if (Binding.bRequired && !Binding.bAllowEmpty && StrValue.IsEmpty())
+			{
+				OutError = FString::Printf(TEXT("Required parameter '%s' is missing or empty"), *KeyPath);
+				return false;
+			}
+			if (Binding.AllowedValues.Num() > 0 && !Binding.AllowedValues.Contains(StrValue))
+			{
+				OutError = FString::Printf(TEXT("Parameter '%s' must be one of: %s"),
+					*KeyPath, *FString::Join(Binding.AllowedValues, TEXT(", ")));
+				return false;
+			}
+		}
+		else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+		{
+			if (Binding.bRequired && FScriptArrayHelper(ArrayProp, ValuePtr).Num() == 0)
+			{
+				OutError = FString::Printf(TEXT("Required parameter '%s' is missing or empty"), *KeyPath);
+				return false;
+			}
+		}
+		else if (const FNumericProperty* NumProp = CastField<FNumericProperty>(Property))
+		{
+			if (Binding.Min.IsSet() || Binding.Max.IsSet())
+			{
+				const double Number = NumProp->IsFloatingPoint()
+					? NumProp->GetFloatingPointPropertyValue(ValuePtr)
+					: static_cast<double>(NumProp->GetSignedIntPropertyValue(ValuePtr));
+				if ((Binding.Min.IsSet() && Number < Binding.Min.GetValue()) ||
+					(Binding.Max.IsSet() && Number > Binding.Max.GetValue()))
+				{
+					OutError = FString::Printf(TEXT("Parameter '%s' is out of range (%s..%s)"),
+						*KeyPath,
+						Binding.Min.IsSet() ? *FString::SanitizeFloat(Binding.Min.GetValue()) : TEXT(""),
+						Binding.Max.IsSet() ? *FString::SanitizeFloat(Binding.Max.GetValue()) : TEXT(""));
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FMCPParamSchema::DecodeValue(const FProperty* Property, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, const FString& JsonType, const FString& KeyPath, FString& OutError)
+{
+	// Raw JSON stays in the params; only its JSON type is checked
+	if (IsRawJsonStruct(Property))
+	{
+		if (!MatchesJsonType(Value, JsonType))
+		{
+			OutError = FString::Printf(TEXT("Parameter '%s' must be a %s"), *KeyPath, *JsonType);
+			return false;
+		}
+		return true;
+	}
+
+	bool bDecoded = false;
+	const FStructProperty* StructProp = CastField<FStructProperty>(Property);
+	const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property);
+	if (StructProp && StructProp->Struct == TBaseStructure<FVector>::Get())
+	{
+		FVector& Vector = *static_cast<FVector*>(ValuePtr);
+		bDecoded = ReadNumberTriple(Value, Vector.X, Vector.Y, Vector.Z);
+	}
+	else if (StructProp && StructProp->Struct == TBaseStructure<FRotator>::Get())
+	{
+		FRotator& Rotator = *static_cast<FRotator*>(ValuePtr);
+		bDecoded = ReadNumberTriple(Value, Rotator.Pitch, Rotator.Yaw, Rotator.Roll);
+	}
+	else if (StructProp)
+	{
+		// Nested params structs use the same snake_case keys and metadata as the top level
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (Value->TryGetObject(Object))
+		{
+			return DecodeStruct(StructProp->Struct, ValuePtr, *Object, KeyPath, OutError);
+		}
+	}
+	else if (ArrayProp)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
+		if (Value->TryGetArray(Items))
+		{
+			FScriptArrayHelper Helper(ArrayProp, ValuePtr);
+			Helper.EmptyAndAddValues(Items->Num());
+			for (int32 i = 0; i < Items->Num(); ++i)
+			{
+				const TSharedPtr<FJsonValue>& Item = (*Items)[i];
+				const FString ItemPath = FString::Printf(TEXT("%s[%d]"), *KeyPath, i);
+				if (!Item.IsValid() || Item->IsNull())
+				{
+					OutError = FString::Printf(TEXT("Parameter '%s' must not be null"), *ItemPath);
+					return false;
+				}
+				if (!DecodeValue(ArrayProp->Inner, Helper.GetRawPtr(i), Item, FString(), ItemPath, OutError))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+	else
+	{
+		bDecoded = FJsonObjectConverter::JsonValueToUProperty(Value, Property, ValuePtr, 0, 0);
+	}
+
+	if (!bDecoded)
+	{
+		OutError = FString::Printf(TEXT("Parameter '%s' must be a %s"), *KeyPath, *DescribeExpectedType(Property));
+		return false;
+	}
+	return true;
+}
+
+TSharedPtr<FJsonObject> FMCPParamSchema::BuildPropertySchema(const FProperty* Property)
+{
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+
+	const UEnum* Enum = nullptr;
+	if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+	{
+		Enum = EnumProp->GetEnum();
+	}
+	else if (const FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+	{
+		Enum = ByteProp->Enum;
+	}
+
+	if (IsRawJsonStruct(Property))
+	{
+		// Any JSON value; JsonType (set by the caller from metadata) narrows it
+	}
+	else if (Enum)
+	{
+		Schema->SetStringField(TEXT("type"), TEXT("string"));
+		TArray<TSharedPtr<FJsonValue>> Names;
+		for (int32 i = 0; i < Enum->NumEnums() - 1; ++i)
+		{
+			Names.Add(MakeShared<FJsonValueString>(Enum->GetNameStringByIndex(i)));
+		}
+		Schema->SetArrayField(TEXT("enum"), Names);
+	}
+	else if (CastField<FBoolProperty>(Property))
+	{
+		Schema->SetStringField(TEXT("type"), TEXT("boolean"));
+	}
+	else if (const FNumericProperty* NumProp = CastField<FNumericProperty>(Property))
+	{
+		Schema->SetStringField(TEXT("type"), NumProp->IsInteger() ? TEXT("integer") : TEXT("number"));
+	}
+	else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
+	{
+		Schema->SetStringField(TEXT("type"), TEXT("array"));
+		Schema->SetObjectField(TEXT("items"), BuildPropertySchema(ArrayProp->Inner));
+	}
+	else if (const FStructProperty* StructProp = CastField<FStructProperty>(Property))
+	{
+		if (StructProp->Struct == TBaseStructure<FVector>::Get() || StructProp->Struct == TBaseStructure<FRotator>::Get())
+		{
+			TSharedPtr<FJsonObject> Items = MakeShared<FJsonObject>();
+			Items->SetStringField(TEXT("type"), TEXT("number"));
+			Schema->SetStringField(TEXT("type"), TEXT("array"));
+			Schema->SetObjectField(TEXT("items"), Items);
+			Schema->SetNumberField(TEXT("minItems"), 3);
+			Schema->SetNumberField(TEXT("maxItems"), 3);
+		}
+		else
+		{
+			Schema = BuildJsonSchema(StructProp->Struct);
+		}
+	}
+	else if (CastField<FMapProperty>(Property))
+	{
+		Schema->SetStringField(TEXT("type"), TEXT("object"));
+	}
+	else
+	{
+		// FString, FName, FText
+		Schema->SetStringField(TEXT("type"), TEXT("string"));
+	}
+
+	return Schema;
+}
+
+TSharedPtr<FJsonObject> FMCPParamSchema::BuildJsonSchema(const UScriptStruct* Struct)
+{
+	TSharedPtr<FJsonObject> Schema = MakeShared<FJsonObject>();
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+
+	TSharedPtr<FJsonObject> Properties = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> Required;
+
+	TSharedRef<const TArray<FParamBinding>> Bindings = GetBindings(Struct);
+	for (const FParamBinding& Binding : *Bindings)
+	{
+		TSharedPtr<FJsonObject> PropertySchema = BuildPropertySchema(Binding.Property);
+		if (!Binding.JsonType.IsEmpty())
+		{
+			PropertySchema->SetStringField(TEXT("type"), Binding.JsonType);
+		}
+
+		const FString Description = Binding.Property->GetToolTipText().ToString();
+		if (!Description.IsEmpty())
+		{
+			PropertySchema->SetStringField(TEXT("description"), Description);
+		}
+		if (Binding.Min.IsSet())
+		{
+			PropertySchema->SetNumberField(TEXT("minimum"), Binding.Min.GetValue());
+		}
+		if (Binding.Max.IsSet())
+		{
+			PropertySchema->SetNumberField(TEXT("maximum"), Binding.Max.GetValue());
+		}
+		if (Binding.AllowedValues.Num() > 0)
+		{
+			TArray<TSharedPtr<FJsonValue>> Allowed;
+			for (const FString& Value : Binding.AllowedValues)
+			{
+				Allowed.Add(MakeShared<FJsonValueString>(Value));
+			}
+			PropertySchema->SetArrayField(TEXT("enum"), Allowed);
+		}
+
+		Properties->SetObjectField(Binding.Key, PropertySchema);
+		if (Binding.bRequired)
+		{
+			Required.Add(MakeShared<FJsonValueString>(Binding.Key));
+		}
+	}
+
+	Schema->SetObjectField(TEXT("properties"), Properties);
+	Schema->SetArrayField(TEXT("required"), Required);
+	return Schema;
+}
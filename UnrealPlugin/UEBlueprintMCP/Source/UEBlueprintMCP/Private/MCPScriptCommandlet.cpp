@@ -0,0 +1,313 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPScriptCommandlet.h"
+#include "MCPBridge.h"
+#include "MCPMetrics.h"
+#include "Editor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "MCPLog.h"
+#include <cstdio>
+
+namespace
+{
+	using FCondensedWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	/** Script lines from a file, or from stdin as they arrive */
+	class FMCPScriptSource
+	{
+	public:
+		explicit FMCPScriptSource(const FString& Path)
+			: bStdin(Path.IsEmpty() || Path == TEXT("-"))
+		{
+			if (!bStdin && !FFileHelper::LoadFileToStringArray(Lines, *Path))
+			{
+				bFailed = true;
+			}
+		}
+
+		bool HasFailed() const { return bFailed; }
+
+		bool Next(FString& OutLine)
+		{
+			if (!bStdin)
+			{
+				if (NextIndex >= Lines.Num())
+				{
+					return false;
+				}
+				OutLine = Lines[NextIndex++];
+				return true;
+			}
+
+			// Lines can be longer than the buffer; keep reading until the newline
+			TArray<ANSICHAR> Bytes;
+			ANSICHAR Buffer[4096];
+			while (fgets(Buffer, sizeof(Buffer), stdin))
+			{
+				const int32 Len = FCStringAnsi::Strlen(Buffer);
+				Bytes.Append(Buffer, Len);
+				if (Len > 0 && Buffer[Len - 1] == '\n')
+				{
+					break;
+				}
+			}
+			if (Bytes.Num() == 0)
+			{
+				return false;
+			}
+			Bytes.Add('\0');
+			FUTF8ToTCHAR Converter(Bytes.GetData(), Bytes.Num() - 1);
+			OutLine = FString(Converter.Length(), Converter.Get());
+			return true;
+		}
+
+	private:
+		bool bStdin;
+		bool bFailed = false;
+		TArray<FString> Lines;
+		int32 NextIndex = 0;
+	};
+
+	/** Result lines to a file or to stdout, flushed per line so a reader sees each as it finishes */
+	class FMCPResultSink
+	{
+	public:
+		explicit FMCPResultSink(const FString& Path)
+		{
+			if (!Path.IsEmpty() && Path != TEXT("-"))
+			{
+				File.Reset(IFileManager::Get().CreateFileWriter(*Path));
+				bFailed = !File.IsValid();
+			}
+		}
+
+		bool HasFailed() const { return bFailed; }
+
+		void Write(const TSharedRef<FJsonObject>& Object)
+		{
+			FString Line;
+			TSharedRef<FCondensedWriter> Writer = FCondensedWriterFactory::Create(&Line);
+			FJsonSerializer::Serialize(Object, Writer);
+
+			if (!File.IsValid())
+			{
+				Line = UMCPScriptCommandlet::StdoutPrefix + Line;
+			}
+			FTCHARToUTF8 Converter(*Line, Line.Len());
+
+			if (File.IsValid())
+			{
+				File->Serialize(const_cast<void*>(static_cast<const void*>(Converter.Get())), Converter.Length());
+				ANSICHAR Newline = '\n';
+				File->Serialize(&Newline, 1);
+				File->Flush();
+			}
+			else
+			{
+				fwrite(Converter.Get(), 1, Converter.Length(), stdout);
+				fputc('\n', stdout);
+				fflush(stdout);
+			}
+		}
+
+	private:
+		TUniquePtr<FArchive> File;
+		bool bFailed = false;
+	};
+
+	bool IsSuccess(const TSharedPtr<FJsonObject>& Response)
+	{
+		bool bSuccess = false;
+		return Response.IsValid() && Response->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess;
+	}
+}
+
+UMCPScriptCommandlet::UMCPScriptCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UMCPScriptCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> Values;
+	ParseCommandLine(*Params, Tokens, Switches, Values);
+
+	const FString* SaveEveryValue = Values.Find(TEXT("SaveEvery"));
+	const int32 SaveEvery = SaveEveryValue ? FMath::Max(0, FCString::Atoi(**SaveEveryValue)) : DefaultSaveEvery;
+	const FString DefaultSession = Values.Contains(TEXT("Session")) ? Values[TEXT("Session")] : FString(TEXT("script"));
+	const bool bStopOnError = Switches.Contains(TEXT("StopOnError"));
+
+	UMCPBridge* Bridge = GEditor ? GEditor->GetEditorSubsystem<UMCPBridge>() : nullptr;
+	if (!Bridge)
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: MCPScript needs the editor (run UnrealEditor-Cmd with -run=MCPScript)"));
+		return 1;
+	}
+
+	FMCPScriptSource Source(Values.FindRef(TEXT("Script")));
+	if (Source.HasFailed())
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to read script %s"), *Values.FindRef(TEXT("Script")));
+		return 1;
+	}
+	FMCPResultSink Sink(Values.FindRef(TEXT("Output")));
+	if (Sink.HasFailed())
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to open output %s"), *Values.FindRef(TEXT("Output")));
+		return 1;
+	}
+
+	// Actions find assets by name, so the registry has to be complete first
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 LineNumber = 0;
+	int32 Commands = 0;
+	int32 Failures = 0;
+	int32 Flushes = 0;
+	int32 SinceFlush = 0;
+
+	auto Flush = [&]()
+	{
+		FMCPRequestTimings Timings;
+		const double FlushStart = FPlatformTime::Seconds();
+		TSharedPtr<FJsonObject> Result = Bridge->FlushDeferredSaves(&Timings);
+
+		TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+		Line->SetNumberField(TEXT("flush"), ++Flushes);
+		Line->SetNumberField(TEXT("ms"), (FPlatformTime::Seconds() - FlushStart) * 1000.0);
+		Line->SetObjectField(TEXT("result"), Result);
+		Sink.Write(Line);
+
+		SinceFlush = 0;
+		if (!IsSuccess(Result))
+		{
+			++Failures;
+			return false;
+		}
+		return true;
+	};
+
+	FString Text;
+	while (Source.Next(Text))
+	{
+		++LineNumber;
+		Text.TrimStartAndEndInline();
+		if (Text.IsEmpty() || Text.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> Request;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Text);
+		FString CommandType;
+		const bool bParsed = FJsonSerializer::Deserialize(Reader, Request) && Request.IsValid() && Request->TryGetStringField(TEXT("type"), CommandType);
+
+		if (bParsed && CommandType == TEXT("flush"))
+		{
+			if (!Flush() && bStopOnError)
+			{
+				break;
+			}
+			continue;
+		}
+
+		FString SessionId;
+		FString RequestId;
+		double Ms = 0.0;
+		TSharedPtr<FJsonObject> Response;
+		if (!bParsed)
+		{
+			Response = UMCPBridge::CreateErrorResponse(TEXT("Expected a JSON object with a 'type' field"), TEXT("validation_failed"));
+		}
+		else
+		{
+			if (!Request->TryGetStringField(TEXT("session"), SessionId) || SessionId.IsEmpty())
+			{
+				SessionId = DefaultSession;
+			}
+			Request->TryGetStringField(TEXT("id"), RequestId);
+			Response = RunRequest(*Bridge, CommandType, Request, SessionId, Ms);
+			++Commands;
+			++SinceFlush;
+		}
+
+		TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+		Line->SetNumberField(TEXT("line"), LineNumber);
+		if (!RequestId.IsEmpty())
+		{
+			Line->SetStringField(TEXT("id"), RequestId);
+		}
+		Line->SetStringField(TEXT("type"), CommandType);
+		Line->SetNumberField(TEXT("ms"), Ms);
+		Line->SetObjectField(TEXT("result"), Response);
+		Sink.Write(Line);
+
+		if (!IsSuccess(Response))
+		{
+			++Failures;
+			if (bStopOnError)
+			{
+				break;
+			}
+		}
+
+		if (SaveEvery > 0 && SinceFlush >= SaveEvery && !Flush() && bStopOnError)
+		{
+			break;
+		}
+	}
+
+	if (SinceFlush > 0)
+	{
+		Flush();
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogUEBlueprintMCP, Display, TEXT("UEBlueprintMCP: MCPScript ran %d commands in %.2fs (%.1f/s), %d flushes, %d failures"),
+		Commands, Seconds, Seconds > 0.0 ? Commands / Seconds : 0.0, Flushes, Failures);
+
+	return Failures > 0 ? 1 : 0;
+}
+
+TSharedPtr<FJsonObject> UMCPScriptCommandlet::RunRequest(UMCPBridge& Bridge, const FString& CommandType, const TSharedPtr<FJsonObject>& Request, const FString& SessionId, double& OutMs)
+{
+	const double Start = FPlatformTime::Seconds();
+
+	TSharedPtr<FJsonObject> Response;
+	if (CommandType == TEXT("ping"))
+	{
+		Response = MakeShared<FJsonObject>();
+		Response->SetBoolField(TEXT("success"), true);
+		Response->SetBoolField(TEXT("pong"), true);
+	}
+	else
+	{
+		const TSharedPtr<FJsonObject>* ParamsPtr = nullptr;
+		const TSharedPtr<FJsonObject> Params = Request->TryGetObjectField(TEXT("params"), ParamsPtr) ? *ParamsPtr : MakeShared<FJsonObject>();
+
+		FMCPRequestTimings Timings;
+		Response = Bridge.ExecuteCommandWithoutSave(CommandType, Params, SessionId, &Timings);
+		if (!Response.IsValid())
+		{
+			Response = UMCPBridge::CreateErrorResponse(FString::Printf(TEXT("%s returned no response"), *CommandType), TEXT("crash_prevented"));
+		}
+	}
+
+	OutMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+	return Response;
+}
@@ -0,0 +1,657 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPSnapshot.h"
+#include "MCPChangeJournal.h"
+#include "MCPCommonUtils.h"
+#include "MCPResponseWriter.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/Blueprint.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/GameplayStatics.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node_Event.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "UObject/UObjectGlobals.h"
+#include "MCPLog.h"
+
+// =========================================================================
+// Helpers
+// =========================================================================
+
+namespace
+{
+	/** Commands TryServe() answers from the level view */
+	const TCHAR* LevelQueries[] = { TEXT("get_actors_in_level"), TEXT("find_actors_by_name"), TEXT("get_actor_properties") };
+
+	/** Commands TryServe() answers from a graph view */
+	const TCHAR* GraphQueries[] = { TEXT("find_blueprint_nodes"), TEXT("get_node_pins") };
+
+	bool IsOneOf(const FString& CommandType, TArrayView<const TCHAR* const> Names)
+	{
+		for (const TCHAR* Name : Names)
+		{
+			if (CommandType == Name)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool IsActorChange(EMCPChangeKind Kind)
+	{
+		return Kind == EMCPChangeKind::ActorAdded || Kind == EMCPChangeKind::ActorRemoved
+			|| Kind == EMCPChangeKind::ActorMoved || Kind == EMCPChangeKind::ActorPropertyChanged;
+	}
+
+	FString GetParamString(const TSharedPtr<FJsonObject>& Params, const TCHAR* Key)
+	{
+		FString Value;
+		Params->TryGetStringField(Key, Value);
+		return Value;
+	}
+
+	/** Live actor with this name in any loaded level of World */
+	AActor* FindLevelActor(UWorld* World, const FString& Name)
+	{
+		const FName ActorName(*Name);
+		for (ULevel* Level : World->GetLevels())
+		{
+			AActor* Actor = Level ? FindObjectFast<AActor>(Level, ActorName) : nullptr;
+			if (IsValid(Actor))
+			{
+				return Actor;
+			}
+		}
+		return nullptr;
+	}
+
+	FMCPActorSnapshot MakeActorRow(const AActor* Actor)
+	{
+		FMCPActorSnapshot Row;
+		Row.Name = Actor->GetName();
+		Row.ClassName = Actor->GetClass()->GetName();
+		Row.Location = Actor->GetActorLocation();
+		Row.Rotation = Actor->GetActorRotation();
+		Row.Scale = Actor->GetActorScale3D();
+		return Row;
+	}
+
+	/** Same fields and order as FMCPCommonUtils::WriteActorFields */
+	void WriteActorRow(FMCPResponseWriter& Writer, const FMCPActorSnapshot& Row)
+	{
+		Writer.WriteField(TEXT("name"), Row.Name);
+		Writer.WriteField(TEXT("class"), Row.ClassName);
+		Writer.WriteVectorField(TEXT("location"), Row.Location);
+		Writer.WriteRotatorField(TEXT("rotation"), Row.Rotation);
+		Writer.WriteVectorField(TEXT("scale"), Row.Scale);
+	}
+
+	/** The graph node actions use when no graph_name is given (see FEditorAction::FindGraph) */
+	UEdGraph* FindDefaultGraph(UBlueprint* Blueprint)
+	{
+		for (UEdGraph* Graph : Blueprint->UbergraphPages)
+		{
+			if (Graph && Graph->GetFName() == TEXT("EventGraph"))
+			{
+				return Graph;
+			}
+		}
+		return Blueprint->UbergraphPages.Num() > 0 ? Blueprint->UbergraphPages[0] : nullptr;
+	}
+
+	UEdGraph* FindGraphByName(UBlueprint* Blueprint, const FString& GraphName)
+	{
+		if (GraphName.IsEmpty())
+		{
+			return FindDefaultGraph(Blueprint);
+		}
+
+		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+		{
+			if (Graph && Graph->GetFName().ToString() == GraphName)
+			{
+				return Graph;
+			}
+		}
+		for (UEdGraph* Graph : Blueprint->UbergraphPages)
+		{
+			if (Graph && Graph->GetFName().ToString() == GraphName)
+			{
+				return Graph;
+			}
+		}
+		return nullptr;
+	}
+
+	TSharedRef<FMCPGraphSnapshot> BuildGraphSnapshot(const UBlueprint* Blueprint, const UEdGraph* Graph)
+	{
+		TSharedRef<FMCPGraphSnapshot> Snapshot = MakeShared<FMCPGraphSnapshot>();
+		Snapshot->BlueprintName = Blueprint->GetName();
+		Snapshot->GraphName = Graph->GetName();
+		Snapshot->Nodes.Reserve(Graph->Nodes.Num());
+		Snapshot->NodeIndex.Reserve(Graph->Nodes.Num());
+
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node) continue;
+
+			FMCPNodeSnapshot& Row = Snapshot->Nodes.AddDefaulted_GetRef();
+			Row.NodeGuid = Node->NodeGuid.ToString();
+			Row.NodeClass = Node->GetClass()->GetName();
+			Row.Title = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
+
+			if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+			{
+				Row.Kind = EMCPSnapshotNodeKind::Event;
+				Row.EventName = EventNode->EventReference.GetMemberName();
+				if (const UK2Node_CustomEvent* CustomNode = Cast<UK2Node_CustomEvent>(Node))
+				{
+					Row.CustomEventName = CustomNode->CustomFunctionName;
+				}
+			}
+			else if (Cast<UK2Node_CallFunction>(Node))
+			{
+				Row.Kind = EMCPSnapshotNodeKind::Function;
+			}
+			else if (Cast<UK2Node_VariableGet>(Node) || Cast<UK2Node_VariableSet>(Node))
+			{
+				Row.Kind = EMCPSnapshotNodeKind::Variable;
+			}
+
+			Row.Pins.Reserve(Node->Pins.Num());
+			for (const UEdGraphPin* Pin : Node->Pins)
+			{
+				if (!Pin) continue;
+
+				FMCPPinSnapshot& PinRow = Row.Pins.AddDefaulted_GetRef();
+				PinRow.Name = Pin->PinName.ToString();
+				PinRow.bInput = Pin->Direction == EGPD_Input;
+				PinRow.Category = Pin->PinType.PinCategory.ToString();
+				if (Pin->PinType.PinSubCategory != NAME_None)
+				{
+					PinRow.SubCategory = Pin->PinType.PinSubCategory.ToString();
+				}
+				if (const UObject* SubObject = Pin->PinType.PinSubCategoryObject.Get())
+				{
+					PinRow.SubCategoryObject = SubObject->GetName();
+				}
+				PinRow.bHidden = Pin->bHidden;
+			}
+
+			// First node wins on duplicate GUIDs, like the linear search in the actions
+			if (!Snapshot->NodeIndex.Contains(Row.NodeGuid))
+			{
+				Snapshot->NodeIndex.Add(Row.NodeGuid, Snapshot->Nodes.Num() - 1);
+			}
+		}
+
+		return Snapshot;
+	}
+}
+
+const FMCPActorSnapshot* FMCPLevelSnapshot::FindActor(const FString& Name) const
+{
+	const int32* Index = ActorIndex.Find(Name);
+	return Index ? &Actors[*Index] : nullptr;
+}
+
+const FMCPNodeSnapshot* FMCPGraphSnapshot::FindNode(const FString& NodeGuid) const
+{
+	const int32* Index = NodeIndex.Find(NodeGuid);
+	return Index ? &Nodes[*Index] : nullptr;
+}
+
+FMCPSnapshotStore::FMCPSnapshotStore(const TSharedPtr<FMCPChangeJournal>& InChangeJournal)
+	: ChangeJournal(InChangeJournal)
+	, PublishedRevision(InChangeJournal.IsValid() ? InChangeJournal->GetRevision() : 0)
+{
+}
+
+// =========================================================================
+// Publishing
+// =========================================================================
+
+void FMCPSnapshotStore::PublishChanges(UWorld* World)
+{
+	check(IsInGameThread());
+
+	if (!ChangeJournal.IsValid())
+	{
+		return;
+	}
+
+	const int64 Revision = ChangeJournal->GetRevision();
+	const int64 SinceRevision = PublishedRevision;
+	if (Revision <= SinceRevision)
+	{
+		return;
+	}
+
+	TArray<FMCPChangeEntry> Entries;
+	if (!ChangeJournal->GetChangesSince(SinceRevision, 0, Entries))
+	{
+		// History was evicted before it was published: rebuild what was primed
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Snapshot store fell behind the change journal, republishing"));
+		const bool bHadLevel = GetLevel().IsValid();
+		Reset();
+		if (bHadLevel && World)
+		{
+			PublishLevel(World);
+		}
+		PublishedRevision = Revision;
+		return;
+	}
+
+	TSet<FString> TouchedActors;
+	TSet<TPair<FString, FString>> TouchedGraphs;
+	for (const FMCPChangeEntry& Entry : Entries)
+	{
+		if (IsActorChange(Entry.Kind))
+		{
+			TouchedActors.Add(Entry.Target);
+		}
+		else if (!Entry.Target.IsEmpty() && !Entry.Graph.IsEmpty())
+		{
+			TouchedGraphs.Add(TPair<FString, FString>(Entry.Target, Entry.Graph));
+		}
+	}
+
+	if (TouchedActors.Num() > 0 && World && GetLevel().IsValid())
+	{
+		PublishActors(World, TouchedActors);
+	}
+
+	for (const TPair<FString, FString>& Touched : TouchedGraphs)
+	{
+		UBlueprint* Blueprint = FMCPCommonUtils::FindBlueprint(Touched.Key);
+		UEdGraph* Graph = Blueprint ? FindGraphByName(Blueprint, Touched.Value) : nullptr;
+		if (Graph)
+		{
+			PublishGraph(Blueprint, Graph);
+		}
+		else
+		{
+			RemoveGraph(Touched.Key, Touched.Value);
+		}
+	}
+
+	// Views first, revision last: a reader that sees the revision sees the views
+	PublishedRevision = Revision;
+}
+
+void FMCPSnapshotStore::PrimeForQuery(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, UWorld* World)
+{
+	check(IsInGameThread());
+
+	if (IsOneOf(CommandType, LevelQueries))
+	{
+		if (World && !GetLevel().IsValid())
+		{
+			PublishLevel(World);
+		}
+		return;
+	}
+
+	if (IsOneOf(CommandType, GraphQueries) && Params.IsValid())
+	{
+		// Without an explicit Blueprint the query depends on the session's current one
+		const FString BlueprintName = GetParamString(Params, TEXT("blueprint_name"));
+		const FString GraphName = GetParamString(Params, TEXT("graph_name"));
+		if (BlueprintName.IsEmpty() || FindGraph(BlueprintName, GraphName).IsValid())
+		{
+			return;
+		}
+
+		// Views are keyed by asset name, so a path-style blueprint_name never hits; don't build one for it
+		UBlueprint* Blueprint = FMCPCommonUtils::FindBlueprint(BlueprintName);
+		UEdGraph* Graph = Blueprint ? FindGraphByName(Blueprint, GraphName) : nullptr;
+		if (Graph && Blueprint->GetName() == BlueprintName)
+		{
+			PublishGraph(Blueprint, Graph);
+		}
+	}
+}
+
+void FMCPSnapshotStore::InvalidateBlueprint(const FString& BlueprintName)
+{
+	const FString Prefix = BlueprintName + TEXT("/");
+
+	FWriteScopeLock WriteLock(Lock);
+	for (auto It = Graphs.CreateIterator(); It; ++It)
+	{
+		if (It.Key().StartsWith(Prefix))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMCPSnapshotStore::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Level.Reset();
+	Graphs.Empty();
+}
+
+void FMCPSnapshotStore::PublishLevel(UWorld* World)
+{
+	TArray<AActor*> AllActors;
+	UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
+
+	TSharedRef<FMCPLevelSnapshot> Snapshot = MakeShared<FMCPLevelSnapshot>();
+	Snapshot->Actors.Reserve(AllActors.Num());
+	Snapshot->ActorIndex.Reserve(AllActors.Num());
+	for (AActor* Actor : AllActors)
+	{
+		if (!Actor) continue;
+
+		FMCPActorSnapshot Row = MakeActorRow(Actor);
+		if (!Snapshot->ActorIndex.Contains(Row.Name))
+		{
+			Snapshot->ActorIndex.Add(Row.Name, Snapshot->Actors.Num());
+		}
+		Snapshot->Actors.Add(MoveTemp(Row));
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Level = Snapshot;
+}
+
+void FMCPSnapshotStore::PublishActors(UWorld* World, const TSet<FString>& TouchedActors)
+{
+	TSharedPtr<const FMCPLevelSnapshot> Previous = GetLevel();
+	if (!Previous.IsValid() || TouchedActors.Num() > Previous->Actors.Num() / 2)
+	{
+		// Patching most of the rows costs as much as a fresh build
+		PublishLevel(World);
+		return;
+	}
+
+	TSharedRef<FMCPLevelSnapshot> Snapshot = MakeShared<FMCPLevelSnapshot>(*Previous);
+	bool bRemoved = false;
+
+	for (const FString& Name : TouchedActors)
+	{
+		const AActor* Actor = FindLevelActor(World, Name);
+		const int32* Index = Snapshot->ActorIndex.Find(Name);
+
+		if (Actor)
+		{
+			if (Index)
+			{
+				Snapshot->Actors[*Index] = MakeActorRow(Actor);
+			}
+			else
+			{
+				Snapshot->ActorIndex.Add(Name, Snapshot->Actors.Num());
+				Snapshot->Actors.Add(MakeActorRow(Actor));
+			}
+		}
+		else if (Index)
+		{
+			// Cleared here, compacted below so indices stay valid during the loop
+			Snapshot->Actors[*Index].Name.Empty();
+			Snapshot->ActorIndex.Remove(Name);
+			bRemoved = true;
+		}
+	}
+
+	if (bRemoved)
+	{
+		Snapshot->Actors.RemoveAll([](const FMCPActorSnapshot& Row) { return Row.Name.IsEmpty(); });
+		Snapshot->ActorIndex.Reset();
+		for (int32 i = 0; i < Snapshot->Actors.Num(); ++i)
+		{
+			if (!Snapshot->ActorIndex.Contains(Snapshot->Actors[i].Name))
+			{
+				Snapshot->ActorIndex.Add(Snapshot->Actors[i].Name, i);
+			}
+		}
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+	Level = Snapshot;
+}
+
+void FMCPSnapshotStore::PublishGraph(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	TSharedRef<FMCPGraphSnapshot> Snapshot = BuildGraphSnapshot(Blueprint, Graph);
+	const bool bIsDefault = FindDefaultGraph(Blueprint) == Graph;
+
+	FWriteScopeLock WriteLock(Lock);
+	Graphs.Add(MakeGraphKey(Snapshot->BlueprintName, Snapshot->GraphName), Snapshot);
+	if (bIsDefault)
+	{
+		Graphs.Add(MakeGraphKey(Snapshot->BlueprintName, FString()), Snapshot);
+	}
+}
+
+void FMCPSnapshotStore::RemoveGraph(const FString& BlueprintName, const FString& GraphName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	Graphs.Remove(MakeGraphKey(BlueprintName, GraphName));
+
+	const FString DefaultKey = MakeGraphKey(BlueprintName, FString());
+	const TSharedPtr<const FMCPGraphSnapshot>* Default = Graphs.Find(DefaultKey);
+	if (Default && (*Default)->GraphName == GraphName)
+	{
+		Graphs.Remove(DefaultKey);
+	}
+}
+
+FString FMCPSnapshotStore::MakeGraphKey(const FString& BlueprintName, const FString& GraphName)
+{
+	return BlueprintName + TEXT("/") + GraphName;
+}
+
+// =========================================================================
+// Queries
+// =========================================================================
+
+bool FMCPSnapshotStore::IsCurrent() const
+{
+	return !ChangeJournal.IsValid() || ChangeJournal->GetRevision() <= PublishedRevision;
+}
+
+TSharedPtr<const FMCPLevelSnapshot> FMCPSnapshotStore::GetLevel() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Level;
+}
+
+TSharedPtr<const FMCPGraphSnapshot> FMCPSnapshotStore::FindGraph(const FString& BlueprintName, const FString& GraphName) const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Graphs.FindRef(MakeGraphKey(BlueprintName, GraphName));
+}
+
+bool FMCPSnapshotStore::CanServe(const FString& CommandType)
+{
+	return IsOneOf(CommandType, LevelQueries) || IsOneOf(CommandType, GraphQueries);
+}
+
+bool FMCPSnapshotStore::TryServe(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const
+{
+	if (!Params.IsValid() || !IsCurrent())
+	{
+		return false;
+	}
+
+	if (CommandType == TEXT("get_actors_in_level"))  return ServeActorsInLevel(Params, Writer);
+	if (CommandType == TEXT("find_actors_by_name"))  return ServeFindActorsByName(Params, Writer);
+	if (CommandType == TEXT("get_actor_properties")) return ServeActorProperties(Params, Writer);
+	if (CommandType == TEXT("find_blueprint_nodes")) return ServeFindBlueprintNodes(Params, Writer);
+	if (CommandType == TEXT("get_node_pins"))        return ServeNodePins(Params, Writer);
+	return false;
+}
+
+bool FMCPSnapshotStore::ServeActorsInLevel(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const
+{
+	TSharedPtr<const FMCPLevelSnapshot> Snapshot = GetLevel();
+	if (!Snapshot.IsValid())
+	{
+		return false;
+	}
+
+	Writer.BeginResponse(true);
+	Writer.BeginArray(TEXT("actors"));
+	for (const FMCPActorSnapshot& Row : Snapshot->Actors)
+	{
+		Writer.BeginObject();
+		WriteActorRow(Writer, Row);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndResponse();
+	return true;
+}
+
+bool FMCPSnapshotStore::ServeFindActorsByName(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const
+{
+	const FString Pattern = GetParamString(Params, TEXT("pattern"));
+	TSharedPtr<const FMCPLevelSnapshot> Snapshot = GetLevel();
+	if (Pattern.IsEmpty() || !Snapshot.IsValid())
+	{
+		return false;
+	}
+
+	Writer.BeginResponse(true);
+	Writer.BeginArray(TEXT("actors"));
+	for (const FMCPActorSnapshot& Row : Snapshot->Actors)
+	{
+		if (Row.Name.Contains(Pattern))
+		{
+			Writer.BeginObject();
+			WriteActorRow(Writer, Row);
+			Writer.EndObject();
+		}
+	}
+	Writer.EndArray();
+	Writer.EndResponse();
+	return true;
+}
+
+bool FMCPSnapshotStore::ServeActorProperties(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const
+{
+	TSharedPtr<const FMCPLevelSnapshot> Snapshot = GetLevel();
+	const FMCPActorSnapshot* Row = Snapshot.IsValid() ? Snapshot->FindActor(GetParamString(Params, TEXT("name"))) : nullptr;
+	if (!Row)
+	{
+		// Not-found errors come from the action itself
+		return false;
+	}
+
+	Writer.BeginResponse(true);
+	WriteActorRow(Writer, *Row);
+	Writer.EndResponse();
+	return true;
+}
+
+bool FMCPSnapshotStore::ServeFindBlueprintNodes(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const
+{
+	const FString BlueprintName = GetParamString(Params, TEXT("blueprint_name"));
+	if (BlueprintName.IsEmpty())
+	{
+		return false;
+	}
+
+	TSharedPtr<const FMCPGraphSnapshot> Snapshot = FindGraph(BlueprintName, GetParamString(Params, TEXT("graph_name")));
+	if (!Snapshot.IsValid())
+	{
+		return false;
+	}
+
+	const FString NodeType = GetParamString(Params, TEXT("node_type"));
+	const FString EventName = GetParamString(Params, TEXT("event_name"));
+	const FName WantedEvent = EventName.IsEmpty() ? NAME_None : FName(*EventName);
+
+	// Same filter semantics as FFindBlueprintNodesAction
+	auto Matches = [&](const FMCPNodeSnapshot& Node)
+	{
+		if (NodeType.IsEmpty())
+		{
+			return true;
+		}
+		if (NodeType == TEXT("Event"))
+		{
+			return Node.Kind == EMCPSnapshotNodeKind::Event
+				&& (EventName.IsEmpty() || Node.EventName == WantedEvent || Node.CustomEventName == WantedEvent);
+		}
+		if (NodeType == TEXT("Function"))
+		{
+			return Node.Kind == EMCPSnapshotNodeKind::Function;
+		}
+		if (NodeType == TEXT("Variable"))
+		{
+			return Node.Kind == EMCPSnapshotNodeKind::Variable;
+		}
+		return false;
+	};
+
+	int32 Count = 0;
+	Writer.BeginResponse(true);
+	Writer.BeginArray(TEXT("nodes"));
+	for (const FMCPNodeSnapshot& Node : Snapshot->Nodes)
+	{
+		if (Matches(Node))
+		{
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("node_guid"), Node.NodeGuid);
+			Writer.WriteField(TEXT("node_class"), Node.NodeClass);
+			Writer.WriteField(TEXT("node_title"), Node.Title);
+			Writer.EndObject();
+			++Count;
+		}
+	}
+	Writer.EndArray();
+	Writer.WriteField(TEXT("count"), Count);
+	Writer.EndResponse();
+	return true;
+}
+
+bool FMCPSnapshotStore::ServeNodePins(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const
+{
+	const FString BlueprintName = GetParamString(Params, TEXT("blueprint_name"));
+	if (BlueprintName.IsEmpty())
+	{
+		return false;
+	}
+
+	TSharedPtr<const FMCPGraphSnapshot> Snapshot = FindGraph(BlueprintName, GetParamString(Params, TEXT("graph_name")));
+	const FMCPNodeSnapshot* Node = Snapshot.IsValid() ? Snapshot->FindNode(GetParamString(Params, TEXT("node_id"))) : nullptr;
+	if (!Node)
+	{
+		return false;
+	}
+
+	Writer.BeginResponse(true);
+	Writer.WriteField(TEXT("node_class"), Node->NodeClass);
+	Writer.BeginArray(TEXT("pins"));
+	for (const FMCPPinSnapshot& Pin : Node->Pins)
+	{
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("name"), Pin.Name);
+		Writer.WriteField(TEXT("direction"), Pin.bInput ? TEXT("Input") : TEXT("Output"));
+		Writer.WriteField(TEXT("category"), Pin.Category);
+		if (!Pin.SubCategory.IsEmpty())
+		{
+			Writer.WriteField(TEXT("sub_category"), Pin.SubCategory);
+		}
+		if (!Pin.SubCategoryObject.IsEmpty())
+		{
+			Writer.WriteField(TEXT("sub_category_object"), Pin.SubCategoryObject);
+		}
+		Writer.WriteField(TEXT("is_hidden"), Pin.bHidden);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+	Writer.EndResponse();
+	return true;
+}
@@ -2,12 +2,13 @@
 
 #include "UEBlueprintMCPModule.h"
 #include "Modules/ModuleManager.h"
+#include "MCPLog.h"
 
 #define LOCTEXT_NAMESPACE "FUEBlueprintMCPModule"
 
 void FUEBlueprintMCPModule::StartupModule()
 {
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Module starting up"));
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Module starting up"));
 
 	// The Bridge is an EditorSubsystem and will be automatically created
 	// when the editor starts. It handles server startup internally.
@@ -15,7 +16,7 @@ void FUEBlueprintMCPModule::StartupModule()
 
 void FUEBlueprintMCPModule::ShutdownModule()
 {
-	UE_LOG(LogTemp, Log, TEXT("UEBlueprintMCP: Module shutting down"));
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Module shutting down"));
 
 	// The Bridge will be automatically destroyed as an EditorSubsystem.
 }
@@ -0,0 +1,498 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActionParams.generated.h"
+
+/**
+ * Typed parameter structs for TEditorAction-based actions.
+ *
+ * Each UPROPERTY is one command parameter; its doc comment becomes the
+ * schema description. See FMCPParamSchema for key naming and metadata.
+ */
+
+// ============================================================================
+// Shared
+// ============================================================================
+
+/**
+ * A param whose value can't be typed (e.g. a property value of any type).
+ * It is described in the schema (narrowed by meta=(JsonType="...")) but not
+ * decoded; the action reads it from the raw params.
+ */
+USTRUCT()
+struct FMCPJsonValue
+{
+	GENERATED_BODY()
+};
+
+/** Blueprint/graph selection shared by graph actions (read by GetTargetBlueprint/GetTargetGraph) */
+USTRUCT()
+struct FMCPBlueprintGraphParams
+{
+	GENERATED_BODY()
+
+	/** Name of the Blueprint (defaults to the current Blueprint) */
+	UPROPERTY()
+	FString BlueprintName;
+
+	/** Optional function graph name (defaults to the event graph) */
+	UPROPERTY()
+	FString GraphName;
+};
+
+
+// ============================================================================
+// Editor Actions
+// ============================================================================
+
+USTRUCT()
+struct FMCPDeleteActorParams
+{
+	GENERATED_BODY()
+
+	/** Name of the actor to delete */
+	UPROPERTY(meta = (Required))
+	FString Name;
+};
+
+USTRUCT()
+struct FMCPSpawnActorsParams
+{
+	GENERATED_BODY()
+
+	/** Actor type, Blueprint name or class path shared by all actors */
+	UPROPERTY(meta = (JsonKey = "class"))
+	FString ClassName;
+
+	/** Per-actor class (one entry per actor, or a single shared entry) */
+	UPROPERTY()
+	TArray<FString> Classes;
+
+	/** Flat [x0, y0, z0, x1, y1, z1, ...]; its length sets the actor count */
+	UPROPERTY(meta = (Required))
+	TArray<double> Locations;
+
+	/** Flat [pitch, yaw, roll, ...] per actor, or one shared triple */
+	UPROPERTY()
+	TArray<double> Rotations;
+
+	/** Flat [x, y, z, ...] per actor, or one shared triple */
+	UPROPERTY()
+	TArray<double> Scales;
+
+	/** Optional per-actor names (existing actors with these names are replaced) */
+	UPROPERTY()
+	TArray<FString> Names;
+
+	/** Optional per-actor tag (string) or tags (array of strings) */
+	UPROPERTY()
+	TArray<FMCPJsonValue> Tags;
+};
+
+USTRUCT()
+struct FMCPSetActorTransformsParams
+{
+	GENERATED_BODY()
+
+	/** Actor names */
+	UPROPERTY(meta = (Required))
+	TArray<FString> Names;
+
+	/** Flat [x, y, z, ...] per actor, or one shared triple */
+	UPROPERTY()
+	TArray<double> Locations;
+
+	/** Flat [pitch, yaw, roll, ...] per actor, or one shared triple */
+	UPROPERTY()
+	TArray<double> Rotations;
+
+	/** Flat [x, y, z, ...] per actor, or one shared triple */
+	UPROPERTY()
+	TArray<double> Scales;
+
+	/** Relative operation applied to the whole selection */
+	UPROPERTY(meta = (AllowedValues = "offset, rotate_about_pivot, align_to_grid, scale_about_centroid"))
+	FString Operation;
+
+	/** offset: [x, y, z] */
+	UPROPERTY()
+	FVector Offset = FVector::ZeroVector;
+
+	/** rotate_about_pivot: [pitch, yaw, roll] */
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/** rotate_about_pivot: [x, y, z] (default: centroid) */
+	UPROPERTY()
+	FVector Pivot = FVector::ZeroVector;
+
+	/** align_to_grid: number or [x, y, z] (0 leaves an axis untouched) */
+	UPROPERTY()
+	FMCPJsonValue GridSize;
+
+	/** scale_about_centroid: number or [x, y, z] along world axes (rotated actors are scaled along their own axes by the matching stretch) */
+	UPROPERTY()
+	FMCPJsonValue Scale;
+
+	/** Return resulting flat locations/rotations/scales, one row per found actor as listed in the returned names */
+	UPROPERTY()
+	bool bReturnTransforms = false;
+};
+
+USTRUCT()
+struct FMCPSphereSelector
+{
+	GENERATED_BODY()
+
+	/** [x, y, z] */
+	UPROPERTY(meta = (Required))
+	FVector Center = FVector::ZeroVector;
+
+	/** Sphere radius */
+	UPROPERTY(meta = (Required, ClampMin = "0"))
+	double Radius = 0.0;
+};
+
+USTRUCT()
+struct FMCPBoxSelector
+{
+	GENERATED_BODY()
+
+	/** [x, y, z] */
+	UPROPERTY(meta = (Required))
+	FVector Min = FVector::ZeroVector;
+
+	/** [x, y, z] */
+	UPROPERTY(meta = (Required))
+	FVector Max = FVector::ZeroVector;
+};
+
+/** Actor selector; all given filters must match */
+USTRUCT()
+struct FMCPActorSelector
+{
+	GENERATED_BODY()
+
+	/** Actor names */
+	UPROPERTY()
+	TArray<FString> Names;
+
+	/** Actor type, Blueprint name or class path */
+	UPROPERTY(meta = (JsonKey = "class"))
+	FString ClassName;
+
+	/** Actor tag */
+	UPROPERTY()
+	FString Tag;
+
+	/** Actors whose location is within the sphere */
+	UPROPERTY()
+	FMCPSphereSelector Sphere;
+
+	/** Actors whose location is inside the box */
+	UPROPERTY()
+	FMCPBoxSelector Box;
+};
+
+USTRUCT()
+struct FMCPSetPropertiesBulkParams
+{
+	GENERATED_BODY()
+
+	/** Selector; all given filters must match */
+	UPROPERTY(meta = (Required))
+	FMCPActorSelector Target;
+
+	/** Property path -> value, e.g. {"LightComponent.Intensity": 5000} */
+	UPROPERTY(meta = (Required, JsonType = "object"))
+	FMCPJsonValue Properties;
+};
+
+USTRUCT()
+struct FMCPGetChangesParams
+{
+	GENERATED_BODY()
+
+	/** Last revision seen (0 for everything retained) */
+	UPROPERTY(meta = (ClampMin = "0"))
+	int64 SinceRevision = 0;
+
+	/** Epoch returned with that revision (by get_changes, get_context or export_graph) */
+	UPROPERTY()
+	FString Epoch;
+
+	/** Maximum number of changes to return (0: no limit) */
+	UPROPERTY(meta = (ClampMin = "0"))
+	int32 Limit = 0;
+};
+
+
+// ============================================================================
+// Node Actions
+// ============================================================================
+
+USTRUCT()
+struct FMCPConnectBlueprintNodesParams : public FMCPBlueprintGraphParams
+{
+	GENERATED_BODY()
+
+	/** GUID of the source node */
+	UPROPERTY(meta = (Required))
+	FString SourceNodeId;
+
+	/** Name of the output pin */
+	UPROPERTY(meta = (Required))
+	FString SourcePin;
+
+	/** GUID of the target node */
+	UPROPERTY(meta = (Required))
+	FString TargetNodeId;
+
+	/** Name of the input pin */
+	UPROPERTY(meta = (Required))
+	FString TargetPin;
+};
+
+USTRUCT()
+struct FMCPSetNodePinDefaultParams : public FMCPBlueprintGraphParams
+{
+	GENERATED_BODY()
+
+	/** GUID of the node */
+	UPROPERTY(meta = (Required))
+	FString NodeId;
+
+	/** Name of the pin */
+	UPROPERTY(meta = (Required))
+	FString PinName;
+
+	/** Default value as string */
+	UPROPERTY(meta = (Required))
+	FString DefaultValue;
+};
+
+USTRUCT()
+struct FMCPExportGraphParams : public FMCPBlueprintGraphParams
+{
+	GENERATED_BODY()
+
+	/** Export every graph of the Blueprint */
+	UPROPERTY()
+	bool bAllGraphs = false;
+
+	/** Include hidden pins */
+	UPROPERTY()
+	bool bIncludeHidden = false;
+};
+
+/** apply_graph_patch add_nodes entry */
+USTRUCT()
+struct FMCPGraphPatchAddNode
+{
+	GENERATED_BODY()
+
+	/** Client-local id that later ops can reference */
+	UPROPERTY(meta = (Required))
+	FString Id;
+
+	/** Node-creating command, e.g. add_blueprint_branch_node */
+	UPROPERTY(meta = (Required))
+	FString Action;
+
+	/** The command's usual params (blueprint_name and graph_name come from the patch) */
+	UPROPERTY(meta = (JsonType = "object"))
+	FMCPJsonValue Params;
+
+	/** [X, Y] */
+	UPROPERTY()
+	TArray<double> Position;
+};
+
+/** apply_graph_patch move_nodes entry */
+USTRUCT()
+struct FMCPGraphPatchMoveNode
+{
+	GENERATED_BODY()
+
+	/** Local id from add_nodes or node GUID */
+	UPROPERTY(meta = (Required))
+	FString Node;
+
+	/** [X, Y] */
+	UPROPERTY(meta = (Required))
+	TArray<double> Position;
+};
+
+/** apply_graph_patch pin_defaults entry */
+USTRUCT()
+struct FMCPGraphPatchPinDefault
+{
+	GENERATED_BODY()
+
+	/** Local id from add_nodes or node GUID */
+	UPROPERTY(meta = (Required))
+	FString Node;
+
+	/** Name of the input pin */
+	UPROPERTY(meta = (Required))
+	FString Pin;
+
+	/** Default value as string (empty clears it) */
+	UPROPERTY(meta = (Required, AllowEmpty))
+	FString Value;
+};
+
+/** apply_graph_patch connections entry */
+USTRUCT()
+struct FMCPGraphPatchConnection
+{
+	GENERATED_BODY()
+
+	/** Source node: local id from add_nodes or node GUID */
+	UPROPERTY(meta = (Required))
+	FString From;
+
+	/** Name of the output pin */
+	UPROPERTY(meta = (Required))
+	FString FromPin;
+
+	/** Target node: local id from add_nodes or node GUID */
+	UPROPERTY(meta = (Required))
+	FString To;
+
+	/** Name of the input pin */
+	UPROPERTY(meta = (Required))
+	FString ToPin;
+};
+
+USTRUCT()
+struct FMCPApplyGraphPatchParams : public FMCPBlueprintGraphParams
+{
+	GENERATED_BODY()
+
+	/** Node GUIDs to delete */
+	UPROPERTY()
+	TArray<FString> DeleteNodes;
+
+	/** Nodes to create through node-creating commands */
+	UPROPERTY()
+	TArray<FMCPGraphPatchAddNode> AddNodes;
+
+	/** Nodes to move */
+	UPROPERTY()
+	TArray<FMCPGraphPatchMoveNode> MoveNodes;
+
+	/** Input pin defaults to set */
+	UPROPERTY()
+	TArray<FMCPGraphPatchPinDefault> PinDefaults;
+
+	/** Links to make */
+	UPROPERTY()
+	TArray<FMCPGraphPatchConnection> Connections;
+
+	/** Compile once after applying */
+	UPROPERTY()
+	bool bCompile = true;
+};
+
+
+// ============================================================================
+// Material Actions
+// ============================================================================
+
+/** build_material_graph expressions entry */
+USTRUCT()
+struct FMCPMaterialExpressionSpec
+{
+	GENERATED_BODY()
+
+	/** Unique node name */
+	UPROPERTY(meta = (Required))
+	FString Name;
+
+	/** Expression type (Time, Noise, Multiply, ...) */
+	UPROPERTY(meta = (Required, JsonKey = "class"))
+	FString ClassName;
+
+	/** [X, Y] */
+	UPROPERTY()
+	TArray<double> Position;
+
+	/** Expression properties */
+	UPROPERTY(meta = (JsonType = "object"))
+	FMCPJsonValue Properties;
+};
+
+/** build_material_graph connections entry */
+USTRUCT()
+struct FMCPMaterialConnectionSpec
+{
+	GENERATED_BODY()
+
+	/** Source node name */
+	UPROPERTY(meta = (Required))
+	FString Source;
+
+	/** Output of the source node */
+	UPROPERTY(meta = (ClampMin = "0"))
+	int32 SourceOutputIndex = 0;
+
+	/** Target node name */
+	UPROPERTY(meta = (Required))
+	FString Target;
+
+	/** Input of the target node */
+	UPROPERTY(meta = (Required))
+	FString TargetInput;
+};
+
+/** build_material_graph outputs entry */
+USTRUCT()
+struct FMCPMaterialOutputSpec
+{
+	GENERATED_BODY()
+
+	/** Source node name */
+	UPROPERTY(meta = (Required))
+	FString Source;
+
+	/** Output of the source node */
+	UPROPERTY(meta = (ClampMin = "0"))
+	int32 SourceOutputIndex = 0;
+
+	/** BaseColor, EmissiveColor, Roughness, ... */
+	UPROPERTY(meta = (Required))
+	FString MaterialProperty;
+};
+
+USTRUCT()
+struct FMCPBuildMaterialGraphParams
+{
+	GENERATED_BODY()
+
+	/** Name of the target Material */
+	UPROPERTY(meta = (Required))
+	FString MaterialName;
+
+	/** Material properties {name: value} (ShadingModel, TwoSided, BlendMode, ...) */
+	UPROPERTY(meta = (JsonType = "object"))
+	FMCPJsonValue MaterialProperties;
+
+	/** Expressions to create */
+	UPROPERTY()
+	TArray<FMCPMaterialExpressionSpec> Expressions;
+
+	/** Expression-to-expression links */
+	UPROPERTY()
+	TArray<FMCPMaterialConnectionSpec> Connections;
+
+	/** Bindings to material outputs */
+	UPROPERTY()
+	TArray<FMCPMaterialOutputSpec> Outputs;
+
+	/** Block the game thread until shaders compile, to report compile errors */
+	UPROPERTY()
+	bool bWaitForCompile = false;
+};
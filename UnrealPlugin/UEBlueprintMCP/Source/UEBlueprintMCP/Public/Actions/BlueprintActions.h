@@ -66,6 +66,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("compile_blueprint"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::Heavy; }
 	virtual bool RequiresSave() const override { return false; } // We save explicitly on success
 
 private:
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
 #include "../MCPContext.h"
+#include "../MCPCommandRegistry.h"
+
+class FMCPResponseWriter;
 
 /**
  * FEditorAction
@@ -34,6 +37,26 @@ public:
 	 */
 	TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context);
 
+	/**
+	 * Execute the pipeline without the auto-save step.
+	 * Used by composite actions that run many sub-actions and save once.
+	 *
+	 * @param Params Command parameters
+	 * @param Context Current editor context
+	 * @return JSON response with success/failure and result/error
+	 */
+	TSharedPtr<FJsonObject> ExecuteWithoutSave(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context);
+
+	/**
+	 * Execute the full pipeline and write the response straight into Writer.
+	 * Streaming actions skip the response DOM; others fall back to Execute().
+	 *
+	 * @param Params Command parameters
+	 * @param Context Current editor context
+	 * @param Writer Response writer for the connection's send buffer
+	 */
+	void ExecuteToWriter(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer);
+
 	/**
 	 * Execute the action (called after validation).
 	 * Public for SEH wrapper access on Windows.
@@ -44,6 +67,28 @@ public:
 	 */
 	virtual TSharedPtr<FJsonObject> ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context) = 0;
 
+	/**
+	 * JSON schema of the action's parameters, or nullptr if the action
+	 * does not declare a params struct (see TEditorAction).
+	 */
+	virtual TSharedPtr<FJsonObject> GetParamsSchema() const { return nullptr; }
+
+	/**
+	 * Cost class advertised by list_commands.
+	 */
+	virtual EMCPCommandCost GetCostClass() const { return EMCPCommandCost::Mutating; }
+
+	/**
+	 * Command version advertised by list_commands; bump on breaking param/result changes.
+	 */
+	virtual int32 GetVersion() const { return 1; }
+
+	/**
+	 * Whether the action adds one graph node and reports its node_id
+	 * (such actions can be used as apply_graph_patch add_nodes entries).
+	 */
+	virtual bool CreatesGraphNode() const { return false; }
+
 protected:
 	// =========================================================================
 	// Override These in Subclasses
@@ -79,6 +124,25 @@ protected:
 	 */
 	virtual bool RequiresSave() const { return true; }
 
+	/**
+	 * Whether ExecuteStreaming() is implemented (used by ExecuteToWriter).
+	 */
+	virtual bool SupportsStreaming() const { return false; }
+
+	/**
+	 * Write the result fields after "success": true has been written.
+	 * On failure, return false; the partial response is discarded and
+	 * replaced by an error response built from OutError/OutErrorType.
+	 *
+	 * @param Params Command parameters
+	 * @param Context Current editor context
+	 * @param Writer Response writer positioned inside the response object
+	 * @param OutError Error message if execution fails
+	 * @param OutErrorType Error type if execution fails
+	 * @return True on success
+	 */
+	virtual bool ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType) { return false; }
+
 	// =========================================================================
 	// Helper Methods
 	// =========================================================================
@@ -117,6 +181,9 @@ protected:
 	UEdGraphNode* FindNode(UEdGraph* Graph, const FGuid& NodeId, FString& OutError) const;
 
 private:
+	/** Validate, execute, post-validate and optionally auto-save */
+	TSharedPtr<FJsonObject> RunPipeline(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, bool bAllowSave);
+
 	/**
 	 * Execute with crash protection.
 	 * Uses SEH on Windows, signal handlers on Unix.
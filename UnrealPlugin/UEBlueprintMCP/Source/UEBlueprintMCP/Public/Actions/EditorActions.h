@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "EditorAction.h"
+#include "TypedEditorAction.h"
+#include "ActionParams.h"
 
 class AActor;
 
@@ -19,7 +21,10 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override { return true; }
 	virtual FString GetActionName() const override { return TEXT("get_actors_in_level"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual bool ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType) override;
 };
 
 
@@ -35,7 +40,10 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("find_actors_by_name"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual bool ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType) override;
 };
 
 
@@ -57,17 +65,31 @@ private:
 };
 
 
+/**
+ * FSpawnActorsAction
+ * Spawns many actors from columnar arrays in one pass (flat xyz/pyr arrays, per-actor class/name/tag columns).
+ */
+class UEBLUEPRINTMCP_API FSpawnActorsAction : public TEditorAction<FMCPSpawnActorsParams>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSpawnActorsParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSpawnActorsParams& Args, FMCPEditorContext& Context, FString& OutError) override;
+	virtual FString GetActionName() const override { return TEXT("spawn_actors"); }
+
+private:
+	/** Resolve a built-in actor type or Blueprint name to a class */
+	UClass* ResolveClass(const FString& ClassName) const;
+};
+
+
 /**
  * FDeleteActorAction
  * Deletes an actor from the level.
  */
-class UEBLUEPRINTMCP_API FDeleteActorAction : public FEditorAction
+class UEBLUEPRINTMCP_API FDeleteActorAction : public TEditorAction<FMCPDeleteActorParams>
 {
-public:
-	virtual TSharedPtr<FJsonObject> ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context) override;
-
 protected:
-	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPDeleteActorParams& Args, FMCPEditorContext& Context) override;
 	virtual FString GetActionName() const override { return TEXT("delete_actor"); }
 };
 
@@ -87,6 +109,19 @@ protected:
 };
 
 
+/**
+ * FSetActorTransformsAction
+ * Sets or adjusts transforms of many actors in one pass (absolute columns plus offset/rotate/align/scale operations).
+ */
+class UEBLUEPRINTMCP_API FSetActorTransformsAction : public TEditorAction<FMCPSetActorTransformsParams>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSetActorTransformsParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSetActorTransformsParams& Args, FMCPEditorContext& Context, FString& OutError) override;
+	virtual FString GetActionName() const override { return TEXT("set_actor_transforms"); }
+};
+
+
 /**
  * FGetActorPropertiesAction
  * Gets all properties of an actor.
@@ -99,7 +134,10 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("get_actor_properties"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
+	virtual bool SupportsStreaming() const override { return true; }
+	virtual bool ExecuteStreaming(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FMCPResponseWriter& Writer, FString& OutError, FString& OutErrorType) override;
 };
 
 
@@ -118,6 +156,19 @@ protected:
 };
 
 
+/**
+ * FSetPropertiesBulkAction
+ * Sets property paths on every actor matched by a selector (names, class, tag, sphere/box).
+ */
+class UEBLUEPRINTMCP_API FSetPropertiesBulkAction : public TEditorAction<FMCPSetPropertiesBulkParams>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSetPropertiesBulkParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSetPropertiesBulkParams& Args, FMCPEditorContext& Context, FString& OutError) override;
+	virtual FString GetActionName() const override { return TEXT("set_properties_bulk"); }
+};
+
+
 /**
  * FFocusViewportAction
  * Focuses the viewport on an actor or location.
@@ -146,6 +197,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override { return true; }
 	virtual FString GetActionName() const override { return TEXT("get_viewport_transform"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
 };
 
@@ -178,5 +230,21 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override { return true; }
 	virtual FString GetActionName() const override { return TEXT("save_all"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::Heavy; }
+	virtual bool RequiresSave() const override { return false; }
+};
+
+
+/**
+ * FGetChangesAction
+ * Returns journaled actor/graph changes newer than since_revision.
+ * A client epoch that isn't the journal's forces resync_required.
+ */
+class UEBLUEPRINTMCP_API FGetChangesAction : public TEditorAction<FMCPGetChangesParams>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPGetChangesParams& Args, FMCPEditorContext& Context) override;
+	virtual FString GetActionName() const override { return TEXT("get_changes"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
 };
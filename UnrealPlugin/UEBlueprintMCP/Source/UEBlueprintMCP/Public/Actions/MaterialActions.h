@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "EditorAction.h"
+#include "TypedEditorAction.h"
+#include "ActionParams.h"
 
 // Forward declarations
 class UMaterial;
@@ -33,6 +35,17 @@ protected:
 
 	/** Mark material as modified and trigger recompilation */
 	void MarkMaterialModified(UMaterial* Material, FMCPEditorContext& Context) const;
+
+	/** Set properties on an expression from JSON object */
+	void SetExpressionProperties(UMaterialExpression* Expression, const TSharedPtr<FJsonObject>& Properties) const;
+
+	/** Connect to a named input on an expression (handles type-specific input property mapping) */
+	bool ConnectToExpressionInput(UMaterialExpression* SourceExpr, int32 OutputIndex,
+		UMaterialExpression* TargetExpr, const FString& InputName, FString& OutError) const;
+
+	/** Connect expression to material property */
+	bool ConnectToMaterialProperty(UMaterial* Material, UMaterialExpression* SourceExpr,
+		int32 OutputIndex, const FString& PropertyName, FString& OutError) const;
 };
 
 
@@ -99,10 +112,6 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_material_expression"); }
-
-private:
-	/** Set properties on an expression from JSON object */
-	void SetExpressionProperties(UMaterialExpression* Expression, const TSharedPtr<FJsonObject>& Properties) const;
 };
 
 
@@ -131,11 +140,6 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("connect_material_expressions"); }
-
-private:
-	/** Connect to a named input on an expression (handles type-specific input property mapping) */
-	bool ConnectToExpressionInput(UMaterialExpression* SourceExpr, int32 OutputIndex,
-		UMaterialExpression* TargetExpr, const FString& InputName, FString& OutError) const;
 };
 
 
@@ -162,11 +166,6 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("connect_to_material_output"); }
-
-private:
-	/** Connect expression to material property */
-	bool ConnectToMaterialProperty(UMaterial* Material, UMaterialExpression* SourceExpr,
-		int32 OutputIndex, const FString& PropertyName, FString& OutError) const;
 };
 
 
@@ -223,10 +222,48 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("compile_material"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::Heavy; }
 	virtual bool RequiresSave() const override { return true; } // Save after successful compilation
 };
 
 
+/**
+ * FBuildMaterialGraphAction
+ *
+ * Builds (or extends) a Material graph in a single call: creates expressions,
+ * sets material properties, wires connections and output bindings, then
+ * recompiles exactly once. Replaces long add/connect/set sequences that each
+ * re-resolve the material and recompile it.
+ *
+ * Parameters:
+ *   - material_name (required): Name of the target Material
+ *   - material_properties (optional): Object of material property name -> value (as for set_material_property)
+ *   - expressions (optional): Array of {name, class, position?: [X, Y], properties?: {...}}
+ *   - connections (optional): Array of {source, source_output_index?, target, target_input}
+ *   - outputs (optional): Array of {source, source_output_index?, material_property}
+ *   - wait_for_compile (optional): Block the editor until shaders compile so errors can be reported (default: false).
+ *     Without it, an async job stays open until the shaders finish, as for compile_material.
+ *
+ * Node names in connections/outputs may refer to expressions created in this call,
+ * nodes registered earlier in the session, or existing expressions by Desc / parameter name.
+ *
+ * Returns:
+ *   - material: Material name
+ *   - nodes: Names of the created expressions, in request order
+ *   - connections / outputs: Number of links made
+ *   - link_errors: Connections or outputs that could not be made (index, error)
+ *   - compile_errors: Array of {message, node?} (node when the error maps to an expression; only with wait_for_compile)
+ */
+class UEBLUEPRINTMCP_API FBuildMaterialGraphAction : public TEditorAction<FMCPBuildMaterialGraphParams, FMaterialAction>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPBuildMaterialGraphParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPBuildMaterialGraphParams& Args, FMCPEditorContext& Context, FString& OutError) override;
+	virtual FString GetActionName() const override { return TEXT("build_material_graph"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::Heavy; }
+};
+
+
 /**
  * FCreateMaterialInstanceAction
  *
@@ -286,10 +323,6 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("set_material_property"); }
-
-private:
-	/** Resolve shading model enum from string */
-	TOptional<EMaterialShadingModel> ResolveShadingModel(const FString& ShadingModelString) const;
 };
 
 
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "EditorAction.h"
+#include "TypedEditorAction.h"
+#include "ActionParams.h"
 
 class UEdGraph;
 class UEdGraphNode;
@@ -14,12 +16,11 @@ class UEdGraphPin;
 // ============================================================================
 
 /** Connect two nodes in a Blueprint graph */
-class UEBLUEPRINTMCP_API FConnectBlueprintNodesAction : public FBlueprintNodeAction
+class UEBLUEPRINTMCP_API FConnectBlueprintNodesAction : public TEditorAction<FMCPConnectBlueprintNodesParams, FBlueprintNodeAction>
 {
-public:
-	virtual TSharedPtr<FJsonObject> ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context) override;
 protected:
-	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPConnectBlueprintNodesParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPConnectBlueprintNodesParams& Args, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("connect_blueprint_nodes"); }
 };
 
@@ -32,6 +33,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("find_blueprint_nodes"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
 };
 
@@ -55,6 +57,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("get_node_pins"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
 	virtual bool RequiresSave() const override { return false; }
 };
 
@@ -70,6 +73,42 @@ protected:
 };
 
 
+/** Export a whole graph (nodes, pins, links, defaults) as compact tables in one call */
+class UEBLUEPRINTMCP_API FExportGraphAction : public TEditorAction<FMCPExportGraphParams, FBlueprintNodeAction>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPExportGraphParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPExportGraphParams& Args, FMCPEditorContext& Context, FString& OutError) override;
+	virtual FString GetActionName() const override { return TEXT("export_graph"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::ReadOnly; }
+	virtual bool RequiresSave() const override { return false; }
+private:
+	TSharedPtr<FJsonObject> ExportGraph(UEdGraph* Graph, bool bIncludeHidden) const;
+};
+
+
+struct FGraphPatchState;
+
+/**
+ * Apply a declarative graph patch (deletes, adds, moves, pin defaults, connections) in one transaction.
+ * Adds dispatch to the regular node actions; client-local ids resolve to the created node GUIDs.
+ * On failure the whole patch is rolled back. Compile and save run once at the end.
+ */
+class UEBLUEPRINTMCP_API FApplyGraphPatchAction : public TEditorAction<FMCPApplyGraphPatchParams, FBlueprintNodeAction>
+{
+protected:
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPApplyGraphPatchParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPApplyGraphPatchParams& Args, FMCPEditorContext& Context, FString& OutError) override;
+	virtual FString GetActionName() const override { return TEXT("apply_graph_patch"); }
+	virtual EMCPCommandCost GetCostClass() const override { return EMCPCommandCost::Heavy; }
+private:
+	bool ApplyPatch(const TSharedPtr<FJsonObject>& Params, const FMCPApplyGraphPatchParams& Args, UEdGraph* Graph,
+		FMCPEditorContext& Context, FGraphPatchState& State, FString& OutError) const;
+	UEdGraphNode* ResolvePatchNode(const FString& NodeRef, const FGraphPatchState& State,
+		const FMCPEditorContext& Context, FString& OutError) const;
+};
+
+
 // ============================================================================
 // Event Nodes
 // ============================================================================
@@ -82,6 +121,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_event_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -93,6 +133,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_input_action_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -104,6 +145,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_enhanced_input_action_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -115,6 +157,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_custom_event"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -141,6 +184,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_variable_get"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -152,16 +196,16 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_variable_set"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
 /** Set the default value of a pin */
-class UEBLUEPRINTMCP_API FSetNodePinDefaultAction : public FBlueprintNodeAction
+class UEBLUEPRINTMCP_API FSetNodePinDefaultAction : public TEditorAction<FMCPSetNodePinDefaultParams, FBlueprintNodeAction>
 {
-public:
-	virtual TSharedPtr<FJsonObject> ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context) override;
 protected:
-	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const FMCPSetNodePinDefaultParams& Args, FMCPEditorContext& Context) override;
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const FMCPSetNodePinDefaultParams& Args, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("set_node_pin_default"); }
 };
 
@@ -178,6 +222,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_function_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -189,6 +234,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_self_reference"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -200,6 +246,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_get_self_component_reference"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -211,6 +258,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_branch_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -222,6 +270,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_cast_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -233,6 +282,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_blueprint_get_subsystem_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -274,6 +324,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("call_event_dispatcher"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -300,6 +351,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_spawn_actor_from_class_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -311,6 +363,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("call_blueprint_function"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -326,6 +379,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("set_object_property"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 };
 
 
@@ -341,6 +395,7 @@ public:
 protected:
 	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override;
 	virtual FString GetActionName() const override { return TEXT("add_macro_instance_node"); }
+	virtual bool CreatesGraphNode() const override { return true; }
 private:
 	UEdGraph* FindMacroGraph(const FString& MacroName) const;
 };
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorAction.h"
+#include "../MCPParamSchema.h"
+
+/**
+ * TEditorAction
+ *
+ * Action base with a typed parameter struct. ParamsType is a USTRUCT whose
+ * UPROPERTYs declare the command's parameters (see FMCPParamSchema for the
+ * key naming and supported metadata). Params are decoded once, in the
+ * pipeline's Validate stage, and the decoded struct is handed to
+ * ExecuteTyped(); the same struct produces the schema returned by
+ * GetParamsSchema().
+ *
+ * BaseType lets typed actions keep the Blueprint/graph helpers, e.g.
+ * TEditorAction<FMyParams, FBlueprintNodeAction>.
+ *
+ * Subclasses override:
+ * - ExecuteTyped(): Perform the operation with decoded params
+ * - ValidateParams(): Checks beyond metadata and context preconditions such as ValidateGraph (optional)
+ */
+template <typename ParamsType, typename BaseType = FEditorAction>
+class TEditorAction : public BaseType
+{
+public:
+	virtual TSharedPtr<FJsonObject> ExecuteInternal(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context) override final
+	{
+		// Decoded by Validate() for these params; decode here only if the pipeline didn't run it
+		if (DecodedArgs.IsSet() && DecodedFrom == Params.Get())
+		{
+			const ParamsType Args = MoveTemp(DecodedArgs.GetValue());
+			ResetDecodedArgs();
+			return ExecuteTyped(Params, Args, Context);
+		}
+		ResetDecodedArgs();
+
+		ParamsType Args;
+		FString Error;
+		if (!DecodeAndValidate(Params, Args, Context, Error))
+		{
+			return this->CreateErrorResponse(Error, TEXT("validation_failed"));
+		}
+		return ExecuteTyped(Params, Args, Context);
+	}
+
+	virtual TSharedPtr<FJsonObject> GetParamsSchema() const override
+	{
+		return FMCPParamSchema::BuildJsonSchema(ParamsType::StaticStruct());
+	}
+
+protected:
+	/** Decodes and validates the params; the result is kept for the ExecuteInternal() that follows */
+	virtual bool Validate(const TSharedPtr<FJsonObject>& Params, FMCPEditorContext& Context, FString& OutError) override final
+	{
+		ResetDecodedArgs();
+
+		ParamsType Args;
+		if (!DecodeAndValidate(Params, Args, Context, OutError))
+		{
+			return false;
+		}
+		DecodedArgs.Emplace(MoveTemp(Args));
+		DecodedFrom = Params.Get();
+		return true;
+	}
+
+	/**
+	 * Checks that metadata can't express (called after a successful decode).
+	 * Raw Params are passed for the shared helpers that read them (ValidateGraph).
+	 */
+	virtual bool ValidateParams(const TSharedPtr<FJsonObject>& Params, const ParamsType& Args, FMCPEditorContext& Context, FString& OutError) { return true; }
+
+	/**
+	 * Execute with decoded params. Raw Params are still passed for the
+	 * shared helpers that read them (GetTargetBlueprint, GetTargetGraph)
+	 * and for FMCPJsonValue params.
+	 */
+	virtual TSharedPtr<FJsonObject> ExecuteTyped(const TSharedPtr<FJsonObject>& Params, const ParamsType& Args, FMCPEditorContext& Context) = 0;
+
+private:
+	bool DecodeAndValidate(const TSharedPtr<FJsonObject>& Params, ParamsType& OutArgs, FMCPEditorContext& Context, FString& OutError)
+	{
+		return FMCPParamSchema::Decode(ParamsType::StaticStruct(), &OutArgs, Params, OutError) &&
+			ValidateParams(Params, OutArgs, Context, OutError);
+	}
+
+	void ResetDecodedArgs()
+	{
+		DecodedArgs.Reset();
+		DecodedFrom = nullptr;
+	}
+
+	/** Params decoded by the last Validate() (actions run on the game thread only) */
+	TOptional<ParamsType> DecodedArgs;
+
+	/** Params object DecodedArgs was decoded from */
+	const FJsonObject* DecodedFrom = nullptr;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "EditorSubsystem.h"
+#include "Containers/Ticker.h"
 #include "Dom/JsonObject.h"
 #include "MCPContext.h"
 #include "MCPBridge.generated.h"
@@ -11,6 +12,24 @@
 // Forward declarations
 class FMCPServer;
 class FEditorAction;
+class FMCPChangeJournal;
+class FMCPResponseWriter;
+class FMCPCommandRegistry;
+class FMCPSnapshotStore;
+class FMCPJobManager;
+class FMCPJob;
+class FMCPEventHub;
+class FMCPResultCache;
+class FMCPMetrics;
+class FMCPFlightRecorder;
+struct FMCPRequestTimings;
+class FMCPCancelToken;
+class FObjectPostSaveContext;
+struct FAssetData;
+class UBlueprint;
+class AActor;
+struct FPropertyChangedEvent;
+class FTransactionObjectEvent;
 
 /**
  * UMCPBridge
@@ -53,14 +72,85 @@ public:
 	 */
 	TSharedPtr<FJsonObject> ExecuteCommandSafe(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+	/**
+	 * Execute a command and write its response directly into Writer.
+	 * Streaming actions never build a response DOM. CancelToken, if set,
+	 * is visible to the action through its context while it runs; Timings,
+	 * if set, gets the validate/execute/save/serialize stage times.
+	 */
+	void ExecuteCommandToWriter(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer, const FString& SessionId = FString(), const TSharedPtr<FMCPCancelToken>& CancelToken = nullptr, FMCPRequestTimings* Timings = nullptr);
+
+	/**
+	 * Execute a command in a session through the action pipeline but skip
+	 * the per-command auto-save; the caller saves the batch with
+	 * FlushDeferredSaves. Used by UMCPScriptCommandlet.
+	 */
+	TSharedPtr<FJsonObject> ExecuteCommandWithoutSave(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& SessionId = FString(), FMCPRequestTimings* Timings = nullptr);
+
+	/**
+	 * Compile every Blueprint in a package dirtied since the last flush (in
+	 * any session) that isn't up to date, then save all dirty packages once.
+	 * @return {"success", "compiled", "compile_errors": [names], "saved", "still_dirty"}
+	 */
+	TSharedPtr<FJsonObject> FlushDeferredSaves(FMCPRequestTimings* Timings = nullptr);
+
+	/**
+	 * Run an async job's command in its session (game thread).
+	 * Skipped if the job was cancelled while queued; the job finishes with
+	 * the command's response unless the action asked to complete later.
+	 */
+	void ExecuteJob(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Params);
+
 	// =========================================================================
 	// Context Access
 	// =========================================================================
 
-	/** Get the current editor context */
+	/** Get the default editor context (used when no session is given) */
 	FMCPEditorContext& GetContext() { return Context; }
 	const FMCPEditorContext& GetContext() const { return Context; }
 
+	/**
+	 * Get the context of a session, creating it on first use.
+	 * Sessions keep their own current Blueprint/material, $last_node aliases
+	 * and material node maps. An empty id returns the default context.
+	 * Null when MaxSessions are open and none has been idle for
+	 * SessionIdleTimeoutSeconds (callers answer busy).
+	 */
+	FMCPEditorContext* GetSessionContext(const FString& SessionId);
+
+	/** Drop a session's context (e.g. when its connection closes) */
+	void ReleaseSession(const FString& SessionId);
+
+	/** Number of live sessions (excluding the default context) */
+	int32 GetSessionCount() const { return Sessions.Num(); }
+
+	/** Get the change journal shared by all contexts */
+	TSharedPtr<FMCPChangeJournal> GetChangeJournal() const { return ChangeJournal; }
+
+	/** Registered action handlers by command name (game thread) */
+	const TMap<FString, TSharedRef<FEditorAction>>& GetActions() const { return ActionHandlers; }
+
+	/** Get the frozen command registry (safe to read from the server thread) */
+	TSharedPtr<const FMCPCommandRegistry> GetCommandRegistry() const { return CommandRegistry; }
+
+	/** Get the published actor/graph snapshots (safe to read from client threads) */
+	TSharedPtr<const FMCPSnapshotStore> GetSnapshotStore() const { return SnapshotStore; }
+
+	/** Get the async job manager (thread-safe) */
+	TSharedPtr<FMCPJobManager> GetJobManager() const { return JobManager; }
+
+	/** Get the editor event hub (thread-safe) */
+	TSharedPtr<FMCPEventHub> GetEventHub() const { return EventHub; }
+
+	/** Get the idempotency-key result cache (thread-safe) */
+	TSharedPtr<FMCPResultCache> GetResultCache() const { return ResultCache; }
+
+	/** Get the per-command latency metrics (thread-safe) */
+	TSharedPtr<FMCPMetrics> GetMetrics() const { return Metrics; }
+
+	/** Get the ring of recently finished requests (thread-safe) */
+	TSharedPtr<FMCPFlightRecorder> GetFlightRecorder() const { return FlightRecorder; }
+
 	// =========================================================================
 	// Response Helpers
 	// =========================================================================
@@ -75,21 +165,144 @@ private:
 	/** Register all action handlers */
 	void RegisterActions();
 
+	/** Build and freeze the command registry from the registered actions */
+	void BuildCommandRegistry();
+
 	/** Find action handler for a command type */
 	TSharedRef<FEditorAction>* FindAction(const FString& CommandType);
 
+	/** Publish snapshots after a command and prime the one a concurrent query needs */
+	void PublishSnapshots(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	/** Poll jobs waiting for side work to finish, and shader compilation for events */
+	bool Tick(float DeltaTime);
+
 	/** Execute internal command (called after validation) */
 	TSharedPtr<FJsonObject> ExecuteCommandInternal(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
+	// =========================================================================
+	// Change Journal Hooks (editor delegates, catch user edits too)
+	// =========================================================================
+
+	void BindChangeJournalDelegates();
+	void UnbindChangeJournalDelegates();
+
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnActorMoved(AActor* Actor);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnMapOpened(const FString& Filename, bool bAsTemplate);
+	void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent);
+	void OnPostUndoRedo();
+
+	/** Only actors in the editor world are journaled (skip PIE, previews) */
+	static bool ShouldJournalActor(const AActor* Actor);
+
+	// =========================================================================
+	// Event Hooks (pushed to subscribed connections)
+	// =========================================================================
+
+	void BindEventDelegates();
+	void UnbindEventDelegates();
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnBlueprintCompiled();
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+	void OnPostPIEStarted(bool bIsSimulating);
+	void OnEndPIE(bool bIsSimulating);
+
+	/** Publish an actor event with the actor's name, class and transform */
+	void PublishActorEvent(const FString& EventName, AActor* Actor);
+
+	/** Publish an asset event (skipped during the initial asset scan) */
+	void PublishAssetEvent(const FString& EventName, const FAssetData& AssetData, const FString& OldObjectPath = FString());
+
 	/** The MCP TCP server (raw pointer - cleanup in Deinitialize) */
 	FMCPServer* Server;
 
-	/** Editor context (persists across commands) */
+	/** Default editor context (persists across commands without a session) */
 	FMCPEditorContext Context;
 
+	/** A session's context plus when it was last used (for eviction) */
+	struct FMCPSession
+	{
+		TSharedRef<FMCPEditorContext> Context = MakeShared<FMCPEditorContext>();
+		double LastUsedTime = 0.0;
+	};
+
+	/** Per-session contexts keyed by session id (game thread only) */
+	TMap<FString, FMCPSession> Sessions;
+
+	/** Beyond this count the least recently used session is evicted if it's idle, else new sessions are refused */
+	static constexpr int32 MaxSessions = 64;
+
+	/** A session unused for this long may be evicted to make room */
+	static constexpr double SessionIdleTimeoutSeconds = 600.0;
+
+	/** busy reply for a session refused because all slots are in use */
+	static TSharedPtr<FJsonObject> CreateSessionsFullResponse();
+
+	/** Drop a session, handing its unsaved dirty packages to the default context */
+	bool RemoveSession(const FString& SessionId);
+
+	/** Journal of actor/graph changes (shared with Context) */
+	TSharedPtr<FMCPChangeJournal> ChangeJournal;
+
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle MapOpenedHandle;
+	FDelegateHandle ObjectTransactedHandle;
+	FDelegateHandle PostUndoRedoHandle;
+
 	/** Map of command types to action handlers */
 	TMap<FString, TSharedRef<FEditorAction>> ActionHandlers;
 
+	/** Schema/version/cost of every command, frozen after registration */
+	TSharedPtr<FMCPCommandRegistry> CommandRegistry;
+
+	/** Snapshots published after each command for off-game-thread reads */
+	TSharedPtr<FMCPSnapshotStore> SnapshotStore;
+
+	/** Async jobs started with "async": true */
+	TSharedPtr<FMCPJobManager> JobManager;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Editor events for subscribed connections */
+	TSharedPtr<FMCPEventHub> EventHub;
+
+	/** Responses of recent mutating commands by idempotency key, for retries */
+	TSharedPtr<FMCPResultCache> ResultCache;
+
+	/** Per-command stage latency histograms, created once the registry is frozen */
+	TSharedPtr<FMCPMetrics> Metrics;
+
+	/** Last requests with their stage times, dumped on demand or when one fails badly */
+	TSharedPtr<FMCPFlightRecorder> FlightRecorder;
+
+	/** Blueprints seen in pre-compile, reported by the next compiled broadcast */
+	TArray<TWeakObjectPtr<UBlueprint>> CompilingBlueprints;
+
+	/** Shader compilation state at the last tick (for shader_compile_finished) */
+	bool bShadersCompiling = false;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle PostPIEStartedHandle;
+	FDelegateHandle EndPIEHandle;
+
 	/** Port to listen on (55558 during development to avoid conflict with old plugin) */
 	static constexpr int32 DefaultPort = 55558;
+
+	/** Command line switch that overrides DefaultPort: -MCPPort=<port> */
+	static constexpr const TCHAR* PortCommandLineSwitch = TEXT("MCPPort=");
 };
@@ -0,0 +1,139 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class AActor;
+class UEdGraphNode;
+
+/** Kinds of mutation recorded in the change journal */
+enum class EMCPChangeKind : uint8
+{
+	ActorAdded,
+	ActorRemoved,
+	ActorMoved,
+	ActorPropertyChanged,
+	NodeAdded,
+	NodeRemoved,
+	NodeMoved,
+	PinDefaultChanged,
+	LinkAdded,
+	LinkRemoved
+};
+
+/** A single journal entry */
+struct UEBLUEPRINTMCP_API FMCPChangeEntry
+{
+	/** Revision at which this change was recorded (monotonic, starts at 1) */
+	int64 Revision = 0;
+
+	EMCPChangeKind Kind = EMCPChangeKind::ActorAdded;
+
+	/** Actor name for actor changes, Blueprint name for graph changes */
+	FString Target;
+
+	/** Graph name (graph changes only) */
+	FString Graph;
+
+	/** Node GUID (graph changes only) */
+	FString NodeId;
+
+	/** Property name, pin name or linked node, depending on kind */
+	FString Detail;
+
+	TSharedPtr<FJsonObject> ToJson() const;
+};
+
+/**
+ * FMCPChangeJournal
+ *
+ * Bounded, monotonically versioned log of actor and Blueprint graph
+ * mutations. Clients remember the last revision they saw and ask for
+ * the deltas with get_changes instead of re-fetching whole actor lists
+ * or node tables after every step.
+ *
+ * Consecutive identical entries (same kind, target, node and detail) are
+ * coalesced by bumping the revision, so a viewport drag that fires
+ * hundreds of move events costs a single slot.
+ *
+ * Revisions restart with every journal (every editor session), so each
+ * journal has an epoch GUID that is returned with its revisions; a client
+ * whose epoch differs holds revisions of another history and must resync.
+ *
+ * Thread-safe: recording happens on the game thread, queries may come
+ * from any thread.
+ */
+class UEBLUEPRINTMCP_API FMCPChangeJournal
+{
+public:
+	explicit FMCPChangeJournal(int32 InCapacity = DefaultCapacity);
+
+	// =========================================================================
+	// Recording
+	// =========================================================================
+
+	/** Record an actor-level change */
+	void RecordActorChange(EMCPChangeKind Kind, const AActor* Actor, const FString& Detail = FString());
+
+	/** Record a graph-level change for a node (Blueprint and graph derived from the node) */
+	void RecordNodeChange(EMCPChangeKind Kind, const UEdGraphNode* Node, const FString& Detail = FString());
+
+	/** Record a fully specified entry */
+	void Record(EMCPChangeKind Kind, const FString& Target, const FString& Graph, const FString& NodeId, const FString& Detail);
+
+	/** Entry describing a node change (Revision unset), for recording later */
+	static FMCPChangeEntry MakeNodeEntry(EMCPChangeKind Kind, const UEdGraphNode* Node, const FString& Detail = FString());
+
+	// =========================================================================
+	// Queries
+	// =========================================================================
+
+	/** Latest revision handed out (0 if nothing has been recorded) */
+	int64 GetRevision() const;
+
+	/** Identifies this journal's revision history (new for every journal) */
+	const FGuid& GetEpoch() const { return Epoch; }
+
+	/**
+	 * Collect entries with Revision > SinceRevision, oldest first.
+	 *
+	 * @param SinceRevision Last revision the client has seen
+	 * @param MaxEntries Maximum number of entries to return (<= 0 for no limit)
+	 * @param OutEntries Collected entries
+	 * @return False if entries after SinceRevision have already been evicted, or SinceRevision is
+	 *         ahead of the journal (it restarted); either way the client must resync
+	 */
+	bool GetChangesSince(int64 SinceRevision, int32 MaxEntries, TArray<FMCPChangeEntry>& OutEntries) const;
+
+	/** Drop all entries (revision counter keeps increasing) */
+	void Reset();
+
+	/** Convert a change kind to its wire name */
+	static const TCHAR* KindToString(EMCPChangeKind Kind);
+
+	static constexpr int32 DefaultCapacity = 8192;
+
+private:
+	/** Ring buffer storage */
+	TArray<FMCPChangeEntry> Entries;
+
+	/** Index of the oldest entry in the ring */
+	int32 Head;
+
+	/** Number of live entries */
+	int32 Count;
+
+	/** Last revision handed out */
+	int64 Revision;
+
+	/** Newest revision evicted from the ring (0 if none) */
+	int64 EvictedRevision;
+
+	/** Set once at construction, so reading it needs no lock */
+	const FGuid Epoch;
+
+	mutable FCriticalSection Lock;
+};
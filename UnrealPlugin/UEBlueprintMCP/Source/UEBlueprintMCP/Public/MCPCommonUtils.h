@@ -11,6 +11,7 @@ class UEdGraph;
 class UEdGraphNode;
 class UEdGraphPin;
 class AActor;
+class FMCPResponseWriter;
 class UK2Node_Event;
 class UK2Node_CallFunction;
 class UK2Node_VariableGet;
@@ -66,6 +67,10 @@ public:
 	static bool SetObjectProperty(UObject* Object, const FString& PropertyName,
 		const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
 
+	/** Set an already-resolved property inside Container (object or struct memory) from a JSON value */
+	static bool SetPropertyValue(FProperty* Property, void* Container,
+		const TSharedPtr<FJsonValue>& Value, FString& OutErrorMessage);
+
 	// =========================================================================
 	// Graph Node Utilities
 	// =========================================================================
@@ -100,4 +105,10 @@ public:
 
 	/** Convert an actor to a JSON value */
 	static TSharedPtr<FJsonValue> ActorToJsonValue(AActor* Actor);
+
+	/** Stream the fields ActorToJsonObject produces into Writer at its current level */
+	static void WriteActorFields(FMCPResponseWriter& Writer, AActor* Actor);
+
+	/** Stream an actor object, or null, as ActorToJsonValue produces it */
+	static void WriteActor(FMCPResponseWriter& Writer, AActor* Actor);
 };
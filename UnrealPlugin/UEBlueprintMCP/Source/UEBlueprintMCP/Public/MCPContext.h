@@ -7,6 +7,11 @@
 #include "Engine/Blueprint.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialExpression.h"
+#include "MCPChangeJournal.h"
+
+class FMCPJob;
+class FMCPCancelToken;
+struct FMCPRequestTimings;
 
 /**
  * FMCPEditorContext
@@ -66,6 +71,46 @@ public:
 	/** Packages that have been modified and need saving */
 	TSet<UPackage*> DirtyPackages;
 
+	// =========================================================================
+	// Batching
+	// =========================================================================
+
+	/** When set, FBlueprintAction::MarkBlueprintModified queues instead of notifying */
+	bool bDeferBlueprintModified;
+
+	/** Blueprints modified while bDeferBlueprintModified was set */
+	TSet<TWeakObjectPtr<UBlueprint>> PendingModifiedBlueprints;
+
+	// =========================================================================
+	// Change Tracking
+	// =========================================================================
+
+	/** Journal of actor/graph mutations (owned by the bridge, survives Clear) */
+	TSharedPtr<FMCPChangeJournal> ChangeJournal;
+
+	/** When true, RecordNodeChange buffers entries in PendingChanges instead of journaling them */
+	bool bDeferJournal = false;
+
+	/** Graph changes recorded while bDeferJournal was set */
+	TArray<FMCPChangeEntry> PendingChanges;
+
+	// =========================================================================
+	// Async Jobs
+	// =========================================================================
+
+	/** Job the current command runs as (null for synchronous commands) */
+	TSharedPtr<FMCPJob> ActiveJob;
+
+	/** Deadline/cancel state of the current synchronous request (null if none) */
+	TSharedPtr<FMCPCancelToken> CancelToken;
+
+	// =========================================================================
+	// Metrics
+	// =========================================================================
+
+	/** Stage times of the current request (null when not measured) */
+	FMCPRequestTimings* Timings;
+
 	// =========================================================================
 	// Methods
 	// =========================================================================
@@ -88,6 +133,27 @@ public:
 	/** Save all dirty packages */
 	void SaveDirtyPackages();
 
+	/** Record an actor change in the journal (no-op without a journal) */
+	void RecordActorChange(EMCPChangeKind Kind, const AActor* Actor, const FString& Detail = FString());
+
+	/** Record a graph node change in the journal (no-op without a journal) */
+	void RecordNodeChange(EMCPChangeKind Kind, const UEdGraphNode* Node, const FString& Detail = FString());
+
+	/** Journal the changes buffered while bDeferJournal was set, or drop them if they were undone */
+	void FlushPendingChanges(bool bCommit);
+
+	/** Report progress (0..1) and phase of the running job (no-op when not a job) */
+	void ReportProgress(float Progress, const FString& Phase);
+
+	/** Whether the running job or request has been cancelled or hit its deadline (check between phases) */
+	bool IsCancelRequested() const;
+
+	/**
+	 * Keep the running job open after the command returns until Condition is true.
+	 * Returns false when not running as a job, so the caller can wait inline instead.
+	 */
+	bool CompleteJobWhen(TFunction<bool()> Condition, const FString& WaitPhase);
+
 	/** Clear the context (reset to defaults) */
 	void Clear();
 
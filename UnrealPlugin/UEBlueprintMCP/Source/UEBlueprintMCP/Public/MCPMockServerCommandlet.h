@@ -0,0 +1,40 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MCPMockServerCommandlet.generated.h"
+
+/**
+ * UMCPMockServerCommandlet
+ *
+ * Serves FMCPMockExecutor over a real FMCPServer, with no editor state
+ * involved, so the transport can be benchmarked on its own:
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=MCPMockServer -nullrhi -unattended -nop4 -nosplash
+ *       [-Port=55600] [-Recording=session.jsonl] [-Seed=0] [-Seconds=60]
+ *
+ * Without -Recording it serves mock_read, mock_write and mock_heavy; with
+ * it, the recorded commands at their recorded cost. The commandlet pumps
+ * the game-thread tasks and the core ticker the server's dispatcher runs
+ * on, until -Seconds have passed (0 or missing: until the process is asked
+ * to exit). Returns 1 if the recording can't be read or the port can't be
+ * bound, 0 otherwise.
+ */
+UCLASS()
+class UEBLUEPRINTMCP_API UMCPMockServerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMCPMockServerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/** Port served when -Port isn't given (away from the editor's) */
+	static constexpr int32 DefaultPort = 55600;
+
+	/** Sleep between pumps of the game-thread queue, in seconds */
+	static constexpr float PumpIntervalSeconds = 0.001f;
+};
@@ -0,0 +1,81 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class UScriptStruct;
+
+/**
+ * FMCPParamSchema
+ *
+ * Decodes command params into a USTRUCT and describes that USTRUCT as a
+ * JSON schema, so an action's params struct is the single source of truth
+ * for decoding, validation and the tool list.
+ *
+ * JSON keys are the snake_case property names (SourceNodeId -> source_node_id,
+ * bForce -> force) unless overridden with meta=(JsonKey="...").
+ *
+ * Supported UPROPERTY metadata:
+ * - Required:                 key must be present (non-empty for strings and arrays)
+ * - AllowEmpty:               with Required, an empty string is accepted (the key must still be present)
+ * - ClampMin / ClampMax:      numeric range check
+ * - AllowedValues="a,b,c":    string must be one of the listed values
+ * - JsonType="object":        JSON type of an FMCPJsonValue param (checked, and its schema "type")
+ * - ToolTip (doc comment):    schema "description"
+ *
+ * FVector and FRotator properties use the [x, y, z] / [pitch, yaw, roll]
+ * array form every other command accepts. Nested structs and arrays of
+ * structs decode with the same keys and metadata as the top level.
+ * FMCPJsonValue properties describe params whose value can't be typed
+ * (e.g. property values of any type); they are not decoded, and the
+ * action reads them from the raw params.
+ */
+class UEBLUEPRINTMCP_API FMCPParamSchema
+{
+public:
+	/**
+	 * Decode Params into OutStruct (an instance of Struct) and run metadata validation.
+	 * Keys not present keep the struct's default values.
+	 *
+	 * @return False with OutError set if a key is missing, mistyped or out of range
+	 */
+	static bool Decode(const UScriptStruct* Struct, void* OutStruct, const TSharedPtr<FJsonObject>& Params, FString& OutError);
+
+	/** Build {"type":"object","properties":{...},"required":[...]} for Struct */
+	static TSharedPtr<FJsonObject> BuildJsonSchema(const UScriptStruct* Struct);
+
+	/** JSON key for a property (JsonKey metadata or snake_case name) */
+	static FString GetJsonKey(const FProperty* Property);
+
+private:
+	/** Per-property decode info, computed once per struct */
+	struct FParamBinding
+	{
+		FProperty* Property = nullptr;
+		FString Key;
+		bool bRequired = false;
+		bool bAllowEmpty = false;
+		TOptional<double> Min;
+		TOptional<double> Max;
+		TArray<FString> AllowedValues;
+		FString JsonType;
+	};
+
+	/** Decode into one (possibly nested) struct; Path prefixes keys in errors */
+	static bool DecodeStruct(const UScriptStruct* Struct, void* OutStruct, const TSharedPtr<FJsonObject>& Params, const FString& Path, FString& OutError);
+
+	/** Decode one value into a property (recurses into structs and arrays) */
+	static bool DecodeValue(const FProperty* Property, void* ValuePtr, const TSharedPtr<FJsonValue>& Value, const FString& JsonType, const FString& KeyPath, FString& OutError);
+
+	/** Bindings are shared so callers keep them valid while the cache grows */
+	static TSharedRef<const TArray<FParamBinding>> GetBindings(const UScriptStruct* Struct);
+
+	/** Schema for a single property value (recurses into arrays and structs) */
+	static TSharedPtr<FJsonObject> BuildPropertySchema(const FProperty* Property);
+
+	static FCriticalSection BindingsLock;
+	static TMap<const UScriptStruct*, TSharedRef<const TArray<FParamBinding>>> BindingsCache;
+};
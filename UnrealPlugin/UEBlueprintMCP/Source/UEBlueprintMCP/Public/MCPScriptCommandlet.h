@@ -0,0 +1,60 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Dom/JsonObject.h"
+#include "MCPScriptCommandlet.generated.h"
+
+class UMCPBridge;
+
+/**
+ * UMCPScriptCommandlet
+ *
+ * Runs MCP commands in-process, without the TCP server or any UI, for CI
+ * asset generation:
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=MCPScript -Script=build.jsonl -Output=results.jsonl
+ *       -nullrhi -unattended -nop4 -nosplash [-SaveEvery=100] [-Session=script] [-StopOnError]
+ *
+ * Each script line is a request as sent over TCP ({"type", "params",
+ * "session", "id"}); blank lines and lines starting with # are skipped.
+ * Commands go through the bridge's FEditorAction pipeline (validation,
+ * execution, post-validation) with the per-command auto-save turned off:
+ * every SaveEvery commands, on {"type": "flush"} and at the end, the
+ * Blueprints touched since the last flush are compiled once and all dirty
+ * packages saved once. "async" is ignored (everything runs in order) and
+ * ping is answered directly.
+ *
+ * Each result is one JSON line, in script order:
+ *
+ *   {"line": 3, "id": "...", "type": "create_blueprint", "ms": 41.2, "result": {"success": true, ...}}
+ *   {"flush": 1, "ms": 930.5, "result": {"success": true, "compiled": 4, "compile_errors": [], "saved": 6, "still_dirty": 0}}
+ *
+ * Without -Script (or with -Script=-) requests are read from stdin one at a
+ * time, and without -Output (or with -Output=-) results go to stdout, each
+ * prefixed with "@mcp " to set them apart from log lines. A process can
+ * then drive the commandlet over pipes like a connection. Returns 0 if
+ * every command and flush succeeded, 1 otherwise.
+ */
+UCLASS()
+class UEBLUEPRINTMCP_API UMCPScriptCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMCPScriptCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/** Commands between batched compile-and-save flushes when -SaveEvery isn't given */
+	static constexpr int32 DefaultSaveEvery = 100;
+
+	/** Prefix of result lines written to stdout */
+	static constexpr const TCHAR* StdoutPrefix = TEXT("@mcp ");
+
+private:
+	/** Run one parsed request and return its response */
+	TSharedPtr<FJsonObject> RunRequest(UMCPBridge& Bridge, const FString& CommandType, const TSharedPtr<FJsonObject>& Request, const FString& SessionId, double& OutMs);
+};
@@ -0,0 +1,195 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeRWLock.h"
+#include "MCPExecutor.h"
+
+class UWorld;
+class UBlueprint;
+class UEdGraph;
+class FMCPChangeJournal;
+
+/** Transform row of one level actor */
+struct UEBLUEPRINTMCP_API FMCPActorSnapshot
+{
+	FString Name;
+	FString ClassName;
+	FVector Location = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FVector Scale = FVector::OneVector;
+};
+
+/** Immutable view of the editor level's actors */
+struct UEBLUEPRINTMCP_API FMCPLevelSnapshot
+{
+	/** Editor iteration order; actors added since the last full build are appended */
+	TArray<FMCPActorSnapshot> Actors;
+
+	/** Actor name -> index into Actors */
+	TMap<FString, int32> ActorIndex;
+
+	const FMCPActorSnapshot* FindActor(const FString& Name) const;
+};
+
+/** Node classification used by find_blueprint_nodes' node_type filter */
+enum class EMCPSnapshotNodeKind : uint8
+{
+	Other,
+	Event,
+	Function,
+	Variable
+};
+
+/** One pin as get_node_pins reports it */
+struct UEBLUEPRINTMCP_API FMCPPinSnapshot
+{
+	FString Name;
+	bool bInput = true;
+	FString Category;
+
+	/** Empty when the pin type has none */
+	FString SubCategory;
+	FString SubCategoryObject;
+
+	bool bHidden = false;
+};
+
+/** One node with its pins */
+struct UEBLUEPRINTMCP_API FMCPNodeSnapshot
+{
+	FString NodeGuid;
+	FString NodeClass;
+	FString Title;
+
+	EMCPSnapshotNodeKind Kind = EMCPSnapshotNodeKind::Other;
+
+	/** Event nodes: bound event member name, plus the function name for custom events */
+	FName EventName;
+	FName CustomEventName;
+
+	TArray<FMCPPinSnapshot> Pins;
+};
+
+/** Immutable view of one Blueprint graph */
+struct UEBLUEPRINTMCP_API FMCPGraphSnapshot
+{
+	FString BlueprintName;
+	FString GraphName;
+
+	TArray<FMCPNodeSnapshot> Nodes;
+
+	/** Node GUID string -> index into Nodes */
+	TMap<FString, int32> NodeIndex;
+
+	const FMCPNodeSnapshot* FindNode(const FString& NodeGuid) const;
+};
+
+/**
+ * FMCPSnapshotStore
+ *
+ * Immutable views of the editor level's actor transforms and of Blueprint
+ * graphs, published by the game thread so read-only queries can be
+ * answered from client threads without waiting behind mutating commands.
+ *
+ * After every command the bridge calls PublishChanges(), which reads the
+ * change journal since the last publish and rebuilds only what was
+ * touched: the affected actor rows and the affected graphs. Snapshots are
+ * handed out as shared pointers to const data, so a reader keeps a
+ * consistent view while newer ones are published.
+ *
+ * A snapshot is only served while it is current, i.e. nothing has been
+ * journaled since the last publish. Otherwise (or when the query needs
+ * session state, such as a missing blueprint_name) TryServe() declines
+ * and the command runs on the game thread as before, which also
+ * publishes the pending changes.
+ *
+ * The level view and graph views are built lazily: the first game-thread
+ * run of a query primes the snapshot it needs, and from then on
+ * PublishChanges() keeps it up to date.
+ *
+ * Thread-safe: publishing happens on the game thread, queries may come
+ * from any thread.
+ */
+class UEBLUEPRINTMCP_API FMCPSnapshotStore : public IMCPSnapshotReader
+{
+public:
+	explicit FMCPSnapshotStore(const TSharedPtr<FMCPChangeJournal>& InChangeJournal);
+
+	// =========================================================================
+	// Publishing (game thread)
+	// =========================================================================
+
+	/** Republish the actors and graphs journaled since the last publish */
+	void PublishChanges(UWorld* World);
+
+	/** Build the snapshot a served query needs if it doesn't exist yet */
+	void PrimeForQuery(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, UWorld* World);
+
+	/** Drop a Blueprint's graph views (edits the journal doesn't see, e.g. recompiles or editor graph edits) */
+	void InvalidateBlueprint(const FString& BlueprintName);
+
+	/** Drop everything (e.g. when another map is opened, or on undo/redo) */
+	void Reset();
+
+	// =========================================================================
+	// Queries (any thread)
+	// =========================================================================
+
+	/** Whether every journaled change has been published */
+	bool IsCurrent() const;
+
+	/** Latest level view, null if not primed */
+	TSharedPtr<const FMCPLevelSnapshot> GetLevel() const;
+
+	/** Latest view of a graph (empty GraphName = the event graph), null if not primed */
+	TSharedPtr<const FMCPGraphSnapshot> FindGraph(const FString& BlueprintName, const FString& GraphName) const;
+
+	/** Whether TryServe() knows how to answer this command */
+	static bool CanServe(const FString& CommandType);
+
+	/**
+	 * Write the full response to a read-only query from the current snapshots.
+	 * Produces the same bytes as the game-thread action would.
+	 *
+	 * @return False without writing anything if the query must run on the game thread
+	 */
+	virtual bool TryServe(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const override;
+
+private:
+	/** Build the level view from scratch */
+	void PublishLevel(UWorld* World);
+
+	/** Patch the touched actor rows into a copy of the current level view */
+	void PublishActors(UWorld* World, const TSet<FString>& TouchedActors);
+
+	/** Build and publish one graph view */
+	void PublishGraph(UBlueprint* Blueprint, UEdGraph* Graph);
+
+	/** Remove one graph view (graph or Blueprint no longer resolvable) */
+	void RemoveGraph(const FString& BlueprintName, const FString& GraphName);
+
+	static FString MakeGraphKey(const FString& BlueprintName, const FString& GraphName);
+
+	bool ServeActorsInLevel(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const;
+	bool ServeFindActorsByName(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const;
+	bool ServeActorProperties(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const;
+	bool ServeFindBlueprintNodes(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const;
+	bool ServeNodePins(const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const;
+
+	/** Journal the views are kept in sync with */
+	TSharedPtr<FMCPChangeJournal> ChangeJournal;
+
+	/** Journal revision covered by the published views */
+	TAtomic<int64> PublishedRevision;
+
+	TSharedPtr<const FMCPLevelSnapshot> Level;
+
+	/** "Blueprint/Graph" -> view; "Blueprint/" aliases the event graph */
+	TMap<FString, TSharedPtr<const FMCPGraphSnapshot>> Graphs;
+
+	/** Guards Level and Graphs (the pointers, not the immutable views) */
+	mutable FRWLock Lock;
+};
@@ -16,6 +16,7 @@ public class UEBlueprintMCP : ModuleRules
 			"Slate",
 			"SlateCore",
 			"InputCore",
+			"UEBlueprintMCPServer",
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]
@@ -28,8 +29,6 @@ public class UEBlueprintMCP : ModuleRules
 			"GraphEditor",
 			"Json",
 			"JsonUtilities",
-			"Networking",
-			"Sockets",
 			"UMG",
 			"UMGEditor",
 			"EnhancedInput",
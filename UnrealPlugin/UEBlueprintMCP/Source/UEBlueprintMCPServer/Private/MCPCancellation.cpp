@@ -0,0 +1,36 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPCancellation.h"
+
+TSharedRef<FMCPCancelToken> FMCPRequestTracker::Begin(const FString& RequestId, double DeadlineMs)
+{
+	const double Deadline = DeadlineMs > 0.0 ? FPlatformTime::Seconds() + DeadlineMs / 1000.0 : 0.0;
+	TSharedRef<FMCPCancelToken> Token = MakeShared<FMCPCancelToken>(Deadline);
+
+	if (!RequestId.IsEmpty())
+	{
+		FScopeLock ScopeLock(&Lock);
+		InFlight.Add(RequestId, Token);
+	}
+	return Token;
+}
+
+void FMCPRequestTracker::End(const FString& RequestId)
+{
+	if (!RequestId.IsEmpty())
+	{
+		FScopeLock ScopeLock(&Lock);
+		InFlight.Remove(RequestId);
+	}
+}
+
+bool FMCPRequestTracker::Cancel(const FString& RequestId)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (TSharedRef<FMCPCancelToken>* Token = InFlight.Find(RequestId))
+	{
+		(*Token)->Cancel();
+		return true;
+	}
+	return false;
+}
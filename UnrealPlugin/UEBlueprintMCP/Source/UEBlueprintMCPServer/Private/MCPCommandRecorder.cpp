@@ -0,0 +1,118 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPCommandRecorder.h"
+#include "MCPMetrics.h"
+#include "HAL/FileManager.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "MCPLog.h"
+
+namespace
+{
+	using FCondensedWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	/** Milliseconds rounded to microseconds, so lines stay short */
+	double RoundMs(double Seconds)
+	{
+		return FMath::RoundToDouble(Seconds * 1000000.0) / 1000.0;
+	}
+}
+
+FMCPCommandRecorder::FMCPCommandRecorder(const FString& InPath, int32 Port)
+	: Path(InPath)
+	, StartTime(FPlatformTime::Seconds())
+{
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to open recording %s"), *Path);
+		return;
+	}
+
+	// A header per recording, so appending a second one to the same file stays readable
+	FString Header;
+	TSharedRef<FCondensedWriter> Json = FCondensedWriterFactory::Create(&Header);
+	Json->WriteObjectStart();
+	Json->WriteValue(TEXT("mcp_recording"), 1);
+	Json->WriteValue(TEXT("source"), TEXT("server"));
+	Json->WriteValue(TEXT("started"), FDateTime::UtcNow().ToIso8601());
+	Json->WriteValue(TEXT("port"), Port);
+	Json->WriteObjectEnd();
+	Json->Close();
+
+	FScopeLock ScopeLock(&Lock);
+	WriteLine(Header);
+}
+
+FMCPCommandRecorder::~FMCPCommandRecorder()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Writer.IsValid())
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+void FMCPCommandRecorder::Record(int32 ConnectionId, const FString& SessionId, const FString& Message, double ReceivedAt, double AnsweredAt, const FMCPRequestTimings& Timings)
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	// Everything but the request, written as an object whose closing brace is replaced by "req"
+	FString Line;
+	Line.Reserve(128 + Message.Len());
+	TSharedRef<FCondensedWriter> Json = FCondensedWriterFactory::Create(&Line);
+	Json->WriteObjectStart();
+	Json->WriteValue(TEXT("t"), RoundMs(ReceivedAt - StartTime));
+	Json->WriteValue(TEXT("c"), ConnectionId);
+	Json->WriteValue(TEXT("s"), SessionId);
+	Json->WriteValue(TEXT("ms"), RoundMs(AnsweredAt - ReceivedAt));
+	Json->WriteValue(TEXT("ok"), Timings.bSuccess);
+	Json->WriteValue(TEXT("e"), Timings.bSuccess ? FString() : Timings.ErrorType);
+	Json->WriteValue(TEXT("rb"), Timings.ResponseBytes);
+	Json->WriteObjectEnd();
+	Json->Close();
+
+	Line.LeftChopInline(1, EAllowShrinking::No);
+	Line += TEXT(",\"req\":");
+	const int32 RequestStart = Line.Len();
+	Line += Message;
+	Line += TEXT('}');
+
+	// Raw line breaks in JSON can only be whitespace (inside strings they are escaped), so blank them
+	for (int32 i = RequestStart; i < Line.Len(); ++i)
+	{
+		if (Line[i] == TEXT('\n') || Line[i] == TEXT('\r'))
+		{
+			Line[i] = TEXT(' ');
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	WriteLine(Line);
+	++RecordedCount;
+}
+
+int64 FMCPCommandRecorder::GetRecordedCount() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return RecordedCount;
+}
+
+void FMCPCommandRecorder::WriteLine(const FString& Line)
+{
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Converter(*Line, Line.Len());
+	Writer->Serialize(const_cast<void*>(static_cast<const void*>(Converter.Get())), Converter.Length());
+	ANSICHAR Newline = '\n';
+	Writer->Serialize(&Newline, 1);
+	Writer->Flush();
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPCommandRegistry.h"
+#include "MCPResponseWriter.h"
+#include "Misc/SecureHash.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "MCPLog.h"
+
+const TCHAR* LexToString(EMCPCommandCost Cost)
+{
+	switch (Cost)
+	{
+	case EMCPCommandCost::ReadOnly: return TEXT("read_only");
+	case EMCPCommandCost::Mutating: return TEXT("mutating");
+	case EMCPCommandCost::Heavy:    return TEXT("heavy");
+	}
+	return TEXT("mutating");
+}
+
+void FMCPCommandRegistry::Register(const FMCPCommandInfo& Info)
+{
+	if (!ensureMsgf(!bFrozen, TEXT("UEBlueprintMCP: Command '%s' registered after the registry was frozen"), *Info.Name))
+	{
+		return;
+	}
+	Commands.Add(Info.Name, Info);
+}
+
+void FMCPCommandRegistry::RegisterServerCommands()
+{
+	const TPair<const TCHAR*, EMCPCommandCost> ServerCommands[] =
+	{
+		{ TEXT("ping"), EMCPCommandCost::ReadOnly },
+		{ TEXT("get_context"), EMCPCommandCost::ReadOnly },
+		{ TEXT("list_commands"), EMCPCommandCost::ReadOnly },
+		{ TEXT("get_job"), EMCPCommandCost::ReadOnly },
+		{ TEXT("list_jobs"), EMCPCommandCost::ReadOnly },
+		{ TEXT("cancel_job"), EMCPCommandCost::Mutating },
+		{ TEXT("cancel"), EMCPCommandCost::Mutating },
+		{ TEXT("get_queue_stats"), EMCPCommandCost::ReadOnly },
+		{ TEXT("get_metrics"), EMCPCommandCost::ReadOnly },
+		{ TEXT("dump_flight_recorder"), EMCPCommandCost::ReadOnly },
+		{ TEXT("subscribe"), EMCPCommandCost::ReadOnly },
+		{ TEXT("unsubscribe"), EMCPCommandCost::ReadOnly },
+	};
+	for (const TPair<const TCHAR*, EMCPCommandCost>& ServerCommand : ServerCommands)
+	{
+		FMCPCommandInfo Info;
+		Info.Name = ServerCommand.Key;
+		Info.Cost = ServerCommand.Value;
+		Register(Info);
+	}
+}
+
+void FMCPCommandRegistry::Freeze()
+{
+	if (bFrozen)
+	{
+		return;
+	}
+
+	// Sorted so the ETag only changes when the commands do
+	TArray<FString> Names;
+	Commands.GetKeys(Names);
+	Names.Sort();
+
+	TArray<TSharedPtr<FJsonValue>> CommandArray;
+	CommandArray.Reserve(Names.Num());
+	for (const FString& Name : Names)
+	{
+		const FMCPCommandInfo& Info = Commands.FindChecked(Name);
+
+		TSharedPtr<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+		CommandObj->SetStringField(TEXT("name"), Info.Name);
+		CommandObj->SetNumberField(TEXT("version"), Info.Version);
+		CommandObj->SetStringField(TEXT("cost"), LexToString(Info.Cost));
+		CommandObj->SetBoolField(TEXT("concurrent"), Info.bConcurrent);
+		if (Info.ParamsSchema.IsValid())
+		{
+			CommandObj->SetObjectField(TEXT("params_schema"), Info.ParamsSchema);
+		}
+		else
+		{
+			CommandObj->SetField(TEXT("params_schema"), MakeShared<FJsonValueNull>());
+		}
+		CommandArray.Add(MakeShared<FJsonValueObject>(CommandObj));
+	}
+
+	// ETag = MD5 of the condensed command list
+	FString Condensed;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> HashWriter =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Condensed);
+	FJsonSerializer::Serialize(CommandArray, HashWriter);
+	FTCHARToUTF8 Utf8(*Condensed);
+	ETag = FMD5::HashBytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+	// The full response never changes, so serialize it once
+	ListResponse.Reset();
+	{
+		FMCPResponseWriter Writer(ListResponse);
+		Writer.BeginResponse(true);
+		Writer.WriteField(TEXT("etag"), ETag);
+		Writer.WriteField(TEXT("count"), Names.Num());
+		Writer.WriteField(TEXT("commands"), MakeShared<FJsonValueArray>(CommandArray));
+		Writer.EndResponse();
+	}
+
+	bFrozen = true;
+
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Command registry frozen (%d commands, etag %s)"), Names.Num(), *ETag);
+}
+
+const FMCPCommandInfo* FMCPCommandRegistry::Find(const FString& Name) const
+{
+	return Commands.Find(Name);
+}
@@ -0,0 +1,272 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPDispatcher.h"
+#include "MCPCommandRegistry.h"
+#include "MCPResponseWriter.h"
+#include "MCPTrace.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "MCPLog.h"
+
+const TCHAR* LexToString(EMCPLane Lane)
+{
+	switch (Lane)
+	{
+	case EMCPLane::Control:     return TEXT("control");
+	case EMCPLane::Interactive: return TEXT("interactive");
+	case EMCPLane::Bulk:        return TEXT("bulk");
+	case EMCPLane::Background:  return TEXT("background");
+	default:                    break;
+	}
+	return TEXT("interactive");
+}
+
+bool LexTryParseString(EMCPLane& OutLane, const TCHAR* Name)
+{
+	for (int32 i = 0; i < static_cast<int32>(EMCPLane::Num); ++i)
+	{
+		if (FCString::Stricmp(Name, LexToString(static_cast<EMCPLane>(i))) == 0)
+		{
+			OutLane = static_cast<EMCPLane>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+EMCPLane FMCPDispatcher::LaneForCommand(const FMCPCommandInfo* Info)
+{
+	return Info && Info->Cost == EMCPCommandCost::Heavy ? EMCPLane::Bulk : EMCPLane::Interactive;
+}
+
+bool FMCPDispatcher::Enqueue(EMCPLane Lane, const FString& SessionId, const FString& CommandType, TUniqueFunction<void()>&& Work)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		FLane& Queue = Lanes[static_cast<int32>(Lane)];
+		if (Queue.Depth >= LaneCapacity[static_cast<int32>(Lane)])
+		{
+			++Queue.Rejected;
+			UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: %s queue full, rejecting %s from %s"), LexToString(Lane), *CommandType, *SessionId);
+			return false;
+		}
+
+		// A lane waking up starts level with the others instead of owing them past picks
+		if (Queue.Depth == 0)
+		{
+			for (FLane& Other : Lanes)
+			{
+				Other.Picks = 0;
+			}
+		}
+
+		TArray<FWorkItem>& SessionQueue = Queue.BySession.FindOrAdd(SessionId);
+		if (SessionQueue.Num() == 0)
+		{
+			Queue.SessionOrder.Add(SessionId);
+		}
+
+		FWorkItem& Item = SessionQueue.AddDefaulted_GetRef();
+		Item.CommandType = CommandType;
+		Item.Work = MoveTemp(Work);
+		Item.EnqueueTime = FPlatformTime::Seconds();
+
+		++Queue.Depth;
+		++Queue.Enqueued;
+		Queue.PeakDepth = FMath::Max(Queue.PeakDepth, Queue.Depth);
+		TRACE_COUNTER_INCREMENT(MCPQueueDepth);
+	}
+
+	SchedulePump();
+	return true;
+}
+
+bool FMCPDispatcher::HasCapacity(EMCPLane Lane) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Lanes[static_cast<int32>(Lane)].Depth < LaneCapacity[static_cast<int32>(Lane)];
+}
+
+void FMCPDispatcher::WriteBusyResponse(EMCPLane Lane, FMCPResponseWriter& Writer) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FLane& Queue = Lanes[static_cast<int32>(Lane)];
+	const int32 Capacity = LaneCapacity[static_cast<int32>(Lane)];
+
+	// Rough time for the backlog to drain, from what this lane's work has cost so far
+	const double AvgExecMs = Queue.Executed > 0 ? Queue.TotalExecSeconds * 1000.0 / Queue.Executed : 50.0;
+	const double RetryAfterMs = FMath::Max(50.0, FMath::RoundToDouble(AvgExecMs * Queue.Depth));
+
+	Writer.BeginResponse(false);
+	Writer.WriteField(TEXT("error"), FString::Printf(TEXT("The %s queue is full (%d waiting), retry later"), LexToString(Lane), Queue.Depth));
+	Writer.WriteField(TEXT("error_type"), TEXT("busy"));
+	Writer.WriteField(TEXT("lane"), LexToString(Lane));
+	Writer.WriteField(TEXT("queue_depth"), Queue.Depth);
+	Writer.WriteField(TEXT("queue_capacity"), Capacity);
+	Writer.WriteField(TEXT("retry_after_ms"), RetryAfterMs);
+	Writer.EndResponse();
+}
+
+void FMCPDispatcher::WriteStats(FMCPResponseWriter& Writer) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TMap<FString, int32> SessionDepths;
+
+	Writer.BeginArray(TEXT("lanes"));
+	for (int32 i = 0; i < static_cast<int32>(EMCPLane::Num); ++i)
+	{
+		const FLane& Queue = Lanes[i];
+		const double Executed = static_cast<double>(Queue.Executed);
+
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("lane"), LexToString(static_cast<EMCPLane>(i)));
+		Writer.WriteField(TEXT("depth"), Queue.Depth);
+		Writer.WriteField(TEXT("capacity"), LaneCapacity[i]);
+		Writer.WriteField(TEXT("peak_depth"), Queue.PeakDepth);
+		Writer.WriteField(TEXT("enqueued"), static_cast<double>(Queue.Enqueued));
+		Writer.WriteField(TEXT("executed"), Executed);
+		Writer.WriteField(TEXT("rejected"), static_cast<double>(Queue.Rejected));
+		Writer.WriteField(TEXT("avg_wait_ms"), Executed > 0 ? Queue.TotalWaitSeconds * 1000.0 / Executed : 0.0);
+		Writer.WriteField(TEXT("max_wait_ms"), Queue.MaxWaitSeconds * 1000.0);
+		Writer.WriteField(TEXT("avg_exec_ms"), Executed > 0 ? Queue.TotalExecSeconds * 1000.0 / Executed : 0.0);
+		Writer.EndObject();
+
+		for (const TPair<FString, TArray<FWorkItem>>& Pair : Queue.BySession)
+		{
+			SessionDepths.FindOrAdd(Pair.Key) += Pair.Value.Num();
+		}
+	}
+	Writer.EndArray();
+
+	// Work currently waiting per session, across lanes
+	Writer.BeginObject(TEXT("sessions"));
+	for (const TPair<FString, int32>& Pair : SessionDepths)
+	{
+		if (Pair.Value > 0)
+		{
+			Writer.WriteField(Pair.Key, Pair.Value);
+		}
+	}
+	Writer.EndObject();
+
+	Writer.WriteField(TEXT("pump_budget_ms"), PumpBudgetSeconds * 1000.0);
+}
+
+void FMCPDispatcher::SchedulePump()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bPumpScheduled)
+		{
+			return;
+		}
+		bPumpScheduled = true;
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [Self = AsShared()]()
+	{
+		Self->Pump();
+	});
+}
+
+void FMCPDispatcher::Pump()
+{
+	check(IsInGameThread());
+	MCP_TRACE_SCOPE("MCP::DispatcherPump");
+
+	const double PumpStart = FPlatformTime::Seconds();
+	for (;;)
+	{
+		FWorkItem Item;
+		EMCPLane Lane = EMCPLane::Interactive;
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (!PopNext(Item, Lane))
+			{
+				bPumpScheduled = false;
+				return;
+			}
+		}
+
+		const double RunStart = FPlatformTime::Seconds();
+		Item.Work();
+		const double RunEnd = FPlatformTime::Seconds();
+
+		{
+			FScopeLock ScopeLock(&Lock);
+			FLane& Queue = Lanes[static_cast<int32>(Lane)];
+			++Queue.Executed;
+			Queue.TotalWaitSeconds += RunStart - Item.EnqueueTime;
+			Queue.MaxWaitSeconds = FMath::Max(Queue.MaxWaitSeconds, RunStart - Item.EnqueueTime);
+			Queue.TotalExecSeconds += RunEnd - RunStart;
+		}
+
+		// Let the editor tick; the next pump (still marked scheduled) picks up the rest.
+		// A game thread task would run in the same task drain, so wait for the next ticker tick.
+		if (RunEnd - PumpStart > PumpBudgetSeconds)
+		{
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Self = AsShared()](float DeltaTime)
+			{
+				Self->Pump();
+				return false;
+			}));
+			return;
+		}
+	}
+}
+
+bool FMCPDispatcher::PopNext(FWorkItem& OutItem, EMCPLane& OutLane)
+{
+	// Control first; otherwise the waiting lane furthest behind its weighted share
+	int32 Picked = INDEX_NONE;
+	if (Lanes[static_cast<int32>(EMCPLane::Control)].Depth > 0)
+	{
+		Picked = static_cast<int32>(EMCPLane::Control);
+	}
+	else
+	{
+		for (int32 i = static_cast<int32>(EMCPLane::Interactive); i < static_cast<int32>(EMCPLane::Num); ++i)
+		{
+			if (Lanes[i].Depth == 0)
+			{
+				continue;
+			}
+			// Picks[i] / Weight[i] < Picks[Picked] / Weight[Picked], ties to the higher priority
+			if (Picked == INDEX_NONE || Lanes[i].Picks * LaneWeight[Picked] < Lanes[Picked].Picks * LaneWeight[i])
+			{
+				Picked = i;
+			}
+		}
+	}
+
+	if (Picked == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Round-robin across the lane's sessions
+	FLane& Queue = Lanes[Picked];
+	const FString SessionId = Queue.SessionOrder[0];
+	Queue.SessionOrder.RemoveAt(0);
+
+	TArray<FWorkItem>& SessionQueue = Queue.BySession.FindChecked(SessionId);
+	OutItem = MoveTemp(SessionQueue[0]);
+	SessionQueue.RemoveAt(0);
+	if (SessionQueue.Num() > 0)
+	{
+		Queue.SessionOrder.Add(SessionId);
+	}
+	else
+	{
+		Queue.BySession.Remove(SessionId);
+	}
+
+	--Queue.Depth;
+	++Queue.Picks;
+	TRACE_COUNTER_DECREMENT(MCPQueueDepth);
+	OutLane = static_cast<EMCPLane>(Picked);
+	return true;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPEvents.h"
+#include "MCPOutbox.h"
+#include "MCPResponseWriter.h"
+
+const TArray<FString>& FMCPEventHub::GetEventNames()
+{
+	static const TArray<FString> EventNames =
+	{
+		TEXT("asset_added"),
+		TEXT("asset_removed"),
+		TEXT("asset_renamed"),
+		TEXT("blueprint_compiled"),
+		TEXT("package_saved"),
+		TEXT("actor_added"),
+		TEXT("actor_deleted"),
+		TEXT("actor_moved"),
+		TEXT("pie_started"),
+		TEXT("pie_stopped"),
+		TEXT("shader_compile_finished"),
+	};
+	return EventNames;
+}
+
+bool FMCPEventHub::IsKnownEvent(const FString& EventName)
+{
+	return GetEventNames().Contains(EventName);
+}
+
+void FMCPEventHub::Subscribe(int32 ConnectionId, const TSharedPtr<FMCPOutbox>& Outbox, const TArray<FString>& Events)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FSubscriber& Subscriber = Subscribers.FindOrAdd(ConnectionId);
+	Subscriber.Outbox = Outbox;
+	Subscriber.Events.Append(Events.Num() > 0 ? Events : GetEventNames());
+}
+
+void FMCPEventHub::Unsubscribe(int32 ConnectionId, const TArray<FString>& Events)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FSubscriber* Subscriber = Subscribers.Find(ConnectionId);
+	if (!Subscriber)
+	{
+		return;
+	}
+
+	for (const FString& EventName : Events)
+	{
+		Subscriber->Events.Remove(EventName);
+	}
+	if (Events.Num() == 0 || Subscriber->Events.Num() == 0)
+	{
+		Subscribers.Remove(ConnectionId);
+	}
+}
+
+TArray<FString> FMCPEventHub::GetSubscriptions(int32 ConnectionId) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<FString> Result;
+	if (const FSubscriber* Subscriber = Subscribers.Find(ConnectionId))
+	{
+		Result = Subscriber->Events.Array();
+		Result.Sort();
+	}
+	return Result;
+}
+
+bool FMCPEventHub::HasSubscribers(const FString& EventName) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	for (const TPair<int32, FSubscriber>& Pair : Subscribers)
+	{
+		if (Pair.Value.Events.Contains(EventName))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FMCPEventHub::Publish(const FString& EventName, TFunctionRef<void(FMCPResponseWriter&)> WriteFields)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// Collect live outboxes first so nothing is serialized for nobody
+	TArray<TSharedPtr<FMCPOutbox>, TInlineAllocator<8>> Outboxes;
+	for (auto It = Subscribers.CreateIterator(); It; ++It)
+	{
+		TSharedPtr<FMCPOutbox> Outbox = It.Value().Outbox.Pin();
+		if (!Outbox.IsValid())
+		{
+			// Connection closed without unsubscribing
+			It.RemoveCurrent();
+		}
+		else if (It.Value().Events.Contains(EventName))
+		{
+			Outboxes.Add(MoveTemp(Outbox));
+		}
+	}
+	if (Outboxes.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<uint8> Body;
+	{
+		FMCPResponseWriter Writer(Body);
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("event"), EventName);
+		Writer.WriteField(TEXT("seq"), static_cast<double>(NextSequence++));
+		WriteFields(Writer);
+		Writer.EndObject();
+	}
+
+	for (int32 i = 0; i < Outboxes.Num(); ++i)
+	{
+		// Last subscriber takes the buffer, the others get a copy
+		Outboxes[i]->PushEvent(i == Outboxes.Num() - 1 ? MoveTemp(Body) : TArray<uint8>(Body));
+	}
+}
+
+void FMCPEventHub::Publish(const FString& EventName)
+{
+	Publish(EventName, [](FMCPResponseWriter&) {});
+}
@@ -0,0 +1,169 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPFlightRecorder.h"
+#include "MCPResponseWriter.h"
+#include "MCPLog.h"
+
+namespace
+{
+	/** Truncating ASCII copy that always leaves Dest null-terminated */
+	template <int32 N>
+	void CopyAscii(ANSICHAR (&Dest)[N], const FString& Source)
+	{
+		const int32 Count = FMath::Min(Source.Len(), N - 1);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const TCHAR Char = Source[i];
+			Dest[i] = (Char >= 0x20 && Char < 0x7F) ? static_cast<ANSICHAR>(Char) : '?';
+		}
+		Dest[Count] = '\0';
+	}
+
+	bool ShouldAutoDump(const FString& ErrorType)
+	{
+		return ErrorType == TEXT("crash_prevented")
+			|| ErrorType == TEXT("execution_failed")
+			|| ErrorType == TEXT("post_validation_failed");
+	}
+
+	double GetTotalMs(const FMCPFlightRecord& Record)
+	{
+		double Total = 0.0;
+		for (float Ms : Record.StageMs)
+		{
+			Total += Ms;
+		}
+		return Total;
+	}
+}
+
+FMCPFlightRecorder::FMCPFlightRecorder()
+{
+	Ring.SetNum(Capacity);
+}
+
+void FMCPFlightRecorder::Record(const FString& CommandType, const FString& SessionId, const FString& RequestId, const FMCPRequestTimings& Timings)
+{
+	bool bDump = false;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		FMCPFlightRecord& Record = Ring[NextSequence % Capacity];
+		Record.UtcTicks = FDateTime::UtcNow().GetTicks();
+		Record.Sequence = NextSequence++;
+		for (int32 i = 0; i < static_cast<int32>(EMCPStage::Num); ++i)
+		{
+			Record.StageMs[i] = static_cast<float>(Timings.StageSeconds[i] * 1000.0);
+		}
+		Record.StagesReached = Timings.StagesReached;
+		Record.RequestBytes = static_cast<int32>(FMath::Min<int64>(Timings.RequestBytes, MAX_int32));
+		Record.ResponseBytes = static_cast<int32>(FMath::Min<int64>(Timings.ResponseBytes, MAX_int32));
+		Record.bSuccess = Timings.bSuccess;
+		CopyAscii(Record.Command, CommandType);
+		CopyAscii(Record.Session, SessionId);
+		CopyAscii(Record.RequestId, RequestId);
+		CopyAscii(Record.ErrorType, Timings.bSuccess ? FString() : Timings.ErrorType);
+
+		if (!Timings.bSuccess && ShouldAutoDump(Timings.ErrorType))
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (Now - LastAutoDumpTime >= AutoDumpIntervalSeconds)
+			{
+				LastAutoDumpTime = Now;
+				bDump = true;
+			}
+		}
+	}
+
+	if (bDump)
+	{
+		DumpToLog(*FString::Printf(TEXT("%s failed with %s"), *CommandType, *Timings.ErrorType), AutoDumpRecords);
+	}
+}
+
+TArray<FMCPFlightRecord> FMCPFlightRecorder::GetLatest(int32 MaxRecords, uint64& OutRecorded) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	OutRecorded = NextSequence;
+	const uint64 Count = FMath::Min<uint64>(FMath::Clamp(MaxRecords, 0, Capacity), FMath::Min<uint64>(NextSequence, Capacity));
+	TArray<FMCPFlightRecord> Records;
+	Records.Reserve(static_cast<int32>(Count));
+	for (uint64 Sequence = NextSequence - Count; Sequence < NextSequence; ++Sequence)
+	{
+		Records.Add(Ring[Sequence % Capacity]);
+	}
+	return Records;
+}
+
+void FMCPFlightRecorder::WriteJson(FMCPResponseWriter& Writer, int32 MaxRecords) const
+{
+	uint64 Recorded = 0;
+	const TArray<FMCPFlightRecord> Records = GetLatest(MaxRecords, Recorded);
+
+	Writer.WriteField(TEXT("capacity"), Capacity);
+	Writer.WriteField(TEXT("recorded"), static_cast<double>(Recorded));
+	Writer.BeginArray(TEXT("records"));
+	for (const FMCPFlightRecord& Record : Records)
+	{
+		Writer.BeginObject();
+		Writer.WriteField(TEXT("seq"), static_cast<double>(Record.Sequence));
+		Writer.WriteField(TEXT("time"), FDateTime(Record.UtcTicks).ToIso8601());
+		Writer.WriteField(TEXT("command"), ANSI_TO_TCHAR(Record.Command));
+		Writer.WriteField(TEXT("session"), ANSI_TO_TCHAR(Record.Session));
+		if (Record.RequestId[0] != '\0')
+		{
+			Writer.WriteField(TEXT("id"), ANSI_TO_TCHAR(Record.RequestId));
+		}
+		Writer.WriteField(TEXT("success"), Record.bSuccess);
+		if (Record.ErrorType[0] != '\0')
+		{
+			Writer.WriteField(TEXT("error_type"), ANSI_TO_TCHAR(Record.ErrorType));
+		}
+		Writer.WriteField(TEXT("total_ms"), GetTotalMs(Record));
+		Writer.BeginObject(TEXT("stages_ms"));
+		for (int32 i = 0; i < static_cast<int32>(EMCPStage::Num); ++i)
+		{
+			if (Record.StagesReached & (1u << i))
+			{
+				Writer.WriteField(LexToString(static_cast<EMCPStage>(i)), static_cast<double>(Record.StageMs[i]));
+			}
+		}
+		Writer.EndObject();
+		Writer.WriteField(TEXT("request_bytes"), Record.RequestBytes);
+		Writer.WriteField(TEXT("response_bytes"), Record.ResponseBytes);
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+}
+
+void FMCPFlightRecorder::DumpToLog(const TCHAR* Reason, int32 MaxRecords) const
+{
+	uint64 Recorded = 0;
+	const TArray<FMCPFlightRecord> Records = GetLatest(MaxRecords, Recorded);
+
+	UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Flight recorder (%s), last %d of %llu requests:"), Reason, Records.Num(), Recorded);
+	for (const FMCPFlightRecord& Record : Records)
+	{
+		FString Stages;
+		for (int32 i = 0; i < static_cast<int32>(EMCPStage::Num); ++i)
+		{
+			if (Record.StagesReached & (1u << i))
+			{
+				Stages += FString::Printf(TEXT(" %s=%.2f"), LexToString(static_cast<EMCPStage>(i)), Record.StageMs[i]);
+			}
+		}
+
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("  #%llu %s %s session=%s id=%s %s %.2fms (%s ) %d/%d bytes"),
+			Record.Sequence,
+			*FDateTime(Record.UtcTicks).ToString(TEXT("%H:%M:%S.%s")),
+			ANSI_TO_TCHAR(Record.Command),
+			ANSI_TO_TCHAR(Record.Session),
+			Record.RequestId[0] != '\0' ? ANSI_TO_TCHAR(Record.RequestId) : TEXT("-"),
+			Record.bSuccess ? TEXT("ok") : (Record.ErrorType[0] != '\0' ? ANSI_TO_TCHAR(Record.ErrorType) : TEXT("error")),
+			GetTotalMs(Record),
+			*Stages,
+			Record.RequestBytes,
+			Record.ResponseBytes);
+	}
+}
@@ -0,0 +1,260 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPJobs.h"
+#include "MCPOutbox.h"
+#include "MCPResponseWriter.h"
+#include "MCPLog.h"
+
+const TCHAR* LexToString(EMCPJobState State)
+{
+	switch (State)
+	{
+	case EMCPJobState::Queued:    return TEXT("queued");
+	case EMCPJobState::Running:   return TEXT("running");
+	case EMCPJobState::Succeeded: return TEXT("succeeded");
+	case EMCPJobState::Failed:    return TEXT("failed");
+	case EMCPJobState::Cancelled: return TEXT("cancelled");
+	}
+	return TEXT("failed");
+}
+
+static TSharedPtr<FJsonObject> MakeJobErrorResponse(const FString& ErrorMessage, const FString& ErrorType)
+{
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetBoolField(TEXT("success"), false);
+	Response->SetStringField(TEXT("error"), ErrorMessage);
+	Response->SetStringField(TEXT("error_type"), ErrorType);
+	return Response;
+}
+
+// =========================================================================
+// FMCPJob
+// =========================================================================
+
+FMCPJob::FMCPJob(const FString& InId, const FString& InCommandType, const FString& InSessionId, const TSharedPtr<FMCPOutbox>& InOutbox)
+	: Id(InId)
+	, CommandType(InCommandType)
+	, SessionId(InSessionId)
+	, Outbox(InOutbox)
+	, bCancelRequested(false)
+	, State(EMCPJobState::Queued)
+	, Progress(0.0f)
+	, CreatedTime(FPlatformTime::Seconds())
+	, FinishedTime(0.0)
+{
+}
+
+EMCPJobState FMCPJob::GetState() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return State;
+}
+
+bool FMCPJob::IsFinished() const
+{
+	const EMCPJobState Current = GetState();
+	return Current != EMCPJobState::Queued && Current != EMCPJobState::Running;
+}
+
+void FMCPJob::SetProgress(float InProgress, const FString& InPhase)
+{
+	FScopeLock ScopeLock(&Lock);
+	Progress = FMath::Clamp(InProgress, 0.0f, 1.0f);
+	Phase = InPhase;
+}
+
+void FMCPJob::CompleteWhen(TFunction<bool()> Condition, const FString& WaitPhase)
+{
+	check(IsInGameThread());
+	CompletionCondition = MoveTemp(Condition);
+	SetProgress(Progress, WaitPhase);
+}
+
+void FMCPJob::WriteStatusFields(FMCPResponseWriter& Writer, bool bIncludeResult) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const double EndTime = FinishedTime > 0.0 ? FinishedTime : FPlatformTime::Seconds();
+	const bool bFinished = State != EMCPJobState::Queued && State != EMCPJobState::Running;
+
+	Writer.WriteField(TEXT("job_id"), Id);
+	Writer.WriteField(TEXT("command"), CommandType);
+	Writer.WriteField(TEXT("status"), LexToString(State));
+	Writer.WriteField(TEXT("progress"), bFinished ? 1.0 : static_cast<double>(Progress));
+	if (!Phase.IsEmpty())
+	{
+		Writer.WriteField(TEXT("phase"), Phase);
+	}
+	Writer.WriteField(TEXT("elapsed_ms"), FMath::RoundToDouble((EndTime - CreatedTime) * 1000.0));
+
+	if (bIncludeResult && bFinished && Result.IsValid())
+	{
+		Writer.WriteField(TEXT("result"), MakeShared<FJsonValueObject>(Result));
+	}
+}
+
+// =========================================================================
+// FMCPJobManager
+// =========================================================================
+
+TSharedRef<FMCPJob> FMCPJobManager::CreateJob(const FString& CommandType, const FString& SessionId, const TSharedPtr<FMCPOutbox>& Outbox)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FString JobId = FString::Printf(TEXT("job-%d"), NextJobId++);
+	TSharedRef<FMCPJob> Job = MakeShared<FMCPJob>(JobId, CommandType, SessionId, Outbox);
+	Jobs.Add(JobId, Job);
+	JobOrder.Add(JobId);
+	return Job;
+}
+
+TSharedPtr<FMCPJob> FMCPJobManager::Find(const FString& JobId) const
+{
+	FScopeLock ScopeLock(&Lock);
+	const TSharedRef<FMCPJob>* Job = Jobs.Find(JobId);
+	return Job ? TSharedPtr<FMCPJob>(*Job) : nullptr;
+}
+
+TArray<TSharedRef<FMCPJob>> FMCPJobManager::GetJobs() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<TSharedRef<FMCPJob>> Result;
+	Result.Reserve(JobOrder.Num());
+	for (const FString& JobId : JobOrder)
+	{
+		Result.Add(Jobs.FindChecked(JobId));
+	}
+	return Result;
+}
+
+bool FMCPJobManager::MarkRunning(const TSharedRef<FMCPJob>& Job)
+{
+	FScopeLock JobLock(&Job->Lock);
+	if (Job->State != EMCPJobState::Queued)
+	{
+		return false;
+	}
+	Job->State = EMCPJobState::Running;
+	return true;
+}
+
+void FMCPJobManager::Finish(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Response)
+{
+	check(IsInGameThread());
+
+	bool bSuccess = false;
+	FString ErrorType;
+	if (Response.IsValid())
+	{
+		Response->TryGetBoolField(TEXT("success"), bSuccess);
+		Response->TryGetStringField(TEXT("error_type"), ErrorType);
+	}
+
+	// The command is done but its side work (e.g. shader compilation) isn't
+	if (bSuccess && Job->CompletionCondition)
+	{
+		{
+			FScopeLock JobLock(&Job->Lock);
+			Job->Result = Response;
+		}
+		WaitingJobs.Add(Job);
+		return;
+	}
+
+	const EMCPJobState FinalState = bSuccess ? EMCPJobState::Succeeded
+		: (ErrorType == TEXT("cancelled") ? EMCPJobState::Cancelled : EMCPJobState::Failed);
+	Complete(Job, FinalState, Response.IsValid() ? Response : MakeJobErrorResponse(TEXT("Command returned no response"), TEXT("crash_prevented")));
+}
+
+bool FMCPJobManager::Cancel(const FString& JobId)
+{
+	TSharedPtr<FMCPJob> Job = Find(JobId);
+	if (!Job.IsValid() || Job->IsFinished())
+	{
+		return false;
+	}
+
+	Job->RequestCancel();
+
+	// Not started yet: claim it so MarkRunning() fails, nothing to wind down
+	bool bWasQueued = false;
+	{
+		FScopeLock JobLock(&Job->Lock);
+		bWasQueued = Job->State == EMCPJobState::Queued;
+		if (bWasQueued)
+		{
+			Job->State = EMCPJobState::Cancelled;
+		}
+	}
+	if (bWasQueued)
+	{
+		Complete(Job.ToSharedRef(), EMCPJobState::Cancelled, MakeJobErrorResponse(TEXT("Job cancelled before it started"), TEXT("cancelled")));
+	}
+	return true;
+}
+
+void FMCPJobManager::TickWaitingJobs()
+{
+	check(IsInGameThread());
+
+	for (int32 i = WaitingJobs.Num() - 1; i >= 0; --i)
+	{
+		TSharedRef<FMCPJob> Job = WaitingJobs[i];
+		if (Job->IsCancelRequested())
+		{
+			WaitingJobs.RemoveAt(i);
+			Complete(Job, EMCPJobState::Cancelled, MakeJobErrorResponse(TEXT("Job cancelled while waiting for completion"), TEXT("cancelled")));
+		}
+		else if (Job->CompletionCondition())
+		{
+			WaitingJobs.RemoveAt(i);
+
+			TSharedPtr<FJsonObject> Response;
+			{
+				FScopeLock JobLock(&Job->Lock);
+				Response = Job->Result;
+			}
+			Complete(Job, EMCPJobState::Succeeded, Response);
+		}
+	}
+}
+
+void FMCPJobManager::Complete(const TSharedRef<FMCPJob>& Job, EMCPJobState FinalState, const TSharedPtr<FJsonObject>& Response)
+{
+	{
+		FScopeLock JobLock(&Job->Lock);
+		Job->State = FinalState;
+		Job->Result = Response;
+		Job->FinishedTime = FPlatformTime::Seconds();
+	}
+
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Job %s (%s) %s"), *Job->GetId(), *Job->GetCommandType(), LexToString(FinalState));
+
+	// Push completion to the connection that started the job, if it's still open
+	if (TSharedPtr<FMCPOutbox> Outbox = Job->Outbox.Pin())
+	{
+		TArray<uint8> Body;
+		{
+			FMCPResponseWriter Writer(Body);
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("event"), TEXT("job_completed"));
+			Job->WriteStatusFields(Writer, true);
+			Writer.EndObject();
+		}
+		Outbox->Push(MoveTemp(Body));
+	}
+
+	// Age out the oldest finished jobs
+	FScopeLock ScopeLock(&Lock);
+	int32 FinishedCount = 0;
+	for (int32 i = JobOrder.Num() - 1; i >= 0; --i)
+	{
+		const TSharedRef<FMCPJob>& Existing = Jobs.FindChecked(JobOrder[i]);
+		if (Existing->IsFinished() && ++FinishedCount > MaxFinishedJobs)
+		{
+			Jobs.Remove(JobOrder[i]);
+			JobOrder.RemoveAt(i);
+		}
+	}
+}
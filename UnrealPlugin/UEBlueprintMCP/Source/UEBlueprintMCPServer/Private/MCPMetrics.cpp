@@ -0,0 +1,287 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPMetrics.h"
+#include "MCPCommandRegistry.h"
+#include "MCPResponseWriter.h"
+
+const TCHAR* LexToString(EMCPStage Stage)
+{
+	switch (Stage)
+	{
+	case EMCPStage::Receive:   return TEXT("receive");
+	case EMCPStage::Parse:     return TEXT("parse");
+	case EMCPStage::QueueWait: return TEXT("queue_wait");
+	case EMCPStage::Validate:  return TEXT("validate");
+	case EMCPStage::Execute:   return TEXT("execute");
+	case EMCPStage::Save:      return TEXT("save");
+	case EMCPStage::Serialize: return TEXT("serialize");
+	case EMCPStage::Send:      return TEXT("send");
+	default:                   break;
+	}
+	return TEXT("unknown");
+}
+
+namespace
+{
+	const double Quantiles[] = { 0.5, 0.9, 0.99 };
+
+	uint64 SecondsToMicros(double Seconds)
+	{
+		return Seconds > 0.0 ? static_cast<uint64>(Seconds * 1000000.0) : 0;
+	}
+
+	/** {"count","mean","p50","p90","p99","max"} with values multiplied by Scale */
+	void WriteHistogram(FMCPResponseWriter& Writer, const FString& Key, const FMCPHistogram& Histogram, double Scale)
+	{
+		const uint64 Count = Histogram.GetCount();
+
+		Writer.BeginObject(Key);
+		Writer.WriteField(TEXT("count"), static_cast<double>(Count));
+		Writer.WriteField(TEXT("mean"), Count > 0 ? Histogram.GetSum() * Scale / Count : 0.0);
+		Writer.WriteField(TEXT("p50"), Histogram.GetPercentile(0.5) * Scale);
+		Writer.WriteField(TEXT("p90"), Histogram.GetPercentile(0.9) * Scale);
+		Writer.WriteField(TEXT("p99"), Histogram.GetPercentile(0.99) * Scale);
+		Writer.WriteField(TEXT("max"), Histogram.GetMax() * Scale);
+		Writer.EndObject();
+	}
+
+	/** Quantile, _sum and _count lines of one summary series */
+	void AppendSummary(FString& Out, const TCHAR* Name, const FString& Labels, const FMCPHistogram& Histogram, double Scale)
+	{
+		for (double Quantile : Quantiles)
+		{
+			Out += FString::Printf(TEXT("%s{%s,quantile=\"%g\"} %.9g\n"), Name, *Labels, Quantile, Histogram.GetPercentile(Quantile) * Scale);
+		}
+		Out += FString::Printf(TEXT("%s_sum{%s} %.9g\n"), Name, *Labels, Histogram.GetSum() * Scale);
+		Out += FString::Printf(TEXT("%s_count{%s} %llu\n"), Name, *Labels, Histogram.GetCount());
+	}
+}
+
+// ============================================================================
+// FMCPHistogram
+// ============================================================================
+
+int32 FMCPHistogram::BucketIndex(uint64 Value)
+{
+	if (Value < SubBucketCount)
+	{
+		return static_cast<int32>(Value);
+	}
+
+	const int32 Exponent = static_cast<int32>(FPlatformMath::FloorLog2_64(Value));
+	if (Exponent > MaxExponent)
+	{
+		return NumBuckets - 1;
+	}
+
+	// Top SubBucketBits+1 bits of the value: SubBucketCount..2*SubBucketCount-1
+	const int32 SubBucket = static_cast<int32>(Value >> (Exponent - SubBucketBits)) - SubBucketCount;
+	return (Exponent - SubBucketBits + 1) * SubBucketCount + SubBucket;
+}
+
+uint64 FMCPHistogram::BucketUpperBound(int32 Index)
+{
+	if (Index < SubBucketCount)
+	{
+		return static_cast<uint64>(Index);
+	}
+
+	const int32 Exponent = Index / SubBucketCount + SubBucketBits - 1;
+	const uint64 SubBucket = static_cast<uint64>(Index % SubBucketCount);
+	const uint64 Width = 1ull << (Exponent - SubBucketBits);
+	return (SubBucketCount + SubBucket) * Width + Width - 1;
+}
+
+void FMCPHistogram::Record(uint64 Value)
+{
+	Buckets[BucketIndex(Value)].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	Sum.fetch_add(Value, std::memory_order_relaxed);
+
+	uint64 Current = Max.load(std::memory_order_relaxed);
+	while (Value > Current && !Max.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+	{
+	}
+}
+
+uint64 FMCPHistogram::GetPercentile(double Fraction) const
+{
+	const uint64 Total = GetCount();
+	if (Total == 0)
+	{
+		return 0;
+	}
+
+	// Counters move independently while we read; the result is approximate anyway
+	const uint64 Target = FMath::Max<uint64>(1, static_cast<uint64>(FMath::CeilToDouble(Fraction * Total)));
+	uint64 Seen = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Seen += Buckets[i].load(std::memory_order_relaxed);
+		if (Seen >= Target)
+		{
+			return FMath::Min(BucketUpperBound(i), GetMax());
+		}
+	}
+	return GetMax();
+}
+
+// ============================================================================
+// FMCPMetrics
+// ============================================================================
+
+FMCPMetrics::FMCPMetrics(const FMCPCommandRegistry& Registry)
+	: Unknown(MakeUnique<FCommandMetrics>())
+	, StartTime(FPlatformTime::Seconds())
+{
+	ByCommand.Reserve(Registry.Num());
+	for (const TPair<FString, FMCPCommandInfo>& Pair : Registry.GetCommands())
+	{
+		ByCommand.Add(Pair.Key, MakeUnique<FCommandMetrics>());
+	}
+}
+
+FMCPMetrics::FCommandMetrics& FMCPMetrics::FindMetrics(const FString& CommandType)
+{
+	TUniquePtr<FCommandMetrics>* Found = ByCommand.Find(CommandType);
+	return Found ? **Found : *Unknown;
+}
+
+void FMCPMetrics::Record(const FString& CommandType, const FMCPRequestTimings& Timings)
+{
+	FCommandMetrics& Metrics = FindMetrics(CommandType);
+
+	double TotalSeconds = 0.0;
+	for (int32 i = 0; i < static_cast<int32>(EMCPStage::Num); ++i)
+	{
+		if (Timings.HasStage(static_cast<EMCPStage>(i)))
+		{
+			Metrics.Stages[i].Record(SecondsToMicros(Timings.StageSeconds[i]));
+			TotalSeconds += Timings.StageSeconds[i];
+		}
+	}
+	Metrics.Total.Record(SecondsToMicros(TotalSeconds));
+
+	// Async jobs don't come with message sizes
+	if (Timings.RequestBytes > 0)
+	{
+		Metrics.RequestBytes.Record(static_cast<uint64>(Timings.RequestBytes));
+	}
+	if (Timings.ResponseBytes > 0)
+	{
+		Metrics.ResponseBytes.Record(static_cast<uint64>(Timings.ResponseBytes));
+	}
+
+	if (!Timings.bSuccess)
+	{
+		Metrics.Errors.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+TArray<TPair<FString, const FMCPMetrics::FCommandMetrics*>> FMCPMetrics::GetRecorded() const
+{
+	TArray<TPair<FString, const FCommandMetrics*>> Recorded;
+	for (const TPair<FString, TUniquePtr<FCommandMetrics>>& Pair : ByCommand)
+	{
+		if (Pair.Value->Total.GetCount() > 0)
+		{
+			Recorded.Emplace(Pair.Key, Pair.Value.Get());
+		}
+	}
+	Recorded.Sort([](const TPair<FString, const FCommandMetrics*>& A, const TPair<FString, const FCommandMetrics*>& B) { return A.Key < B.Key; });
+
+	if (Unknown->Total.GetCount() > 0)
+	{
+		Recorded.Emplace(TEXT("unknown"), Unknown.Get());
+	}
+	return Recorded;
+}
+
+void FMCPMetrics::WriteJson(FMCPResponseWriter& Writer) const
+{
+	Writer.WriteField(TEXT("uptime_seconds"), FPlatformTime::Seconds() - StartTime);
+
+	Writer.BeginObject(TEXT("commands"));
+	for (const TPair<FString, const FCommandMetrics*>& Pair : GetRecorded())
+	{
+		const FCommandMetrics& Metrics = *Pair.Value;
+		const uint64 Count = Metrics.Total.GetCount();
+		const uint64 Errors = Metrics.Errors.load(std::memory_order_relaxed);
+
+		Writer.BeginObject(Pair.Key);
+		Writer.WriteField(TEXT("count"), static_cast<double>(Count));
+		Writer.WriteField(TEXT("errors"), static_cast<double>(Errors));
+		Writer.WriteField(TEXT("error_rate"), static_cast<double>(Errors) / Count);
+
+		Writer.BeginObject(TEXT("latency_ms"));
+		WriteHistogram(Writer, TEXT("total"), Metrics.Total, 0.001);
+		for (int32 i = 0; i < static_cast<int32>(EMCPStage::Num); ++i)
+		{
+			if (Metrics.Stages[i].GetCount() > 0)
+			{
+				WriteHistogram(Writer, LexToString(static_cast<EMCPStage>(i)), Metrics.Stages[i], 0.001);
+			}
+		}
+		Writer.EndObject();
+
+		WriteHistogram(Writer, TEXT("request_bytes"), Metrics.RequestBytes, 1.0);
+		WriteHistogram(Writer, TEXT("response_bytes"), Metrics.ResponseBytes, 1.0);
+		Writer.EndObject();
+	}
+	Writer.EndObject();
+}
+
+FString FMCPMetrics::ToPrometheus() const
+{
+	const TArray<TPair<FString, const FCommandMetrics*>> Recorded = GetRecorded();
+
+	FString Out;
+	Out += TEXT("# HELP ue_mcp_uptime_seconds Seconds since the bridge started.\n");
+	Out += TEXT("# TYPE ue_mcp_uptime_seconds gauge\n");
+	Out += FString::Printf(TEXT("ue_mcp_uptime_seconds %.3f\n"), FPlatformTime::Seconds() - StartTime);
+
+	Out += TEXT("# HELP ue_mcp_requests_total Requests handled, by command.\n");
+	Out += TEXT("# TYPE ue_mcp_requests_total counter\n");
+	for (const TPair<FString, const FCommandMetrics*>& Pair : Recorded)
+	{
+		Out += FString::Printf(TEXT("ue_mcp_requests_total{command=\"%s\"} %llu\n"), *Pair.Key, Pair.Value->Total.GetCount());
+	}
+
+	Out += TEXT("# HELP ue_mcp_errors_total Requests answered with success=false, by command.\n");
+	Out += TEXT("# TYPE ue_mcp_errors_total counter\n");
+	for (const TPair<FString, const FCommandMetrics*>& Pair : Recorded)
+	{
+		Out += FString::Printf(TEXT("ue_mcp_errors_total{command=\"%s\"} %llu\n"), *Pair.Key, Pair.Value->Errors.load(std::memory_order_relaxed));
+	}
+
+	Out += TEXT("# HELP ue_mcp_stage_seconds Time per pipeline stage (stage=\"total\" is end to end), by command.\n");
+	Out += TEXT("# TYPE ue_mcp_stage_seconds summary\n");
+	for (const TPair<FString, const FCommandMetrics*>& Pair : Recorded)
+	{
+		AppendSummary(Out, TEXT("ue_mcp_stage_seconds"), FString::Printf(TEXT("command=\"%s\",stage=\"total\""), *Pair.Key), Pair.Value->Total, 0.000001);
+		for (int32 i = 0; i < static_cast<int32>(EMCPStage::Num); ++i)
+		{
+			if (Pair.Value->Stages[i].GetCount() > 0)
+			{
+				const FString Labels = FString::Printf(TEXT("command=\"%s\",stage=\"%s\""), *Pair.Key, LexToString(static_cast<EMCPStage>(i)));
+				AppendSummary(Out, TEXT("ue_mcp_stage_seconds"), Labels, Pair.Value->Stages[i], 0.000001);
+			}
+		}
+	}
+
+	Out += TEXT("# HELP ue_mcp_request_bytes Request message size, by command.\n");
+	Out += TEXT("# TYPE ue_mcp_request_bytes summary\n");
+	for (const TPair<FString, const FCommandMetrics*>& Pair : Recorded)
+	{
+		AppendSummary(Out, TEXT("ue_mcp_request_bytes"), FString::Printf(TEXT("command=\"%s\""), *Pair.Key), Pair.Value->RequestBytes, 1.0);
+	}
+
+	Out += TEXT("# HELP ue_mcp_response_bytes Response message size, by command.\n");
+	Out += TEXT("# TYPE ue_mcp_response_bytes summary\n");
+	for (const TPair<FString, const FCommandMetrics*>& Pair : Recorded)
+	{
+		AppendSummary(Out, TEXT("ue_mcp_response_bytes"), FString::Printf(TEXT("command=\"%s\""), *Pair.Key), Pair.Value->ResponseBytes, 1.0);
+	}
+
+	return Out;
+}
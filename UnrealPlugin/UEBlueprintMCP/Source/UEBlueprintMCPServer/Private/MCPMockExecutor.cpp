@@ -0,0 +1,273 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPMockExecutor.h"
+#include "MCPResponseWriter.h"
+#include "MCPCancellation.h"
+#include "MCPJobs.h"
+#include "MCPEvents.h"
+#include "MCPResultCache.h"
+#include "MCPMetrics.h"
+#include "MCPFlightRecorder.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FMCPMockExecutorSettings FMCPMockExecutorSettings::MakeDefault()
+{
+	FMCPMockExecutorSettings Settings;
+
+	FMCPMockCommandProfile& Read = Settings.Commands.Add(TEXT("mock_read"));
+	Read.Cost = EMCPCommandCost::ReadOnly;
+	Read.LatencyMs = 1.0;
+	Read.PayloadBytes = 256;
+
+	FMCPMockCommandProfile& Write = Settings.Commands.Add(TEXT("mock_write"));
+	Write.Cost = EMCPCommandCost::Mutating;
+	Write.LatencyMs = 5.0;
+	Write.PayloadBytes = 64;
+
+	FMCPMockCommandProfile& Heavy = Settings.Commands.Add(TEXT("mock_heavy"));
+	Heavy.Cost = EMCPCommandCost::Heavy;
+	Heavy.LatencyMs = 50.0;
+	Heavy.PayloadBytes = 4096;
+
+	return Settings;
+}
+
+FMCPMockExecutorSettings FMCPMockExecutorSettings::FromRecording(const FString& Path)
+{
+	FMCPMockExecutorSettings Settings;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path))
+	{
+		return Settings;
+	}
+
+	FMCPCommandRegistry ServerCommands;
+	ServerCommands.RegisterServerCommands();
+
+	struct FObserved
+	{
+		TArray<double> Ms;
+		TArray<int32> ResponseBytes;
+		int32 Failures = 0;
+	};
+	TMap<FString, FObserved> ByCommand;
+
+	for (const FString& Line : Lines)
+	{
+		TSharedPtr<FJsonObject> Record;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+		const TSharedPtr<FJsonObject>* Request = nullptr;
+		if (!FJsonSerializer::Deserialize(Reader, Record) || !Record.IsValid() || !Record->TryGetObjectField(TEXT("req"), Request))
+		{
+			// Header, or a line cut short
+			continue;
+		}
+
+		FString CommandType;
+		if (!(*Request)->TryGetStringField(TEXT("type"), CommandType) || CommandType == TEXT("close") || ServerCommands.Find(CommandType))
+		{
+			continue;
+		}
+
+		FObserved& Observed = ByCommand.FindOrAdd(CommandType);
+		Observed.Ms.Add(Record->GetNumberField(TEXT("ms")));
+		Observed.ResponseBytes.Add(static_cast<int32>(Record->GetNumberField(TEXT("rb"))));
+		if (!Record->GetBoolField(TEXT("ok")))
+		{
+			++Observed.Failures;
+		}
+	}
+
+	for (TPair<FString, FObserved>& Pair : ByCommand)
+	{
+		FObserved& Observed = Pair.Value;
+		Observed.Ms.Sort();
+		Observed.ResponseBytes.Sort();
+
+		FMCPMockCommandProfile& Profile = Settings.Commands.Add(Pair.Key);
+		Profile.LatencyMs = Observed.Ms[Observed.Ms.Num() / 2];
+		Profile.PayloadBytes = Observed.ResponseBytes[Observed.ResponseBytes.Num() / 2];
+		Profile.ErrorRate = static_cast<double>(Observed.Failures) / Observed.Ms.Num();
+	}
+	return Settings;
+}
+
+FMCPMockExecutor::FMCPMockExecutor(const FMCPMockExecutorSettings& InSettings)
+	: Settings(InSettings.Commands.Num() > 0 ? InSettings : FMCPMockExecutorSettings::MakeDefault())
+	, Random(InSettings.Seed)
+{
+	CommandRegistry = MakeShared<FMCPCommandRegistry>();
+	CommandRegistry->RegisterServerCommands();
+
+	int32 MaxPayloadBytes = 0;
+	for (const TPair<FString, FMCPMockCommandProfile>& Pair : Settings.Commands)
+	{
+		FMCPCommandInfo Info;
+		Info.Name = Pair.Key;
+		Info.Cost = Pair.Value.Cost;
+		CommandRegistry->Register(Info);
+
+		MaxPayloadBytes = FMath::Max(MaxPayloadBytes, Pair.Value.PayloadBytes);
+	}
+	CommandRegistry->Freeze();
+
+	// Cut from one string so a payload costs a copy, not a fill
+	PayloadSource = FString::ChrN(MaxPayloadBytes, TEXT('x'));
+
+	JobManager = MakeShared<FMCPJobManager>();
+	EventHub = MakeShared<FMCPEventHub>();
+	ResultCache = MakeShared<FMCPResultCache>();
+	Metrics = MakeShared<FMCPMetrics>(*CommandRegistry);
+	FlightRecorder = MakeShared<FMCPFlightRecorder>();
+}
+
+bool FMCPMockExecutor::Simulate(const FMCPMockCommandProfile& Profile, TFunctionRef<bool()> ShouldStop, double& OutLatencyMs)
+{
+	const double Jitter = Profile.JitterMs > 0.0 ? Random.FRandRange(-Profile.JitterMs, Profile.JitterMs) : 0.0;
+	const double TargetSeconds = FMath::Max(0.0, Profile.LatencyMs + Jitter) / 1000.0;
+
+	// Sleep in slices so a cancel or deadline cuts the wait short, like a real action checking between phases
+	const double StartTime = FPlatformTime::Seconds();
+	bool bCompleted = true;
+	for (double Elapsed = 0.0; Elapsed < TargetSeconds; Elapsed = FPlatformTime::Seconds() - StartTime)
+	{
+		if (ShouldStop())
+		{
+			bCompleted = false;
+			break;
+		}
+		FPlatformProcess::Sleep(static_cast<float>(FMath::Min(TargetSeconds - Elapsed, 0.001)));
+	}
+
+	OutLatencyMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	return bCompleted;
+}
+
+FString FMCPMockExecutor::MakePayload(const FMCPMockCommandProfile& Profile) const
+{
+	return PayloadSource.Left(Profile.PayloadBytes);
+}
+
+void FMCPMockExecutor::ExecuteCommandToWriter(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer, const FString& SessionId, const TSharedPtr<FMCPCancelToken>& CancelToken, FMCPRequestTimings* Timings)
+{
+	const FMCPMockCommandProfile* Profile = Settings.Commands.Find(CommandType);
+	if (!Profile)
+	{
+		Writer.WriteErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *CommandType), TEXT("unknown_command"));
+		return;
+	}
+
+	++SessionCalls.FindOrAdd(SessionId);
+
+	double LatencyMs = 0.0;
+	bool bCompleted = false;
+	{
+		FMCPStageTimer ExecuteTimer(Timings, EMCPStage::Execute);
+		bCompleted = Simulate(*Profile, [&CancelToken]() { return CancelToken.IsValid() && CancelToken->ShouldStop(); }, LatencyMs);
+	}
+
+	FMCPStageTimer SerializeTimer(Timings, EMCPStage::Serialize);
+	if (!bCompleted)
+	{
+		const bool bCancelled = CancelToken->IsCancelled();
+		Writer.WriteErrorResponse(
+			bCancelled ? TEXT("Request cancelled") : TEXT("Request deadline passed"),
+			bCancelled ? TEXT("cancelled") : TEXT("deadline_exceeded"));
+		return;
+	}
+	if (Profile->ErrorRate > 0.0 && Random.FRand() < Profile->ErrorRate)
+	{
+		Writer.WriteErrorResponse(FString::Printf(TEXT("Injected failure of %s"), *CommandType), TEXT("execution_failed"));
+		return;
+	}
+
+	Writer.BeginResponse(true);
+	Writer.WriteField(TEXT("command"), CommandType);
+	Writer.WriteField(TEXT("session"), SessionId);
+	Writer.WriteField(TEXT("latency_ms"), LatencyMs);
+	if (Profile->Cost != EMCPCommandCost::ReadOnly && Params.IsValid())
+	{
+		Writer.BeginObject(TEXT("params"));
+		Writer.WriteObjectFields(Params);
+		Writer.EndObject();
+	}
+	Writer.WriteField(TEXT("payload"), MakePayload(*Profile));
+	Writer.EndResponse();
+}
+
+void FMCPMockExecutor::ExecuteJob(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Params)
+{
+	if (!JobManager->MarkRunning(Job))
+	{
+		// Cancelled while queued
+		return;
+	}
+
+	const FString& CommandType = Job->GetCommandType();
+	const FMCPMockCommandProfile* Profile = Settings.Commands.Find(CommandType);
+
+	TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+	FMCPRequestTimings Timings;
+	double LatencyMs = 0.0;
+	bool bCompleted = false;
+	if (Profile)
+	{
+		++SessionCalls.FindOrAdd(Job->GetSessionId());
+		FMCPStageTimer ExecuteTimer(&Timings, EMCPStage::Execute);
+		bCompleted = Simulate(*Profile, [&Job]() { return Job->IsCancelRequested(); }, LatencyMs);
+	}
+
+	if (!Profile)
+	{
+		Response->SetBoolField(TEXT("success"), false);
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+		Response->SetStringField(TEXT("error_type"), TEXT("unknown_command"));
+	}
+	else if (!bCompleted)
+	{
+		Response->SetBoolField(TEXT("success"), false);
+		Response->SetStringField(TEXT("error"), TEXT("Job cancelled"));
+		Response->SetStringField(TEXT("error_type"), TEXT("cancelled"));
+	}
+	else if (Profile->ErrorRate > 0.0 && Random.FRand() < Profile->ErrorRate)
+	{
+		Response->SetBoolField(TEXT("success"), false);
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Injected failure of %s"), *CommandType));
+		Response->SetStringField(TEXT("error_type"), TEXT("execution_failed"));
+	}
+	else
+	{
+		Response->SetBoolField(TEXT("success"), true);
+		Response->SetStringField(TEXT("command"), CommandType);
+		Response->SetStringField(TEXT("session"), Job->GetSessionId());
+		Response->SetNumberField(TEXT("latency_ms"), LatencyMs);
+		if (Profile->Cost != EMCPCommandCost::ReadOnly && Params.IsValid())
+		{
+			Response->SetObjectField(TEXT("params"), Params);
+		}
+		Response->SetStringField(TEXT("payload"), MakePayload(*Profile));
+	}
+
+	Response->TryGetBoolField(TEXT("success"), Timings.bSuccess);
+	Response->TryGetStringField(TEXT("error_type"), Timings.ErrorType);
+	Metrics->Record(CommandType, Timings);
+	FlightRecorder->Record(CommandType, Job->GetSessionId(), Job->GetId(), Timings);
+
+	JobManager->Finish(Job, Response);
+}
+
+TSharedPtr<FJsonObject> FMCPMockExecutor::GetSessionContextJson(const FString& SessionId)
+{
+	TSharedPtr<FJsonObject> ContextJson = MakeShared<FJsonObject>();
+	ContextJson->SetBoolField(TEXT("mock"), true);
+	ContextJson->SetNumberField(TEXT("calls"), SessionCalls.FindRef(SessionId));
+	return ContextJson;
+}
+
+void FMCPMockExecutor::ReleaseSession(const FString& SessionId)
+{
+	SessionCalls.Remove(SessionId);
+}
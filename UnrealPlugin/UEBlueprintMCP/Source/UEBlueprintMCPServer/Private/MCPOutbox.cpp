@@ -0,0 +1,67 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPOutbox.h"
+#include "MCPResponseWriter.h"
+#include "Misc/ScopeLock.h"
+#include "MCPLog.h"
+
+void FMCPOutbox::Push(TArray<uint8>&& Body)
+{
+	Completions.Enqueue(MoveTemp(Body));
+}
+
+void FMCPOutbox::PushEvent(TArray<uint8>&& Body)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (Events.Num() >= MaxQueuedEvents)
+	{
+		if (DroppedEvents == 0)
+		{
+			UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Subscriber isn't reading, dropping its oldest events (%d queued)"), Events.Num());
+		}
+		Events.PopFirst();
+		++DroppedEvents;
+	}
+	Events.PushLast(MoveTemp(Body));
+}
+
+bool FMCPOutbox::Pop(TArray<uint8>& OutBody)
+{
+	if (Completions.Dequeue(OutBody))
+	{
+		return true;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+
+	// The dropped events were the oldest, so the marker goes ahead of what's left
+	if (DroppedEvents > 0)
+	{
+		OutBody.Reset();
+		{
+			FMCPResponseWriter Writer(OutBody);
+			Writer.BeginObject();
+			Writer.WriteField(TEXT("event"), TEXT("events_dropped"));
+			Writer.WriteField(TEXT("count"), DroppedEvents);
+			Writer.EndObject();
+		}
+
+		DroppedEvents = 0;
+		return true;
+	}
+
+	if (Events.IsEmpty())
+	{
+		return false;
+	}
+	OutBody = MoveTemp(Events.First());
+	Events.PopFirst();
+	return true;
+}
+
+bool FMCPOutbox::IsEmpty() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Completions.IsEmpty() && Events.IsEmpty() && DroppedEvents == 0;
+}
@@ -0,0 +1,212 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPResponseWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+FMCPResponseWriter::FMCPResponseWriter(TArray<uint8>& InBuffer)
+	: Buffer(InBuffer)
+	, StartOffset(InBuffer.Num())
+	, bSuccess(true)
+{
+	ResetWriter();
+}
+
+FMCPResponseWriter::~FMCPResponseWriter()
+{
+	// Writer must go before the archive it streams into
+	JsonWriter.Reset();
+	Archive.Reset();
+}
+
+void FMCPResponseWriter::ResetWriter()
+{
+	JsonWriter.Reset();
+	Archive = MakeUnique<FMemoryWriter>(Buffer);
+	Archive->Seek(Buffer.Num());
+	JsonWriter = FJsonWriterType::Create(Archive.Get());
+}
+
+// =========================================================================
+// Response Envelope
+// =========================================================================
+
+void FMCPResponseWriter::BeginResponse(bool bInSuccess)
+{
+	bSuccess = bInSuccess;
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("success"), bInSuccess);
+}
+
+void FMCPResponseWriter::EndResponse()
+{
+	JsonWriter->WriteObjectEnd();
+}
+
+void FMCPResponseWriter::WriteErrorResponse(const FString& ErrorMessage, const FString& InErrorType)
+{
+	// Drop any partially streamed response, keep whatever preceded it
+	Buffer.SetNum(StartOffset, EAllowShrinking::No);
+	ResetWriter();
+
+	BeginResponse(false);
+	ErrorType = InErrorType;
+	JsonWriter->WriteValue(TEXT("error"), ErrorMessage);
+	JsonWriter->WriteValue(TEXT("error_type"), InErrorType);
+	EndResponse();
+}
+
+void FMCPResponseWriter::WriteResponseObject(const TSharedPtr<FJsonObject>& Response)
+{
+	if (!Response.IsValid())
+	{
+		WriteErrorResponse(TEXT("Action returned no response"), TEXT("crash_prevented"));
+		return;
+	}
+
+	// Legacy handlers answer with "status": "error" instead of "success": false
+	bool bResponseSuccess = true;
+	FString Status;
+	if (Response->TryGetBoolField(TEXT("success"), bResponseSuccess))
+	{
+		bSuccess = bResponseSuccess;
+	}
+	else if (Response->TryGetStringField(TEXT("status"), Status))
+	{
+		bSuccess = Status != TEXT("error");
+	}
+	Response->TryGetStringField(TEXT("error_type"), ErrorType);
+	FJsonSerializer::Serialize(Response.ToSharedRef(), JsonWriter.ToSharedRef(), false);
+}
+
+// =========================================================================
+// Fields
+// =========================================================================
+
+void FMCPResponseWriter::WriteField(const FString& Key, const FString& Value)
+{
+	JsonWriter->WriteValue(Key, Value);
+}
+
+void FMCPResponseWriter::WriteField(const FString& Key, const TCHAR* Value)
+{
+	JsonWriter->WriteValue(Key, FString(Value));
+}
+
+void FMCPResponseWriter::WriteField(const FString& Key, double Value)
+{
+	JsonWriter->WriteValue(Key, Value);
+}
+
+void FMCPResponseWriter::WriteField(const FString& Key, int32 Value)
+{
+	// FJsonValueNumber stores doubles, so DOM responses always printed integers as doubles
+	JsonWriter->WriteValue(Key, static_cast<double>(Value));
+}
+
+void FMCPResponseWriter::WriteField(const FString& Key, bool Value)
+{
+	JsonWriter->WriteValue(Key, Value);
+}
+
+void FMCPResponseWriter::WriteNullField(const FString& Key)
+{
+	JsonWriter->WriteNull(Key);
+}
+
+void FMCPResponseWriter::WriteField(const FString& Key, const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		JsonWriter->WriteNull(Key);
+		return;
+	}
+	FJsonSerializer::Serialize(Value, Key, JsonWriter.ToSharedRef(), false);
+}
+
+void FMCPResponseWriter::WriteVectorField(const FString& Key, const FVector& Value)
+{
+	JsonWriter->WriteArrayStart(Key);
+	JsonWriter->WriteValue(Value.X);
+	JsonWriter->WriteValue(Value.Y);
+	JsonWriter->WriteValue(Value.Z);
+	JsonWriter->WriteArrayEnd();
+}
+
+void FMCPResponseWriter::WriteRotatorField(const FString& Key, const FRotator& Value)
+{
+	JsonWriter->WriteArrayStart(Key);
+	JsonWriter->WriteValue(Value.Pitch);
+	JsonWriter->WriteValue(Value.Yaw);
+	JsonWriter->WriteValue(Value.Roll);
+	JsonWriter->WriteArrayEnd();
+}
+
+void FMCPResponseWriter::WriteObjectFields(const TSharedPtr<FJsonObject>& Object)
+{
+	if (!Object.IsValid())
+	{
+		return;
+	}
+	for (const auto& Field : Object->Values)
+	{
+		WriteField(Field.Key, Field.Value);
+	}
+}
+
+void FMCPResponseWriter::BeginObject(const FString& Key)
+{
+	JsonWriter->WriteObjectStart(Key);
+}
+
+void FMCPResponseWriter::BeginArray(const FString& Key)
+{
+	JsonWriter->WriteArrayStart(Key);
+}
+
+// =========================================================================
+// Values
+// =========================================================================
+
+void FMCPResponseWriter::WriteValue(const FString& Value)
+{
+	JsonWriter->WriteValue(Value);
+}
+
+void FMCPResponseWriter::WriteValue(double Value)
+{
+	JsonWriter->WriteValue(Value);
+}
+
+void FMCPResponseWriter::WriteValue(bool Value)
+{
+	JsonWriter->WriteValue(Value);
+}
+
+void FMCPResponseWriter::WriteNull()
+{
+	JsonWriter->WriteNull();
+}
+
+void FMCPResponseWriter::BeginObject()
+{
+	JsonWriter->WriteObjectStart();
+}
+
+void FMCPResponseWriter::BeginArray()
+{
+	JsonWriter->WriteArrayStart();
+}
+
+// =========================================================================
+// Closing
+// =========================================================================
+
+void FMCPResponseWriter::EndObject()
+{
+	JsonWriter->WriteObjectEnd();
+}
+
+void FMCPResponseWriter::EndArray()
+{
+	JsonWriter->WriteArrayEnd();
+}
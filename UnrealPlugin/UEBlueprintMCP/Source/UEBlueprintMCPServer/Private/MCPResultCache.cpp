@@ -0,0 +1,115 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPResultCache.h"
+#include "MCPResponseWriter.h"
+
+FMCPResultCache::FMCPResultCache()
+	: Entries(MaxEntries)
+{
+}
+
+EMCPIdempotencyLookup FMCPResultCache::Begin(const FString& Key, const FString& CommandType, uint32 Fingerprint, TArray<uint8>& OutBody)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (FEntry* Entry = Entries.FindAndTouch(Key))
+	{
+		const bool bExpired = Entry->bCompleted && FPlatformTime::Seconds() - Entry->CompletedTime > EntryLifetimeSeconds;
+		if (!bExpired)
+		{
+			if (Entry->CommandType != CommandType || Entry->Fingerprint != Fingerprint)
+			{
+				return EMCPIdempotencyLookup::Mismatch;
+			}
+			if (!Entry->bCompleted)
+			{
+				return EMCPIdempotencyLookup::InFlight;
+			}
+			OutBody = Entry->Body;
+			return EMCPIdempotencyLookup::Hit;
+		}
+		Remove(Key);
+	}
+
+	// Make room ourselves so the evicted entry's bytes leave TotalBytes too
+	if (Entries.Num() >= MaxEntries)
+	{
+		RemoveLeastRecent();
+	}
+
+	FEntry NewEntry;
+	NewEntry.CommandType = CommandType;
+	NewEntry.Fingerprint = Fingerprint;
+	Entries.Add(Key, MoveTemp(NewEntry));
+	return EMCPIdempotencyLookup::Miss;
+}
+
+void FMCPResultCache::Complete(const FString& Key, bool bSuccess, TArrayView<const uint8> Body)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	// May have been evicted while the command ran; the response just isn't replayable then
+	FEntry* Entry = Entries.FindAndTouch(Key);
+	if (!Entry)
+	{
+		return;
+	}
+
+	TotalBytes -= Entry->Body.Num();
+	if (Body.Num() > MaxEntryBytes)
+	{
+		WriteAlreadyApplied(bSuccess, Body.Num(), Entry->Body);
+	}
+	else
+	{
+		Entry->Body = Body;
+	}
+	Entry->bCompleted = true;
+	Entry->CompletedTime = FPlatformTime::Seconds();
+	TotalBytes += Entry->Body.Num();
+
+	// Entry was just touched, so it is the last to go; it alone always fits
+	while (TotalBytes > MaxTotalBytes && Entries.Num() > 1)
+	{
+		RemoveLeastRecent();
+	}
+}
+
+void FMCPResultCache::Abort(const FString& Key)
+{
+	FScopeLock ScopeLock(&Lock);
+	Remove(Key);
+}
+
+void FMCPResultCache::Remove(const FString& Key)
+{
+	if (const FEntry* Entry = Entries.Find(Key))
+	{
+		TotalBytes -= Entry->Body.Num();
+		Entries.Remove(Key);
+	}
+}
+
+void FMCPResultCache::RemoveLeastRecent()
+{
+	const FEntry Evicted = Entries.RemoveLeastRecent();
+	TotalBytes -= Evicted.Body.Num();
+}
+
+void FMCPResultCache::WriteAlreadyApplied(bool bSuccess, int32 BodyBytes, TArray<uint8>& OutBody)
+{
+	OutBody.Reset();
+	FMCPResponseWriter Writer(OutBody);
+	if (bSuccess)
+	{
+		Writer.BeginResponse(true);
+		Writer.WriteField(TEXT("already_applied"), true);
+		Writer.WriteField(TEXT("response_bytes"), BodyBytes);
+		Writer.WriteField(TEXT("message"), TEXT("Already applied; the original response was too large to keep for replay"));
+		Writer.EndResponse();
+	}
+	else
+	{
+		Writer.WriteErrorResponse(TEXT("Already ran and failed; the original error was too large to keep for replay"), TEXT("already_applied"));
+	}
+}
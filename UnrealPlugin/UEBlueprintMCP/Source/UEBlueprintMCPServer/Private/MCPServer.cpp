@@ -0,0 +1,1273 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPServer.h"
+#include "MCPExecutor.h"
+#include "MCPResponseWriter.h"
+#include "MCPCommandRegistry.h"
+#include "MCPJobs.h"
+#include "MCPOutbox.h"
+#include "MCPEvents.h"
+#include "MCPResultCache.h"
+#include "MCPMetrics.h"
+#include "MCPFlightRecorder.h"
+#include "MCPCommandRecorder.h"
+#include "MCPTrace.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeExit.h"
+#include "MCPLog.h"
+
+/**
+ * Runs one client connection on its own thread.
+ * Owns the socket; joined and deleted by the accept thread once finished.
+ */
+class FMCPClientRunnable : public FRunnable
+{
+public:
+	FMCPClientRunnable(FMCPServer* InServer, FSocket* InSocket, int32 InConnectionId)
+		: Server(InServer)
+		, Socket(InSocket)
+		, ConnectionId(InConnectionId)
+		, Thread(nullptr)
+		, bFinished(false)
+	{
+	}
+
+	virtual ~FMCPClientRunnable() override
+	{
+		if (Thread)
+		{
+			Thread->WaitForCompletion();
+			delete Thread;
+			Thread = nullptr;
+		}
+
+		if (Socket)
+		{
+			ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+			if (SocketSubsystem)
+			{
+				SocketSubsystem->DestroySocket(Socket);
+			}
+			Socket = nullptr;
+		}
+	}
+
+	bool Start()
+	{
+		Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UEBlueprintMCP Client %d"), ConnectionId));
+		return Thread != nullptr;
+	}
+
+	bool IsFinished() const { return bFinished; }
+
+	virtual uint32 Run() override
+	{
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Client %d connected"), ConnectionId);
+		Server->HandleClient(Socket, ConnectionId);
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Client %d disconnected"), ConnectionId);
+		bFinished = true;
+		return 0;
+	}
+
+private:
+	FMCPServer* Server;
+	FSocket* Socket;
+	int32 ConnectionId;
+	FRunnableThread* Thread;
+	TAtomic<bool> bFinished;
+};
+
+FMCPServer::FMCPServer(const TSharedRef<IMCPCommandExecutor>& InExecutor, int32 InPort)
+	: Executor(InExecutor)
+	, CommandRegistry(InExecutor->GetCommandRegistry())
+	, SnapshotStore(InExecutor->GetSnapshotStore())
+	, JobManager(InExecutor->GetJobManager())
+	, EventHub(InExecutor->GetEventHub())
+	, ResultCache(InExecutor->GetResultCache())
+	, Metrics(InExecutor->GetMetrics())
+	, FlightRecorder(InExecutor->GetFlightRecorder())
+	, Dispatcher(MakeShared<FMCPDispatcher>())
+	, ListenerSocket(nullptr)
+	, Port(InPort)
+	, Thread(nullptr)
+	, bShouldStop(false)
+	, bIsRunning(false)
+	, NextConnectionId(1)
+{
+}
+
+FMCPServer::~FMCPServer()
+{
+	Stop();
+}
+
+bool FMCPServer::Start()
+{
+	if (bIsRunning)
+	{
+		return true;
+	}
+
+	// Create the listener socket
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem)
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to get socket subsystem"));
+		return false;
+	}
+
+	ListenerSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("UEBlueprintMCP Listener"), false);
+	if (!ListenerSocket)
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to create listener socket"));
+		return false;
+	}
+
+	// Bind to localhost only (127.0.0.1) - NOT exposed to network
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	bool bIsValid = false;
+	Addr->SetIp(TEXT("127.0.0.1"), bIsValid);
+	Addr->SetPort(Port);
+
+	if (!ListenerSocket->Bind(*Addr))
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to bind to port %d"), Port);
+		SocketSubsystem->DestroySocket(ListenerSocket);
+		ListenerSocket = nullptr;
+		return false;
+	}
+
+	// Start listening
+	if (!ListenerSocket->Listen(8))
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to listen on socket"));
+		SocketSubsystem->DestroySocket(ListenerSocket);
+		ListenerSocket = nullptr;
+		return false;
+	}
+
+	// Start the worker thread
+	bShouldStop = false;
+	Thread = FRunnableThread::Create(this, TEXT("UEBlueprintMCP Server Thread"));
+	if (!Thread)
+	{
+		UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to create server thread"));
+		SocketSubsystem->DestroySocket(ListenerSocket);
+		ListenerSocket = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void FMCPServer::Stop()
+{
+	bShouldStop = true;
+
+	if (ListenerSocket)
+	{
+		ListenerSocket->Close();
+	}
+
+	if (Thread)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (ListenerSocket)
+	{
+		ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+		if (SocketSubsystem)
+		{
+			SocketSubsystem->DestroySocket(ListenerSocket);
+		}
+		ListenerSocket = nullptr;
+	}
+
+	bIsRunning = false;
+}
+
+bool FMCPServer::Init()
+{
+	return true;
+}
+
+uint32 FMCPServer::Run()
+{
+	bIsRunning = true;
+
+	while (!bShouldStop)
+	{
+		// Wait for connection (with timeout so we can check bShouldStop)
+		bool bPendingConnection = false;
+		if (ListenerSocket->WaitForPendingConnection(bPendingConnection, FTimespan::FromSeconds(0.5)))
+		{
+			if (bPendingConnection)
+			{
+				// Accept the connection
+				FSocket* ClientSocket = ListenerSocket->Accept(TEXT("UEBlueprintMCP Client"));
+				if (ClientSocket)
+				{
+					if (Clients.Num() >= MaxClients)
+					{
+						UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Rejecting client, %d connections already open"), Clients.Num());
+						SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Too many connections\",\"error_type\":\"busy\"}"));
+						ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+						if (SocketSubsystem)
+						{
+							SocketSubsystem->DestroySocket(ClientSocket);
+						}
+					}
+					else
+					{
+						// Each client gets its own thread; the runnable owns the socket from here
+						TUniquePtr<FMCPClientRunnable> Client = MakeUnique<FMCPClientRunnable>(this, ClientSocket, NextConnectionId++);
+						if (Client->Start())
+						{
+							Clients.Add(MoveTemp(Client));
+						}
+						else
+						{
+							UE_LOG(LogUEBlueprintMCP, Error, TEXT("UEBlueprintMCP: Failed to create client thread"));
+						}
+					}
+				}
+			}
+		}
+
+		ReapFinishedClients(false);
+	}
+
+	// bShouldStop makes every client loop exit
+	ReapFinishedClients(true);
+
+	bIsRunning = false;
+	return 0;
+}
+
+void FMCPServer::Exit()
+{
+	bIsRunning = false;
+}
+
+void FMCPServer::ReapFinishedClients(bool bWaitForAll)
+{
+	for (int32 i = Clients.Num() - 1; i >= 0; --i)
+	{
+		if (bWaitForAll || Clients[i]->IsFinished())
+		{
+			// Destructor joins the thread and destroys the socket
+			Clients.RemoveAtSwap(i);
+		}
+	}
+}
+
+void FMCPServer::HandleClient(FSocket* ClientSocket, int32 ConnectionId)
+{
+	// Set socket options
+	ClientSocket->SetNonBlocking(false);
+	ClientSocket->SetNoDelay(true);
+
+	float LastActivityTime = FPlatformTime::Seconds();
+
+	// Reused for every response on this connection so large replies don't reallocate
+	TArray<uint8> SendBuffer;
+
+	// Commands without a "session" token share this connection-scoped session
+	const FString ConnectionSessionId = FString::Printf(TEXT("conn-%d"), ConnectionId);
+	bool bUsedConnectionSession = false;
+
+	// Job completions and subscribed events for this connection, sent between responses
+	TSharedPtr<FMCPOutbox> Outbox = MakeShared<FMCPOutbox>();
+
+	// Keep connection alive until client disconnects or timeout
+	while (!bShouldStop)
+	{
+		FlushOutbox(ClientSocket, *Outbox, SendBuffer);
+
+		// Check for timeout
+		float CurrentTime = FPlatformTime::Seconds();
+		if (CurrentTime - LastActivityTime > ConnectionTimeout)
+		{
+			UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Client connection timed out"));
+			break;
+		}
+
+		// Wait briefly for a request, so pushed frames in the outbox go out while the client is idle
+		if (!ClientSocket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(ClientPollIntervalMs)))
+		{
+			continue;
+		}
+
+		// Readable: either a request arrived or the peer closed the connection
+		uint8 PeekByte;
+		int32 PeekBytes = 0;
+		if (!ClientSocket->Recv(&PeekByte, 1, PeekBytes, ESocketReceiveFlags::Peek))
+		{
+			// Socket error - likely disconnected
+			UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Client disconnected (recv error)"));
+			break;
+		}
+		if (PeekBytes == 0)
+		{
+			// Connection closed by peer (EOF)
+			UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Client disconnected (EOF)"));
+			break;
+		}
+
+		// Stage times of this request, recorded once it is answered
+		FMCPRequestTimings Timings;
+
+		// Receive message
+		const double ReceivedAt = FPlatformTime::Seconds();
+		FString Message;
+		bool bReceived = false;
+		{
+			FMCPStageTimer ReceiveTimer(&Timings, EMCPStage::Receive);
+			bReceived = ReceiveMessage(ClientSocket, Message);
+		}
+		if (!bReceived)
+		{
+			UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Failed to receive message"));
+			break;
+		}
+		Timings.RequestBytes = FPlatformString::ConvertedLength<UTF8CHAR>(*Message, Message.Len());
+
+		LastActivityTime = FPlatformTime::Seconds();
+
+		// Parse JSON
+		TSharedPtr<FJsonObject> JsonObj;
+		bool bParsed = false;
+		{
+			FMCPStageTimer ParseTimer(&Timings, EMCPStage::Parse);
+			MCP_TRACE_SCOPE("MCP::ParseRequest");
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+			bParsed = FJsonSerializer::Deserialize(Reader, JsonObj) && JsonObj.IsValid();
+		}
+		if (!bParsed)
+		{
+			FString ErrorResponse = TEXT("{\"status\":\"error\",\"error\":\"Invalid JSON\"}");
+			SendResponse(ClientSocket, ErrorResponse);
+			continue;
+		}
+
+		// Get command type
+		FString CommandType;
+		if (!JsonObj->TryGetStringField(TEXT("type"), CommandType))
+		{
+			FString ErrorResponse = TEXT("{\"status\":\"error\",\"error\":\"Missing 'type' field\"}");
+			SendResponse(ClientSocket, ErrorResponse);
+			continue;
+		}
+
+		// Resolve the session this command runs in
+		FString SessionId;
+		if (!JsonObj->TryGetStringField(TEXT("session"), SessionId) || SessionId.IsEmpty())
+		{
+			SessionId = ConnectionSessionId;
+			bUsedConnectionSession = true;
+		}
+
+		// Every request answered from here on goes to the recording, if one is running
+		TSharedPtr<FMCPCommandRecorder> ActiveRecorder = GetRecorder();
+		ON_SCOPE_EXIT
+		{
+			if (ActiveRecorder.IsValid())
+			{
+				ActiveRecorder->Record(ConnectionId, SessionId, Message, ReceivedAt, FPlatformTime::Seconds(), Timings);
+			}
+		};
+
+		// Handle special commands that don't need game thread
+		if (CommandType == TEXT("ping"))
+		{
+			SendResponse(ClientSocket, HandlePing());
+			continue;
+		}
+
+		if (CommandType == TEXT("close"))
+		{
+			HandleClose(ClientSocket);
+			break;
+		}
+
+		if (CommandType == TEXT("get_context"))
+		{
+			HandleGetContext(ClientSocket, SessionId, SendBuffer);
+			continue;
+		}
+
+		if (CommandType == TEXT("list_commands"))
+		{
+			TSharedPtr<FJsonObject> ListParams;
+			const TSharedPtr<FJsonObject>* ListParamsPtr = nullptr;
+			if (JsonObj->TryGetObjectField(TEXT("params"), ListParamsPtr))
+			{
+				ListParams = *ListParamsPtr;
+			}
+			HandleListCommands(ClientSocket, ListParams, SendBuffer);
+			continue;
+		}
+
+		// Get params (optional)
+		TSharedPtr<FJsonObject> Params;
+		const TSharedPtr<FJsonObject>* ParamsPtr;
+		if (JsonObj->TryGetObjectField(TEXT("params"), ParamsPtr))
+		{
+			Params = *ParamsPtr;
+		}
+		else
+		{
+			Params = MakeShared<FJsonObject>();
+		}
+
+		if (CommandType == TEXT("get_job") || CommandType == TEXT("cancel_job") || CommandType == TEXT("list_jobs"))
+		{
+			HandleJobCommand(ClientSocket, CommandType, Params, SessionId, SendBuffer);
+			continue;
+		}
+
+		if (CommandType == TEXT("get_queue_stats"))
+		{
+			HandleQueueStats(ClientSocket, SendBuffer);
+			continue;
+		}
+
+		if (CommandType == TEXT("get_metrics"))
+		{
+			HandleGetMetrics(ClientSocket, Params, SendBuffer);
+			continue;
+		}
+
+		if (CommandType == TEXT("dump_flight_recorder"))
+		{
+			HandleDumpFlightRecorder(ClientSocket, Params, SendBuffer);
+			continue;
+		}
+
+		if (CommandType == TEXT("cancel"))
+		{
+			HandleCancel(ClientSocket, Params, SendBuffer);
+			continue;
+		}
+
+		if (CommandType == TEXT("subscribe") || CommandType == TEXT("unsubscribe"))
+		{
+			HandleSubscription(ClientSocket, CommandType, Params, ConnectionId, Outbox, SendBuffer);
+			continue;
+		}
+
+		// A mutating command re-sent after a dropped connection gets its first response back
+		FString IdempotencyKey;
+		if (ClaimIdempotencyKey(ClientSocket, CommandType, JsonObj, Params, SessionId, IdempotencyKey, SendBuffer))
+		{
+			continue;
+		}
+
+		// "async": true returns a job id now and pushes the result when done
+		bool bAsync = false;
+		if (JsonObj->TryGetBoolField(TEXT("async"), bAsync) && bAsync)
+		{
+			StartJob(ClientSocket, CommandType, Params, SessionId, ResolveLane(CommandType, JsonObj, EMCPLane::Background), Outbox, IdempotencyKey, SendBuffer);
+			continue;
+		}
+
+		// Optional request id (for cancel and the flight recorder)
+		FString RequestId;
+		JsonObj->TryGetStringField(TEXT("id"), RequestId);
+
+		// Read-only queries don't wait behind mutating work when the snapshot is current
+		if (TryServeFromSnapshot(ClientSocket, CommandType, Params, Timings, SendBuffer))
+		{
+			RecordRequest(CommandType, SessionId, RequestId, Timings);
+			continue;
+		}
+
+		// Optional time budget; the client gives up after it anyway
+		double DeadlineMs = 0.0;
+		JsonObj->TryGetNumberField(TEXT("deadline_ms"), DeadlineMs);
+		TSharedRef<FMCPCancelToken> CancelToken = RequestTracker.Begin(RequestId, DeadlineMs);
+		TRACE_BOOKMARK(TEXT("MCP %s [%s]"), *CommandType, *RequestId);
+
+		// Execute on game thread, response is written straight into the send buffer
+		const FMCPCommandInfo* Info = CommandRegistry.IsValid() ? CommandRegistry->Find(CommandType) : nullptr;
+		const EMCPLane Lane = ResolveLane(CommandType, JsonObj, FMCPDispatcher::LaneForCommand(Info));
+
+		BeginFrame(SendBuffer);
+		const bool bRan = ExecuteOnGameThread(CommandType, Params, SessionId, RequestId, Lane, CancelToken, Timings, SendBuffer);
+		RequestTracker.End(RequestId);
+
+		// Only a response from an actual run is replayable; a retry of a dropped one runs it
+		if (!IdempotencyKey.IsEmpty())
+		{
+			if (bRan)
+			{
+				ResultCache->Complete(IdempotencyKey, Timings.bSuccess, TArrayView<const uint8>(SendBuffer.GetData() + 4, SendBuffer.Num() - 4));
+			}
+			else
+			{
+				ResultCache->Abort(IdempotencyKey);
+			}
+		}
+
+		Timings.ResponseBytes = SendBuffer.Num() - 4;
+		{
+			FMCPStageTimer SendTimer(&Timings, EMCPStage::Send);
+			SendFrame(ClientSocket, SendBuffer);
+		}
+		RecordRequest(CommandType, SessionId, RequestId, Timings);
+	}
+
+	if (EventHub.IsValid())
+	{
+		EventHub->Unsubscribe(ConnectionId, TArray<FString>());
+	}
+
+	if (bUsedConnectionSession && !bShouldStop)
+	{
+		ReleaseSessionOnGameThread(ConnectionSessionId);
+	}
+}
+
+bool FMCPServer::ReceiveMessage(FSocket* ClientSocket, FString& OutMessage)
+{
+	MCP_TRACE_SCOPE("MCP::ReceiveMessage");
+
+	// Receive length prefix (4 bytes, big endian)
+	uint8 LengthBytes[4];
+	int32 BytesRead = 0;
+	if (!ClientSocket->Recv(LengthBytes, 4, BytesRead) || BytesRead != 4)
+	{
+		return false;
+	}
+
+	int32 Length = (LengthBytes[0] << 24) | (LengthBytes[1] << 16) | (LengthBytes[2] << 8) | LengthBytes[3];
+
+	// Sanity check
+	if (Length <= 0 || Length > RecvBufferSize)
+	{
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Invalid message length: %d"), Length);
+		return false;
+	}
+
+	// Receive message
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(Length);
+
+	int32 TotalReceived = 0;
+	while (TotalReceived < Length)
+	{
+		int32 Received = 0;
+		if (!ClientSocket->Recv(Buffer.GetData() + TotalReceived, Length - TotalReceived, Received) || Received <= 0)
+		{
+			return false;
+		}
+		TotalReceived += Received;
+	}
+
+	MCPTrace::CountBytesReceived(4 + Length);
+
+	// Convert to string
+	OutMessage = FString(Length, UTF8_TO_TCHAR(reinterpret_cast<const char*>(Buffer.GetData())));
+	return true;
+}
+
+bool FMCPServer::SendResponse(FSocket* ClientSocket, const FString& Response)
+{
+	// Convert to UTF-8
+	FTCHARToUTF8 Converter(*Response);
+
+	TArray<uint8> Frame;
+	Frame.Reserve(4 + Converter.Length());
+	BeginFrame(Frame);
+	Frame.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+
+	return SendFrame(ClientSocket, Frame);
+}
+
+void FMCPServer::BeginFrame(TArray<uint8>& Frame)
+{
+	Frame.SetNumUninitialized(4, EAllowShrinking::No);
+}
+
+bool FMCPServer::SendFrame(FSocket* ClientSocket, TArray<uint8>& Frame)
+{
+	MCP_TRACE_SCOPE("MCP::SendFrame");
+	check(Frame.Num() >= 4);
+
+	// Patch length prefix (4 bytes, big endian)
+	const int32 Length = Frame.Num() - 4;
+	Frame[0] = static_cast<uint8>((Length >> 24) & 0xFF);
+	Frame[1] = static_cast<uint8>((Length >> 16) & 0xFF);
+	Frame[2] = static_cast<uint8>((Length >> 8) & 0xFF);
+	Frame[3] = static_cast<uint8>(Length & 0xFF);
+
+	// Send prefix and message together
+	int32 TotalSent = 0;
+	while (TotalSent < Frame.Num())
+	{
+		int32 Sent = 0;
+		if (!ClientSocket->Send(Frame.GetData() + TotalSent, Frame.Num() - TotalSent, Sent) || Sent <= 0)
+		{
+			return false;
+		}
+		TotalSent += Sent;
+	}
+
+	MCPTrace::CountBytesSent(TotalSent);
+	return true;
+}
+
+FString FMCPServer::HandlePing()
+{
+	return TEXT("{\"status\":\"success\",\"result\":{\"pong\":true}}");
+}
+
+void FMCPServer::HandleClose(FSocket* ClientSocket)
+{
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Client requested disconnect"));
+	SendResponse(ClientSocket, TEXT("{\"status\":\"success\",\"result\":{\"closed\":true}}"));
+}
+
+bool FMCPServer::HandleGetContext(FSocket* ClientSocket, const FString& SessionId, TArray<uint8>& Frame)
+{
+	// Execute on game thread to safely access context
+	FString Result;
+
+	FEvent* DoneEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+	const bool bQueued = Dispatcher->Enqueue(EMCPLane::Control, SessionId, TEXT("get_context"), [this, &SessionId, &Result, DoneEvent]()
+	{
+		if (TSharedPtr<FJsonObject> ContextJson = Executor->GetSessionContextJson(SessionId))
+		{
+			ContextJson->SetStringField(TEXT("session"), SessionId);
+
+			TSharedPtr<FJsonObject> Response = MakeShared<FJsonObject>();
+			Response->SetStringField(TEXT("status"), TEXT("success"));
+			Response->SetObjectField(TEXT("result"), ContextJson);
+
+			FString ResponseStr;
+			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResponseStr);
+			FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+			Result = ResponseStr;
+		}
+		else
+		{
+			Result = TEXT("{\"status\":\"error\",\"error\":\"Bridge not available\"}");
+		}
+
+		DoneEvent->Trigger();
+	});
+
+	if (!bQueued)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+
+		BeginFrame(Frame);
+		{
+			FMCPResponseWriter Writer(Frame);
+			Dispatcher->WriteBusyResponse(EMCPLane::Control, Writer);
+		}
+		return SendFrame(ClientSocket, Frame);
+	}
+
+	DoneEvent->Wait();
+	FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+
+	return SendResponse(ClientSocket, Result);
+}
+
+bool FMCPServer::HandleListCommands(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame)
+{
+	if (!CommandRegistry.IsValid() || !CommandRegistry->IsFrozen())
+	{
+		return SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Command registry not available\",\"error_type\":\"not_ready\"}"));
+	}
+
+	BeginFrame(Frame);
+
+	// Client already has this list cached
+	FString IfNoneMatch;
+	if (Params.IsValid() && Params->TryGetStringField(TEXT("if_none_match"), IfNoneMatch) && IfNoneMatch == CommandRegistry->GetETag())
+	{
+		FMCPResponseWriter Writer(Frame);
+		Writer.BeginResponse(true);
+		Writer.WriteField(TEXT("not_modified"), true);
+		Writer.WriteField(TEXT("etag"), CommandRegistry->GetETag());
+		Writer.EndResponse();
+	}
+	else
+	{
+		Frame.Append(CommandRegistry->GetListResponse());
+	}
+
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::TryServeFromSnapshot(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPRequestTimings& Timings, TArray<uint8>& Frame)
+{
+	if (!SnapshotStore.IsValid() || !CommandRegistry.IsValid())
+	{
+		return false;
+	}
+
+	const FMCPCommandInfo* Info = CommandRegistry->Find(CommandType);
+	if (!Info || !Info->bConcurrent)
+	{
+		return false;
+	}
+
+	BeginFrame(Frame);
+	bool bServed = false;
+	{
+		FMCPStageTimer ExecuteTimer(&Timings, EMCPStage::Execute);
+		FMCPResponseWriter Writer(Frame);
+		bServed = SnapshotStore->TryServe(CommandType, Params, Writer);
+		Timings.bSuccess = Writer.IsSuccess();
+		Timings.ErrorType = Writer.GetErrorType();
+	}
+
+	if (bServed)
+	{
+		Timings.ResponseBytes = Frame.Num() - 4;
+		FMCPStageTimer SendTimer(&Timings, EMCPStage::Send);
+		SendFrame(ClientSocket, Frame);
+	}
+	return bServed;
+}
+
+void FMCPServer::FlushOutbox(FSocket* ClientSocket, FMCPOutbox& Outbox, TArray<uint8>& Frame)
+{
+	TArray<uint8> Body;
+	while (Outbox.Pop(Body))
+	{
+		BeginFrame(Frame);
+		Frame.Append(Body);
+		SendFrame(ClientSocket, Frame);
+	}
+}
+
+bool FMCPServer::StartJob(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, EMCPLane Lane, const TSharedPtr<FMCPOutbox>& Outbox, const FString& IdempotencyKey, TArray<uint8>& Frame)
+{
+	if (!JobManager.IsValid() || !CommandRegistry.IsValid())
+	{
+		if (!IdempotencyKey.IsEmpty())
+		{
+			ResultCache->Abort(IdempotencyKey);
+		}
+		return SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Job manager not available\",\"error_type\":\"not_ready\"}"));
+	}
+
+	// Server commands are answered before this point, so anything registered is a bridge action
+	if (!CommandRegistry->Find(CommandType))
+	{
+		BeginFrame(Frame);
+		{
+			FMCPResponseWriter Writer(Frame);
+			Writer.WriteErrorResponse(FString::Printf(TEXT("Unknown command: %s"), *CommandType), TEXT("unknown_command"));
+		}
+		return SendFrame(ClientSocket, Frame);
+	}
+
+	// Refuse before creating a job the client would never hear about
+	if (!Dispatcher->HasCapacity(Lane))
+	{
+		// Not replayed: a retry may well get a job
+		if (!IdempotencyKey.IsEmpty())
+		{
+			ResultCache->Abort(IdempotencyKey);
+		}
+
+		BeginFrame(Frame);
+		{
+			FMCPResponseWriter Writer(Frame);
+			Dispatcher->WriteBusyResponse(Lane, Writer);
+		}
+		return SendFrame(ClientSocket, Frame);
+	}
+
+	TSharedRef<FMCPJob> Job = JobManager->CreateJob(CommandType, SessionId, Outbox);
+	UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Queued job %s (%s, %s lane)"), *Job->GetId(), *CommandType, LexToString(Lane));
+
+	// Fire and forget; the job finishes (and pushes) from the game thread
+	const bool bQueued = Dispatcher->Enqueue(Lane, SessionId, CommandType, [JobExecutor = Executor, Job, Params]()
+	{
+		JobExecutor->ExecuteJob(Job, Params);
+	});
+	if (!bQueued)
+	{
+		// Lost the race for the last slot
+		JobManager->Cancel(Job->GetId());
+	}
+
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+		Writer.BeginResponse(true);
+		Job->WriteStatusFields(Writer, false);
+		Writer.EndResponse();
+	}
+	if (!IdempotencyKey.IsEmpty())
+	{
+		ResultCache->Complete(IdempotencyKey, true, TArrayView<const uint8>(Frame.GetData() + 4, Frame.Num() - 4));
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::ClaimIdempotencyKey(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Request, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, FString& OutKey, TArray<uint8>& Frame)
+{
+	OutKey.Reset();
+
+	FString ClientKey;
+	if (!ResultCache.IsValid() || !Request->TryGetStringField(TEXT("idempotency_key"), ClientKey) || ClientKey.IsEmpty())
+	{
+		return false;
+	}
+
+	// Read-only commands are safe to repeat; unknown ones fail the same way twice
+	const FMCPCommandInfo* Info = CommandRegistry.IsValid() ? CommandRegistry->Find(CommandType) : nullptr;
+	if (!Info || Info->Cost == EMCPCommandCost::ReadOnly)
+	{
+		return false;
+	}
+
+	// The retry is the same message, so its params serialize to the same text
+	FString ParamsText;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> ParamsWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ParamsText);
+	FJsonSerializer::Serialize(Params.ToSharedRef(), ParamsWriter);
+	const uint32 Fingerprint = FCrc::StrCrc32(*ParamsText);
+
+	const FString Key = SessionId + TEXT("/") + ClientKey;
+
+	double DeadlineMs = 0.0;
+	Request->TryGetNumberField(TEXT("deadline_ms"), DeadlineMs);
+	const double WaitUntil = FPlatformTime::Seconds() + (DeadlineMs > 0.0 ? DeadlineMs / 1000.0 : IdempotentWaitTimeout);
+
+	TArray<uint8> Body;
+	for (;;)
+	{
+		switch (ResultCache->Begin(Key, CommandType, Fingerprint, Body))
+		{
+		case EMCPIdempotencyLookup::Miss:
+			OutKey = Key;
+			return false;
+
+		case EMCPIdempotencyLookup::Hit:
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Replayed %s for idempotency key %s"), *CommandType, *ClientKey);
+			BeginFrame(Frame);
+			Frame.Append(Body);
+			return SendFrame(ClientSocket, Frame);
+
+		case EMCPIdempotencyLookup::Mismatch:
+			BeginFrame(Frame);
+			{
+				FMCPResponseWriter Writer(Frame);
+				Writer.WriteErrorResponse(FString::Printf(TEXT("idempotency_key '%s' was already used for a different command or params"), *ClientKey), TEXT("validation_failed"));
+			}
+			return SendFrame(ClientSocket, Frame);
+
+		case EMCPIdempotencyLookup::InFlight:
+			// The first attempt is still queued or running; its response is the answer
+			if (FPlatformTime::Seconds() >= WaitUntil || bShouldStop)
+			{
+				BeginFrame(Frame);
+				{
+					FMCPResponseWriter Writer(Frame);
+					Writer.WriteErrorResponse(FString::Printf(TEXT("A request with idempotency_key '%s' is still running"), *ClientKey), TEXT("deadline_exceeded"));
+				}
+				return SendFrame(ClientSocket, Frame);
+			}
+			FPlatformProcess::Sleep(0.01f);
+			break;
+		}
+	}
+}
+
+bool FMCPServer::HandleJobCommand(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, TArray<uint8>& Frame)
+{
+	if (!JobManager.IsValid())
+	{
+		return SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Job manager not available\",\"error_type\":\"not_ready\"}"));
+	}
+
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+
+		if (CommandType == TEXT("list_jobs"))
+		{
+			// This session's jobs unless "all" is set
+			bool bAll = false;
+			Params->TryGetBoolField(TEXT("all"), bAll);
+
+			int32 Count = 0;
+			Writer.BeginResponse(true);
+			Writer.BeginArray(TEXT("jobs"));
+			for (const TSharedRef<FMCPJob>& Job : JobManager->GetJobs())
+			{
+				if (bAll || Job->GetSessionId() == SessionId)
+				{
+					Writer.BeginObject();
+					Job->WriteStatusFields(Writer, false);
+					Writer.EndObject();
+					++Count;
+				}
+			}
+			Writer.EndArray();
+			Writer.WriteField(TEXT("count"), Count);
+			Writer.EndResponse();
+		}
+		else
+		{
+			FString JobId;
+			TSharedPtr<FMCPJob> Job = Params->TryGetStringField(TEXT("job_id"), JobId) ? JobManager->Find(JobId) : nullptr;
+			if (!Job.IsValid())
+			{
+				if (JobId.IsEmpty())
+				{
+					Writer.WriteErrorResponse(TEXT("Missing 'job_id' parameter"), TEXT("validation_failed"));
+				}
+				else
+				{
+					Writer.WriteErrorResponse(FString::Printf(TEXT("Job not found: %s"), *JobId), TEXT("not_found"));
+				}
+			}
+			else if (CommandType == TEXT("cancel_job"))
+			{
+				const bool bCancelRequested = JobManager->Cancel(JobId);
+				Writer.BeginResponse(true);
+				Writer.WriteField(TEXT("cancel_requested"), bCancelRequested);
+				Job->WriteStatusFields(Writer, false);
+				Writer.EndResponse();
+			}
+			else
+			{
+				Writer.BeginResponse(true);
+				Job->WriteStatusFields(Writer, true);
+				Writer.EndResponse();
+			}
+		}
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::HandleQueueStats(FSocket* ClientSocket, TArray<uint8>& Frame)
+{
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+		Writer.BeginResponse(true);
+		Dispatcher->WriteStats(Writer);
+		Writer.EndResponse();
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::HandleGetMetrics(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame)
+{
+	if (!Metrics.IsValid())
+	{
+		return SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Metrics not available\",\"error_type\":\"not_ready\"}"));
+	}
+
+	FString Format = TEXT("json");
+	Params->TryGetStringField(TEXT("format"), Format);
+
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+		if (Format == TEXT("json"))
+		{
+			Writer.BeginResponse(true);
+			Metrics->WriteJson(Writer);
+			Writer.EndResponse();
+		}
+		else if (Format == TEXT("prometheus"))
+		{
+			// Text exposition format in a field; the client serves it as text/plain
+			Writer.BeginResponse(true);
+			Writer.WriteField(TEXT("format"), TEXT("prometheus"));
+			Writer.WriteField(TEXT("text"), Metrics->ToPrometheus());
+			Writer.EndResponse();
+		}
+		else
+		{
+			Writer.WriteErrorResponse(FString::Printf(TEXT("Unknown format '%s'. Available: json, prometheus"), *Format), TEXT("validation_failed"));
+		}
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::HandleDumpFlightRecorder(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame)
+{
+	if (!FlightRecorder.IsValid())
+	{
+		return SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Flight recorder not available\",\"error_type\":\"not_ready\"}"));
+	}
+
+	int32 Count = 100;
+	Params->TryGetNumberField(TEXT("count"), Count);
+	Count = FMath::Clamp(Count, 1, FMCPFlightRecorder::Capacity);
+
+	bool bLog = false;
+	Params->TryGetBoolField(TEXT("log"), bLog);
+	if (bLog)
+	{
+		FlightRecorder->DumpToLog(TEXT("requested"), Count);
+	}
+
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+		Writer.BeginResponse(true);
+		FlightRecorder->WriteJson(Writer, Count);
+		Writer.EndResponse();
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+void FMCPServer::RecordRequest(const FString& CommandType, const FString& SessionId, const FString& RequestId, const FMCPRequestTimings& Timings)
+{
+	if (Metrics.IsValid())
+	{
+		Metrics->Record(CommandType, Timings);
+	}
+	if (FlightRecorder.IsValid())
+	{
+		FlightRecorder->Record(CommandType, SessionId, RequestId, Timings);
+	}
+}
+
+bool FMCPServer::StartRecording(const FString& Path)
+{
+	TSharedPtr<FMCPCommandRecorder> NewRecorder = MakeShared<FMCPCommandRecorder>(Path, Port);
+	if (!NewRecorder->IsOpen())
+	{
+		return false;
+	}
+
+	{
+		FScopeLock ScopeLock(&RecorderLock);
+		Recorder = NewRecorder;
+	}
+	UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Recording requests to %s"), *Path);
+	return true;
+}
+
+void FMCPServer::StopRecording()
+{
+	TSharedPtr<FMCPCommandRecorder> OldRecorder;
+	{
+		FScopeLock ScopeLock(&RecorderLock);
+		OldRecorder = MoveTemp(Recorder);
+	}
+
+	// Closed once the last in-flight request holding it has been recorded
+	if (OldRecorder.IsValid())
+	{
+		UE_LOG(LogUEBlueprintMCP, Log, TEXT("UEBlueprintMCP: Stopped recording to %s (%lld requests)"), *OldRecorder->GetPath(), OldRecorder->GetRecordedCount());
+	}
+}
+
+FString FMCPServer::GetRecordingPath() const
+{
+	TSharedPtr<FMCPCommandRecorder> ActiveRecorder = GetRecorder();
+	return ActiveRecorder.IsValid() ? ActiveRecorder->GetPath() : FString();
+}
+
+TSharedPtr<FMCPCommandRecorder> FMCPServer::GetRecorder() const
+{
+	FScopeLock ScopeLock(&RecorderLock);
+	return Recorder;
+}
+
+EMCPLane FMCPServer::ResolveLane(const FString& CommandType, const TSharedPtr<FJsonObject>& Request, EMCPLane DefaultLane) const
+{
+	FString Priority;
+	if (!Request->TryGetStringField(TEXT("priority"), Priority))
+	{
+		return DefaultLane;
+	}
+
+	// Control is reserved for the server's own session bookkeeping
+	EMCPLane Lane = DefaultLane;
+	if (!LexTryParseString(Lane, *Priority) || Lane == EMCPLane::Control)
+	{
+		UE_LOG(LogUEBlueprintMCP, Warning, TEXT("UEBlueprintMCP: Ignoring priority '%s' for %s"), *Priority, *CommandType);
+		return DefaultLane;
+	}
+	return Lane;
+}
+
+bool FMCPServer::HandleCancel(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame)
+{
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+
+		FString RequestId;
+		if (!Params->TryGetStringField(TEXT("id"), RequestId) || RequestId.IsEmpty())
+		{
+			Writer.WriteErrorResponse(TEXT("Missing 'id' parameter"), TEXT("validation_failed"));
+		}
+		else
+		{
+			// Not found just means it already finished (or never had an id)
+			bool bCancelled = RequestTracker.Cancel(RequestId);
+			if (!bCancelled && JobManager.IsValid())
+			{
+				bCancelled = JobManager->Cancel(RequestId);
+			}
+
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: cancel %s -> %s"), *RequestId, bCancelled ? TEXT("cancelled") : TEXT("not in flight"));
+
+			Writer.BeginResponse(true);
+			Writer.WriteField(TEXT("id"), RequestId);
+			Writer.WriteField(TEXT("cancelled"), bCancelled);
+			Writer.EndResponse();
+		}
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::HandleSubscription(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, int32 ConnectionId, const TSharedPtr<FMCPOutbox>& Outbox, TArray<uint8>& Frame)
+{
+	if (!EventHub.IsValid())
+	{
+		return SendResponse(ClientSocket, TEXT("{\"success\":false,\"error\":\"Event hub not available\",\"error_type\":\"not_ready\"}"));
+	}
+
+	// "events" is optional: none means every event
+	TArray<FString> Events;
+	const TArray<TSharedPtr<FJsonValue>>* EventValues = nullptr;
+	if (Params->TryGetArrayField(TEXT("events"), EventValues))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *EventValues)
+		{
+			Events.Add(Value->AsString());
+		}
+	}
+
+	BeginFrame(Frame);
+	{
+		FMCPResponseWriter Writer(Frame);
+
+		const FString* Unknown = Events.FindByPredicate([](const FString& EventName) { return !FMCPEventHub::IsKnownEvent(EventName); });
+		if (Unknown)
+		{
+			Writer.WriteErrorResponse(FString::Printf(TEXT("Unknown event '%s'. Available: %s"), **Unknown, *FString::Join(FMCPEventHub::GetEventNames(), TEXT(", "))), TEXT("validation_failed"));
+		}
+		else
+		{
+			if (CommandType == TEXT("subscribe"))
+			{
+				EventHub->Subscribe(ConnectionId, Outbox, Events);
+			}
+			else
+			{
+				EventHub->Unsubscribe(ConnectionId, Events);
+			}
+
+			Writer.BeginResponse(true);
+			Writer.BeginArray(TEXT("subscribed"));
+			for (const FString& EventName : EventHub->GetSubscriptions(ConnectionId))
+			{
+				Writer.WriteValue(EventName);
+			}
+			Writer.EndArray();
+			Writer.BeginArray(TEXT("available"));
+			for (const FString& EventName : FMCPEventHub::GetEventNames())
+			{
+				Writer.WriteValue(EventName);
+			}
+			Writer.EndArray();
+			Writer.EndResponse();
+		}
+	}
+	return SendFrame(ClientSocket, Frame);
+}
+
+bool FMCPServer::ExecuteOnGameThread(const FString& CommandType, TSharedPtr<FJsonObject> Params, const FString& SessionId, const FString& RequestId, EMCPLane Lane, const TSharedRef<FMCPCancelToken>& CancelToken, FMCPRequestTimings& Timings, TArray<uint8>& Frame)
+{
+	FEvent* DoneEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	bool bRan = false;
+	const double EnqueueTime = FPlatformTime::Seconds();
+
+	// The lane wait shows as a timing region (it spans threads, so it can't be a CPU scope)
+	FString QueueRegion;
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(MCPChannel))
+	{
+		QueueRegion = FString::Printf(TEXT("MCP queue wait: %s [%s]"), *CommandType, RequestId.IsEmpty() ? *SessionId : *RequestId);
+		TRACE_BEGIN_REGION(*QueueRegion);
+	}
+
+	const bool bQueued = Dispatcher->Enqueue(Lane, SessionId, CommandType, [this, &CommandType, Params, &SessionId, &CancelToken, &Timings, &Frame, &bRan, &QueueRegion, EnqueueTime, DoneEvent]()
+	{
+		// Frame and Timings are only touched here while the socket thread waits below
+		Timings.Add(EMCPStage::QueueWait, FPlatformTime::Seconds() - EnqueueTime);
+		if (!QueueRegion.IsEmpty())
+		{
+			TRACE_END_REGION(*QueueRegion);
+		}
+		MCP_TRACE_SCOPE_TEXT(TEXT("MCP %s"), *CommandType);
+
+		if (CancelToken->ShouldStop())
+		{
+			// Nobody is waiting for this any more; don't do the work
+			const bool bCancelled = CancelToken->IsCancelled();
+			UE_LOG(LogUEBlueprintMCP, Verbose, TEXT("UEBlueprintMCP: Dropped %s before it ran (%s)"), *CommandType, bCancelled ? TEXT("cancelled") : TEXT("deadline passed"));
+
+			FMCPResponseWriter Writer(Frame);
+			Writer.WriteErrorResponse(
+				bCancelled ? TEXT("Request cancelled before it ran") : TEXT("Request deadline passed before it ran"),
+				bCancelled ? TEXT("cancelled") : TEXT("deadline_exceeded"));
+			Timings.bSuccess = false;
+			Timings.ErrorType = Writer.GetErrorType();
+		}
+		else
+		{
+			FMCPResponseWriter Writer(Frame);
+			Executor->ExecuteCommandToWriter(CommandType, Params, Writer, SessionId, CancelToken, &Timings);
+			Timings.bSuccess = Writer.IsSuccess();
+			Timings.ErrorType = Writer.GetErrorType();
+			bRan = true;
+		}
+
+		DoneEvent->Trigger();
+	});
+
+	// Wait for game thread to complete, unless the lane turned us away
+	if (bQueued)
+	{
+		DoneEvent->Wait();
+	}
+	else
+	{
+		if (!QueueRegion.IsEmpty())
+		{
+			TRACE_END_REGION(*QueueRegion);
+		}
+
+		FMCPResponseWriter Writer(Frame);
+		Dispatcher->WriteBusyResponse(Lane, Writer);
+		Timings.bSuccess = false;
+		Timings.ErrorType = TEXT("busy");
+	}
+	FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+	return bRan;
+}
+
+void FMCPServer::ReleaseSessionOnGameThread(const FString& SessionId)
+{
+	// Fire and forget; the executor copes with its backend being gone during shutdown.
+	// If the control lane is full the session is left to idle eviction.
+	Dispatcher->Enqueue(EMCPLane::Control, SessionId, TEXT("release_session"), [SessionExecutor = Executor, SessionId]()
+	{
+		SessionExecutor->ReleaseSession(SessionId);
+	});
+}
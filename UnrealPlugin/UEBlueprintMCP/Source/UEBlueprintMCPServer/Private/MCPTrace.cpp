@@ -0,0 +1,29 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "MCPTrace.h"
+#include <atomic>
+
+UE_TRACE_CHANNEL_DEFINE(MCPChannel);
+
+TRACE_DECLARE_INT_COUNTER(MCPQueueDepth, TEXT("MCP/QueueDepth"));
+TRACE_DECLARE_INT_COUNTER(MCPBytesReceived, TEXT("MCP/BytesReceived"));
+TRACE_DECLARE_INT_COUNTER(MCPBytesSent, TEXT("MCP/BytesSent"));
+
+namespace
+{
+	// Trace counters aren't atomic; every client thread adds to these, then sets the counter
+	std::atomic<int64> TotalBytesReceived{0};
+	std::atomic<int64> TotalBytesSent{0};
+}
+
+void MCPTrace::CountBytesReceived(int64 Bytes)
+{
+	const int64 Total = TotalBytesReceived.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+	TRACE_COUNTER_SET(MCPBytesReceived, Total);
+}
+
+void MCPTrace::CountBytesSent(int64 Bytes)
+{
+	const int64 Total = TotalBytesSent.fetch_add(Bytes, std::memory_order_relaxed) + Bytes;
+	TRACE_COUNTER_SET(MCPBytesSent, Total);
+}
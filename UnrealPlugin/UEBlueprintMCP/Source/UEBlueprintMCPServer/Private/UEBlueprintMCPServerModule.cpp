@@ -0,0 +1,9 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#include "Modules/ModuleManager.h"
+#include "MCPLog.h"
+
+DEFINE_LOG_CATEGORY(LogUEBlueprintMCP);
+
+// Transport and services only; the editor module (or a benchmark program) starts the server
+IMPLEMENT_MODULE(FDefaultModuleImpl, UEBlueprintMCPServer)
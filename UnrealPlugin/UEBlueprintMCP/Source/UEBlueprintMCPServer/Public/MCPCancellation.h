@@ -0,0 +1,67 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * FMCPCancelToken
+ *
+ * Cancellation state of one request: cancelled explicitly with the cancel
+ * command, or expired once its deadline passes. Requests still queued for
+ * the game thread are dropped when their token stops; running actions see
+ * it through FMCPEditorContext::IsCancelRequested() between phases.
+ *
+ * Thread-safe.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPCancelToken
+{
+public:
+	/** @param InDeadline Absolute FPlatformTime::Seconds() deadline, 0 for none */
+	explicit FMCPCancelToken(double InDeadline = 0.0)
+		: bCancelled(false)
+		, Deadline(InDeadline)
+	{
+	}
+
+	void Cancel() { bCancelled = true; }
+
+	bool IsCancelled() const { return bCancelled; }
+
+	bool IsExpired() const { return Deadline > 0.0 && FPlatformTime::Seconds() > Deadline; }
+
+	/** Cancelled or past the deadline */
+	bool ShouldStop() const { return IsCancelled() || IsExpired(); }
+
+private:
+	TAtomic<bool> bCancelled;
+	const double Deadline;
+};
+
+/**
+ * FMCPRequestTracker
+ *
+ * In-flight requests by their client-supplied "id", so a cancel sent on any
+ * connection (typically the one a client opened after timing out) reaches
+ * the request still queued or running for the old one.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPRequestTracker
+{
+public:
+	/**
+	 * Create the token for a request; tracked by id when RequestId is set.
+	 * @param DeadlineMs Time budget from now in ms, <= 0 for none
+	 */
+	TSharedRef<FMCPCancelToken> Begin(const FString& RequestId, double DeadlineMs);
+
+	/** Stop tracking a finished request */
+	void End(const FString& RequestId);
+
+	/** @return False if no request with that id is in flight */
+	bool Cancel(const FString& RequestId);
+
+private:
+	FCriticalSection Lock;
+	TMap<FString, TSharedRef<FMCPCancelToken>> InFlight;
+};
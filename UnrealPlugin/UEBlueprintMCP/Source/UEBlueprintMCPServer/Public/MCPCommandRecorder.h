@@ -0,0 +1,66 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FArchive;
+struct FMCPRequestTimings;
+
+/**
+ * FMCPCommandRecorder
+ *
+ * Appends every inbound request to a JSON Lines file, so a captured
+ * session can be replayed later as a performance or regression workload
+ * (python -m ue_blueprint_mcp.recording). The first line of a recording
+ * is a header, each following line one answered request:
+ *
+ *   {"mcp_recording":1,"source":"server","started":"2025-...","port":55558}
+ *   {"t":1520.113,"c":1,"s":"conn-1","ms":12.402,"ok":true,"e":"","rb":311,"req":{"type":"create_blueprint",...}}
+ *
+ * t is ms since recording started (when the request arrived), c the
+ * connection, s the session, ms the time to answer, ok/e the outcome and rb
+ * the response size; req is the request exactly as received. The Python
+ * client writes the same format (ConnectionConfig.record_path).
+ *
+ * Thread-safe (recorded from every client thread). Each line is flushed as
+ * it is written, so a recording survives the editor going down.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPCommandRecorder
+{
+public:
+	/** Open Path for appending; check IsOpen() */
+	FMCPCommandRecorder(const FString& InPath, int32 Port);
+	~FMCPCommandRecorder();
+
+	bool IsOpen() const { return Writer.IsValid(); }
+	const FString& GetPath() const { return Path; }
+
+	/** Seconds on the FPlatformTime clock that "t" is measured from */
+	double GetStartTime() const { return StartTime; }
+
+	/**
+	 * Append one answered request.
+	 * @param Message Request JSON as received
+	 * @param ReceivedAt FPlatformTime::Seconds() when it arrived
+	 * @param AnsweredAt FPlatformTime::Seconds() when its response was sent
+	 */
+	void Record(int32 ConnectionId, const FString& SessionId, const FString& Message, double ReceivedAt, double AnsweredAt, const FMCPRequestTimings& Timings);
+
+	/** Requests recorded so far */
+	int64 GetRecordedCount() const;
+
+	/** Command line switch that starts a recording with the server: -MCPRecord=<path> */
+	static constexpr const TCHAR* CommandLineSwitch = TEXT("MCPRecord=");
+
+private:
+	void WriteLine(const FString& Line);
+
+	FString Path;
+	double StartTime;
+
+	mutable FCriticalSection Lock;
+	TUniquePtr<FArchive> Writer;
+	int64 RecordedCount = 0;
+};
@@ -0,0 +1,81 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/** How expensive/invasive a command is (used by clients and schedulers) */
+enum class EMCPCommandCost : uint8
+{
+	/** Only reads editor state */
+	ReadOnly,
+	/** Mutates assets or the level */
+	Mutating,
+	/** Mutates and may run for a long time (compiles, saves, large patches) */
+	Heavy
+};
+
+UEBLUEPRINTMCPSERVER_API const TCHAR* LexToString(EMCPCommandCost Cost);
+
+/** Registry entry for a single command */
+struct UEBLUEPRINTMCPSERVER_API FMCPCommandInfo
+{
+	FString Name;
+
+	/** Bumped when a command's params or result shape changes */
+	int32 Version = 1;
+
+	EMCPCommandCost Cost = EMCPCommandCost::Mutating;
+
+	/** Read-only command the server may answer off the game thread from published snapshots */
+	bool bConcurrent = false;
+
+	/** JSON schema of the params, null if the action has no params struct yet */
+	TSharedPtr<FJsonObject> ParamsSchema;
+};
+
+/**
+ * FMCPCommandRegistry
+ *
+ * Schema, version and cost class of every command the bridge serves.
+ * Filled on the game thread while actions are registered, then frozen:
+ * Freeze() serializes the list_commands response and its ETag once, and
+ * from then on the registry is immutable, so the server thread answers
+ * list_commands without touching the game thread.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPCommandRegistry
+{
+public:
+	/** Add or replace a command (only before Freeze) */
+	void Register(const FMCPCommandInfo& Info);
+
+	/** Add the commands FMCPServer answers itself (every executor serves these) */
+	void RegisterServerCommands();
+
+	/** Serialize the list response and compute the ETag; no registrations after this */
+	void Freeze();
+
+	bool IsFrozen() const { return bFrozen; }
+
+	/** Find a command by name (thread-safe once frozen) */
+	const FMCPCommandInfo* Find(const FString& Name) const;
+
+	int32 Num() const { return Commands.Num(); }
+
+	/** Every command by name (thread-safe once frozen) */
+	const TMap<FString, FMCPCommandInfo>& GetCommands() const { return Commands; }
+
+	/** Content hash of the command list */
+	const FString& GetETag() const { return ETag; }
+
+	/** Pre-serialized UTF-8 list_commands response body */
+	const TArray<uint8>& GetListResponse() const { return ListResponse; }
+
+private:
+	TMap<FString, FMCPCommandInfo> Commands;
+
+	FString ETag;
+	TArray<uint8> ListResponse;
+	bool bFrozen = false;
+};
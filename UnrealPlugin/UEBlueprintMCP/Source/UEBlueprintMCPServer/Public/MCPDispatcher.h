@@ -0,0 +1,121 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+struct FMCPCommandInfo;
+class FMCPResponseWriter;
+
+/** Priority class of game-thread work, highest first */
+enum class EMCPLane : uint8
+{
+	/** Session bookkeeping (get_context, session release) */
+	Control,
+	/** Read-only and ordinary mutating commands an agent waits on */
+	Interactive,
+	/** Heavy synchronous commands (compiles, saves, large patches) */
+	Bulk,
+	/** Async jobs */
+	Background,
+
+	Num
+};
+
+UEBLUEPRINTMCPSERVER_API const TCHAR* LexToString(EMCPLane Lane);
+
+/** Parse a lane name ("control", "interactive", "bulk", "background") */
+UEBLUEPRINTMCPSERVER_API bool LexTryParseString(EMCPLane& OutLane, const TCHAR* Name);
+
+/**
+ * FMCPDispatcher
+ *
+ * Queues game-thread work from client threads in four priority lanes and
+ * runs it from a game-thread pump:
+ * - Each lane has a bounded depth; Enqueue() refuses work when it is full so
+ *   the client gets an explicit busy error (with a retry hint) instead of
+ *   waiting behind an unbounded backlog.
+ * - Lanes are picked by weighted stride scheduling (control always first),
+ *   so interactive calls overtake queued compiles without starving them.
+ * - Within a lane, sessions are served round-robin so one agent's burst
+ *   doesn't delay another agent's next command.
+ * - The pump yields back to the editor after a small time budget and
+ *   resumes on the next core ticker tick.
+ *
+ * Thread-safe; work always runs on the game thread.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPDispatcher : public TSharedFromThis<FMCPDispatcher>
+{
+public:
+	/** Default lane for a command (Interactive for unknown commands) */
+	static EMCPLane LaneForCommand(const FMCPCommandInfo* Info);
+
+	/**
+	 * Queue Work to run on the game thread.
+	 * @return False (Work discarded) if the lane is full
+	 */
+	bool Enqueue(EMCPLane Lane, const FString& SessionId, const FString& CommandType, TUniqueFunction<void()>&& Work);
+
+	/** Whether Enqueue would currently accept work for Lane */
+	bool HasCapacity(EMCPLane Lane) const;
+
+	/** Write a complete busy error response for a rejected Enqueue */
+	void WriteBusyResponse(EMCPLane Lane, FMCPResponseWriter& Writer) const;
+
+	/** Write per-lane and per-session queue stats as fields of the current object */
+	void WriteStats(FMCPResponseWriter& Writer) const;
+
+	/** Queue capacity per lane */
+	static constexpr int32 LaneCapacity[] = { 64, 64, 16, 32 };
+
+	/** Share of picks per lane when several are waiting (control is always first) */
+	static constexpr int32 LaneWeight[] = { 0, 16, 4, 1 };
+
+	/** Game-thread time a pump may spend before yielding to the editor */
+	static constexpr double PumpBudgetSeconds = 0.008;
+
+private:
+	struct FWorkItem
+	{
+		FString CommandType;
+		TUniqueFunction<void()> Work;
+		double EnqueueTime = 0.0;
+	};
+
+	struct FLane
+	{
+		/** Queued work per session */
+		TMap<FString, TArray<FWorkItem>> BySession;
+
+		/** Sessions with queued work, next to serve first */
+		TArray<FString> SessionOrder;
+
+		int32 Depth = 0;
+		int32 PeakDepth = 0;
+		uint64 Enqueued = 0;
+		uint64 Executed = 0;
+		uint64 Rejected = 0;
+		double TotalWaitSeconds = 0.0;
+		double MaxWaitSeconds = 0.0;
+		double TotalExecSeconds = 0.0;
+
+		/** Picks since the lanes were last all idle (for stride scheduling) */
+		uint64 Picks = 0;
+	};
+
+	/** Schedule a pump on the game thread unless one is pending */
+	void SchedulePump();
+
+	/** Run queued work until empty or out of budget (game thread) */
+	void Pump();
+
+	/** Take the next item by lane priority and session round-robin (Lock held) */
+	bool PopNext(FWorkItem& OutItem, EMCPLane& OutLane);
+
+	mutable FCriticalSection Lock;
+
+	FLane Lanes[static_cast<int32>(EMCPLane::Num)];
+
+	bool bPumpScheduled = false;
+};
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FMCPOutbox;
+class FMCPResponseWriter;
+
+/**
+ * FMCPEventHub
+ *
+ * Editor events pushed to subscribed connections as unsolicited frames:
+ *   {"event": "actor_moved", "seq": 42, ...fields}
+ *
+ * Connections subscribe to a set of event names; each published event is
+ * serialized once and queued on the outbox of every matching connection,
+ * which sends it between responses. seq increases across all events so
+ * clients can tell if they missed any (e.g. while reconnecting).
+ *
+ * Thread-safe: published on the game thread, (un)subscribed from client threads.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPEventHub
+{
+public:
+	/** Every event name that can be subscribed to */
+	static const TArray<FString>& GetEventNames();
+
+	static bool IsKnownEvent(const FString& EventName);
+
+	/** Add events to a connection's subscription (empty = all events) */
+	void Subscribe(int32 ConnectionId, const TSharedPtr<FMCPOutbox>& Outbox, const TArray<FString>& Events);
+
+	/** Remove events from a connection's subscription (empty = all events) */
+	void Unsubscribe(int32 ConnectionId, const TArray<FString>& Events);
+
+	/** Events a connection is subscribed to, sorted */
+	TArray<FString> GetSubscriptions(int32 ConnectionId) const;
+
+	/** Whether anyone listens for EventName (lets hooks skip building the event) */
+	bool HasSubscribers(const FString& EventName) const;
+
+	/**
+	 * Push an event to its subscribers. WriteFields adds the payload after
+	 * "event" and "seq"; it only runs if someone is subscribed.
+	 */
+	void Publish(const FString& EventName, TFunctionRef<void(FMCPResponseWriter&)> WriteFields);
+
+	/** Publish an event without payload */
+	void Publish(const FString& EventName);
+
+private:
+	struct FSubscriber
+	{
+		TWeakPtr<FMCPOutbox> Outbox;
+		TSet<FString> Events;
+	};
+
+	mutable FCriticalSection Lock;
+
+	/** Connection id -> subscription */
+	TMap<int32, FSubscriber> Subscribers;
+
+	int64 NextSequence = 1;
+};
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+class FMCPCommandRegistry;
+class FMCPJobManager;
+class FMCPJob;
+class FMCPEventHub;
+class FMCPResultCache;
+class FMCPMetrics;
+class FMCPFlightRecorder;
+class FMCPResponseWriter;
+class FMCPCancelToken;
+struct FMCPRequestTimings;
+
+/**
+ * IMCPSnapshotReader
+ *
+ * Read-only queries an executor can answer from client threads, without
+ * the game thread (the editor's FMCPSnapshotStore). Implementations must be
+ * safe to call concurrently.
+ */
+class UEBLUEPRINTMCPSERVER_API IMCPSnapshotReader
+{
+public:
+	virtual ~IMCPSnapshotReader() = default;
+
+	/**
+	 * Write the complete response to a concurrent query into Writer.
+	 * Returns false, having written nothing, when it can't be answered from
+	 * a current snapshot and must go through the dispatcher.
+	 */
+	virtual bool TryServe(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer) const = 0;
+};
+
+/**
+ * IMCPCommandExecutor
+ *
+ * What FMCPServer needs from whatever runs its commands. The server owns
+ * the transport (sockets, framing, sessions, lanes, deadlines, idempotency)
+ * and only reaches the executor through this interface, so the same server
+ * runs against the editor (UMCPBridge) or a synthetic backend
+ * (FMCPMockExecutor) for benchmarking without an editor.
+ *
+ * Services are fetched once when the server is constructed and used from
+ * client threads; a null service turns the matching feature off (e.g. no
+ * snapshot store means every read goes through the dispatcher). The
+ * Execute/Session calls are made from the dispatcher's pump, i.e. on the
+ * game thread, and may outlive whatever backs the executor, so they must
+ * cope with it having gone away.
+ */
+class UEBLUEPRINTMCPSERVER_API IMCPCommandExecutor
+{
+public:
+	virtual ~IMCPCommandExecutor() = default;
+
+	// =========================================================================
+	// Services (thread-safe, fetched once)
+	// =========================================================================
+
+	/** Frozen command registry; required */
+	virtual TSharedPtr<const FMCPCommandRegistry> GetCommandRegistry() const = 0;
+
+	virtual TSharedPtr<const IMCPSnapshotReader> GetSnapshotStore() const { return nullptr; }
+	virtual TSharedPtr<FMCPJobManager> GetJobManager() const { return nullptr; }
+	virtual TSharedPtr<FMCPEventHub> GetEventHub() const { return nullptr; }
+	virtual TSharedPtr<FMCPResultCache> GetResultCache() const { return nullptr; }
+	virtual TSharedPtr<FMCPMetrics> GetMetrics() const { return nullptr; }
+	virtual TSharedPtr<FMCPFlightRecorder> GetFlightRecorder() const { return nullptr; }
+
+	// =========================================================================
+	// Execution (game thread)
+	// =========================================================================
+
+	/**
+	 * Run a command and write its complete response into Writer.
+	 * CancelToken and Timings may be null.
+	 */
+	virtual void ExecuteCommandToWriter(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer, const FString& SessionId, const TSharedPtr<FMCPCancelToken>& CancelToken, FMCPRequestTimings* Timings) = 0;
+
+	/** Run an async job created by the server's job manager */
+	virtual void ExecuteJob(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Params) = 0;
+
+	/** get_context result for a session, or null if the executor is gone */
+	virtual TSharedPtr<FJsonObject> GetSessionContextJson(const FString& SessionId) = 0;
+
+	/** Drop a session's state once its connection closes */
+	virtual void ReleaseSession(const FString& SessionId) = 0;
+};
@@ -0,0 +1,80 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "MCPMetrics.h"
+
+class FMCPResponseWriter;
+
+/**
+ * One finished request, fixed size with no heap members so the ring is
+ * allocated once and recording never allocates. Strings are truncated
+ * ASCII (anything else becomes '?').
+ */
+struct FMCPFlightRecord
+{
+	/** FDateTime::UtcNow ticks when the request finished */
+	int64 UtcTicks = 0;
+	uint64 Sequence = 0;
+
+	float StageMs[static_cast<int32>(EMCPStage::Num)] = {};
+	uint32 StagesReached = 0;
+
+	int32 RequestBytes = 0;
+	int32 ResponseBytes = 0;
+	bool bSuccess = false;
+
+	ANSICHAR Command[48] = {};
+	ANSICHAR Session[40] = {};
+	ANSICHAR RequestId[40] = {};
+	ANSICHAR ErrorType[24] = {};
+};
+
+/**
+ * FMCPFlightRecorder
+ *
+ * Ring of the last Capacity requests with their stage times, sizes and
+ * outcome, cheap enough to keep on in every build. Read on demand with
+ * dump_flight_recorder, and dumped to the log by itself (rate limited)
+ * when a request fails with crash_prevented, execution_failed or
+ * post_validation_failed, so the lead-up to a failure is in the log
+ * without per-command logging turned on.
+ *
+ * Thread-safe (recorded from client threads and the game thread).
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPFlightRecorder
+{
+public:
+	FMCPFlightRecorder();
+
+	/** Add one finished request, overwriting the oldest once full */
+	void Record(const FString& CommandType, const FString& SessionId, const FString& RequestId, const FMCPRequestTimings& Timings);
+
+	/** Write capacity, total recorded and the last MaxRecords as fields of the current object (oldest first) */
+	void WriteJson(FMCPResponseWriter& Writer, int32 MaxRecords) const;
+
+	/** Log the last MaxRecords at Warning, headed by Reason */
+	void DumpToLog(const TCHAR* Reason, int32 MaxRecords) const;
+
+	static constexpr int32 Capacity = 1024;
+
+	/** Records logged by an automatic dump on failure */
+	static constexpr int32 AutoDumpRecords = 32;
+
+	/** Minimum time between automatic dumps */
+	static constexpr double AutoDumpIntervalSeconds = 5.0;
+
+private:
+	/** Copy of the last MaxRecords, oldest first, and how many were ever recorded */
+	TArray<FMCPFlightRecord> GetLatest(int32 MaxRecords, uint64& OutRecorded) const;
+
+	mutable FCriticalSection Lock;
+	TArray<FMCPFlightRecord> Ring;
+
+	/** Requests recorded so far; the next one goes in Ring[NextSequence % Capacity] */
+	uint64 NextSequence = 0;
+
+	double LastAutoDumpTime = -AutoDumpIntervalSeconds;
+};
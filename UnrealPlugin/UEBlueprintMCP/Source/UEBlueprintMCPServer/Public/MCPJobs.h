@@ -0,0 +1,148 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+
+class FMCPOutbox;
+class FMCPResponseWriter;
+
+/** Lifecycle of an async job */
+enum class EMCPJobState : uint8
+{
+	Queued,
+	Running,
+	Succeeded,
+	Failed,
+	Cancelled
+};
+
+UEBLUEPRINTMCPSERVER_API const TCHAR* LexToString(EMCPJobState State);
+
+/**
+ * FMCPJob
+ *
+ * One command started with "async": true. The client gets the job id
+ * right away; the command runs on the game thread, reports progress
+ * through its context, and its full response is kept as the job result.
+ *
+ * Thread-safe: the game thread updates progress and state, client
+ * threads read status and request cancellation.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPJob
+{
+public:
+	FMCPJob(const FString& InId, const FString& InCommandType, const FString& InSessionId, const TSharedPtr<FMCPOutbox>& InOutbox);
+
+	const FString& GetId() const { return Id; }
+	const FString& GetCommandType() const { return CommandType; }
+	const FString& GetSessionId() const { return SessionId; }
+
+	EMCPJobState GetState() const;
+	bool IsFinished() const;
+
+	/** Update progress (0..1) and the current phase name */
+	void SetProgress(float InProgress, const FString& InPhase);
+
+	/** Ask the job to stop; actions see it through FMCPEditorContext::IsCancelRequested() */
+	void RequestCancel() { bCancelRequested = true; }
+	bool IsCancelRequested() const { return bCancelRequested; }
+
+	/**
+	 * Keep the job running after its command returns until Condition is true
+	 * (polled on the game thread), e.g. while shaders compile asynchronously.
+	 */
+	void CompleteWhen(TFunction<bool()> Condition, const FString& WaitPhase);
+
+	/** Write id, command, status, progress, phase, elapsed_ms and (once finished) result */
+	void WriteStatusFields(FMCPResponseWriter& Writer, bool bIncludeResult) const;
+
+private:
+	friend class FMCPJobManager;
+
+	const FString Id;
+	const FString CommandType;
+	const FString SessionId;
+
+	/** Connection that started the job (completion is pushed here) */
+	TWeakPtr<FMCPOutbox> Outbox;
+
+	TAtomic<bool> bCancelRequested;
+
+	/** Guards everything below */
+	mutable FCriticalSection Lock;
+
+	EMCPJobState State;
+	float Progress;
+	FString Phase;
+	double CreatedTime;
+	double FinishedTime;
+
+	/** The command's full response, set once the job finishes */
+	TSharedPtr<FJsonObject> Result;
+
+	/** Set via CompleteWhen (game thread only) */
+	TFunction<bool()> CompletionCondition;
+};
+
+/**
+ * FMCPJobManager
+ *
+ * Owns async jobs from creation until they age out. Finished jobs are kept
+ * (newest MaxFinishedJobs) so clients that missed the pushed completion
+ * can still fetch the result with get_job.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPJobManager
+{
+public:
+	/** Create a queued job */
+	TSharedRef<FMCPJob> CreateJob(const FString& CommandType, const FString& SessionId, const TSharedPtr<FMCPOutbox>& Outbox);
+
+	/** Find a job by id (null if unknown or aged out) */
+	TSharedPtr<FMCPJob> Find(const FString& JobId) const;
+
+	/** All known jobs, oldest first */
+	TArray<TSharedRef<FMCPJob>> GetJobs() const;
+
+	/** Queued -> Running; false if the job was cancelled before it started */
+	bool MarkRunning(const TSharedRef<FMCPJob>& Job);
+
+	/**
+	 * Finish a job with its command's response. The state follows the response
+	 * ("cancelled" errors become Cancelled) and completion is pushed to the
+	 * connection that started it.
+	 */
+	void Finish(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Response);
+
+	/**
+	 * Cancel a job. Queued jobs finish as cancelled right away; running ones
+	 * are asked to stop and finish when their action notices.
+	 *
+	 * @return False if the job is unknown or already finished
+	 */
+	bool Cancel(const FString& JobId);
+
+	/** Poll jobs waiting on a completion condition (game thread) */
+	void TickWaitingJobs();
+
+	static constexpr int32 MaxFinishedJobs = 128;
+
+private:
+	/** Set the final state, push the completion frame and age out old jobs */
+	void Complete(const TSharedRef<FMCPJob>& Job, EMCPJobState FinalState, const TSharedPtr<FJsonObject>& Response);
+
+	mutable FCriticalSection Lock;
+
+	/** Job id -> job */
+	TMap<FString, TSharedRef<FMCPJob>> Jobs;
+
+	/** Creation order, for listing and ageing out */
+	TArray<FString> JobOrder;
+
+	/** Jobs whose command returned but whose CompletionCondition is pending (game thread only) */
+	TArray<TSharedRef<FMCPJob>> WaitingJobs;
+
+	int32 NextJobId = 1;
+};
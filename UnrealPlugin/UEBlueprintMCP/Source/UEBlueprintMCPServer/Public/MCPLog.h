@@ -0,0 +1,20 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+/**
+ * Log category for the whole plugin.
+ *
+ * Lifecycle and failures log at Log/Warning/Error. Per-command detail logs
+ * at Verbose: off by default at runtime ("log LogUEBlueprintMCP Verbose" or
+ * -LogCmds="LogUEBlueprintMCP Verbose" to see it), and compiled out entirely
+ * in Test and Shipping builds, where it's capped at Log.
+ */
+#if UE_BUILD_SHIPPING || UE_BUILD_TEST
+UEBLUEPRINTMCPSERVER_API DECLARE_LOG_CATEGORY_EXTERN(LogUEBlueprintMCP, Log, Log);
+#else
+UEBLUEPRINTMCPSERVER_API DECLARE_LOG_CATEGORY_EXTERN(LogUEBlueprintMCP, Log, All);
+#endif
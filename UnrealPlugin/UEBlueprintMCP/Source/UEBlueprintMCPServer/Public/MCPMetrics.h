@@ -0,0 +1,185 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FMCPCommandRegistry;
+class FMCPResponseWriter;
+
+/** Pipeline stage of a request, in the order a request goes through them */
+enum class EMCPStage : uint8
+{
+	/** Reading the message off the socket */
+	Receive,
+	/** JSON parse of the message */
+	Parse,
+	/** Waiting in a dispatcher lane for the game thread */
+	QueueWait,
+	/** FEditorAction::Validate */
+	Validate,
+	/** ExecuteInternal / ExecuteStreaming (and PostValidate) */
+	Execute,
+	/** SaveDirtyPackages */
+	Save,
+	/** Serializing a DOM response (streamed responses serialize during Execute) */
+	Serialize,
+	/** Writing the response to the socket */
+	Send,
+
+	Num
+};
+
+UEBLUEPRINTMCPSERVER_API const TCHAR* LexToString(EMCPStage Stage);
+
+/** Stage times and sizes of one request, filled in as it moves through the pipeline */
+struct UEBLUEPRINTMCPSERVER_API FMCPRequestTimings
+{
+	double StageSeconds[static_cast<int32>(EMCPStage::Num)] = {};
+
+	/** Bit per stage that was reached (stages not reached aren't recorded) */
+	uint32 StagesReached = 0;
+
+	bool bSuccess = true;
+
+	/** error_type of a failed response, if it had one */
+	FString ErrorType;
+
+	int64 RequestBytes = 0;
+	int64 ResponseBytes = 0;
+
+	void Add(EMCPStage Stage, double Seconds)
+	{
+		StageSeconds[static_cast<int32>(Stage)] += Seconds;
+		StagesReached |= 1u << static_cast<uint32>(Stage);
+	}
+
+	bool HasStage(EMCPStage Stage) const { return (StagesReached & (1u << static_cast<uint32>(Stage))) != 0; }
+
+	/** Sum of every stage so far */
+	double GetTotalSeconds() const
+	{
+		double Total = 0.0;
+		for (double Seconds : StageSeconds)
+		{
+			Total += Seconds;
+		}
+		return Total;
+	}
+};
+
+/**
+ * Adds its lifetime to a stage of Timings (no-op for null Timings), minus
+ * any time stages timed inside it recorded (a save, or a nested action in
+ * a batch), so stages never double count and still sum to the total.
+ */
+class FMCPStageTimer
+{
+public:
+	FMCPStageTimer(FMCPRequestTimings* InTimings, EMCPStage InStage)
+		: Timings(InTimings)
+		, Stage(InStage)
+		, StartTime(FPlatformTime::Seconds())
+		, StartAccounted(InTimings ? InTimings->GetTotalSeconds() : 0.0)
+	{
+	}
+
+	~FMCPStageTimer()
+	{
+		if (Timings)
+		{
+			const double Inner = Timings->GetTotalSeconds() - StartAccounted;
+			Timings->Add(Stage, FMath::Max(0.0, FPlatformTime::Seconds() - StartTime - Inner));
+		}
+	}
+
+private:
+	FMCPRequestTimings* Timings;
+	EMCPStage Stage;
+	double StartTime;
+	double StartAccounted;
+};
+
+/**
+ * FMCPHistogram
+ *
+ * Log-linear (HDR-style) histogram of non-negative integers: exact below 8,
+ * then 8 sub-buckets per power of two, so any value is reported within
+ * 12.5%. Recording is a handful of relaxed atomic adds, no locks.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPHistogram
+{
+public:
+	void Record(uint64 Value);
+
+	uint64 GetCount() const { return Count.load(std::memory_order_relaxed); }
+	uint64 GetSum() const { return Sum.load(std::memory_order_relaxed); }
+	uint64 GetMax() const { return Max.load(std::memory_order_relaxed); }
+
+	/** Smallest bucket bound at or below which Fraction (0..1) of the samples fall */
+	uint64 GetPercentile(double Fraction) const;
+
+	static constexpr int32 SubBucketBits = 3;
+	static constexpr int32 SubBucketCount = 1 << SubBucketBits;
+
+	/** Values of 2^(MaxExponent+1) and up land in the last bucket */
+	static constexpr int32 MaxExponent = 40;
+
+	static constexpr int32 NumBuckets = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+private:
+	static int32 BucketIndex(uint64 Value);
+	static uint64 BucketUpperBound(int32 Index);
+
+	std::atomic<uint32> Buckets[NumBuckets] = {};
+	std::atomic<uint64> Count{0};
+	std::atomic<uint64> Sum{0};
+	std::atomic<uint64> Max{0};
+};
+
+/**
+ * FMCPMetrics
+ *
+ * Per-command latency histograms (microseconds) for every pipeline stage
+ * plus end to end, request/response size histograms (bytes), and error
+ * counts. One entry per registered command is created up front, so
+ * recording from any thread never takes a lock; unregistered names share
+ * an "unknown" entry.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPMetrics
+{
+public:
+	/** @param Registry Frozen registry; its commands are the ones tracked by name */
+	explicit FMCPMetrics(const FMCPCommandRegistry& Registry);
+
+	/** Add one finished request */
+	void Record(const FString& CommandType, const FMCPRequestTimings& Timings);
+
+	/** Write uptime and per-command stats as fields of the current object (commands seen so far) */
+	void WriteJson(FMCPResponseWriter& Writer) const;
+
+	/** Prometheus text exposition format (summaries with p50/p90/p99) */
+	FString ToPrometheus() const;
+
+private:
+	struct FCommandMetrics
+	{
+		FMCPHistogram Stages[static_cast<int32>(EMCPStage::Num)];
+		FMCPHistogram Total;
+		FMCPHistogram RequestBytes;
+		FMCPHistogram ResponseBytes;
+		std::atomic<uint64> Errors{0};
+	};
+
+	FCommandMetrics& FindMetrics(const FString& CommandType);
+
+	/** Commands in name order with at least one recorded request */
+	TArray<TPair<FString, const FCommandMetrics*>> GetRecorded() const;
+
+	/** Immutable after construction */
+	TMap<FString, TUniquePtr<FCommandMetrics>> ByCommand;
+	TUniquePtr<FCommandMetrics> Unknown;
+
+	const double StartTime;
+};
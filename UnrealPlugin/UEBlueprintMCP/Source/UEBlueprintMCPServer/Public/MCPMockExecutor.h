@@ -0,0 +1,119 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "MCPExecutor.h"
+#include "MCPCommandRegistry.h"
+
+/** Synthetic cost and response of one mock command */
+struct UEBLUEPRINTMCPSERVER_API FMCPMockCommandProfile
+{
+	EMCPCommandCost Cost = EMCPCommandCost::Mutating;
+
+	/** Time the command holds the game thread, in ms */
+	double LatencyMs = 1.0;
+
+	/** Uniform +/- spread around LatencyMs */
+	double JitterMs = 0.0;
+
+	/** Size of the "payload" string in the response, in bytes */
+	int32 PayloadBytes = 64;
+
+	/** Fraction of calls (0..1) that fail with execution_failed */
+	double ErrorRate = 0.0;
+};
+
+/** Commands served by FMCPMockExecutor */
+struct UEBLUEPRINTMCPSERVER_API FMCPMockExecutorSettings
+{
+	/** Commands by name; empty serves mock_read, mock_write and mock_heavy */
+	TMap<FString, FMCPMockCommandProfile> Commands;
+
+	/** Seed for latency jitter and injected errors, so runs repeat */
+	int32 Seed = 0;
+
+	/** mock_read (1 ms, 256 B), mock_write (5 ms, 64 B) and mock_heavy (50 ms, 4 KB) */
+	static FMCPMockExecutorSettings MakeDefault();
+
+	/**
+	 * One command per command type in an FMCPCommandRecorder file, with its
+	 * median answer time and response size and its failure rate, so the
+	 * recording replays against the mock at the editor's recorded cost.
+	 * Server commands are left out. Empty if the file can't be read.
+	 */
+	static FMCPMockExecutorSettings FromRecording(const FString& Path);
+};
+
+/**
+ * FMCPMockExecutor
+ *
+ * Headless IMCPCommandExecutor that answers every registered command after
+ * a synthetic latency with a payload of a configured size, touching no
+ * UObjects. An FMCPServer over it exercises the real sockets, framing,
+ * sessions, lanes, deadlines, idempotency and metrics, so transport and
+ * client throughput can be measured without an editor:
+ *
+ *   FMCPServer Server(MakeShared<FMCPMockExecutor>(FMCPMockExecutorSettings::MakeDefault()), 55600);
+ *   Server.Start();
+ *   // Commands run from the dispatcher's game-thread tasks and yielded
+ *   // pumps resume from the core ticker; outside the editor loop, pump
+ *   // both from the main thread:
+ *   FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+ *   FTSTicker::GetCoreTicker().Tick(DeltaTime);
+ *
+ * UMCPMockServerCommandlet (-run=MCPMockServer) does exactly that. The
+ * server and this executor live in the UEBlueprintMCPServer module, which
+ * needs only Core, Json and Sockets, so a program or Low-Level Test target
+ * can depend on it alone.
+ *
+ * Responses are {"success": true, "command", "session", "latency_ms",
+ * "payload"}; mutating commands also echo their params. Async jobs and
+ * get_context work; there is no snapshot store, so reads queue like writes.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPMockExecutor : public IMCPCommandExecutor
+{
+public:
+	explicit FMCPMockExecutor(const FMCPMockExecutorSettings& InSettings);
+
+	virtual TSharedPtr<const FMCPCommandRegistry> GetCommandRegistry() const override { return CommandRegistry; }
+	virtual TSharedPtr<FMCPJobManager> GetJobManager() const override { return JobManager; }
+	virtual TSharedPtr<FMCPEventHub> GetEventHub() const override { return EventHub; }
+	virtual TSharedPtr<FMCPResultCache> GetResultCache() const override { return ResultCache; }
+	virtual TSharedPtr<FMCPMetrics> GetMetrics() const override { return Metrics; }
+	virtual TSharedPtr<FMCPFlightRecorder> GetFlightRecorder() const override { return FlightRecorder; }
+
+	virtual void ExecuteCommandToWriter(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPResponseWriter& Writer, const FString& SessionId, const TSharedPtr<FMCPCancelToken>& CancelToken, FMCPRequestTimings* Timings) override;
+	virtual void ExecuteJob(const TSharedRef<FMCPJob>& Job, const TSharedPtr<FJsonObject>& Params) override;
+	virtual TSharedPtr<FJsonObject> GetSessionContextJson(const FString& SessionId) override;
+	virtual void ReleaseSession(const FString& SessionId) override;
+
+private:
+	/**
+	 * Hold the thread for the command's latency, checking ShouldStop every millisecond.
+	 * @return False if it stopped early
+	 */
+	bool Simulate(const FMCPMockCommandProfile& Profile, TFunctionRef<bool()> ShouldStop, double& OutLatencyMs);
+
+	/** The command's payload: PayloadBytes of filler */
+	FString MakePayload(const FMCPMockCommandProfile& Profile) const;
+
+	FMCPMockExecutorSettings Settings;
+
+	/** Only used from the game thread */
+	FRandomStream Random;
+
+	/** Calls served per session (what get_context reports) */
+	TMap<FString, int32> SessionCalls;
+
+	/** Shared filler the payloads are cut from */
+	FString PayloadSource;
+
+	TSharedPtr<FMCPCommandRegistry> CommandRegistry;
+	TSharedPtr<FMCPJobManager> JobManager;
+	TSharedPtr<FMCPEventHub> EventHub;
+	TSharedPtr<FMCPResultCache> ResultCache;
+	TSharedPtr<FMCPMetrics> Metrics;
+	TSharedPtr<FMCPFlightRecorder> FlightRecorder;
+};
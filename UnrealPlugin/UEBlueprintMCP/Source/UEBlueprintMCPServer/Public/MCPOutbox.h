@@ -0,0 +1,53 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Deque.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * FMCPOutbox
+ *
+ * Unsolicited frames (job completions, events) waiting to be sent on one
+ * client connection. Any thread may push; only the connection's own
+ * thread pops and sends, between responses and every
+ * FMCPServer::ClientPollIntervalMs while the client is idle, so pushed
+ * frames never interleave with a response on the socket.
+ *
+ * Job completions are never dropped. Events are bounded: a subscriber
+ * that stops reading (or whose thread is stuck in a long command) while
+ * actor_moved fires every frame would otherwise grow editor memory
+ * without limit. Past MaxQueuedEvents the oldest event is dropped, and
+ * the next pop sends one {"event": "events_dropped", "count": N} marker
+ * ahead of the surviving events so the client knows to resync.
+ *
+ * Producers hold it weakly: once the connection closes, pushes go nowhere.
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPOutbox
+{
+public:
+	/** Queue a job completion (any thread); never dropped */
+	void Push(TArray<uint8>&& Body);
+
+	/** Queue an event (any thread); drops the oldest queued event when full */
+	void PushEvent(TArray<uint8>&& Body);
+
+	/** Take the next body: completions first, then the drop marker, then events (connection thread only) */
+	bool Pop(TArray<uint8>& OutBody);
+
+	bool IsEmpty() const;
+
+	/** Events held per connection before the oldest are dropped */
+	static constexpr int32 MaxQueuedEvents = 1024;
+
+private:
+	TQueue<TArray<uint8>, EQueueMode::Mpsc> Completions;
+
+	/** Events oldest first, and how many were dropped since the last marker */
+	TDeque<TArray<uint8>> Events;
+	int32 DroppedEvents = 0;
+
+	mutable FCriticalSection Lock;
+};
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/MemoryWriter.h"
+
+/**
+ * FMCPResponseWriter
+ *
+ * Streams a response object as UTF-8 straight into a connection's send
+ * buffer, without building an FJsonObject DOM first. Uses the same writer
+ * and print policy as FJsonSerializer, so the bytes match what serializing
+ * the equivalent DOM produced.
+ *
+ * Usage:
+ *   Writer.BeginResponse(true);          // {"success": true
+ *   Writer.WriteField(TEXT("count"), 3);
+ *   Writer.BeginArray(TEXT("names"));
+ *   Writer.WriteValue(Name);
+ *   Writer.EndArray();
+ *   Writer.EndResponse();                // }
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPResponseWriter
+{
+public:
+	using FJsonWriterType = TJsonWriter<UTF8CHAR, TPrettyJsonPrintPolicy<UTF8CHAR>>;
+
+	/** Appends to Buffer; anything already in it (e.g. a length prefix) is kept */
+	explicit FMCPResponseWriter(TArray<uint8>& InBuffer);
+	~FMCPResponseWriter();
+
+	// =========================================================================
+	// Response Envelope
+	// =========================================================================
+
+	/** Open the response object and write the "success" field */
+	void BeginResponse(bool bInSuccess);
+
+	/** Close the response object */
+	void EndResponse();
+
+	/** Discard everything written so far and write a complete error response */
+	void WriteErrorResponse(const FString& ErrorMessage, const FString& InErrorType);
+
+	/** Write a complete response from an existing DOM (fallback for actions that build one) */
+	void WriteResponseObject(const TSharedPtr<FJsonObject>& Response);
+
+	// =========================================================================
+	// Fields (inside an object)
+	// =========================================================================
+
+	void WriteField(const FString& Key, const FString& Value);
+	void WriteField(const FString& Key, const TCHAR* Value);
+	void WriteField(const FString& Key, double Value);
+	void WriteField(const FString& Key, int32 Value);
+	void WriteField(const FString& Key, bool Value);
+	void WriteNullField(const FString& Key);
+	void WriteField(const FString& Key, const TSharedPtr<FJsonValue>& Value);
+
+	/** Write [X, Y, Z] as a number array field */
+	void WriteVectorField(const FString& Key, const FVector& Value);
+
+	/** Write [Pitch, Yaw, Roll] as a number array field */
+	void WriteRotatorField(const FString& Key, const FRotator& Value);
+
+	/** Write every field of Object at the current level (like CreateSuccessResponse merging) */
+	void WriteObjectFields(const TSharedPtr<FJsonObject>& Object);
+
+	void BeginObject(const FString& Key);
+	void BeginArray(const FString& Key);
+
+	// =========================================================================
+	// Values (inside an array)
+	// =========================================================================
+
+	void WriteValue(const FString& Value);
+	void WriteValue(double Value);
+	void WriteValue(bool Value);
+	void WriteNull();
+
+	void BeginObject();
+	void BeginArray();
+
+	// =========================================================================
+	// Closing
+	// =========================================================================
+
+	void EndObject();
+	void EndArray();
+
+	/** Bytes written by this writer so far */
+	int32 GetBytesWritten() const { return Buffer.Num() - StartOffset; }
+
+	/** Whether the response written so far reports success (for metrics) */
+	bool IsSuccess() const { return bSuccess; }
+
+	/** error_type of the response written so far, empty if it had none (for the flight recorder) */
+	const FString& GetErrorType() const { return ErrorType; }
+
+private:
+	/** (Re)create the archive and JSON writer at the end of the buffer */
+	void ResetWriter();
+
+	TArray<uint8>& Buffer;
+	int32 StartOffset;
+	bool bSuccess;
+	FString ErrorType;
+
+	TUniquePtr<FMemoryWriter> Archive;
+	TSharedPtr<FJsonWriterType> JsonWriter;
+};
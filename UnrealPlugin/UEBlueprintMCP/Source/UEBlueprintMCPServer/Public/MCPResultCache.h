@@ -0,0 +1,87 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+
+/** Outcome of looking up an idempotency key */
+enum class EMCPIdempotencyLookup : uint8
+{
+	/** First time: the caller runs the command and must Complete() or Abort() */
+	Miss,
+	/** Already ran: the original response body is returned */
+	Hit,
+	/** The first attempt is still running; look again shortly */
+	InFlight,
+	/** The key was used for a different command or params */
+	Mismatch
+};
+
+/**
+ * FMCPResultCache
+ *
+ * Responses of recent mutating commands by idempotency key, so a command
+ * re-sent after a dropped connection returns its original response
+ * instead of running twice. Keys are scoped by the caller (session + key).
+ * Bounded LRU, by entry count and by the total size of the stored bodies;
+ * entries also expire after EntryLifetimeSeconds. A body over
+ * MaxEntryBytes isn't kept: its key replays a short "already applied"
+ * response instead, so the command still doesn't run twice.
+ *
+ * Thread-safe (used from client threads).
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPResultCache
+{
+public:
+	FMCPResultCache();
+
+	/**
+	 * Claim Key for a command, or get the response it already produced.
+	 * @param Fingerprint Hash of the command's params (a reused key must match)
+	 * @param OutBody Original UTF-8 response body on Hit
+	 */
+	EMCPIdempotencyLookup Begin(const FString& Key, const FString& CommandType, uint32 Fingerprint, TArray<uint8>& OutBody);
+
+	/**
+	 * Store the response of a claimed key
+	 * @param bSuccess Whether Body reports success (kept if Body is too large to store)
+	 */
+	void Complete(const FString& Key, bool bSuccess, TArrayView<const uint8> Body);
+
+	/** Release a claimed key whose command never ran (busy, dropped) */
+	void Abort(const FString& Key);
+
+	static constexpr int32 MaxEntries = 256;
+	static constexpr double EntryLifetimeSeconds = 600.0;
+
+	/** Budget for all stored bodies; least recently used entries go first past it */
+	static constexpr int64 MaxTotalBytes = 16 * 1024 * 1024;
+
+	/** Largest body stored as-is */
+	static constexpr int32 MaxEntryBytes = 256 * 1024;
+
+private:
+	struct FEntry
+	{
+		FString CommandType;
+		uint32 Fingerprint = 0;
+		bool bCompleted = false;
+		double CompletedTime = 0.0;
+		TArray<uint8> Body;
+	};
+
+	/** Short replay for a body over MaxEntryBytes */
+	static void WriteAlreadyApplied(bool bSuccess, int32 BodyBytes, TArray<uint8>& OutBody);
+
+	/** Remove Key, or the least recently used entry, keeping TotalBytes in step (lock held) */
+	void Remove(const FString& Key);
+	void RemoveLeastRecent();
+
+	FCriticalSection Lock;
+	TLruCache<FString, FEntry> Entries;
+
+	/** Sum of the stored bodies' sizes */
+	int64 TotalBytes = 0;
+};
@@ -0,0 +1,252 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "MCPCancellation.h"
+#include "MCPDispatcher.h"
+
+// Forward declarations
+class IMCPCommandExecutor;
+class FMCPCommandRegistry;
+class IMCPSnapshotReader;
+class FMCPJobManager;
+class FMCPOutbox;
+class FMCPEventHub;
+class FMCPResultCache;
+class FMCPMetrics;
+class FMCPFlightRecorder;
+class FMCPCommandRecorder;
+struct FMCPRequestTimings;
+class FMCPClientRunnable;
+
+/**
+ * FMCPServer
+ *
+ * TCP server that accepts connections from MCP clients and routes
+ * commands to an executor: the editor's UMCPBridge, or FMCPMockExecutor
+ * to benchmark the transport without an editor.
+ *
+ * Key differences from original UnrealMCP:
+ * - Persistent connections (socket stays open between commands)
+ * - Each client runs on its own thread with its own session context
+ * - ping/close/list_commands handled without game thread
+ * - Read-only queries served from published snapshots when current
+ * - Long-running commands can run as async jobs with pushed completion
+ * - Editor events pushed to connections that subscribe to them
+ * - Requests with an "id" can be cancelled; expired or cancelled ones never run
+ * - Game-thread work is queued in bounded priority lanes, fair across sessions
+ * - Mutating commands retried with the same idempotency key are answered, not re-run
+ * - Per-command stage latency histograms served by get_metrics
+ * - Flight recorder of recent requests served by dump_flight_recorder
+ * - Optional recording of every request to a file, for replay
+ * - Unreal Insights scopes, regions and counters on the "MCP" trace channel
+ * - Timeout handling for stale connections
+ */
+class UEBLUEPRINTMCPSERVER_API FMCPServer : public FRunnable
+{
+public:
+	FMCPServer(const TSharedRef<IMCPCommandExecutor>& InExecutor, int32 InPort = 55557);
+	virtual ~FMCPServer();
+
+	/** Start the server thread */
+	bool Start();
+
+	/** Stop the server thread */
+	void Stop();
+
+	/** Check if server is running */
+	bool IsRunning() const { return bIsRunning; }
+
+	/**
+	 * Append every request answered from now on to Path (see FMCPCommandRecorder),
+	 * replacing any recording already running.
+	 * @return False if the file could not be opened
+	 */
+	bool StartRecording(const FString& Path);
+
+	/** Stop recording; requests already answered stay in the file */
+	void StopRecording();
+
+	/** Path of the running recording, or empty */
+	FString GetRecordingPath() const;
+
+	// =========================================================================
+	// FRunnable Interface
+	// =========================================================================
+
+	virtual bool Init() override;
+	virtual uint32 Run() override;
+	virtual void Exit() override;
+
+private:
+	friend class FMCPClientRunnable;
+
+	/**
+	 * Handle a single client connection (runs on that client's thread).
+	 * Commands use the session named by their "session" field, or a
+	 * connection-scoped session that is released on disconnect.
+	 */
+	void HandleClient(FSocket* ClientSocket, int32 ConnectionId);
+
+	/** Join and delete client threads whose connection has closed */
+	void ReapFinishedClients(bool bWaitForAll);
+
+	/** Receive a message from client (length-prefixed JSON) */
+	bool ReceiveMessage(FSocket* ClientSocket, FString& OutMessage);
+
+	/** Send a response to client (length-prefixed JSON) */
+	bool SendResponse(FSocket* ClientSocket, const FString& Response);
+
+	/** Reset Frame to an empty message: just the reserved 4-byte length prefix */
+	static void BeginFrame(TArray<uint8>& Frame);
+
+	/** Patch the length prefix of Frame and send prefix + body in one go */
+	bool SendFrame(FSocket* ClientSocket, TArray<uint8>& Frame);
+
+	/** Handle ping command (no game thread needed) */
+	FString HandlePing();
+
+	/** Handle close command */
+	void HandleClose(FSocket* ClientSocket);
+
+	/** Handle get_context command for a session */
+	bool HandleGetContext(FSocket* ClientSocket, const FString& SessionId, TArray<uint8>& Frame);
+
+	/** Handle list_commands from the frozen registry (no game thread needed) */
+	bool HandleListCommands(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame);
+
+	/**
+	 * Answer a registry-flagged read-only command from the snapshot store on this thread.
+	 * @return False if the command must go to the game thread instead
+	 */
+	bool TryServeFromSnapshot(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPRequestTimings& Timings, TArray<uint8>& Frame);
+
+	/** Send every frame queued for this connection (job completions, events) */
+	void FlushOutbox(FSocket* ClientSocket, FMCPOutbox& Outbox, TArray<uint8>& Frame);
+
+	/**
+	 * Start a command as an async job and reply with its id straight away.
+	 * The reply is stored under IdempotencyKey (if claimed) so a retry gets the same job.
+	 */
+	bool StartJob(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, EMCPLane Lane, const TSharedPtr<FMCPOutbox>& Outbox, const FString& IdempotencyKey, TArray<uint8>& Frame);
+
+	/**
+	 * Claim the request's "idempotency_key" (mutating commands only), waiting out a first
+	 * attempt that is still running.
+	 * @param OutKey Session-scoped key the caller must complete or abort; empty if none
+	 * @return True if the request was already answered (original response, or an error)
+	 */
+	bool ClaimIdempotencyKey(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Request, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, FString& OutKey, TArray<uint8>& Frame);
+
+	/** Handle get_queue_stats from the dispatcher (no game thread needed) */
+	bool HandleQueueStats(FSocket* ClientSocket, TArray<uint8>& Frame);
+
+	/** Handle get_metrics as JSON or Prometheus text (no game thread needed) */
+	bool HandleGetMetrics(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame);
+
+	/** Handle dump_flight_recorder: return the last "count" requests, optionally logging them too */
+	bool HandleDumpFlightRecorder(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame);
+
+	/** Add an answered request to the metrics and the flight recorder */
+	void RecordRequest(const FString& CommandType, const FString& SessionId, const FString& RequestId, const FMCPRequestTimings& Timings);
+
+	/** The running recording, or null */
+	TSharedPtr<FMCPCommandRecorder> GetRecorder() const;
+
+	/** Lane for a request: its "priority" field if valid, else the command's default */
+	EMCPLane ResolveLane(const FString& CommandType, const TSharedPtr<FJsonObject>& Request, EMCPLane DefaultLane) const;
+
+	/** Handle get_job / cancel_job / list_jobs (no game thread needed) */
+	bool HandleJobCommand(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, const FString& SessionId, TArray<uint8>& Frame);
+
+	/** Handle cancel: stop a request (or async job) by id from any connection */
+	bool HandleCancel(FSocket* ClientSocket, const TSharedPtr<FJsonObject>& Params, TArray<uint8>& Frame);
+
+	/** Handle subscribe / unsubscribe for this connection (no game thread needed) */
+	bool HandleSubscription(FSocket* ClientSocket, const FString& CommandType, const TSharedPtr<FJsonObject>& Params, int32 ConnectionId, const TSharedPtr<FMCPOutbox>& Outbox, TArray<uint8>& Frame);
+
+	/**
+	 * Execute command on game thread, streaming the response into Frame after its length prefix.
+	 * Dropped with a cancelled/deadline_exceeded error if CancelToken stops before it runs,
+	 * and answered with a busy error without waiting if the lane is full.
+	 * @return True if the command itself ran
+	 */
+	bool ExecuteOnGameThread(const FString& CommandType, TSharedPtr<FJsonObject> Params, const FString& SessionId, const FString& RequestId, EMCPLane Lane, const TSharedRef<FMCPCancelToken>& CancelToken, FMCPRequestTimings& Timings, TArray<uint8>& Frame);
+
+	/** Drop a connection-scoped session on the game thread */
+	void ReleaseSessionOnGameThread(const FString& SessionId);
+
+	/** Runs commands and provides the shared services below */
+	TSharedRef<IMCPCommandExecutor> Executor;
+
+	/** Command registry captured at construction (immutable, read from the server thread) */
+	TSharedPtr<const FMCPCommandRegistry> CommandRegistry;
+
+	/** Snapshots published by the game thread (read from client threads) */
+	TSharedPtr<const IMCPSnapshotReader> SnapshotStore;
+
+	/** Async jobs (created here, run on the game thread) */
+	TSharedPtr<FMCPJobManager> JobManager;
+
+	/** Editor events (published on the game thread, subscribed from client threads) */
+	TSharedPtr<FMCPEventHub> EventHub;
+
+	/** Responses of recent keyed mutating commands (shared by all connections) */
+	TSharedPtr<FMCPResultCache> ResultCache;
+
+	/** Per-command latency and size histograms (recorded from every client thread) */
+	TSharedPtr<FMCPMetrics> Metrics;
+
+	/** Ring of recently answered requests (recorded from every client thread) */
+	TSharedPtr<FMCPFlightRecorder> FlightRecorder;
+
+	/** Recording of inbound requests, if one is running (swapped under RecorderLock) */
+	TSharedPtr<FMCPCommandRecorder> Recorder;
+	mutable FCriticalSection RecorderLock;
+
+	/** Priority lanes in front of the game thread */
+	TSharedRef<FMCPDispatcher> Dispatcher;
+
+	/** In-flight requests by client "id" (shared by all connections) */
+	FMCPRequestTracker RequestTracker;
+
+	/** Listener socket */
+	FSocket* ListenerSocket;
+
+	/** Port to listen on */
+	int32 Port;
+
+	/** Server thread */
+	FRunnableThread* Thread;
+
+	/** Flag to signal thread to stop */
+	TAtomic<bool> bShouldStop;
+
+	/** Flag indicating if server is running */
+	TAtomic<bool> bIsRunning;
+
+	/** Active client connections (accept thread only) */
+	TArray<TUniquePtr<FMCPClientRunnable>> Clients;
+
+	/** Id for the next accepted connection (names its default session) */
+	int32 NextConnectionId;
+
+	/** Maximum concurrent client connections */
+	static constexpr int32 MaxClients = 8;
+
+	/** Connection timeout in seconds */
+	static constexpr float ConnectionTimeout = 60.0f;
+
+	/** How long a client thread waits for a request before flushing its outbox again */
+	static constexpr int32 ClientPollIntervalMs = 20;
+
+	/** Longest a retry waits for its first attempt, if the request has no deadline */
+	static constexpr double IdempotentWaitTimeout = 300.0;
+
+	/** Receive buffer size */
+	static constexpr int32 RecvBufferSize = 1024 * 1024;  // 1MB
+};
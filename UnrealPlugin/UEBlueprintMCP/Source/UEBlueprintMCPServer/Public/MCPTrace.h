@@ -0,0 +1,44 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+/**
+ * Unreal Insights instrumentation of the MCP pipeline.
+ *
+ * Everything goes on the "MCP" trace channel, so a capture can include it
+ * without the rest of the cpu channel, e.g.:
+ *   -trace=cpu,mcp,counters,bookmark,region
+ *
+ * - CPU scopes for receive, parse, validate/execute/post-validate (named
+ *   per command), save, compile and send.
+ * - A timing region per request for its wait in a dispatcher lane.
+ * - A bookmark per request with its command type and request id; scope
+ *   names carry only the command type, so the timer table stays grouped
+ *   by command instead of growing one timer per request.
+ * - Counters for queued game-thread work and bytes received/sent.
+ */
+UE_TRACE_CHANNEL_EXTERN(MCPChannel, UEBLUEPRINTMCPSERVER_API);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(MCPQueueDepth);
+
+namespace MCPTrace
+{
+	/** Add to the running MCP/BytesReceived counter (thread-safe) */
+	UEBLUEPRINTMCPSERVER_API void CountBytesReceived(int64 Bytes);
+
+	/** Add to the running MCP/BytesSent counter (thread-safe) */
+	UEBLUEPRINTMCPSERVER_API void CountBytesSent(int64 Bytes);
+}
+
+/** CPU scope with a static name on the MCP channel */
+#define MCP_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, MCPChannel)
+
+/** CPU scope with a formatted name on the MCP channel; the name is only built while the channel is on */
+#define MCP_TRACE_SCOPE_TEXT(Format, ...) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(UE_TRACE_CHANNELEXPR_IS_ENABLED(MCPChannel) ? *FString::Printf(Format, ##__VA_ARGS__) : TEXT(""), MCPChannel)
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 zolnoor. All rights reserved.
+
+using UnrealBuildTool;
+
+// The MCP transport and its services. Nothing above Core, so the server and
+// FMCPMockExecutor also build into a plain program or a Low-Level Test target.
+public class UEBlueprintMCPServer : ModuleRules
+{
+	public UEBlueprintMCPServer(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[]
+		{
+			"Core",
+			"Json",               // FJsonObject and TJsonWriter in the public headers
+			"Sockets",            // FSocket in FMCPServer
+		});
+	}
+}